@@ -1081,6 +1081,24 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function:: 
         void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
 
+        //!rst::
+        // Apply to an image whose color channels could be premultiplied by the alpha
+        // channel. With :cpp:enumerator:`ALPHA_PREMULTIPLIED`, the color channels are
+        // divided by alpha before the color processing and multiplied by the processed
+        // alpha afterwards, as part of the bit-depth conversions (i.e. with no extra pass
+        // on the image). The fully transparent pixels (i.e. alpha not greater than 0)
+        // are not processed, only converted to the output bit-depth. An image without
+        // an alpha channel is processed as with :cpp:enumerator:`ALPHA_STRAIGHT`.
+        //
+        // .. note::
+        //    The statistics only describe the processing of straight alpha images.
+
+        //!cpp:function:: 
+        void apply(ImageDesc & imgDesc, AlphaMode alphaMode) const;
+        //!cpp:function:: 
+        void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                   AlphaMode alphaMode) const;
+
         //!rst::
         // Apply to a single pixel respecting that the input and output bit-depths
         // be 32-bit float and the image buffer be packed RGB/RGBA.
@@ -1095,6 +1113,101 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function:: 
         void applyRGBA(float * pixel) const;
 
+        //!rst::
+        // Fill an image with a processed constant color i.e. the color is processed only
+        // once. The color is one packed RGBA 32-bit float pixel (i.e. whatever the input
+        // bit-depth) and the destination image respects the output bit-depth.
+        //
+        // .. note::
+        //    All the ops process the color in 32-bit float, so the result could slightly
+        //    differ from an image apply using optimized integer look-ups.
+
+        //!cpp:function:: 
+        void applyConstantRGBA(const float * pixel, ImageDesc & dstImgDesc) const;
+
+        ///////////////////////////////////////////////////////////////////////////
+        //!rst::
+        // Uniform regions
+        // ^^^^^^^^^^^^^^^
+        // Opt-in detection of the runs of identical pixels in each image line, enabled
+        // by finalizing the CPU processor with the FINALIZATION_RUN_DETECTION flag, so
+        // the complete color processing is only done once per run, the packing and
+        // unpacking steps still being done per pixel. It speeds up the images with
+        // large flat regions (e.g. letterbox bars, mattes or constant backgrounds) but
+        // adds a comparison per pixel to the other ones. A line with too few runs is
+        // processed as usual.
+        //
+        // .. note::
+        //    The detection is not used when the statistics are enabled, nor when the
+        //    processing is a single look-up from the input to the output values.
+        //    The number of lines accumulates over the apply calls until the
+        //    statistics are reset.
+
+        //!cpp:function::
+        bool isRunDetectionEnabled() const;
+        //!cpp:function:: Accumulated number of image lines processed once per run.
+        long long getRunDetectionNumLines() const;
+
+        ///////////////////////////////////////////////////////////////////////////
+        //!rst::
+        // Color cache
+        // ^^^^^^^^^^^
+        // Opt-in cache of the processed colors for the images with a limited palette
+        // (e.g. graphics, user interfaces or 8-bit sources), enabled by finalizing the
+        // CPU processor with the FINALIZATION_COLOR_CACHE flag. The cache is direct-mapped,
+        // keyed by the exact bits of the input color, and holds the result of the
+        // complete chain of ops. It is local to each apply call (i.e. no locking
+        // between threads) and stops being used when the hit rate is too low. It is
+        // only worth it for expensive ops such as inverse 3D LUTs.
+        //
+        // .. note::
+        //    The cache is not used when the statistics are enabled. The number of
+        //    lookups & hits accumulate over the apply calls until the statistics
+        //    are reset.
+
+        //!cpp:function::
+        bool isColorCacheEnabled() const;
+        //!cpp:function:: Accumulated number of pixels looked up in the cache.
+        long long getColorCacheNumLookups() const;
+        //!cpp:function:: Accumulated number of pixels found in the cache.
+        long long getColorCacheNumHits() const;
+
+        ///////////////////////////////////////////////////////////////////////////
+        //!rst::
+        // Statistics
+        // ^^^^^^^^^^
+        // Opt-in instrumentation of the image apply methods, enabled by finalizing the
+        // CPU processor with the FINALIZATION_STATISTICS flag. When enabled, each
+        // processing step records its accumulated wall time, number of pixels and
+        // number of bytes read & written. The steps are the unpacking of the input
+        // buffer to 32-bit float RGBA, each CPU op, and the packing to the output
+        // buffer (the first or last op may be fused into the unpacking or packing
+        // step).
+        //
+        // .. note::
+        //    The statistics accumulate over the apply calls until they are reset.
+        //    Timing adds an overhead per scanline and per op, so only enable it
+        //    when investigating performance.
+
+        //!cpp:function::
+        bool isStatisticsEnabled() const;
+        //!cpp:function:: Reset the accumulated statistics.
+        void resetStatistics() const;
+
+        //!cpp:function:: Number of processing steps.
+        int getNumStatistics() const;
+        //!cpp:function:: Description of the processing step (e.g. "<Lut3DOp>").
+        const char * getStatisticName(int index) const;
+        //!cpp:function:: Accumulated wall time of the processing step in seconds.
+        double getStatisticTime(int index) const;
+        //!cpp:function:: Accumulated number of pixels processed by the step.
+        long long getStatisticNumPixels(int index) const;
+        //!cpp:function:: Accumulated number of bytes read & written by the step.
+        long long getStatisticNumBytes(int index) const;
+
+        //!cpp:function:: Write the statistics as a JSON document.
+        void serializeStatistics(std::ostream & os) const;
+
     private:
         CPUProcessor();
         ~CPUProcessor();
@@ -1305,6 +1418,23 @@ OCIO_NAMESPACE_ENTER
         
         //!cpp:function:: bake the lut into the output stream
         void bake(std::ostream & os) const;
+
+        //!cpp:function:: add a target to bake with :cpp:func:`Baker::bakeTargets`
+        // i.e. a lut format, the output stream, and optional cube and shaper
+        // sizes (-1 uses the baker ones). The stream must stay valid until the
+        // targets are baked. Targets are not copied by createEditableCopy.
+        void addTarget(const char * formatName, std::ostream & os,
+                       int cubeSize = -1, int shaperSize = -1);
+        //!cpp:function:: get the number of targets
+        int getNumTargets() const;
+        //!cpp:function:: remove all the targets
+        void clearTargets();
+
+        //!cpp:function:: bake all the targets. The processed lattices are
+        // shared between the targets: each shaper and cube lattice is only
+        // evaluated once, and a smaller cube whose grid nests in a larger one
+        // is sub-sampled from it.
+        void bakeTargets() const;
         
         //!cpp:function:: get the number of lut writers
         static int getNumFormats();
@@ -1575,6 +1705,93 @@ OCIO_NAMESPACE_ENTER
         PlanarImageDesc(const PlanarImageDesc &);
         PlanarImageDesc& operator= (const PlanarImageDesc &);
     };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    //!rst::
+    // BitPackedImageDesc
+    // ^^^^^^^^^^^^^^^^^^
+
+    //!cpp:class::
+    class OCIOEXPORT BitPackedImageDesc : public ImageDesc
+    {
+    public:
+
+        //!rst::
+        // The constructor expects a pointer to the 32-bit words holding the bit-packed
+        // integer values (such as the DPX 10-bit or 12-bit image data) starting at
+        // the first pixel of a line. Each line starts on a word, the 10-bit layouts
+        // only hold RGB pixels (i.e. one pixel per word) and the 12-bit layout holds
+        // RGB or RGBA pixels. The unpacked values are BIT_DEPTH_UINT10 or
+        // BIT_DEPTH_UINT12 so the CPUProcessor must use the matching bit-depth.
+        //
+        // .. note::
+        // As the channels are not byte addressable, getRData() returns the data
+        // pointer, the other channel pointers are null and the x stride is 0.
+
+        //!cpp:function::
+        //
+        // .. note::
+        //    numChannels must be 3 (RGB) for the 10-bit layouts, and 3 (RGB) or
+        //    4 (RGBA) for the 12-bit one. bigEndian describes the byte order
+        //    of the words.
+        BitPackedImageDesc(void * data,
+                           long width, long height,
+                           long numChannels,
+                           BitPacking packing,
+                           bool bigEndian,
+                           ptrdiff_t yStrideBytes = AutoStride);
+
+        //!cpp:function::
+        virtual ~BitPackedImageDesc();
+
+        //!cpp:function:: Get the layout of the values in the words.
+        BitPacking getBitPacking() const;
+        //!cpp:function:: Is the byte order of the words big-endian?
+        bool isBigEndian() const;
+
+        //!cpp:function:: Get the bit-depth of the unpacked values.
+        BitDepth getBitDepth() const override;
+
+        //!cpp:function:: Get a pointer to the first word of the first pixel.
+        void * getData() const;
+
+        //!cpp:function::
+        void * getRData() const override;
+        //!cpp:function::
+        void * getGData() const override;
+        //!cpp:function::
+        void * getBData() const override;
+        //!cpp:function::
+        void * getAData() const override;
+
+        //!cpp:function::
+        long getWidth() const override;
+        //!cpp:function::
+        long getHeight() const override;
+        //!cpp:function::
+        long getNumChannels() const;
+
+        //!cpp:function::
+        ptrdiff_t getXStrideBytes() const override;
+        //!cpp:function::
+        ptrdiff_t getYStrideBytes() const override;
+
+        //!cpp:function::
+        bool isRGBAPacked() const override;
+        //!cpp:function::
+        bool isFloat() const override;
+
+    private:
+        struct Impl;
+        Impl * m_impl;
+        Impl * getImpl() { return m_impl; }
+        const Impl * getImpl() const { return m_impl; }
+
+        BitPackedImageDesc();
+        BitPackedImageDesc(const BitPackedImageDesc &);
+        BitPackedImageDesc& operator= (const BitPackedImageDesc &);
+    };
     
     
     ///////////////////////////////////////////////////////////////////////////
@@ -1774,6 +1991,32 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function::
         virtual const char * getCacheID() const;
 
+        enum ParameterMode
+        {
+            PARAMETER_CONSTANT = 0, // The op parameters are constants (default)
+            PARAMETER_UNIFORM,      // Each op parameter is a float uniform
+            PARAMETER_UNIFORM_BLOCK // The op parameters are the float members of a
+                                    // std140 uniform block
+        };
+
+        //!cpp:function:: Set how the op parameters (i.e. CDL, Matrix, Exponent, Range
+        // and Log ones) are written in the shader program
+        //
+        // .. note::
+        //   With the uniform modes, the op parameters are the uniforms of type
+        //   DYNAMIC_PROPERTY_PARAMETER. Their names only depend on the list of ops
+        //   (i.e. these ops are neither removed nor combined by the optimizations,
+        //   even when their values make them identities) so a host can update the values of an existing shader program (i.e.
+        //   same cache identifier) instead of rebuilding it when a parameter
+        //   changes. With PARAMETER_UNIFORM_BLOCK, these uniforms are the members,
+        //   in the uniform order, of the block named '<resource prefix>_parameters'
+        //   i.e. the n-th one is at the offset 4 * n. The uniform blocks are only
+        //   supported by the GLSL 4.0 and HLSL languages.
+        //
+        void setParameterMode(ParameterMode mode);
+        //!cpp:function::
+        ParameterMode getParameterMode() const;
+
     public:
 
         enum TextureType
@@ -1782,6 +2025,25 @@ OCIO_NAMESPACE_ENTER
             TEXTURE_RGB_CHANNEL
         };
 
+        enum TextureFormat
+        {
+            TEXTURE_FORMAT_FLOAT32 = 0, // 32-bit float values (default)
+            TEXTURE_FORMAT_FLOAT16,     // 16-bit half float values
+            TEXTURE_FORMAT_UNORM16      // 16-bit normalized values (i.e. unsigned short)
+        };
+
+        //!cpp:function:: Set the format of the texture values
+        //
+        // .. note::
+        //   The 16-bit formats halve the texture memory and bandwidth at the
+        //   cost of some precision (refer to getTexturePackingInfo). The format
+        //   must be set before the shader program extraction as the shader code
+        //   depends on it.
+        //
+        void setTextureFormat(TextureFormat format);
+        //!cpp:function::
+        TextureFormat getTextureFormat() const;
+
         //!cpp:function:: Dynamic Property related methods.
         virtual unsigned getNumUniforms() const = 0;
         virtual void getUniform(unsigned index, const char *& name, 
@@ -1801,6 +2063,16 @@ OCIO_NAMESPACE_ENTER
                                 unsigned & width, unsigned & height,
                                 TextureType & channel, Interpolation & interpolation) const = 0;
         virtual void getTextureValues(unsigned index, const float *& values) const = 0;
+        //!cpp:function:: Get the 16-bit texture values (i.e. half or unsigned short values
+        // depending on the texture format), or null with TEXTURE_FORMAT_FLOAT32.
+        // The default implementation returns null i.e. no packed values.
+        virtual void getTexturePackedValues(unsigned index, const void *& values) const;
+        //!cpp:function:: Get the largest absolute error of the decoded 16-bit texture values,
+        // and how to decode the TEXTURE_FORMAT_UNORM16 values
+        // i.e. value = scale * (packed / 65535) + offset. The default implementation
+        // returns a zero error, a unit scale and a zero offset.
+        virtual void getTexturePackingInfo(unsigned index, float & maxError,
+                                           float & scale, float & offset) const;
 
         //!cpp:function:: 3D lut related methods
         virtual unsigned getNum3DTextures() const = 0;
@@ -1809,6 +2081,11 @@ OCIO_NAMESPACE_ENTER
         virtual void get3DTexture(unsigned index, const char *& name, const char *& id, 
                                   unsigned & edgelen, Interpolation & interpolation) const = 0;
         virtual void get3DTextureValues(unsigned index, const float *& values) const = 0;
+        //!cpp:function::
+        virtual void get3DTexturePackedValues(unsigned index, const void *& values) const;
+        //!cpp:function::
+        virtual void get3DTexturePackingInfo(unsigned index, float & maxError,
+                                             float & scale, float & offset) const;
 
         //!cpp:function:: Methods to specialize parts of a OCIO shader program
         //
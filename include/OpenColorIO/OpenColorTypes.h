@@ -324,6 +324,26 @@ OCIO_NAMESPACE_ENTER
         CHANNEL_ORDERING_BGR
     };
 
+    //!cpp:type:: Used by :cpp:class`CPUProcessor` to indicate whether the color channels
+    //            of the image to process are premultiplied by the alpha channel.
+    enum AlphaMode
+    {
+        ALPHA_STRAIGHT = 0,     // The color channels are independent from the alpha channel.
+        ALPHA_PREMULTIPLIED     // The color channels are premultiplied by the alpha channel.
+    };
+
+    //!cpp:type:: Used by :cpp:class`BitPackedImageDesc` to indicate the layout
+    //            of the integer values in the 32-bit words of the image to process.
+    enum BitPacking
+    {
+        BIT_PACKING_10_FILLED_A = 0, // 10-bit RGB per word, the 2 padding bits are the
+                                     // lowest ones (i.e. DPX filled method A).
+        BIT_PACKING_10_FILLED_B,     // 10-bit RGB per word, the 2 padding bits are the
+                                     // highest ones (i.e. DPX filled method B).
+        BIT_PACKING_12_PACKED        // Consecutive 12-bit values filling the words from
+                                     // the lowest bits (i.e. DPX packed).
+    };
+
     //!cpp:type::
     enum Allocation {
         ALLOCATION_UNKNOWN = 0,
@@ -380,7 +400,10 @@ OCIO_NAMESPACE_ENTER
     {
         DYNAMIC_PROPERTY_EXPOSURE = 0, //! Image exposure value (double floating point value)
         DYNAMIC_PROPERTY_CONTRAST,     //! Image contrast value (double floating point value)
-        DYNAMIC_PROPERTY_GAMMA         //! Image gamma value (double floating point value)
+        DYNAMIC_PROPERTY_GAMMA,        //! Image gamma value (double floating point value)
+        DYNAMIC_PROPERTY_PARAMETER     //! Op parameter held by a shader uniform (double
+                                       //! floating point value), refer to
+                                       //! GpuShaderDesc::setParameterMode
     };
 
     enum DynamicPropertyValueType
@@ -424,6 +447,12 @@ OCIO_NAMESPACE_ENTER
         // For integer input bit-depth only, replace separable ops 
         // (i.e. no channel crosstalk ops) by a single 1D LUT of input bit-depth domain.
         OPTIMIZATION_COMP_SEPARABLE_PREFIX = 0x0400,
+        // Replace an expensive chain of ops by a shaper 1D LUT and a 3D LUT when the 
+        // estimated CPU cost justifies it and the measured error remains small.
+        OPTIMIZATION_COMP_BAKE_LUT3D       = 0x0800,
+        // For integer output bit-depth only, replace the trailing separable ops 
+        // by a single half-domain 1D LUT also doing the output bit-depth conversion.
+        OPTIMIZATION_COMP_SEPARABLE_SUFFIX = 0x1000,
 
         // Can apply all the optimization types.
         OPTIMIZATION_ALL                   = 0xFFFF,
@@ -441,7 +470,8 @@ OCIO_NAMESPACE_ENTER
 
         OPTIMIZATION_VERY_GOOD  = (OPTIMIZATION_LOSSLESS
                                     | OPTIMIZATION_COMP_LUT1D
-                                    | OPTIMIZATION_COMP_SEPARABLE_PREFIX),
+                                    | OPTIMIZATION_COMP_SEPARABLE_PREFIX
+                                    | OPTIMIZATION_COMP_SEPARABLE_SUFFIX),
 
         OPTIMIZATION_GOOD       = OPTIMIZATION_VERY_GOOD | OPTIMIZATION_COMP_LUT3D,
 
@@ -458,7 +488,18 @@ OCIO_NAMESPACE_ENTER
         FINALIZATION_EXACT = 0,
         FINALIZATION_FAST,
 
-        FINALIZATION_DEFAULT = FINALIZATION_FAST
+        FINALIZATION_DEFAULT = FINALIZATION_FAST,
+
+        // Record the per-op timing statistics of the CPU processor
+        // (e.g. FINALIZATION_DEFAULT | FINALIZATION_STATISTICS).
+        FINALIZATION_STATISTICS = 0x10,
+
+        // Only process once the runs of identical pixels of each image line
+        // with the CPU processor.
+        FINALIZATION_RUN_DETECTION = 0x20,
+
+        // Cache the colors processed by the CPU processor.
+        FINALIZATION_COLOR_CACHE = 0x40
     };
    
 
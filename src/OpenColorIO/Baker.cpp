@@ -1,11 +1,16 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 #include <iostream>
+#include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "ops/Lut1D/Lut1DOp.h"
 #include "transforms/FileTransform.h"
 #include "MathUtils.h"
 #include "pystring/pystring.h"
@@ -37,6 +42,18 @@ OCIO_NAMESPACE_ENTER
         std::string targetSpace_;
         int shapersize_;
         int cubesize_;
+
+        struct Target
+        {
+            std::string formatName_;
+            std::ostream * os_;
+            int cubesize_;
+            int shapersize_;
+        };
+        std::vector<Target> targets_;
+
+        // Lattices shared by the targets baked together.
+        BakingContextRcPtr context_;
         
         Impl() :
             shapersize_(-1),
@@ -202,6 +219,252 @@ OCIO_NAMESPACE_ENTER
         return getImpl()->cubesize_;
     }
     
+    void Baker::addTarget(const char * formatName, std::ostream & os,
+                          int cubesize, int shapersize)
+    {
+        Impl::Target target;
+        target.formatName_ = formatName ? formatName : "";
+        target.os_ = &os;
+        target.cubesize_ = cubesize;
+        target.shapersize_ = shapersize;
+        getImpl()->targets_.push_back(target);
+    }
+
+    int Baker::getNumTargets() const
+    {
+        return static_cast<int>(getImpl()->targets_.size());
+    }
+
+    void Baker::clearTargets()
+    {
+        getImpl()->targets_.clear();
+    }
+
+    void Baker::bakeTargets() const
+    {
+        if(getImpl()->targets_.empty())
+        {
+            throw Exception("No bake targets have been added.");
+        }
+
+        const std::vector<Impl::Target> & targets = getImpl()->targets_;
+        const size_t numTargets = targets.size();
+
+        // Cube size actually baked by each target i.e. the target one, else
+        // the baker one, else the format default.
+        std::vector<int> cubeSizes(numTargets, -1);
+        for(size_t i = 0; i < numTargets; ++i)
+        {
+            int cubeSize = targets[i].cubesize_;
+            if(cubeSize == -1) cubeSize = getImpl()->cubesize_;
+            if(cubeSize == -1)
+            {
+                const std::string & name = targets[i].formatName_;
+                FileFormat * fmt = FormatRegistry::GetInstance().getFileFormatByName(name);
+                if(fmt) cubeSize = fmt->getDefaultCubeSize(name);
+            }
+            cubeSizes[i] = cubeSize;
+        }
+
+        // Bake the largest cubes first so the smaller nested ones are
+        // sub-sampled from them.
+        std::vector<size_t> order(numTargets);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&cubeSizes](size_t a, size_t b)
+                         {
+                             return cubeSizes[a] > cubeSizes[b];
+                         });
+
+        BakingContextRcPtr context = std::make_shared<BakingContext>();
+
+        // Several targets may share a stream so the outputs are written in
+        // the order the targets were added, once all of them are baked.
+        std::vector<std::ostringstream> outputs(numTargets);
+        for(size_t idx : order)
+        {
+            const Impl::Target & target = targets[idx];
+
+            BakerRcPtr baker = createEditableCopy();
+            baker->setFormat(target.formatName_.c_str());
+            if(target.cubesize_ != -1) baker->setCubeSize(target.cubesize_);
+            if(target.shapersize_ != -1) baker->setShaperSize(target.shapersize_);
+            baker->getImpl()->context_ = context;
+
+            baker->bake(outputs[idx]);
+        }
+
+        for(size_t i = 0; i < numTargets; ++i)
+        {
+            *targets[i].os_ << outputs[i].str();
+        }
+    }
+
+    namespace
+    {
+        std::string GetLatticeKey(const ConstCPUProcessorVec & procs)
+        {
+            std::string key;
+            for(const auto & proc : procs)
+            {
+                key += proc->getCacheID();
+                key += "\n";
+            }
+            return key;
+        }
+
+        void ApplyProcessors(const ConstCPUProcessorVec & procs,
+                             float * data, long numPixels, long numChannels)
+        {
+            PackedImageDesc img(data, numPixels, 1, numChannels);
+            for(const auto & proc : procs)
+            {
+                proc->apply(img);
+            }
+        }
+
+        // Are the identity values of a grid of size entries the same as
+        // the ones of the nesting grid of largeSize entries?
+        bool IsNestedGrid(int size, int largeSize)
+        {
+            if(size < 2 || largeSize < size || (largeSize - 1) % (size - 1) != 0)
+            {
+                return false;
+            }
+
+            // Same computation as GenerateIdentityLut3D().
+            const int step = (largeSize - 1) / (size - 1);
+            const float c = 1.0f / ((float)size - 1.0f);
+            const float largeC = 1.0f / ((float)largeSize - 1.0f);
+            for(int i = 0; i < size; ++i)
+            {
+                if((float)i * c != (float)(i * step) * largeC)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    void BakingContext::evaluateLut3D(const ConstCPUProcessorVec & procs,
+                                      int size,
+                                      Lut3DOrder order,
+                                      std::vector<float> & data)
+    {
+        if(order != LUT3DORDER_FAST_RED && order != LUT3DORDER_FAST_BLUE)
+        {
+            throw Exception("Unknown Lut3DOrder.");
+        }
+
+        Lattice3DVec & lattices = m_lut3Ds[GetLatticeKey(procs)];
+
+        const Lattice3D * lattice = nullptr;
+        for(const auto & candidate : lattices)
+        {
+            if(candidate.m_size == size)
+            {
+                lattice = &candidate;
+                break;
+            }
+            if(!lattice && IsNestedGrid(size, candidate.m_size))
+            {
+                lattice = &candidate;
+            }
+        }
+
+        if(!lattice)
+        {
+            Lattice3D newLattice;
+            newLattice.m_size = size;
+            newLattice.m_data.resize(size*size*size*3);
+            GenerateIdentityLut3D(&newLattice.m_data[0], size, 3, LUT3DORDER_FAST_RED);
+            ApplyProcessors(procs, &newLattice.m_data[0], size*size*size, 3);
+            ++m_numEvaluations;
+
+            lattices.push_back(newLattice);
+            lattice = &lattices.back();
+        }
+
+        const int largeSize = lattice->m_size;
+        const int step = (size > 1) ? (largeSize - 1) / (size - 1) : 1;
+
+        data.resize(size*size*size*3);
+        for(int b = 0; b < size; ++b)
+        {
+            for(int g = 0; g < size; ++g)
+            {
+                for(int r = 0; r < size; ++r)
+                {
+                    const int src = (r + (g + b * largeSize) * largeSize) * step;
+                    const int dst = (order == LUT3DORDER_FAST_RED)
+                                    ? r + (g + b * size) * size
+                                    : b + (g + r * size) * size;
+
+                    data[3*dst+0] = lattice->m_data[3*src+0];
+                    data[3*dst+1] = lattice->m_data[3*src+1];
+                    data[3*dst+2] = lattice->m_data[3*src+2];
+                }
+            }
+        }
+    }
+
+    void BakingContext::evaluateLut1D(const ConstCPUProcessorVec & procs,
+                                      int size,
+                                      int numChannels,
+                                      std::vector<float> & data)
+    {
+        std::ostringstream key;
+        key << GetLatticeKey(procs) << size << " " << numChannels;
+
+        std::vector<float> & lattice = m_lut1Ds[key.str()];
+        if(lattice.empty())
+        {
+            lattice.resize(size*numChannels);
+            GenerateIdentityLut1D(&lattice[0], size, numChannels);
+            ApplyProcessors(procs, &lattice[0], size, numChannels);
+            ++m_numEvaluations;
+        }
+
+        data = lattice;
+    }
+
+    void BakingContext::EvaluateLut3D(BakingContext * context,
+                                      const ConstCPUProcessorVec & procs,
+                                      int size,
+                                      Lut3DOrder order,
+                                      std::vector<float> & data)
+    {
+        if(context)
+        {
+            context->evaluateLut3D(procs, size, order, data);
+        }
+        else
+        {
+            data.resize(size*size*size*3);
+            GenerateIdentityLut3D(&data[0], size, 3, order);
+            ApplyProcessors(procs, &data[0], size*size*size, 3);
+        }
+    }
+
+    void BakingContext::EvaluateLut1D(BakingContext * context,
+                                      const ConstCPUProcessorVec & procs,
+                                      int size,
+                                      int numChannels,
+                                      std::vector<float> & data)
+    {
+        if(context)
+        {
+            context->evaluateLut1D(procs, size, numChannels, data);
+        }
+        else
+        {
+            data.resize(size*numChannels);
+            GenerateIdentityLut1D(&data[0], size, numChannels);
+            ApplyProcessors(procs, &data[0], size, numChannels);
+        }
+    }
+    
     void Baker::bake(std::ostream & os) const
     {
         FileFormat* fmt = FormatRegistry::GetInstance().getFileFormatByName(getImpl()->formatName_);
@@ -216,7 +479,7 @@ OCIO_NAMESPACE_ENTER
         
         try
         {
-            fmt->bake(*this, getImpl()->formatName_, os);
+            fmt->bake(*this, getImpl()->formatName_, os, getImpl()->context_.get());
         }
         catch(std::exception & e)
         {
@@ -388,6 +651,188 @@ OCIO_ADD_TEST(Baker_Unit_Tests, bake)
 
 }
 
+namespace
+{
+static const std::string bakeTargetsProfile =
+    "ocio_profile_version: 1\n"
+    "\n"
+    "strictparsing: false\n"
+    "\n"
+    "colorspaces :\n"
+    "  - !<ColorSpace>\n"
+    "    name : lnh\n"
+    "    bitdepth : 16f\n"
+    "    isdata : false\n"
+    "    allocation : lg2\n"
+    "\n"
+    "  - !<ColorSpace>\n"
+    "    name : test\n"
+    "    bitdepth : 8ui\n"
+    "    isdata : false\n"
+    "    allocation : uniform\n"
+    "    to_reference : !<MatrixTransform> {matrix: [0.8, 0.1, 0.1, 0, 0.2, 0.7, 0.1, 0, "
+                                                     "0.1, 0.1, 0.8, 0, 0, 0, 0, 1]}\n";
+}
+
+OCIO_ADD_TEST(Baker_Unit_Tests, bake_targets)
+{
+    std::istringstream is(bakeTargetsProfile);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    OCIO::BakerRcPtr baker = OCIO::Baker::Create();
+    baker->setConfig(config);
+    baker->setInputSpace("lnh");
+    baker->setTargetSpace("test");
+    baker->setShaperSize(10);
+    baker->setCubeSize(3);
+
+    OCIO_CHECK_THROW_WHAT(baker->bakeTargets(), OCIO::Exception,
+                          "No bake targets have been added");
+
+    struct TargetDesc
+    {
+        const char * format;
+        int cubeSize;
+        int shaperSize;
+    };
+    const TargetDesc descs[] = { { "cinespace",    -1, -1 },
+                                 { "iridas_cube",   5, -1 },
+                                 { "flame",         9, -1 },
+                                 { "resolve_cube", -1, -1 },
+                                 { "houdini",       5,  8 },
+                                 { "truelight",     2, -1 },
+                                 { "iridas_itx",    9, -1 } };
+    const size_t numTargets = sizeof(descs) / sizeof(descs[0]);
+
+    std::ostringstream streams[numTargets];
+    for (size_t i = 0; i < numTargets; ++i)
+    {
+        baker->addTarget(descs[i].format, streams[i], descs[i].cubeSize, descs[i].shaperSize);
+    }
+    OCIO_CHECK_EQUAL(baker->getNumTargets(), (int)numTargets);
+
+    // Targets are not copied.
+    OCIO_CHECK_EQUAL(baker->createEditableCopy()->getNumTargets(), 0);
+
+    OCIO_CHECK_NO_THROW(baker->bakeTargets());
+
+    // Each target is identical to a separate bake.
+    for (size_t i = 0; i < numTargets; ++i)
+    {
+        OCIO::BakerRcPtr single = baker->createEditableCopy();
+        single->setFormat(descs[i].format);
+        if (descs[i].cubeSize != -1) single->setCubeSize(descs[i].cubeSize);
+        if (descs[i].shaperSize != -1) single->setShaperSize(descs[i].shaperSize);
+
+        std::ostringstream os;
+        OCIO_CHECK_NO_THROW(single->bake(os));
+        OCIO_CHECK_ASSERT(!os.str().empty());
+        OCIO_CHECK_EQUAL(streams[i].str(), os.str());
+    }
+
+    baker->clearTargets();
+    OCIO_CHECK_EQUAL(baker->getNumTargets(), 0);
+
+    std::ostringstream os;
+    baker->addTarget("unknown", os);
+    OCIO_CHECK_THROW_WHAT(baker->bakeTargets(), OCIO::Exception,
+                          "The format named 'unknown' could not be found");
+}
+
+OCIO_ADD_TEST(Baker_Unit_Tests, bake_targets_default_size)
+{
+    std::istringstream is(bakeTargetsProfile);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    // No cube size so the format defaults are used (i.e. 17 for flame and
+    // 33 for lustre).
+    OCIO::BakerRcPtr baker = OCIO::Baker::Create();
+    baker->setConfig(config);
+    baker->setInputSpace("lnh");
+    baker->setTargetSpace("test");
+
+    std::string ref;
+    for (const char * format : { "flame", "lustre", "cinespace" })
+    {
+        OCIO::BakerRcPtr single = baker->createEditableCopy();
+        single->setFormat(format);
+        std::ostringstream os;
+        OCIO_CHECK_NO_THROW(single->bake(os));
+        ref += os.str();
+    }
+
+    // The targets sharing a stream are written in the order they were added
+    // even if the larger cubes are baked first.
+    std::ostringstream os;
+    baker->addTarget("flame", os);
+    baker->addTarget("lustre", os);
+    baker->addTarget("cinespace", os);
+    OCIO_CHECK_NO_THROW(baker->bakeTargets());
+    OCIO_CHECK_EQUAL(os.str(), ref);
+}
+
+OCIO_ADD_TEST(Baker_Unit_Tests, baking_context)
+{
+    std::istringstream is(bakeTargetsProfile);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    OCIO::ConstCPUProcessorRcPtr cpu
+        = config->getProcessor("lnh", "test")->getDefaultCPUProcessor();
+    OCIO::ConstCPUProcessorRcPtr cpuInv
+        = config->getProcessor("test", "lnh")->getDefaultCPUProcessor();
+
+    OCIO::BakingContext context;
+    std::vector<float> data;
+    // Direct evaluation (i.e. without a context) used as reference.
+    std::vector<float> refData;
+
+    // The largest cube is evaluated, the nested ones are sub-sampled
+    // in both orders.
+    context.evaluateLut3D({ cpu }, 33, OCIO::LUT3DORDER_FAST_RED, data);
+    OCIO::BakingContext::EvaluateLut3D(nullptr, { cpu }, 33, OCIO::LUT3DORDER_FAST_RED, refData);
+    OCIO_CHECK_ASSERT(data == refData);
+    OCIO_CHECK_EQUAL(context.getNumEvaluations(), 1u);
+
+    for (int size : { 2, 3, 5, 9, 17, 33 })
+    {
+        for (auto order : { OCIO::LUT3DORDER_FAST_RED, OCIO::LUT3DORDER_FAST_BLUE })
+        {
+            context.evaluateLut3D({ cpu }, size, order, data);
+            OCIO::BakingContext::EvaluateLut3D(nullptr, { cpu }, size, order, refData);
+            OCIO_CHECK_EQUAL(data.size(), (size_t)(size * size * size * 3));
+            OCIO_CHECK_ASSERT(data == refData);
+        }
+    }
+    OCIO_CHECK_EQUAL(context.getNumEvaluations(), 1u);
+
+    // Not nested.
+    context.evaluateLut3D({ cpu }, 4, OCIO::LUT3DORDER_FAST_BLUE, data);
+    OCIO::BakingContext::EvaluateLut3D(nullptr, { cpu }, 4, OCIO::LUT3DORDER_FAST_BLUE, refData);
+    OCIO_CHECK_ASSERT(data == refData);
+    OCIO_CHECK_EQUAL(context.getNumEvaluations(), 2u);
+
+    // Other processors.
+    context.evaluateLut3D({ cpu, cpuInv }, 5, OCIO::LUT3DORDER_FAST_RED, data);
+    OCIO::BakingContext::EvaluateLut3D(nullptr, { cpu, cpuInv }, 5,
+                                       OCIO::LUT3DORDER_FAST_RED, refData);
+    OCIO_CHECK_ASSERT(data == refData);
+    OCIO_CHECK_EQUAL(context.getNumEvaluations(), 3u);
+
+    // 1D lattices.
+    context.evaluateLut1D({ cpu }, 10, 3, data);
+    context.evaluateLut1D({ cpu }, 10, 3, data);
+    OCIO::BakingContext::EvaluateLut1D(nullptr, { cpu }, 10, 3, refData);
+    OCIO_CHECK_ASSERT(data == refData);
+    OCIO_CHECK_EQUAL(context.getNumEvaluations(), 4u);
+
+    context.evaluateLut1D({ cpu }, 10, 4, data);
+    OCIO_CHECK_EQUAL(data.size(), 40u);
+    OCIO_CHECK_EQUAL(context.getNumEvaluations(), 5u);
+}
+
 #endif // OCIO_BUILD_TESTS
 
     
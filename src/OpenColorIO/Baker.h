@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_BAKER_H
+#define INCLUDED_OCIO_BAKER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "ops/Lut3D/Lut3DOp.h"
+
+OCIO_NAMESPACE_ENTER
+{
+
+typedef std::vector<ConstCPUProcessorRcPtr> ConstCPUProcessorVec;
+
+// Evaluate the lattices (i.e. identity LUTs processed by a list of CPU
+// processors) written by the LUT bakers.
+//
+// When several targets are baked at once (refer to Baker::bakeTargets), the
+// context is shared by all the targets so a lattice is only evaluated once per
+// list of processors.  A 3D lattice whose grid nests in an already evaluated
+// larger one (i.e. its edge length minus one divides the larger one's) is
+// sub-sampled from it when the identity values are identical, so the result
+// is always the same as a direct evaluation.
+class BakingContext
+{
+public:
+    BakingContext() = default;
+    BakingContext(const BakingContext &) = delete;
+    BakingContext & operator=(const BakingContext &) = delete;
+
+    // Fill data with a 3 channels identity 3D LUT of edge length size in the
+    // requested order, processed by the processors.
+    void evaluateLut3D(const ConstCPUProcessorVec & procs,
+                       int size,
+                       Lut3DOrder order,
+                       std::vector<float> & data);
+
+    // Fill data with an identity 1D LUT processed by the processors.
+    void evaluateLut1D(const ConstCPUProcessorVec & procs,
+                       int size,
+                       int numChannels,
+                       std::vector<float> & data);
+
+    // Number of lattices actually processed (i.e. not found in the context).
+    unsigned getNumEvaluations() const { return m_numEvaluations; }
+
+    // Helpers for the bakers using the context when there is one,
+    // or evaluating the lattice otherwise.
+    static void EvaluateLut3D(BakingContext * context,
+                              const ConstCPUProcessorVec & procs,
+                              int size,
+                              Lut3DOrder order,
+                              std::vector<float> & data);
+
+    static void EvaluateLut1D(BakingContext * context,
+                              const ConstCPUProcessorVec & procs,
+                              int size,
+                              int numChannels,
+                              std::vector<float> & data);
+
+private:
+    // 3D lattice in the LUT3DORDER_FAST_RED order.
+    struct Lattice3D
+    {
+        int m_size;
+        std::vector<float> m_data;
+    };
+
+    typedef std::vector<Lattice3D> Lattice3DVec;
+
+    std::map<std::string, Lattice3DVec> m_lut3Ds;
+    std::map<std::string, std::vector<float>> m_lut1Ds;
+
+    unsigned m_numEvaluations = 0;
+};
+
+typedef OCIO_SHARED_PTR<BakingContext> BakingContextRcPtr;
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
@@ -159,6 +159,28 @@ struct Converter<BIT_DEPTH_F32>
     }
 };
 
+// The UINT10 & UINT12 codes are stored in 16-bit integers so an image buffer could
+// hold out of range codes (e.g. above 1023 for UINT10) which are then clamped.
+template<BitDepth bd>
+inline typename BitDepthInfo<bd>::Type ClampCode(typename BitDepthInfo<bd>::Type code)
+{
+    return code;
+}
+
+template<>
+inline uint16_t ClampCode<BIT_DEPTH_UINT10>(uint16_t code)
+{
+    return code > BitDepthInfo<BIT_DEPTH_UINT10>::maxValue
+        ? uint16_t(BitDepthInfo<BIT_DEPTH_UINT10>::maxValue) : code;
+}
+
+template<>
+inline uint16_t ClampCode<BIT_DEPTH_UINT12>(uint16_t code)
+{
+    return code > BitDepthInfo<BIT_DEPTH_UINT12>::maxValue
+        ? uint16_t(BitDepthInfo<BIT_DEPTH_UINT12>::maxValue) : code;
+}
+
 
 }
 OCIO_NAMESPACE_EXIT
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <chrono>
+#include <iomanip>
+#include <sstream>
 #include <string.h>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -9,14 +12,132 @@
 #include "CPUProcessor.h"
 #include "ops/Lut1D/Lut1DOpCPU.h"
 #include "ops/Lut3D/Lut3DOpCPU.h"
+#include "ops/Matrix/MatrixOpCPU.h"
 #include "ops/Matrix/MatrixOps.h"
 #include "ops/Range/RangeOpCPU.h"
 #include "ScanlineHelper.h"
+#include "SSE.h"
+
+#if defined(USE_SSE) && defined(__F16C__)
+#include <immintrin.h>
+#endif
 
 
 OCIO_NAMESPACE_ENTER
 {
 
+#ifdef USE_SSE
+
+// Load the four channels of a pixel as floats.
+template<BitDepth bd>
+inline __m128 LoadPixel(const typename BitDepthInfo<bd>::Type * in)
+{
+    // UINT10, UINT12 & UINT16 values are all stored in 16-bit integers.
+    const __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in));
+    const __m128 pxl = _mm_cvtepi32_ps(_mm_unpacklo_epi16(values, _mm_setzero_si128()));
+
+    // Out of range codes (e.g. above 1023 in a 10-bit image buffer) are clamped.
+    return bd==BIT_DEPTH_UINT16 ? pxl
+                                : _mm_min_ps(pxl, _mm_set1_ps(float(BitDepthInfo<bd>::maxValue)));
+}
+
+template<>
+inline __m128 LoadPixel<BIT_DEPTH_UINT8>(const uint8_t * in)
+{
+    int32_t pxl;
+    memcpy(&pxl, in, sizeof(int32_t));
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i values = _mm_unpacklo_epi8(_mm_cvtsi32_si128(pxl), zero);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(values, zero));
+}
+
+template<>
+inline __m128 LoadPixel<BIT_DEPTH_F16>(const half * in)
+{
+#ifdef __F16C__
+    return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in)));
+#else
+    // The half to float conversion is a table lookup.
+    return _mm_set_ps(in[3], in[2], in[1], in[0]);
+#endif
+}
+
+template<>
+inline __m128 LoadPixel<BIT_DEPTH_F32>(const float * in)
+{
+    return _mm_loadu_ps(in);
+}
+
+// Round, clamp and store the four channels of a pixel i.e. the SSE version of
+// Converter<bd>::CastValue().
+template<BitDepth bd>
+inline void StorePixel(__m128 values, typename BitDepthInfo<bd>::Type * out)
+{
+    // The max with zero first also converts NaNs to zero.
+    values = _mm_max_ps(_mm_add_ps(values, _mm_set1_ps(0.5f)), _mm_setzero_ps());
+    values = _mm_min_ps(values, _mm_set1_ps(float(BitDepthInfo<bd>::maxValue)));
+
+    // UINT10 & UINT12 values fit in signed 16-bit integers so the saturation
+    // of the pack is a no-op.
+    const __m128i ints = _mm_cvttps_epi32(values);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packs_epi32(ints, ints));
+}
+
+template<>
+inline void StorePixel<BIT_DEPTH_UINT8>(__m128 values, uint8_t * out)
+{
+    values = _mm_max_ps(_mm_add_ps(values, _mm_set1_ps(0.5f)), _mm_setzero_ps());
+    values = _mm_min_ps(values, _mm_set1_ps(255.0f));
+
+    __m128i ints = _mm_cvttps_epi32(values);
+    ints = _mm_packs_epi32(ints, ints);
+    ints = _mm_packus_epi16(ints, ints);
+
+    const int32_t pxl = _mm_cvtsi128_si32(ints);
+    memcpy(out, &pxl, sizeof(int32_t));
+}
+
+template<>
+inline void StorePixel<BIT_DEPTH_UINT16>(__m128 values, uint16_t * out)
+{
+    values = _mm_max_ps(_mm_add_ps(values, _mm_set1_ps(0.5f)), _mm_setzero_ps());
+    values = _mm_min_ps(values, _mm_set1_ps(65535.0f));
+
+    // There is no unsigned 32-bit to 16-bit pack in SSE2 so shift the values in the
+    // signed range before the pack, and flip the sign bits back after.
+    __m128i ints = _mm_sub_epi32(_mm_cvttps_epi32(values), _mm_set1_epi32(32768));
+    ints = _mm_packs_epi32(ints, ints);
+    ints = _mm_xor_si128(ints, _mm_set1_epi16(-32768));
+
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), ints);
+}
+
+template<>
+inline void StorePixel<BIT_DEPTH_F16>(__m128 values, half * out)
+{
+#ifdef __F16C__
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out),
+                     _mm_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+#else
+    OCIO_ALIGN(float pxl[4]);
+    _mm_store_ps(pxl, values);
+
+    out[0] = pxl[0];
+    out[1] = pxl[1];
+    out[2] = pxl[2];
+    out[3] = pxl[3];
+#endif
+}
+
+template<>
+inline void StorePixel<BIT_DEPTH_F32>(__m128 values, float * out)
+{
+    _mm_storeu_ps(out, values);
+}
+
+#endif // USE_SSE
+
 template<BitDepth inBD, BitDepth outBD>
 class BitDepthCast : public OpCPU
 {
@@ -32,16 +153,28 @@ public:
         const InType * in = reinterpret_cast<const InType*>(inImg);
         OutType * out = reinterpret_cast<OutType*>(outImg);
 
+#ifdef USE_SSE
+        const __m128 scale = _mm_set1_ps(m_scale);
+
+        for(long pxl=0; pxl<numPixels; ++pxl)
+        {
+            StorePixel<outBD>(_mm_mul_ps(LoadPixel<inBD>(in), scale), out);
+
+            in  += 4;
+            out += 4;
+        }
+#else
         for(long pxl=0; pxl<numPixels; ++pxl)
         {
-            out[0] = Converter<outBD>::CastValue(in[0] * m_scale);
-            out[1] = Converter<outBD>::CastValue(in[1] * m_scale);
-            out[2] = Converter<outBD>::CastValue(in[2] * m_scale);
-            out[3] = Converter<outBD>::CastValue(in[3] * m_scale);
+            out[0] = Converter<outBD>::CastValue(ClampCode<inBD>(in[0]) * m_scale);
+            out[1] = Converter<outBD>::CastValue(ClampCode<inBD>(in[1]) * m_scale);
+            out[2] = Converter<outBD>::CastValue(ClampCode<inBD>(in[2]) * m_scale);
+            out[3] = Converter<outBD>::CastValue(ClampCode<inBD>(in[3]) * m_scale);
 
             in  += 4;
             out += 4;
         }
+#endif
     }
 
 protected:
@@ -140,80 +273,96 @@ ConstOpCPURcPtr CreateLut1DHelper(ConstLut1DOpDataRcPtr & lut, BitDepth in, BitD
     return GetLut1DRenderer(tmp, in, out);
 }
 
-void CreateCPUEngine(const OpRcPtrVec & ops,
-                     BitDepth in,
-                     BitDepth out,
-                     // The bit-depth 'cast' or the first CPU Op.
-                     ConstOpCPURcPtr & inBitDepthOp,
-                     // The remaining CPU Ops.
-                     ConstOpCPURcPtrVec & cpuOps,
-                     // The bit-depth 'cast' or the last CPU Op.
-                     ConstOpCPURcPtr & outBitDepthOp)
+// Look-up of the whole color processing indexed by the integer codes of the input pixels
+// i.e. the table holds the processed RGBA values of all the input codes.  It's only valid
+// for a separable color processing (i.e. no channel crosstalk) and it's built by
+// processing all the codes so the results are always identical to the generic processing.
+template<BitDepth inBD, BitDepth outBD>
+class IntegerLookup : public OpCPU
 {
-    const size_t maxOps = ops.size();
-    for(size_t idx=0; idx<maxOps; ++idx)
+public:
+    typedef typename BitDepthInfo<inBD>::Type InType;
+    typedef typename BitDepthInfo<outBD>::Type OutType;
+
+    IntegerLookup() = delete;
+    IntegerLookup(const IntegerLookup &) = delete;
+
+    IntegerLookup(const ConstOpCPURcPtr & inBitDepthOp,
+                  const ConstOpCPURcPtrVec & cpuOps,
+                  const ConstOpCPURcPtr & outBitDepthOp)
+        :   OpCPU()
     {
-        ConstOpRcPtr op = ops[idx];
-        ConstOpDataRcPtr opData = op->data();
+        const long numCodes = long(BitDepthInfo<inBD>::maxValue) + 1;
 
-        if(idx==0)
+        std::vector<InType> codes(4 * numCodes);
+        for(long idx=0; idx<numCodes; ++idx)
         {
-            if(opData->getType()==OpData::Lut1DType)
-            {
-                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
-                inBitDepthOp = CreateLut1DHelper(lut, in, BIT_DEPTH_F32);
-            }
-            else if(in==BIT_DEPTH_F32)
-            {
-                inBitDepthOp = op->getCPUOp();
-            }
-            else
-            {
-                inBitDepthOp = CreateGenericBitDepthHelper(in, BIT_DEPTH_F32);
-                cpuOps.push_back(op->getCPUOp());
-            }
-
-            if(maxOps==1)
-            {
-                outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
-            }
+            codes[4 * idx + 0] = InType(idx);
+            codes[4 * idx + 1] = InType(idx);
+            codes[4 * idx + 2] = InType(idx);
+            codes[4 * idx + 3] = InType(idx);
         }
-        else if(idx==(maxOps-1))
+
+        std::vector<float> buffer(4 * numCodes);
+        inBitDepthOp->apply(&codes[0], &buffer[0], numCodes);
+        for(const auto & op : cpuOps)
         {
-            if(opData->getType()==OpData::Lut1DType)
-            {
-                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
-                outBitDepthOp = CreateLut1DHelper(lut, BIT_DEPTH_F32, out);
-            }
-            else if(out==BIT_DEPTH_F32)
-            {
-                outBitDepthOp = op->getCPUOp();
-            }
-            else
-            {
-                outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
-                cpuOps.push_back(op->getCPUOp());
-            }
+            op->apply(&buffer[0], &buffer[0], numCodes);
         }
-        else
+
+        m_table.resize(4 * numCodes);
+        outBitDepthOp->apply(&buffer[0], &m_table[0], numCodes);
+    }
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        const InType * in = (const InType *)inImg;
+        OutType * out = (OutType *)outImg;
+
+        const OutType * table = &m_table[0];
+
+        for(long idx=0; idx<numPixels; ++idx)
         {
-            cpuOps.push_back(op->getCPUOp());
+            // Read the whole pixel first to support the in-place processing.
+            const OutType r = table[4 * GetCode(in[0]) + 0];
+            const OutType g = table[4 * GetCode(in[1]) + 1];
+            const OutType b = table[4 * GetCode(in[2]) + 2];
+            const OutType a = table[4 * GetCode(in[3]) + 3];
+
+            out[0] = r;
+            out[1] = g;
+            out[2] = b;
+            out[3] = a;
+
+            in  += 4;
+            out += 4;
         }
     }
-}
 
+private:
+    // Out of range codes (e.g. above 1023 in a 10-bit image buffer) are clamped like
+    // the generic processing does.
+    static inline size_t GetCode(InType code)
+    {
+        return size_t(ClampCode<inBD>(code));
+    }
+
+    std::vector<OutType> m_table;
+};
 
-ScanlineHelper * CreateScanlineHelper(BitDepth in, const ConstOpCPURcPtr & inBitDepthOp,
-                                      BitDepth out, const ConstOpCPURcPtr & outBitDepthOp)
+ConstOpCPURcPtr CreateIntegerLookupHelper(BitDepth in, BitDepth out,
+                                          const ConstOpCPURcPtr & inBitDepthOp,
+                                          const ConstOpCPURcPtrVec & cpuOps,
+                                          const ConstOpCPURcPtr & outBitDepthOp)
 {
 
-#define ADD_OUT_BIT_DEPTH(in, out)                    \
-case out:                                             \
-{                                                     \
-    return new GenericScanlineHelper<BitDepthInfo<in>::Type,                      \
-                                     BitDepthInfo<out>::Type>(in, inBitDepthOp,   \
-                                                              out, outBitDepthOp);\
-    break;                                            \
+#define ADD_OUT_BIT_DEPTH(in, out)                                    \
+case out:                                                             \
+{                                                                     \
+    return std::make_shared<IntegerLookup<in, out>>(inBitDepthOp,     \
+                                                    cpuOps,           \
+                                                    outBitDepthOp);   \
+    break;                                                            \
 }
 
 #define ADD_IN_BIT_DEPTH(in)                          \
@@ -232,19 +381,21 @@ case in:                                              \
         case BIT_DEPTH_UNKNOWN:                       \
         default:                                      \
             throw Exception("Unsupported bit-depth"); \
+            break;                                    \
                                                       \
     }                                                 \
     break;                                            \
 }
 
+
     switch(in)
     {
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT8)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT10)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT12)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT16)
-        ADD_IN_BIT_DEPTH(BIT_DEPTH_F16)
-        ADD_IN_BIT_DEPTH(BIT_DEPTH_F32)
+        case BIT_DEPTH_F16:
+        case BIT_DEPTH_F32:
         case BIT_DEPTH_UINT14:
         case BIT_DEPTH_UINT32:
         case BIT_DEPTH_UNKNOWN:
@@ -258,1136 +409,2146 @@ case in:                                              \
     throw Exception("Unsupported bit-depths");
 }
 
-DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType type) const
+// Create the op directly processing the input pixels to the output pixels (i.e. without
+// the conversions to and from the F32 intermediate buffer), if any:
+//
+// 1. A 1D LUT alone processing F16 images is indexed by the raw half codes of the input
+//    pixels and directly outputs the F16 or F32 values.  That's the common case of the
+//    half-domain 1D LUTs (i.e. 65536 entries) from EXR-based pipelines.
+//
+// 2. A separable color processing of integer images is a look-up of the output values
+//    indexed by the integer codes of the input pixels (e.g. 10-bit DPX or 16-bit TIFF).
+//    Like the separable prefix optimization, it's only done when the OptimizationFlags
+//    allow it.
+ConstOpCPURcPtr CreateDirectOp(const OpRcPtrVec & ops,
+                               BitDepth in,
+                               BitDepth out,
+                               OptimizationFlags oFlags,
+                               const ConstOpCPURcPtr & inBitDepthOp,
+                               const ConstOpCPURcPtrVec & cpuOps,
+                               const ConstOpCPURcPtr & outBitDepthOp)
 {
-    if(m_inBitDepthOp->hasDynamicProperty(type))
+    if(ops.size()==1 && in==BIT_DEPTH_F16 && (out==BIT_DEPTH_F16 || out==BIT_DEPTH_F32))
     {
-        return m_inBitDepthOp->getDynamicProperty(type);
+        ConstOpRcPtr op = ops[0];
+        if(op->data()->getType()==OpData::Lut1DType)
+        {
+            ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(op->data());
+            if(lut->getHueAdjust()==HUE_NONE)
+            {
+                return CreateLut1DHelper(lut, in, out);
+            }
+        }
     }
 
-    for(const auto & op : m_cpuOps)
+    if((oFlags & OPTIMIZATION_COMP_SEPARABLE_PREFIX) == OPTIMIZATION_COMP_SEPARABLE_PREFIX
+        && (in==BIT_DEPTH_UINT8 || in==BIT_DEPTH_UINT10
+            || in==BIT_DEPTH_UINT12 || in==BIT_DEPTH_UINT16))
     {
-        if(op->hasDynamicProperty(type))
+        for(const auto & op : ops)
         {
-            return op->getDynamicProperty(type);
+            if(op->hasChannelCrosstalk() || op->isDynamic())
+            {
+                return ConstOpCPURcPtr();
+            }
         }
+
+        return CreateIntegerLookupHelper(in, out, inBitDepthOp, cpuOps, outBitDepthOp);
     }
 
-    if(m_outBitDepthOp->hasDynamicProperty(type))
+    return ConstOpCPURcPtr();
+}
+
+// Describe the op for the statistics i.e. the op type and its name (if any)
+// to identify the corresponding look, LUT file, etc.
+std::string GetStatisticName(ConstOpRcPtr & op)
+{
+    std::string desc = op->getInfo();
+
+    const std::string & name = op->data()->getName();
+    const std::string & id   = op->data()->getID();
+    if(!name.empty())
     {
-        return m_outBitDepthOp->getDynamicProperty(type);
+        desc += " " + name;
+    }
+    else if(!id.empty())
+    {
+        desc += " " + id;
     }
 
-    throw Exception("Cannot find dynamic property; not used by CPU processor.");
+    return desc;
 }
 
-void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
-                                  BitDepth in, BitDepth out,
-                                  OptimizationFlags oFlags, FinalizationFlags fFlags)
+// Get the CPU Op of ops[idx] and its statistic name.  A Range following a Matrix
+// is fused into the tail of the Matrix renderer (i.e. one pass over the pixels
+// instead of two) so idx then moves to the Range op.
+ConstOpCPURcPtr GetCPUOp(const OpRcPtrVec & ops, size_t & idx, std::string & name)
 {
-    AutoMutex lock(m_mutex);
+    ConstOpRcPtr op = ops[idx];
+    name = GetStatisticName(op);
 
-    OpRcPtrVec ops = rawOps.clone();
+    ConstOpRcPtr next = (idx+1<ops.size()) ? ops[idx+1] : ConstOpRcPtr();
 
-    if(!ops.empty())
+    if(next
+        && op->data()->getType()==OpData::MatrixType
+        && next->data()->getType()==OpData::RangeType)
     {
-        // Optimize the ops.
+        ++idx;
+        name += " + " + GetStatisticName(next);
 
-        OptimizeOpVec(ops, in, out, oFlags);
+        ConstMatrixOpDataRcPtr mat = DynamicPtrCast<const MatrixOpData>(op->data());
+        ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(next->data());
+        return GetMatrixWithRangeRenderer(mat, range);
     }
 
-    if(ops.empty())
+    return op->getCPUOp();
+}
+
+void CreateCPUEngine(const OpRcPtrVec & ops,
+                     BitDepth in,
+                     BitDepth out,
+                     // The bit-depth 'cast' or the first CPU Op.
+                     ConstOpCPURcPtr & inBitDepthOp,
+                     // The remaining CPU Ops.
+                     ConstOpCPURcPtrVec & cpuOps,
+                     // The bit-depth 'cast' or the last CPU Op.
+                     ConstOpCPURcPtr & outBitDepthOp,
+                     // The unpacking step, the CPU Ops and the packing step.
+                     CPUProcessorStatistics & statistics)
+{
+    statistics.clear();
+
+    CPUProcessorStatistic inStep;
+    inStep.m_name = std::string("Unpack ") + BitDepthToString(in);
+    CPUProcessorStatistic outStep;
+    outStep.m_name = std::string("Pack ") + BitDepthToString(out);
+
+    const size_t maxOps = ops.size();
+    for(size_t idx=0; idx<maxOps; ++idx)
     {
-        // Support an empty list.
+        ConstOpRcPtr op = ops[idx];
+        ConstOpDataRcPtr opData = op->data();
 
-        const double scale = GetBitDepthMaxValue(out) / GetBitDepthMaxValue(in);
+        std::string name;
 
-        if(scale==1.0f)
+        if(idx==0)
         {
-            // Needs at least one op (even an identity one) as the input
-            // and output buffers could be different.
-            CreateIdentityMatrixOp(ops);
+            if(opData->getType()==OpData::Lut1DType)
+            {
+                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
+                inBitDepthOp = CreateLut1DHelper(lut, in, BIT_DEPTH_F32);
+                inStep.m_name += ", " + GetStatisticName(op);
+            }
+            else if(in==BIT_DEPTH_F32)
+            {
+                inBitDepthOp = GetCPUOp(ops, idx, name);
+                inStep.m_name += ", " + name;
+            }
+            else
+            {
+                inBitDepthOp = CreateGenericBitDepthHelper(in, BIT_DEPTH_F32);
+                cpuOps.push_back(GetCPUOp(ops, idx, name));
+                statistics.resize(cpuOps.size());
+                statistics.back().m_name = name;
+            }
+
+            // Note: The first op could have been fused with the last one.
+            if(idx==(maxOps-1))
+            {
+                outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
+            }
+        }
+        else if(idx==(maxOps-1))
+        {
+            if(opData->getType()==OpData::Lut1DType)
+            {
+                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
+                outBitDepthOp = CreateLut1DHelper(lut, BIT_DEPTH_F32, out);
+                outStep.m_name += ", " + GetStatisticName(op);
+            }
+            else if(out==BIT_DEPTH_F32)
+            {
+                outBitDepthOp = op->getCPUOp();
+                outStep.m_name += ", " + GetStatisticName(op);
+            }
+            else
+            {
+                outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
+                cpuOps.push_back(op->getCPUOp());
+                statistics.resize(cpuOps.size());
+                statistics.back().m_name = GetStatisticName(op);
+            }
         }
         else
         {
-            // Note: CreateScaleOp will not add an op if scale == 1.
-            const double scale4[4] = {scale, scale, scale, scale};
-            CreateScaleOp(ops, scale4, TRANSFORM_DIR_FORWARD);
+            ConstOpCPURcPtr cpuOp = GetCPUOp(ops, idx, name);
+
+            // The op could have been fused with the last one.
+            if(idx==(maxOps-1) && out==BIT_DEPTH_F32)
+            {
+                outBitDepthOp = cpuOp;
+                outStep.m_name += ", " + name;
+            }
+            else
+            {
+                cpuOps.push_back(cpuOp);
+                statistics.resize(cpuOps.size());
+                statistics.back().m_name = name;
+
+                if(idx==(maxOps-1))
+                {
+                    outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
+                }
+            }
         }
     }
 
-    // Finalize the ops.
+    statistics.insert(statistics.begin(), inStep);
+    statistics.push_back(outStep);
+}
 
-    FinalizeOpVec(ops, fFlags);
-    UnifyDynamicProperties(ops);
+// Number of bytes of one pixel in the image buffer.
+size_t GetPixelSizeInBytes(const ImageDesc & img)
+{
+    if(const BitPackedImageDesc * bitPackedImg = dynamic_cast<const BitPackedImageDesc*>(&img))
+    {
+        // Note: A 12-bit pixel is rounded up to a whole number of bytes.
+        const size_t numBits = img.getBitDepth()==BIT_DEPTH_UINT12
+            ? 12 * bitPackedImg->getNumChannels() : 32;
+        return (numBits + 7) / 8;
+    }
 
-    m_inBitDepth  = in;
-    m_outBitDepth = out;
+    size_t channelSize = 0;
+    switch(img.getBitDepth())
+    {
+        case BIT_DEPTH_UINT8:
+            channelSize = sizeof(BitDepthInfo<BIT_DEPTH_UINT8>::Type);
+            break;
+        case BIT_DEPTH_UINT10:
+            channelSize = sizeof(BitDepthInfo<BIT_DEPTH_UINT10>::Type);
+            break;
+        case BIT_DEPTH_UINT12:
+            channelSize = sizeof(BitDepthInfo<BIT_DEPTH_UINT12>::Type);
+            break;
+        case BIT_DEPTH_UINT16:
+            channelSize = sizeof(BitDepthInfo<BIT_DEPTH_UINT16>::Type);
+            break;
+        case BIT_DEPTH_F16:
+            channelSize = sizeof(BitDepthInfo<BIT_DEPTH_F16>::Type);
+            break;
+        case BIT_DEPTH_F32:
+            channelSize = sizeof(BitDepthInfo<BIT_DEPTH_F32>::Type);
+            break;
+        case BIT_DEPTH_UINT14:
+        case BIT_DEPTH_UINT32:
+        case BIT_DEPTH_UNKNOWN:
+        default:
+            throw Exception("Unsupported bit-depth");
+    }
 
-    // Does the color processing introduce crosstalk between the pixel channels?
+    return (img.getAData() ? 4 : 3) * channelSize;
+}
 
-    m_hasChannelCrosstalk = false;
-    for(const auto & op : ops)
+// Escape the string to be a JSON string value.
+std::string EscapeJSON(const std::string & str)
+{
+    std::ostringstream oss;
+    for(const char c : str)
     {
-        if(op->hasChannelCrosstalk())
+        switch(c)
         {
-            m_hasChannelCrosstalk = true;
-            break;
+            case '"':  oss << "\\\""; break;
+            case '\\': oss << "\\\\"; break;
+            case '\n': oss << "\\n"; break;
+            case '\t': oss << "\\t"; break;
+            default:
+                if((unsigned char)c < 0x20)
+                {
+                    oss << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+                        << (int)(unsigned char)c << std::dec;
+                }
+                else
+                {
+                    oss << c;
+                }
+                break;
         }
     }
+    return oss.str();
+}
 
-    // Get the CPU Ops while taking care of the input and output bit-depths.
-
-    m_cpuOps.clear();
-    m_inBitDepthOp = nullptr;
-    m_outBitDepthOp = nullptr;
-    CreateCPUEngine(ops, in, out, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
+// Process the runs of identical consecutive pixels of the line only once. Returns false
+// (i.e. nothing is processed) when the runs are too short to be worth it. The buffers
+// holding one pixel per run are provided by the caller to be reused between lines.
+bool ApplyOnRuns(const ConstOpCPURcPtrVec & cpuOps, float * rgbaBuffer, long numPixels,
+                 std::vector<float> & runPixels, std::vector<long> & runLengths)
+{
+    static constexpr size_t pixelBytes = 4 * sizeof(float);
 
-    // Compute the cache id.
+    runLengths.clear();
 
-    std::stringstream ss;
-    ss << "CPU Processor: from " << BitDepthToString(in)
-       << " to "  << BitDepthToString(out)
-       << " oFlags " << oFlags
-       << " fFlags " << fFlags
-       << " ops :";
-    for(const auto & op : ops)
+    // Note: Comparing the bits also makes the NaNs of a run identical.
+    long runStart = 0;
+    for(long idx=1; idx<numPixels; ++idx)
     {
-        ss << " " << op->getCacheID();
+        if(memcmp(&rgbaBuffer[4 * idx], &rgbaBuffer[4 * (idx - 1)], pixelBytes)!=0)
+        {
+            runLengths.push_back(idx - runStart);
+            runStart = idx;
+
+            if((long)runLengths.size() > numPixels / 2)
+            {
+                return false;
+            }
+        }
     }
+    runLengths.push_back(numPixels - runStart);
 
-    m_cacheID = ss.str();
-}
+    const long numRuns = (long)runLengths.size();
 
-void CPUProcessor::Impl::apply(ImageDesc & imgDesc) const
-{   
-    // Get the ScanlineHelper for this thread (no significant performance impact).
-    std::unique_ptr<ScanlineHelper> 
-        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                             m_outBitDepth, m_outBitDepthOp));
+    // Process the first pixel of each run.
 
-    // Prepare the processing.
-    scanlineBuilder->init(imgDesc);
+    runPixels.resize(4 * numRuns);
 
-    float * rgbaBuffer = nullptr;
-    long numPixels = 0;
+    const float * in = rgbaBuffer;
+    for(long run=0; run<numRuns; ++run)
+    {
+        memcpy(&runPixels[4 * run], in, pixelBytes);
+        in += 4 * runLengths[run];
+    }
 
-    while(true)
+    for(const auto & op : cpuOps)
     {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
-        if(numPixels == 0) break;
+        op->apply(&runPixels[0], &runPixels[0], numRuns);
+    }
 
-        const size_t numOps = m_cpuOps.size();
-        for(size_t i = 0; i<numOps; ++i)
+    // Copy the processed pixel to the whole run.
+
+    float * out = rgbaBuffer;
+    for(long run=0; run<numRuns; ++run)
+    {
+        const float * pixel = &runPixels[4 * run];
+        for(long idx=0; idx<runLengths[run]; ++idx)
         {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            memcpy(out, pixel, pixelBytes);
+            out += 4;
         }
-
-        scanlineBuilder->finishRGBAScanline();
     }
+
+    return true;
 }
 
-void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
+// Direct-mapped cache of the processed colors keyed by the exact bits of the RGBA 32-bit
+// float input values. As an instance only lives during one apply call, no locking is needed.
+class ColorCache
 {
-    // Get the ScanlineHelper for this thread (no significant performance impact).
-    std::unique_ptr<ScanlineHelper> 
-        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                             m_outBitDepth, m_outBitDepthOp));
+public:
+    ColorCache() = delete;
+    ColorCache(const ColorCache &) = delete;
+    ColorCache & operator=(const ColorCache &) = delete;
 
-    // Prepare the processing.
-    scanlineBuilder->init(srcImgDesc, dstImgDesc);
+    explicit ColorCache(const ConstOpCPURcPtrVec & cpuOps)
+        :   m_cpuOps(cpuOps)
+    {
+    }
 
-    float * rgbaBuffer = nullptr;
-    long numPixels = 0;
+    // Process the line while only processing the colors missing from the cache.
+    void apply(float * rgbaBuffer, long numPixels);
 
-    while(true)
-    {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
-        if(numPixels == 0) break;
+    long long getNumLookups() const noexcept { return m_numLookups; }
+    long long getNumHits() const noexcept { return m_numHits; }
 
-        const size_t numOps = m_cpuOps.size();
-        for(size_t i = 0; i<numOps; ++i)
-        {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
-        }
+private:
+    static constexpr uint32_t NumEntries = 4096; // Must be a power of two.
+    static constexpr size_t PixelBytes = 4 * sizeof(float);
 
-        scanlineBuilder->finishRGBAScanline();
+    static uint32_t GetIndex(const uint32_t * key)
+    {
+        uint32_t h = key[0] * 0x9E3779B1u;
+        h ^= key[1] * 0x85EBCA77u;
+        h ^= key[2] * 0xC2B2AE3Du;
+        h ^= key[3] * 0x27D4EB2Fu;
+        return (h ^ (h >> 15)) & (NumEntries - 1);
     }
-}
 
-void CPUProcessor::Impl::applyRGB(float * pixel) const
-{
-    float v[4]{pixel[0], pixel[1], pixel[2], 0.0f};
+    const ConstOpCPURcPtrVec & m_cpuOps;
 
-    m_inBitDepthOp->apply(v, v, 1);
+    std::vector<uint32_t> m_keys;    // The input bits.
+    std::vector<float>    m_values;  // The processed colors.
+    std::vector<uint8_t>  m_valid;
 
-    const size_t numOps = m_cpuOps.size();
-    for(size_t i = 0; i<numOps; ++i)
-    {
-        m_cpuOps[i]->apply(pixel, pixel, 1);
-    }
+    // The colors to process for the current line and their pixel indices.
+    std::vector<float> m_missPixels;
+    std::vector<long>  m_missIndices;
 
-    m_outBitDepthOp->apply(v, v, 1);
+    long long m_numLookups = 0;
+    long long m_numHits    = 0;
 
-    pixel[0] = v[0];
-    pixel[1] = v[1];
-    pixel[2] = v[2];
-}
+    // The cache is bypassed when the hit rate is too low.
+    bool m_bypass = false;
+};
 
-void CPUProcessor::Impl::applyRGBA(float * pixel) const
+void ColorCache::apply(float * rgbaBuffer, long numPixels)
 {
-    m_inBitDepthOp->apply(pixel, pixel, 1);
+    if(m_bypass)
+    {
+        for(const auto & op : m_cpuOps)
+        {
+            op->apply(rgbaBuffer, rgbaBuffer, numPixels);
+        }
+        return;
+    }
 
-    const size_t numOps = m_cpuOps.size();
-    for(size_t i = 0; i<numOps; ++i)
+    if(m_keys.empty())
     {
-        m_cpuOps[i]->apply(pixel, pixel, 1);
+        m_keys.resize(4 * NumEntries);
+        m_values.resize(4 * NumEntries);
+        m_valid.resize(NumEntries, 0);
     }
 
-    m_outBitDepthOp->apply(pixel, pixel, 1);
-}
+    m_missPixels.clear();
+    m_missIndices.clear();
 
+    float * pixel = rgbaBuffer;
+    for(long idx=0; idx<numPixels; ++idx, pixel+=4)
+    {
+        uint32_t key[4];
+        memcpy(key, pixel, PixelBytes);
 
+        const uint32_t entry = GetIndex(key);
+        if(m_valid[entry] && memcmp(&m_keys[4 * entry], key, PixelBytes)==0)
+        {
+            memcpy(pixel, &m_values[4 * entry], PixelBytes);
+            ++m_numHits;
+        }
+        else
+        {
+            m_missPixels.insert(m_missPixels.end(), pixel, pixel + 4);
+            m_missIndices.push_back(idx);
+        }
+    }
+    m_numLookups += numPixels;
 
+    const long numMisses = (long)m_missIndices.size();
+    if(numMisses>0)
+    {
+        // Process all the missing colors at once.
+        for(const auto & op : m_cpuOps)
+        {
+            op->apply(&m_missPixels[0], &m_missPixels[0], numMisses);
+        }
 
-//////////////////////////////////////////////////////////////////////////
+        for(long miss=0; miss<numMisses; ++miss)
+        {
+            float * out = rgbaBuffer + 4 * m_missIndices[miss];
 
+            // The pixel still holds the input color.
+            uint32_t key[4];
+            memcpy(key, out, PixelBytes);
 
+            const uint32_t entry = GetIndex(key);
+            memcpy(&m_keys[4 * entry], key, PixelBytes);
+            memcpy(&m_values[4 * entry], &m_missPixels[4 * miss], PixelBytes);
+            m_valid[entry] = 1;
 
+            memcpy(out, &m_missPixels[4 * miss], PixelBytes);
+        }
+    }
 
-void CPUProcessor::deleter(CPUProcessor * c)
-{
-    delete c;
+    // Stop using the cache when less than a quarter of the lookups are hits.
+    if(m_numLookups >= (long long)NumEntries && 4 * m_numHits < m_numLookups)
+    {
+        m_bypass = true;
+    }
 }
 
-CPUProcessor::CPUProcessor()
-    :   m_impl(new Impl)
-{
-}
 
-CPUProcessor::~CPUProcessor()
+ScanlineHelper * CreateScanlineHelper(BitDepth in, const ConstOpCPURcPtr & inBitDepthOp,
+                                      BitDepth out, const ConstOpCPURcPtr & outBitDepthOp,
+                                      AlphaMode alphaMode, bool modifiesAlpha)
 {
-    delete m_impl;
-    m_impl = nullptr;
-}
 
-bool CPUProcessor::hasChannelCrosstalk() const
-{
-    return getImpl()->hasChannelCrosstalk();
+#define ADD_OUT_BIT_DEPTH(in, out)                    \
+case out:                                             \
+{                                                     \
+    return new GenericScanlineHelper<BitDepthInfo<in>::Type,                      \
+                                     BitDepthInfo<out>::Type>(in, inBitDepthOp,   \
+                                                              out, outBitDepthOp, \
+                                                              alphaMode,          \
+                                                              modifiesAlpha);     \
+    break;                                            \
 }
 
-const char * CPUProcessor::getCacheID() const
-{
-    return getImpl()->getCacheID();
+#define ADD_IN_BIT_DEPTH(in)                          \
+case in:                                              \
+{                                                     \
+    switch(out)                                       \
+    {                                                 \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT8)        \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT10)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT12)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT16)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F16)          \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F32)          \
+        case BIT_DEPTH_UINT14:                        \
+        case BIT_DEPTH_UINT32:                        \
+        case BIT_DEPTH_UNKNOWN:                       \
+        default:                                      \
+            throw Exception("Unsupported bit-depth"); \
+                                                      \
+    }                                                 \
+    break;                                            \
 }
 
-BitDepth CPUProcessor::getInputBitDepth() const
-{
-    return getImpl()->getInputBitDepth();
-}
+    switch(in)
+    {
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT8)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT10)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT12)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT16)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_F16)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_F32)
+        case BIT_DEPTH_UINT14:
+        case BIT_DEPTH_UINT32:
+        case BIT_DEPTH_UNKNOWN:
+        default:
+            throw Exception("Unsupported bit-depth");
+    }
 
-BitDepth CPUProcessor::getOutputBitDepth() const
-{
-    return getImpl()->getOutputBitDepth();
-}
+#undef ADD_OUT_BIT_DEPTH
+#undef ADD_IN_BIT_DEPTH
 
-DynamicPropertyRcPtr CPUProcessor::getDynamicProperty(DynamicPropertyType type) const
-{
-    return getImpl()->getDynamicProperty(type);
+    throw Exception("Unsupported bit-depths");
 }
 
-void CPUProcessor::apply(ImageDesc & imgDesc) const
+DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType type) const
 {
-    getImpl()->apply(imgDesc);
-}
+    if(m_inBitDepthOp->hasDynamicProperty(type))
+    {
+        return m_inBitDepthOp->getDynamicProperty(type);
+    }
 
-void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
-{
-    getImpl()->apply(srcImgDesc, dstImgDesc);
-}
+    for(const auto & op : m_cpuOps)
+    {
+        if(op->hasDynamicProperty(type))
+        {
+            return op->getDynamicProperty(type);
+        }
+    }
 
-void CPUProcessor::applyRGB(float * pixel) const
-{
-    getImpl()->applyRGB(pixel);
+    if(m_outBitDepthOp->hasDynamicProperty(type))
+    {
+        return m_outBitDepthOp->getDynamicProperty(type);
+    }
+
+    throw Exception("Cannot find dynamic property; not used by CPU processor.");
 }
 
-void CPUProcessor::applyRGBA(float * pixel) const
+void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
+                                  BitDepth in, BitDepth out,
+                                  OptimizationFlags oFlags, FinalizationFlags fFlags)
 {
-    getImpl()->applyRGBA(pixel);
-}
+    AutoMutex lock(m_mutex);
 
-}
-OCIO_NAMESPACE_EXIT
+    OpRcPtrVec ops = rawOps.clone();
 
+    if(!ops.empty())
+    {
+        // Optimize the ops.
 
+        OptimizeOpVec(ops, in, out, oFlags);
+    }
 
-///////////////////////////////////////////////////////////////////////////////
+    if(ops.empty())
+    {
+        // Support an empty list.
 
+        const double scale = GetBitDepthMaxValue(out) / GetBitDepthMaxValue(in);
 
+        if(scale==1.0f)
+        {
+            // Needs at least one op (even an identity one) as the input
+            // and output buffers could be different.
+            CreateIdentityMatrixOp(ops);
+        }
+        else
+        {
+            // Note: CreateScaleOp will not add an op if scale == 1.
+            const double scale4[4] = {scale, scale, scale, scale};
+            CreateScaleOp(ops, scale4, TRANSFORM_DIR_FORWARD);
+        }
+    }
 
-#ifdef OCIO_UNIT_TEST
+    // Finalize the ops.
 
-namespace OCIO = OCIO_NAMESPACE;
+    FinalizeOpVec(ops, fFlags);
+    UnifyDynamicProperties(ops);
 
-#include "ops/Lut1D/Lut1DOp.h"
-#include "ops/Lut1D/Lut1DOpData.h"
-#include "ScanlineHelper.h"
-#include "UnitTest.h"
-#include "UnitTestUtils.h"
+    m_inBitDepth  = in;
+    m_outBitDepth = out;
 
+    m_statisticsEnabled = (fFlags & FINALIZATION_STATISTICS) == FINALIZATION_STATISTICS;
+    m_runDetectionEnabled
+        = (fFlags & FINALIZATION_RUN_DETECTION) == FINALIZATION_RUN_DETECTION;
+    m_colorCacheEnabled = (fFlags & FINALIZATION_COLOR_CACHE) == FINALIZATION_COLOR_CACHE;
 
-OCIO_ADD_TEST(CPUProcessor, flag_composition)
-{
-    // The test validates the build of a custom optimization flag.
+    // Does the color processing introduce crosstalk between the pixel channels, and
+    // does it change the alpha channel?
 
-    OCIO::OptimizationFlags customFlags = OCIO::OPTIMIZATION_LOSSLESS;
+    m_hasChannelCrosstalk = false;
+    m_modifiesAlpha = false;
+    for(const auto & op : ops)
+    {
+        m_hasChannelCrosstalk = m_hasChannelCrosstalk || op->hasChannelCrosstalk();
+        m_modifiesAlpha       = m_modifiesAlpha || op->modifiesAlpha();
+    }
 
-    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
-                     OCIO::OPTIMIZATION_NONE);
+    // Get the CPU Ops while taking care of the input and output bit-depths.
 
-    customFlags
-        = OCIO::OptimizationFlags(customFlags | OCIO::OPTIMIZATION_COMP_LUT1D);
+    m_cpuOps.clear();
+    m_inBitDepthOp = nullptr;
+    m_outBitDepthOp = nullptr;
+    {
+        AutoMutex statisticsLock(m_statisticsMutex);
+        CreateCPUEngine(ops, in, out, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp, m_statistics);
+    }
 
-    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
-                     OCIO::OPTIMIZATION_COMP_LUT1D);
+    m_directOp = CreateDirectOp(ops, in, out, oFlags, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
+
+    {
+        AutoMutex genericLock(m_genericMutex);
+        m_ops = ops;
+        m_genericInBitDepthOp = nullptr;
+        m_genericCpuOps.clear();
+        m_genericOutBitDepthOp = nullptr;
+    }
+
+    // Compute the cache id.
+
+    std::stringstream ss;
+    ss << "CPU Processor: from " << BitDepthToString(in)
+       << " to "  << BitDepthToString(out)
+       << " oFlags " << oFlags
+       << " fFlags " << fFlags
+       << " ops :";
+    for(const auto & op : ops)
+    {
+        ss << " " << op->getCacheID();
+    }
+
+    m_cacheID = ss.str();
 }
 
+void CPUProcessor::Impl::apply(ImageDesc & imgDesc, AlphaMode alphaMode) const
+{   
+    if(alphaMode==ALPHA_PREMULTIPLIED)
+    {
+        applyGeneric(imgDesc, imgDesc, true, alphaMode);
+        return;
+    }
 
-// TODO: CPUProcessor being part of the OCIO public API limits the ability
-//       to inspect the CPUProcessor instance content i.e. the list of CPUOps.
-//       Even a successful apply could hide a major performance hit because of
-//       a missing/partial optimization.
+    if(applyDirect(imgDesc, imgDesc))
+    {
+        return;
+    }
 
+    // Note: The runs & the cache keys are the input colors so all the ops are needed
+    //       as CPU ops.
+    if((m_runDetectionEnabled || m_colorCacheEnabled) && !m_statisticsEnabled)
+    {
+        applyGeneric(imgDesc, imgDesc, true, alphaMode);
+        return;
+    }
 
-template<OCIO::BitDepth inBD, OCIO::BitDepth outBD, unsigned line>
-OCIO::ConstCPUProcessorRcPtr ComputeValues(OCIO::ConstProcessorRcPtr processor,
-                                           const void * inImg,
-                                           OCIO::ChannelOrdering inChans,
-                                           const void * resImg,
-                                           OCIO::ChannelOrdering outChans,
-                                           long numPixels,
-                                           // Default value to nan to break any float comparisons
-                                           // as a valid error threshold is mandatory in that case.
-                                           float absErrorThreshold
-                                                = std::numeric_limits<float>::quiet_NaN())
+    // Get the ScanlineHelper for this thread (no significant performance impact).
+    std::unique_ptr<ScanlineHelper> 
+        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
+                                             m_outBitDepth, m_outBitDepthOp,
+                                             ALPHA_STRAIGHT, m_modifiesAlpha));
+
+    // Prepare the processing.
+    scanlineBuilder->init(imgDesc);
+
+    if(m_statisticsEnabled)
+    {
+        const size_t pixelBytes = GetPixelSizeInBytes(imgDesc);
+        applyWithStatistics(*scanlineBuilder, pixelBytes, pixelBytes);
+        return;
+    }
+
+    applyScanlines(*scanlineBuilder, m_cpuOps);
+}
+
+void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                               AlphaMode alphaMode) const
 {
-    typedef typename OCIO::BitDepthInfo<inBD>::Type inType;
-    typedef typename OCIO::BitDepthInfo<outBD>::Type outType;
+    if(alphaMode==ALPHA_PREMULTIPLIED)
+    {
+        applyGeneric(srcImgDesc, dstImgDesc, false, alphaMode);
+        return;
+    }
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    if(applyDirect(srcImgDesc, dstImgDesc))
+    {
+        return;
+    }
 
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor
-        = processor->getOptimizedCPUProcessor(inBD, outBD,
-                                              OCIO::OPTIMIZATION_DEFAULT,
-                                              OCIO::FINALIZATION_DEFAULT), line);
+    if((m_runDetectionEnabled || m_colorCacheEnabled) && !m_statisticsEnabled)
+    {
+        applyGeneric(srcImgDesc, dstImgDesc, false, alphaMode);
+        return;
+    }
 
-    size_t numChannels = 4;
-    if(outChans==OCIO::CHANNEL_ORDERING_RGB || outChans==OCIO::CHANNEL_ORDERING_BGR)
+    // Get the ScanlineHelper for this thread (no significant performance impact).
+    std::unique_ptr<ScanlineHelper> 
+        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
+                                             m_outBitDepth, m_outBitDepthOp,
+                                             ALPHA_STRAIGHT, m_modifiesAlpha));
+
+    // Prepare the processing.
+    scanlineBuilder->init(srcImgDesc, dstImgDesc);
+
+    if(m_statisticsEnabled)
     {
-        numChannels = 3;
+        applyWithStatistics(*scanlineBuilder,
+                            GetPixelSizeInBytes(srcImgDesc),
+                            GetPixelSizeInBytes(dstImgDesc));
+        return;
     }
-    const size_t numValues = size_t(numPixels * numChannels);
 
-    const OCIO::PackedImageDesc srcImgDesc((void *)inImg, numPixels, 1,
-                                           inChans,
-                                           inBD,
-                                           sizeof(inType),
-                                           OCIO::AutoStride,
-                                           OCIO::AutoStride);
+    applyScanlines(*scanlineBuilder, m_cpuOps);
+}
 
-    std::vector<outType> out(numValues);
-    OCIO::PackedImageDesc dstImgDesc(&out[0], numPixels, 1,
-                                     outChans,
-                                     outBD,
-                                     sizeof(outType),
-                                     OCIO::AutoStride,
-                                     OCIO::AutoStride);
+void CPUProcessor::Impl::applyScanlines(ScanlineHelper & scanlineBuilder,
+                                        const ConstOpCPURcPtrVec & cpuOps) const
+{
+    float * rgbaBuffer = nullptr;
+    long numPixels = 0;
 
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), line);
+    const bool detectRuns = m_runDetectionEnabled && !m_statisticsEnabled && !cpuOps.empty();
+    std::vector<float> runPixels;
+    std::vector<long> runLengths;
+    long long numRunLines = 0;
 
-    const outType * res = reinterpret_cast<const outType*>(resImg);
+    std::unique_ptr<ColorCache> colorCache;
+    if(m_colorCacheEnabled && !m_statisticsEnabled && !cpuOps.empty())
+    {
+        colorCache.reset(new ColorCache(cpuOps));
+    }
 
-    for(size_t idx=0; idx<numValues; ++idx)
+    while(true)
     {
-        if(OCIO::BitDepthInfo<outBD>::isFloat)
+        scanlineBuilder.prepRGBAScanline(&rgbaBuffer, numPixels);
+        if(numPixels == 0) break;
+
+        if(detectRuns && ApplyOnRuns(cpuOps, rgbaBuffer, numPixels, runPixels, runLengths))
         {
-            OCIO_CHECK_CLOSE_FROM(out[idx], res[idx], absErrorThreshold, line);
+            // The line was processed one color per run.
+            ++numRunLines;
+        }
+        else if(colorCache)
+        {
+            colorCache->apply(rgbaBuffer, numPixels);
         }
         else
         {
-            OCIO_CHECK_EQUAL_FROM(out[idx], res[idx], line);
+            const size_t numOps = cpuOps.size();
+            for(size_t i = 0; i<numOps; ++i)
+            {
+                cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            }
         }
+
+        scanlineBuilder.finishRGBAScanline();
     }
 
-    return cpuProcessor;
+    m_runDetectionNumLines += numRunLines;
+
+    if(colorCache)
+    {
+        m_colorCacheNumLookups += colorCache->getNumLookups();
+        m_colorCacheNumHits    += colorCache->getNumHits();
+    }
 }
 
-OCIO_ADD_TEST(CPUProcessor, with_one_matrix)
+void CPUProcessor::Impl::getGenericEngine(ConstOpCPURcPtr & inBitDepthOp,
+                                          ConstOpCPURcPtrVec & cpuOps,
+                                          ConstOpCPURcPtr & outBitDepthOp) const
 {
-    // The unit test validates that pixel formats are correctly
-    // processed when the op list contains only one arbitrary Op
-    // (except a 1D LUT one which has dedicated optimizations).
+    AutoMutex lock(m_genericMutex);
 
-    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    if(!m_genericInBitDepthOp)
+    {
+        // As the ops are finalized for 32-bit float values, the first and last ops
+        // of a F32 to F32 processing are CPU ops.
 
-    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
-    constexpr const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5f };
-    transform->setOffset( offset4 );
+        ConstOpCPURcPtr firstOp;
+        ConstOpCPURcPtr lastOp;
+        CPUProcessorStatistics statistics;
+        CreateCPUEngine(m_ops, BIT_DEPTH_F32, BIT_DEPTH_F32,
+                        firstOp, m_genericCpuOps, lastOp, statistics);
 
-    OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+        m_genericCpuOps.insert(m_genericCpuOps.begin(), firstOp);
+        m_genericCpuOps.push_back(lastOp);
 
-    constexpr const unsigned NB_PIXELS = 3;
+        m_genericInBitDepthOp  = CreateGenericBitDepthHelper(m_inBitDepth, BIT_DEPTH_F32);
+        m_genericOutBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, m_outBitDepth);
+    }
 
-    const std::vector<float> f_inImg =
-        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-            0.1023f,  0.5045f,  1.5089f,  1.0f,
-            1.0000f,  1.2500f,  1.9900f,  0.0f  };
+    inBitDepthOp  = m_genericInBitDepthOp;
+    cpuOps        = m_genericCpuOps;
+    outBitDepthOp = m_genericOutBitDepthOp;
+}
 
-    {
-        const std::vector<float> resImg
-            = { 0.4002f, -0.3995f,  0.7007f,  0.5000f,
-                1.5025f,  0.9050f,  2.3096f,  1.5000f,
-                2.4002f,  1.6505f,  2.7907f,  0.5000f };
+void CPUProcessor::Impl::applyGeneric(const ImageDesc & srcImgDesc,
+                                      ImageDesc & dstImgDesc,
+                                      bool inPlace,
+                                      AlphaMode alphaMode) const
+{
+    ConstOpCPURcPtr    inBitDepthOp;
+    ConstOpCPURcPtrVec cpuOps;
+    ConstOpCPURcPtr    outBitDepthOp;
+    getGenericEngine(inBitDepthOp, cpuOps, outBitDepthOp);
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
-    }
+    std::unique_ptr<ScanlineHelper> 
+        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, inBitDepthOp,
+                                             m_outBitDepth, outBitDepthOp,
+                                             alphaMode, m_modifiesAlpha));
 
+    if(inPlace)
     {
-        const std::vector<float> resImg
-            = { -0.1993f, -0.3995f,  1.3002f,  0.5000f,
-                 0.9030f,  0.9050f,  2.9091f,  1.5000f,
-                 1.8007f,  1.6505f,  3.3902f,  0.5000f };
+        scanlineBuilder->init(dstImgDesc);
+    }
+    else
+    {
+        scanlineBuilder->init(srcImgDesc, dstImgDesc);
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    applyScanlines(*scanlineBuilder, cpuOps);
+}
+
+bool CPUProcessor::Impl::applyDirect(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
+{
+    // Note: The statistics describe the generic processing steps.
+    if(!m_directOp || m_statisticsEnabled)
+    {
+        return false;
     }
 
+    GenericImageDesc srcImg;
+    srcImg.init(srcImgDesc, m_inBitDepth, m_directOp);
+    GenericImageDesc dstImg;
+    dstImg.init(dstImgDesc, m_outBitDepth, m_directOp);
+
+    if(!srcImg.isRGBAPacked() || !dstImg.isRGBAPacked())
     {
-        const std::vector<float> resImg
-            = {  -0.500000f,  0.000700f, 0.300500f, 1.400200f,
-                  0.602300f,  1.305199f, 1.909399f, 2.400200f,
-                  1.500000f,  2.050699f, 2.390500f, 1.400200f  };
+        return false;
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_ABGR,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    if(srcImg.m_width!=dstImg.m_width || srcImg.m_height!=dstImg.m_height)
+    {
+        throw Exception("Dimension inconsistency between source and destination image buffers.");
     }
 
+    for(long y=0; y<dstImg.m_height; ++y)
     {
-        const std::vector<float> resImg
-            = { 0.7007f, -0.3995f,  0.4002f,  0.5000f,
-                2.3096f,  0.9050f,  1.5025f,  1.5000f,
-                2.7907f,  1.6505f,  2.4002f,  0.5000f };
+        const void * in = (void*)(srcImg.m_rData + srcImg.m_yStrideBytes * y);
+        void * out      = (void*)(dstImg.m_rData + dstImg.m_yStrideBytes * y);
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+        m_directOp->apply(in, out, dstImg.m_width);
     }
 
+    return true;
+}
+
+void CPUProcessor::Impl::applyWithStatistics(ScanlineHelper & scanlineBuilder,
+                                             size_t inPixelBytes,
+                                             size_t outPixelBytes) const
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    const size_t numOps = m_cpuOps.size();
+
+    // Accumulate locally to only lock once per call.
+    CPUProcessorStatistics stats(numOps + 2);
+    CPUProcessorStatistic & inStep  = stats.front();
+    CPUProcessorStatistic & outStep = stats.back();
+
+    const long long rgbaBytes = 4 * sizeof(float);
+
+    float * rgbaBuffer = nullptr;
+    long numPixels = 0;
+
+    while(true)
     {
-        const std::vector<float> resImg
-            = { 0.5000f, 0.7007f, -0.3995f, 0.4002f,
-                1.5000f, 2.3096f,  0.9050f, 1.5025f,
-                0.5000f, 2.7907f,  1.6505f, 2.4002f  };
+        Clock::time_point start = Clock::now();
+        scanlineBuilder.prepRGBAScanline(&rgbaBuffer, numPixels);
+        Clock::time_point end = Clock::now();
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+        if(numPixels == 0) break;
+
+        inStep.m_time      += std::chrono::duration<double>(end - start).count();
+        inStep.m_numPixels += numPixels;
+        inStep.m_numBytes  += numPixels * ((long long)inPixelBytes + rgbaBytes);
+
+        for(size_t i = 0; i<numOps; ++i)
+        {
+            start = end;
+            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            end = Clock::now();
+
+            CPUProcessorStatistic & step = stats[i + 1];
+            step.m_time      += std::chrono::duration<double>(end - start).count();
+            step.m_numPixels += numPixels;
+            step.m_numBytes  += numPixels * 2 * rgbaBytes;
+        }
+
+        start = end;
+        scanlineBuilder.finishRGBAScanline();
+        end = Clock::now();
+
+        outStep.m_time      += std::chrono::duration<double>(end - start).count();
+        outStep.m_numPixels += numPixels;
+        outStep.m_numBytes  += numPixels * (rgbaBytes + (long long)outPixelBytes);
     }
 
+    AutoMutex lock(m_statisticsMutex);
+    for(size_t i = 0; i<stats.size() && i<m_statistics.size(); ++i)
     {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,
-                0.1023f,  0.5045f,  1.5089f,
-                1.0000f,  1.2500f,  1.9900f  };
+        m_statistics[i].m_time      += stats[i].m_time;
+        m_statistics[i].m_numPixels += stats[i].m_numPixels;
+        m_statistics[i].m_numBytes  += stats[i].m_numBytes;
+    }
+}
 
-        const std::vector<float> resImg
-            = { 0.4002f, -0.3995f,  0.7007f,
-                1.5025f,  0.9050f,  2.3096f,
-                2.4002f,  1.6505f,  2.7907f };
+void CPUProcessor::Impl::resetStatistics() const
+{
+    m_runDetectionNumLines = 0;
+    m_colorCacheNumLookups = 0;
+    m_colorCacheNumHits    = 0;
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    AutoMutex lock(m_statisticsMutex);
+    for(auto & step : m_statistics)
+    {
+        step.m_time      = 0.0;
+        step.m_numPixels = 0;
+        step.m_numBytes  = 0;
     }
+}
 
+const CPUProcessorStatistic & CPUProcessor::Impl::getStatisticRef(int index) const
+{
+    if(index<0 || index>=(int)m_statistics.size())
     {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,
-                0.1023f,  0.5045f,  1.5089f,
-                1.0000f,  1.2500f,  1.9900f  };
+        std::ostringstream oss;
+        oss << "Invalid statistic index " << index << ", the CPU processor has "
+            << m_statistics.size() << " processing steps.";
+        throw Exception(oss.str().c_str());
+    }
 
-        const std::vector<float> resImg
-            = { -0.199299f, -0.399500f, 1.300199f,
-                 0.902999f,  0.905000f, 2.909100f,
-                 1.800699f,  1.650500f, 3.390200f };
+    return m_statistics[index];
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
-    }
+const char * CPUProcessor::Impl::getStatisticName(int index) const
+{
+    // The names only change when the processor is finalized.
+    return getStatisticRef(index).m_name.c_str();
+}
 
-    {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,
-                0.1023f,  0.5045f,  1.5089f,
-                1.0000f,  1.2500f,  1.9900f  };
+CPUProcessorStatistic CPUProcessor::Impl::getStatistic(int index) const
+{
+    AutoMutex lock(m_statisticsMutex);
+    return getStatisticRef(index);
+}
 
-        const std::vector<float> resImg
-            = { 0.7007f, -0.3995f,  0.4002f,
-                2.3096f,  0.9050f,  1.5025f,
-                2.7907f,  1.6505f,  2.4002f };
+void CPUProcessor::Impl::serializeStatistics(std::ostream & os) const
+{
+    AutoMutex lock(m_statisticsMutex);
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    os << "{\n";
+    os << "    \"cacheID\": \"" << EscapeJSON(m_cacheID) << "\",\n";
+    os << "    \"steps\": [";
+    for(size_t i = 0; i<m_statistics.size(); ++i)
+    {
+        const CPUProcessorStatistic & step = m_statistics[i];
+        os << (i==0 ? "\n" : ",\n");
+        os << "        { \"name\": \"" << EscapeJSON(step.m_name) << "\"";
+        os << ", \"time\": " << step.m_time;
+        os << ", \"pixels\": " << step.m_numPixels;
+        os << ", \"bytes\": " << step.m_numBytes << " }";
     }
+    os << "\n    ]\n";
+    os << "}\n";
+}
 
-    {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,
-                0.1023f,  0.5045f,  1.5089f,
-                1.0000f,  1.2500f,  1.9900f  };
+void CPUProcessor::Impl::applyRGB(float * pixel) const
+{
+    float v[4]{pixel[0], pixel[1], pixel[2], 0.0f};
 
-        const std::vector<float> resImg
-            = { 0.7007f, -0.3995f,  0.4002f, 0.5f,
-                2.3096f,  0.9050f,  1.5025f, 0.5f,
-                2.7907f,  1.6505f,  2.4002f, 0.5f   };
+    m_inBitDepthOp->apply(v, v, 1);
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    const size_t numOps = m_cpuOps.size();
+    for(size_t i = 0; i<numOps; ++i)
+    {
+        m_cpuOps[i]->apply(pixel, pixel, 1);
     }
 
-    {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1023f,  0.5045f,  1.5089f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+    m_outBitDepthOp->apply(v, v, 1);
 
-        const std::vector<float> resImg
-            = { 0.7007f, -0.3995f,  0.4002f,
-                2.3096f,  0.9050f,  1.5025f,
-                2.7907f,  1.6505f,  2.4002f   };
+    pixel[0] = v[0];
+    pixel[1] = v[1];
+    pixel[2] = v[2];
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+void CPUProcessor::Impl::applyRGBA(float * pixel) const
+{
+    m_inBitDepthOp->apply(pixel, pixel, 1);
+
+    const size_t numOps = m_cpuOps.size();
+    for(size_t i = 0; i<numOps; ++i)
+    {
+        m_cpuOps[i]->apply(pixel, pixel, 1);
     }
 
-    const std::vector<uint16_t> i_inImg =
-        {    0,      8,    32,  0,
-            64,    128,   256,  0,
-          5120,  20140, 65535,  0  };
+    m_outBitDepthOp->apply(pixel, pixel, 1);
+}
 
-    {
-        const std::vector<float> resImg
-            = { 1.40020000f,  0.40062206f,  0.80118829f,  0.5f,
-                1.40117657f,  0.40245315f,  0.80460631f,  0.5f,
-                1.47832620f,  0.70781672f,  1.80070000f,  0.5f };
+void CPUProcessor::Impl::applyConstantRGBA(const float * pixel, ImageDesc & dstImgDesc) const
+{
+    ConstOpCPURcPtr    inBitDepthOp;
+    ConstOpCPURcPtrVec cpuOps;
+    ConstOpCPURcPtr    outBitDepthOp;
+    getGenericEngine(inBitDepthOp, cpuOps, outBitDepthOp);
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    float rgba[4] = { pixel[0], pixel[1], pixel[2], pixel[3] };
+    for(const auto & op : cpuOps)
+    {
+        op->apply(rgba, rgba, 1);
     }
 
-    {
-        const std::vector<uint16_t> resImg
-            = { 65535, 26255, 52506, 32768,
-                65535, 26375, 52730, 32768,
-                65535, 46387, 65535, 32768 };
+    // Only the packing step of the destination image is needed, so the input is the
+    // destination image itself.
+    std::unique_ptr<ScanlineHelper>
+        scanlineBuilder(CreateScanlineHelper(m_outBitDepth,
+                                             CreateGenericBitDepthHelper(m_outBitDepth,
+                                                                         BIT_DEPTH_F32),
+                                             m_outBitDepth, outBitDepthOp,
+                                             ALPHA_STRAIGHT, true));
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-    }
+    scanlineBuilder->init(dstImgDesc);
 
-    {
-        const std::vector<uint16_t> resImg
-            = { 52506, 26255, 65535, 32768,
-                52730, 26375, 65535, 32768,
-                65535, 46387, 65535, 32768 };
+    while(scanlineBuilder->fillRGBAScanline(rgba));
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
-    }
 
-    {
-        const std::vector<uint16_t> resImg
-            = { 52506, 26255, 65535,
-                52730, 26375, 65535,
-                65535, 46387, 65535 };
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                        NB_PIXELS);
-    }
 
-    {
-        const std::vector<uint8_t> resImg
-            = { 255, 102, 204, 128,
-                255, 103, 205, 128,
-                255, 180, 255, 128 };
+//////////////////////////////////////////////////////////////////////////
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
-                                                       &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                       NB_PIXELS);
-    }
 
-    {
-        const std::vector<uint8_t> resImg
-            = { 204, 102, 255,
-                205, 103, 255,
-                255, 180, 255 };
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
-                                                       &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                       NB_PIXELS);
-    }
 
-    {
-        const std::vector<uint8_t> resImg
-            = { 128, 204, 102, 255,
-                128, 205, 103, 255,
-                128, 255, 180, 255 };
+void CPUProcessor::deleter(CPUProcessor * c)
+{
+    delete c;
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
-                                                       &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
-                                                       NB_PIXELS);
-    }
+CPUProcessor::CPUProcessor()
+    :   m_impl(new Impl)
+{
 }
 
-OCIO_ADD_TEST(CPUProcessor, with_one_1d_lut)
+CPUProcessor::~CPUProcessor()
 {
-    // The unit test validates that pixel formats are correctly
-    // processed when the op list only contains one 1D LUT because it
-    // has a dedicated optimization when the input bit-depth is an integer type.
+    delete m_impl;
+    m_impl = nullptr;
+}
 
-    const std::string filePath
-        = std::string(OCIO::getTestFilesDir()) + "/lut1d_5.spi1d";
+bool CPUProcessor::hasChannelCrosstalk() const
+{
+    return getImpl()->hasChannelCrosstalk();
+}
 
-    OCIO::FileTransformRcPtr transform = OCIO::FileTransform::Create();
-    transform->setDirection(OCIO::TRANSFORM_DIR_FORWARD);
-    transform->setSrc(filePath.c_str());
-    transform->setInterpolation(OCIO::INTERP_LINEAR);
+const char * CPUProcessor::getCacheID() const
+{
+    return getImpl()->getCacheID();
+}
 
-    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+BitDepth CPUProcessor::getInputBitDepth() const
+{
+    return getImpl()->getInputBitDepth();
+}
 
-    OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+BitDepth CPUProcessor::getOutputBitDepth() const
+{
+    return getImpl()->getOutputBitDepth();
+}
 
-    constexpr const unsigned NB_PIXELS = 4;
+DynamicPropertyRcPtr CPUProcessor::getDynamicProperty(DynamicPropertyType type) const
+{
+    return getImpl()->getDynamicProperty(type);
+}
 
-    const std::vector<float> f_inImg =
-        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-            0.1002f,  0.2509f,  0.5009f,  1.0f,
-            0.5505f,  0.7090f,  0.9099f,  1.0f,
-            1.0000f,  1.2500f,  1.9900f,  0.0f  };
+void CPUProcessor::apply(ImageDesc & imgDesc) const
+{
+    getImpl()->apply(imgDesc, ALPHA_STRAIGHT);
+}
 
-    {
-        const std::vector<float> resImg
-            = {  0,            0,            0,            0,
-                 0.03728949f,  0.10394855f,  0.24695572f,  1,
-                 0.29089212f,  0.50935059f,  1.91091322f,  1,
-                64,           64,           64,            0 };
+void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
+{
+    getImpl()->apply(srcImgDesc, dstImgDesc, ALPHA_STRAIGHT);
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS,
-                                                     1e-7f);
-    }
+void CPUProcessor::apply(ImageDesc & imgDesc, AlphaMode alphaMode) const
+{
+    getImpl()->apply(imgDesc, alphaMode);
+}
 
-    {
-        const std::vector<uint16_t> resImg
-            = {     0,     0,     0,     0,
-                 2444,  6812, 16184, 65535,
-                19064, 33380, 65535, 65535,
-                65535, 65535, 65535,     0 };
+void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                         AlphaMode alphaMode) const
+{
+    getImpl()->apply(srcImgDesc, dstImgDesc, alphaMode);
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-    }
+void CPUProcessor::applyRGB(float * pixel) const
+{
+    getImpl()->applyRGB(pixel);
+}
 
-    const std::vector<uint16_t> i_inImg =
-        {    0,      8,    32,     0,
-            64,    128,   256,    32,
-           512,   1024,  2048,    64,
-          5120,  20480, 65535,   512 };
-
-    {
-        const std::vector<float> resImg
-            = {  0,           0.00036166f, 0.00144666f, 0,
-                 0.00187417f, 0.00271759f, 0.00408672f, 0.00048828f,
-                 0.00601041f, 0.00912247f, 0.01456576f, 0.00097657f,
-                 0.03030112f, 0.13105739f, 64,          0.00781261f };
-
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS, 1e-7f);
-    }
+void CPUProcessor::applyRGBA(float * pixel) const
+{
+    getImpl()->applyRGBA(pixel);
+}
 
-    {
-        const std::vector<uint16_t> resImg
-            = {     0,    24,    95,     0,
-                  123,   178,   268,    32,
-                  394,   598,   955,    64,
-                 1986,  8589, 65535,   512 };
+void CPUProcessor::applyConstantRGBA(const float * pixel, ImageDesc & dstImgDesc) const
+{
+    getImpl()->applyConstantRGBA(pixel, dstImgDesc);
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-    }
+bool CPUProcessor::isRunDetectionEnabled() const
+{
+    return getImpl()->isRunDetectionEnabled();
+}
 
-    {
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,     0,
-                  268,   178,   123,    32,
-                  955,   598,   394,    64,
-                65535,  8589,  1986,   512 };
+long long CPUProcessor::getRunDetectionNumLines() const
+{
+    return getImpl()->getRunDetectionNumLines();
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-    }
+bool CPUProcessor::isColorCacheEnabled() const
+{
+    return getImpl()->isColorCacheEnabled();
+}
 
-    {
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,     0,
-                  268,   178,   123,    32,
-                  955,   598,   394,    64,
-                65535,  8589,  1986,   512 };
+long long CPUProcessor::getColorCacheNumLookups() const
+{
+    return getImpl()->getColorCacheNumLookups();
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
-    }
+long long CPUProcessor::getColorCacheNumHits() const
+{
+    return getImpl()->getColorCacheNumHits();
+}
 
-    {
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,
-                  268,   178,   123,
-                  955,   598,   394,
-                65535,  8589,  1986 };
+bool CPUProcessor::isStatisticsEnabled() const
+{
+    return getImpl()->isStatisticsEnabled();
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                        NB_PIXELS);
-    }
+void CPUProcessor::resetStatistics() const
+{
+    getImpl()->resetStatistics();
+}
 
-    {
-        const std::vector<uint16_t> resImg
-            = {     0,    24,    95,     0,
-                  123,   178,   268,    32,
-                  394,   598,   955,    64,
-                 1986,  8589, 65535,    512 };
+int CPUProcessor::getNumStatistics() const
+{
+    return getImpl()->getNumStatistics();
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
-    }
+const char * CPUProcessor::getStatisticName(int index) const
+{
+    return getImpl()->getStatisticName(index);
+}
 
-    {
-        const std::vector<uint16_t> my_i_inImg =
-            {    0,      8,    32,
-                64,    128,   256,
-               512,   1024,  2048,
-              5120,  20480, 65535  };
+double CPUProcessor::getStatisticTime(int index) const
+{
+    return getImpl()->getStatistic(index).m_time;
+}
 
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,     0,
-                  268,   178,   123,     0,
-                  955,   598,   394,     0,
-                65535,  8589,  1986,     0 };
+long long CPUProcessor::getStatisticNumPixels(int index) const
+{
+    return getImpl()->getStatistic(index).m_numPixels;
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &my_i_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
-    }
+long long CPUProcessor::getStatisticNumBytes(int index) const
+{
+    return getImpl()->getStatistic(index).m_numBytes;
 }
 
-OCIO_ADD_TEST(CPUProcessor, with_several_ops)
+void CPUProcessor::serializeStatistics(std::ostream & os) const
 {
-    // The unit test validates that pixel formats are correctly
-    // processed when the op list starts or ends with a 1D LUT because it
-    // has a dedicated optimization when the input bit-depth is an integer type.
+    getImpl()->serializeStatistics(os);
+}
 
-    const std::string SIMPLE_PROFILE =
-        "ocio_profile_version: 2\n"
-        "\n"
-        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
-        "strictparsing: true\n"
-        "luma: [0.2126, 0.7152, 0.0722]\n"
-        "\n"
-        "roles:\n"
-        "  default: cs1\n"
-        "  scene_linear: cs2\n"
-        "\n"
-        "displays:\n"
-        "  sRGB:\n"
-        "    - !<View> {name: Raw, colorspace: cs1}\n"
-        "\n"
-        "colorspaces:\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs1\n"
-        "    allocation: uniform\n"
-        "\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs2\n"
-        "    allocation: uniform\n";
+}
+OCIO_NAMESPACE_EXIT
 
-    // Step 1: The 1D LUT is the last Op.
 
-    {
-        const std::string strEnd =
-            "    from_reference: !<GroupTransform>\n"
-            "      children:\n"
-            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
-            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
 
-        const std::string str = SIMPLE_PROFILE + strEnd;
+///////////////////////////////////////////////////////////////////////////////
 
-        std::istringstream is;
-        is.str(str);
 
-        OCIO::ConstConfigRcPtr config;
-        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-        OCIO_CHECK_NO_THROW(config->sanityCheck());
 
-        OCIO::ConstProcessorRcPtr processor;
-        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+#ifdef OCIO_UNIT_TEST
 
-        constexpr const unsigned NB_PIXELS = 4;
+namespace OCIO = OCIO_NAMESPACE;
 
-        const std::vector<float> f_inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1002f,  0.2509f,  0.5009f,  1.0f,
-                0.5505f,  0.7090f,  0.9099f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+#include "MathUtils.h"
+#include "ops/Lut1D/Lut1DOp.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ScanlineHelper.h"
+#include "UnitTest.h"
+#include "UnitTestUtils.h"
 
-        {
-            const std::vector<float> resImg
-                = {  0.0f,         0.0f,         0.0f,         0.0f,
-                     0.0f,         0.20273837f,  0.24680146f,  1.0f,
-                     0.15488569f,  1.69210147f,  1.90666747f,  1.0f,
-                     0.81575858f, 64.0f,        64.0f,         0.0f };
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
-        }
+OCIO_ADD_TEST(CPUProcessor, flag_composition)
+{
+    // The test validates the build of a custom optimization flag.
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0,     0,     0,     0,
-                        0, 13286, 16174, 65535,
-                    10150, 65535, 65535, 65535,
-                    53461, 65535, 65535,     0 };
+    OCIO::OptimizationFlags customFlags = OCIO::OPTIMIZATION_LOSSLESS;
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
-        }
+    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
+                     OCIO::OPTIMIZATION_NONE);
 
-        const std::vector<uint16_t> i_inImg =
-            {    0,      8,    32,  0,
-                64,    128,   256,  65535,
-               512,   1024,  2048,  0,
-              5120,  20480, 65535,  65535  };
+    customFlags
+        = OCIO::OptimizationFlags(customFlags | OCIO::OPTIMIZATION_COMP_LUT1D);
 
-        {
-            const std::vector<float> resImg
-                = {  0.0f,  0.07789713f,  0.00088374f,  0.0f,
-                     0.0f,  0.07871927f,  0.00396248f,  1.0f,
-                     0.0f,  0.08474064f,  0.01450117f,  0.0f,
-                     0.0f,  0.24826171f, 56.39490891f,  1.0f };
+    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
+                     OCIO::OPTIMIZATION_COMP_LUT1D);
+}
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
-        }
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0,  5105,    58,     0,
-                        0,  5159,   260,     65535,
-                        0,  5553,   950,     0,
-                        0, 16270, 65535,     65535 };
+// TODO: CPUProcessor being part of the OCIO public API limits the ability
+//       to inspect the CPUProcessor instance content i.e. the list of CPUOps.
+//       Even a successful apply could hide a major performance hit because of
+//       a missing/partial optimization.
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
-        }
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0,  5105,     0,     0,
-                        0,  5159,   112,     65535,
-                        0,  5553,   388,     0,
-                    53461, 16270,  1982,     65535 };
-
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
-        }
-
-        {
-            const std::vector<uint16_t> resImg
-                = {    58,  5105,     0,     0,
-                      260,  5159,     0,     65535,
-                      950,  5553,     0,     0,
-                    65535, 16270,     0,     65535 };
+template<OCIO::BitDepth inBD, OCIO::BitDepth outBD, unsigned line>
+OCIO::ConstCPUProcessorRcPtr ComputeValues(OCIO::ConstProcessorRcPtr processor,
+                                           const void * inImg,
+                                           OCIO::ChannelOrdering inChans,
+                                           const void * resImg,
+                                           OCIO::ChannelOrdering outChans,
+                                           long numPixels,
+                                           // Default value to nan to break any float comparisons
+                                           // as a valid error threshold is mandatory in that case.
+                                           float absErrorThreshold
+                                                = std::numeric_limits<float>::quiet_NaN())
+{
+    typedef typename OCIO::BitDepthInfo<inBD>::Type inType;
+    typedef typename OCIO::BitDepthInfo<outBD>::Type outType;
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                            NB_PIXELS);
-        }
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0,  5105,     0,     0,
-                      112,  5159,     0,     65535,
-                      388,  5553,     0,     0,
-                     1982, 16270, 53461,     65535 };
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor
+        = processor->getOptimizedCPUProcessor(inBD, outBD,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT), line);
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                            NB_PIXELS);
-        }
+    size_t numChannels = 4;
+    if(outChans==OCIO::CHANNEL_ORDERING_RGB || outChans==OCIO::CHANNEL_ORDERING_BGR)
+    {
+        numChannels = 3;
     }
+    const size_t numValues = size_t(numPixels * numChannels);
 
-    // Step 2: The 1D LUT is the first Op.
+    const OCIO::PackedImageDesc srcImgDesc((void *)inImg, numPixels, 1,
+                                           inChans,
+                                           inBD,
+                                           sizeof(inType),
+                                           OCIO::AutoStride,
+                                           OCIO::AutoStride);
 
-    {
-        const std::string strEnd =
-            "    from_reference: !<GroupTransform>\n"
-            "      children:\n"
-            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
-            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n";
+    std::vector<outType> out(numValues);
+    OCIO::PackedImageDesc dstImgDesc(&out[0], numPixels, 1,
+                                     outChans,
+                                     outBD,
+                                     sizeof(outType),
+                                     OCIO::AutoStride,
+                                     OCIO::AutoStride);
 
-        const std::string str = SIMPLE_PROFILE + strEnd;
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), line);
 
-        std::istringstream is;
-        is.str(str);
+    const outType * res = reinterpret_cast<const outType*>(resImg);
 
-        OCIO::ConstConfigRcPtr config;
-        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-        OCIO_CHECK_NO_THROW(config->sanityCheck());
+    for(size_t idx=0; idx<numValues; ++idx)
+    {
+        if(OCIO::BitDepthInfo<outBD>::isFloat)
+        {
+            OCIO_CHECK_CLOSE_FROM(out[idx], res[idx], absErrorThreshold, line);
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL_FROM(out[idx], res[idx], line);
+        }
+    }
 
-        OCIO::ConstProcessorRcPtr processor;
-        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+    return cpuProcessor;
+}
 
-        const unsigned NB_PIXELS = 4;
+namespace
+{
 
-        const std::vector<float> f_inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1002f,  0.2509f,  0.5009f,  1.0f,
-                0.5505f,  0.7090f,  0.9099f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+// Compare the bit-depth cast with the scalar conversion, on the edge cases
+// i.e. rounding, clamping and NaNs.
+template<OCIO::BitDepth inBD, OCIO::BitDepth outBD>
+void ValidateBitDepthCast(const std::vector<float> & values, unsigned line)
+{
+    typedef typename OCIO::BitDepthInfo<inBD>::Type InType;
+    typedef typename OCIO::BitDepthInfo<outBD>::Type OutType;
 
-        {
-            const std::vector<float> resImg
-                = { -0.18999999f,  0.18999999f, -0.00019000f,  0.0f,
-                    -0.15271049f,  0.29394856f,  0.24676571f,  1.0f,
-                     0.10089212f,  0.69935059f,  1.91072320f,  1.0f,
-                    63.81000137f, 64.19000244f, 63.99980927f,  0.0f };
+    std::vector<InType> in(values.size());
+    for(size_t idx=0; idx<values.size(); ++idx)
+    {
+        in[idx] = OCIO::Converter<inBD>::CastValue(values[idx]);
+    }
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
-        }
+    std::vector<OutType> out(values.size());
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0, 12452,     0,     0,
-                        0, 19264, 16172, 65535,
-                     6612, 45832, 65535, 65535,
-                    65535, 65535, 65535,     0 };
+    OCIO::ConstOpCPURcPtr op = OCIO::CreateGenericBitDepthHelper(inBD, outBD);
+    op->apply(&in[0], &out[0], long(values.size() / 4));
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
-        }
+    const float scale = float(OCIO::BitDepthInfo<outBD>::maxValue)
+                            / float(OCIO::BitDepthInfo<inBD>::maxValue);
 
-        const std::vector<uint16_t> i_inImg =
-            {    0,      8,    32,  0,
-                64,    128,   256,  0,
-               512,   1024,  2048,  0,
-              5120,  20480, 65535,  0  };
+    for(size_t idx=0; idx<values.size(); ++idx)
+    {
+        const float value  = in[idx] * scale;
+        const float result = out[idx];
+        if(OCIO::IsNan(value))
         {
-            const std::vector<float> resImg
-                = { -0.18999999f, 0.19036166f,  0.00125666f,  0.0f,
-                    -0.18812581f, 0.19271758f,  0.00389672f,  0.0f,
-                    -0.18398958f, 0.19912247f,  0.01437576f,  0.0f,
-                    -0.15969887f, 0.32105737f, 63.99980927f,  0.0f };
-
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
+            // The scalar cast of a NaN to an integer is undefined.
+            if(OCIO::BitDepthInfo<outBD>::isFloat)
+            {
+                OCIO_CHECK_EQUAL_FROM(OCIO::IsNan(result), true, line);
+            }
         }
-
+        else
         {
-            const std::vector<uint16_t> resImg
-                = {     0, 12475,     0,     0,
-                      110, 12630,     0,     0,
-                      381, 13049,     0,     0,
-                     1973, 21040, 65535,     0 };
-
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                            NB_PIXELS);
+            const float expected = OCIO::Converter<outBD>::CastValue(value);
+            OCIO_CHECK_EQUAL_FROM(result, expected, line);
         }
     }
+}
 
-    // Step 3: The 1D LUT is the first and the last Op.
-
-    {
+template<OCIO::BitDepth inBD>
+void ValidateBitDepthCasts(const std::vector<float> & values, unsigned line)
+{
+    ValidateBitDepthCast<inBD, OCIO::BIT_DEPTH_UINT8>(values, line);
+    ValidateBitDepthCast<inBD, OCIO::BIT_DEPTH_UINT10>(values, line);
+    ValidateBitDepthCast<inBD, OCIO::BIT_DEPTH_UINT12>(values, line);
+    ValidateBitDepthCast<inBD, OCIO::BIT_DEPTH_UINT16>(values, line);
+    ValidateBitDepthCast<inBD, OCIO::BIT_DEPTH_F16>(values, line);
+    ValidateBitDepthCast<inBD, OCIO::BIT_DEPTH_F32>(values, line);
+}
 
-        const std::string strEnd =
-            "    from_reference: !<GroupTransform>\n"
-            "      children:\n"
-            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
-            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
-            "        - !<FileTransform>   { src: lut1d_4.spi1d, interpolation: linear }\n";
+} // anon
 
-        const std::string str = SIMPLE_PROFILE + strEnd;
+OCIO_ADD_TEST(CPUProcessor, bit_depth_cast)
+{
+    // Values in the input bit-depth range (i.e. before the cast to the input bit-depth).
+    const std::vector<float> intValues = {     0.0f,     1.0f,     2.0f,     3.0f,
+                                              127.0f,   128.0f,   254.0f,   255.0f,
+                                              511.0f,   512.0f,  1022.0f,  1023.0f,
+                                             2047.0f,  4095.0f, 32767.0f, 32768.0f,
+                                            40000.0f, 65534.0f, 65535.0f, 65536.0f };
+
+    ValidateBitDepthCasts<OCIO::BIT_DEPTH_UINT8>(intValues, __LINE__);
+    ValidateBitDepthCasts<OCIO::BIT_DEPTH_UINT10>(intValues, __LINE__);
+    ValidateBitDepthCasts<OCIO::BIT_DEPTH_UINT12>(intValues, __LINE__);
+    ValidateBitDepthCasts<OCIO::BIT_DEPTH_UINT16>(intValues, __LINE__);
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf  = std::numeric_limits<float>::infinity();
+
+    const std::vector<float> floatValues = { -1.0f,   -0.001f, 0.0f,     0.5f / 65535.0f,
+                                              1.5f / 65535.0f, 0.5f / 255.0f, 1.49f / 255.0f,
+                                              0.1f,    0.18f,  0.5f,     0.99f,
+                                              1.0f,    1.001f, 2.0f,     65504.0f,
+                                              qnan,    inf,    -inf,     1e-6f,
+                                              -0.0f };
+
+    ValidateBitDepthCasts<OCIO::BIT_DEPTH_F16>(floatValues, __LINE__);
+    ValidateBitDepthCasts<OCIO::BIT_DEPTH_F32>(floatValues, __LINE__);
+}
 
-        std::istringstream is;
-        is.str(str);
+OCIO_ADD_TEST(CPUProcessor, with_one_matrix)
+{
+    // The unit test validates that pixel formats are correctly
+    // processed when the op list contains only one arbitrary Op
+    // (except a 1D LUT one which has dedicated optimizations).
 
-        OCIO::ConstConfigRcPtr config;
-        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-        OCIO_CHECK_NO_THROW(config->sanityCheck());
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        OCIO::ConstProcessorRcPtr processor;
-        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
+    constexpr const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5f };
+    transform->setOffset( offset4 );
 
-        const unsigned NB_PIXELS = 4;
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
 
-        const std::vector<float> f_inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1002f,  0.2509f,  0.5009f,  1.0f,
-                0.5505f,  0.7090f,  0.9099f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+    constexpr const unsigned NB_PIXELS = 3;
 
-        {
-            const std::vector<float> resImg
-                = { -0.79690927f, -0.06224250f, -0.42994320f,  0.0f,
-                    -0.72481626f,  0.13872468f,  0.04750441f,  1.0f,
-                    -0.23451784f,  0.92250210f,  3.26448941f,  1.0f,
-                     3.43709063f,  3.43709063f,  3.43709063f,  0.0f };
+    const std::vector<float> f_inImg =
+        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+            0.1023f,  0.5045f,  1.5089f,  1.0f,
+            1.0000f,  1.2500f,  1.9900f,  0.0f  };
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
-        }
+    {
+        const std::vector<float> resImg
+            = { 0.4002f, -0.3995f,  0.7007f,  0.5000f,
+                1.5025f,  0.9050f,  2.3096f,  1.5000f,
+                2.4002f,  1.6505f,  2.7907f,  0.5000f };
 
-        const std::vector<uint16_t> i_inImg =
-            {    0,      8,    32,  0,
-                64,    128,   256,  0,
-               512,   1024,  2048,  0,
-              5120,  20480, 65535,  0  };
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0,     0,     0,     0,
-                        0,     0,     0,     0,
-                        0,     0,     0,     0,
-                        0, 12526, 65535,     0 };
+    {
+        const std::vector<float> resImg
+            = { -0.1993f, -0.3995f,  1.3002f,  0.5000f,
+                 0.9030f,  0.9050f,  2.9091f,  1.5000f,
+                 1.8007f,  1.6505f,  3.3902f,  0.5000f };
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> resImg
+            = {  -0.500000f,  0.000700f, 0.300500f, 1.400200f,
+                  0.602300f,  1.305199f, 1.909399f, 2.400200f,
+                  1.500000f,  2.050699f, 2.390500f, 1.400200f  };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_ABGR,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> resImg
+            = { 0.7007f, -0.3995f,  0.4002f,  0.5000f,
+                2.3096f,  0.9050f,  1.5025f,  1.5000f,
+                2.7907f,  1.6505f,  2.4002f,  0.5000f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> resImg
+            = { 0.5000f, 0.7007f, -0.3995f, 0.4002f,
+                1.5000f, 2.3096f,  0.9050f, 1.5025f,
+                0.5000f, 2.7907f,  1.6505f, 2.4002f  };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,
+                0.1023f,  0.5045f,  1.5089f,
+                1.0000f,  1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { 0.4002f, -0.3995f,  0.7007f,
+                1.5025f,  0.9050f,  2.3096f,
+                2.4002f,  1.6505f,  2.7907f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,
+                0.1023f,  0.5045f,  1.5089f,
+                1.0000f,  1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { -0.199299f, -0.399500f, 1.300199f,
+                 0.902999f,  0.905000f, 2.909100f,
+                 1.800699f,  1.650500f, 3.390200f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,
+                0.1023f,  0.5045f,  1.5089f,
+                1.0000f,  1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { 0.7007f, -0.3995f,  0.4002f,
+                2.3096f,  0.9050f,  1.5025f,
+                2.7907f,  1.6505f,  2.4002f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,
+                0.1023f,  0.5045f,  1.5089f,
+                1.0000f,  1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { 0.7007f, -0.3995f,  0.4002f, 0.5f,
+                2.3096f,  0.9050f,  1.5025f, 0.5f,
+                2.7907f,  1.6505f,  2.4002f, 0.5f   };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1023f,  0.5045f,  1.5089f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        const std::vector<float> resImg
+            = { 0.7007f, -0.3995f,  0.4002f,
+                2.3096f,  0.9050f,  1.5025f,
+                2.7907f,  1.6505f,  2.4002f   };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    const std::vector<uint16_t> i_inImg =
+        {    0,      8,    32,  0,
+            64,    128,   256,  0,
+          5120,  20140, 65535,  0  };
+
+    {
+        const std::vector<float> resImg
+            = { 1.40020000f,  0.40062206f,  0.80118829f,  0.5f,
+                1.40117657f,  0.40245315f,  0.80460631f,  0.5f,
+                1.47832620f,  0.70781672f,  1.80070000f,  0.5f };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = { 65535, 26255, 52506, 32768,
+                65535, 26375, 52730, 32768,
+                65535, 46387, 65535, 32768 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = { 52506, 26255, 65535, 32768,
+                52730, 26375, 65535, 32768,
+                65535, 46387, 65535, 32768 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = { 52506, 26255, 65535,
+                52730, 26375, 65535,
+                65535, 46387, 65535 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint8_t> resImg
+            = { 255, 102, 204, 128,
+                255, 103, 205, 128,
+                255, 180, 255, 128 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
+                                                       &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                       NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint8_t> resImg
+            = { 204, 102, 255,
+                205, 103, 255,
+                255, 180, 255 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
+                                                       &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                       NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint8_t> resImg
+            = { 128, 204, 102, 255,
+                128, 205, 103, 255,
+                128, 255, 180, 255 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
+                                                       &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
+                                                       NB_PIXELS);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, with_one_1d_lut)
+{
+    // The unit test validates that pixel formats are correctly
+    // processed when the op list only contains one 1D LUT because it
+    // has a dedicated optimization when the input bit-depth is an integer type.
+
+    const std::string filePath
+        = std::string(OCIO::getTestFilesDir()) + "/lut1d_5.spi1d";
+
+    OCIO::FileTransformRcPtr transform = OCIO::FileTransform::Create();
+    transform->setDirection(OCIO::TRANSFORM_DIR_FORWARD);
+    transform->setSrc(filePath.c_str());
+    transform->setInterpolation(OCIO::INTERP_LINEAR);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+
+    constexpr const unsigned NB_PIXELS = 4;
+
+    const std::vector<float> f_inImg =
+        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+            0.1002f,  0.2509f,  0.5009f,  1.0f,
+            0.5505f,  0.7090f,  0.9099f,  1.0f,
+            1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+    {
+        const std::vector<float> resImg
+            = {  0,            0,            0,            0,
+                 0.03728949f,  0.10394855f,  0.24695572f,  1,
+                 0.29089212f,  0.50935059f,  1.91091322f,  1,
+                64,           64,           64,            0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS,
+                                                     1e-7f);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {     0,     0,     0,     0,
+                 2444,  6812, 16184, 65535,
+                19064, 33380, 65535, 65535,
+                65535, 65535, 65535,     0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    const std::vector<uint16_t> i_inImg =
+        {    0,      8,    32,     0,
+            64,    128,   256,    32,
+           512,   1024,  2048,    64,
+          5120,  20480, 65535,   512 };
+
+    {
+        const std::vector<float> resImg
+            = {  0,           0.00036166f, 0.00144666f, 0,
+                 0.00187417f, 0.00271759f, 0.00408672f, 0.00048828f,
+                 0.00601041f, 0.00912247f, 0.01456576f, 0.00097657f,
+                 0.03030112f, 0.13105739f, 64,          0.00781261f };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS, 1e-7f);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {     0,    24,    95,     0,
+                  123,   178,   268,    32,
+                  394,   598,   955,    64,
+                 1986,  8589, 65535,   512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,     0,
+                  268,   178,   123,    32,
+                  955,   598,   394,    64,
+                65535,  8589,  1986,   512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,     0,
+                  268,   178,   123,    32,
+                  955,   598,   394,    64,
+                65535,  8589,  1986,   512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,
+                  268,   178,   123,
+                  955,   598,   394,
+                65535,  8589,  1986 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {     0,    24,    95,     0,
+                  123,   178,   268,    32,
+                  394,   598,   955,    64,
+                 1986,  8589, 65535,    512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> my_i_inImg =
+            {    0,      8,    32,
+                64,    128,   256,
+               512,   1024,  2048,
+              5120,  20480, 65535  };
+
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,     0,
+                  268,   178,   123,     0,
+                  955,   598,   394,     0,
+                65535,  8589,  1986,     0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &my_i_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, with_several_ops)
+{
+    // The unit test validates that pixel formats are correctly
+    // processed when the op list starts or ends with a 1D LUT because it
+    // has a dedicated optimization when the input bit-depth is an integer type.
+
+    const std::string SIMPLE_PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
+        "strictparsing: true\n"
+        "luma: [0.2126, 0.7152, 0.0722]\n"
+        "\n"
+        "roles:\n"
+        "  default: cs1\n"
+        "  scene_linear: cs2\n"
+        "\n"
+        "displays:\n"
+        "  sRGB:\n"
+        "    - !<View> {name: Raw, colorspace: cs1}\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs1\n"
+        "    allocation: uniform\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs2\n"
+        "    allocation: uniform\n";
+
+    // Step 1: The 1D LUT is the last Op.
+
+    {
+        const std::string strEnd =
+            "    from_reference: !<GroupTransform>\n"
+            "      children:\n"
+            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
+            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
+
+        const std::string str = SIMPLE_PROFILE + strEnd;
+
+        std::istringstream is;
+        is.str(str);
+
+        OCIO::ConstConfigRcPtr config;
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+        OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+        constexpr const unsigned NB_PIXELS = 4;
+
+        const std::vector<float> f_inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1002f,  0.2509f,  0.5009f,  1.0f,
+                0.5505f,  0.7090f,  0.9099f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        {
+            const std::vector<float> resImg
+                = {  0.0f,         0.0f,         0.0f,         0.0f,
+                     0.0f,         0.20273837f,  0.24680146f,  1.0f,
+                     0.15488569f,  1.69210147f,  1.90666747f,  1.0f,
+                     0.81575858f, 64.0f,        64.0f,         0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,     0,     0,     0,
+                        0, 13286, 16174, 65535,
+                    10150, 65535, 65535, 65535,
+                    53461, 65535, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        const std::vector<uint16_t> i_inImg =
+            {    0,      8,    32,  0,
+                64,    128,   256,  65535,
+               512,   1024,  2048,  0,
+              5120,  20480, 65535,  65535  };
+
+        {
+            const std::vector<float> resImg
+                = {  0.0f,  0.07789713f,  0.00088374f,  0.0f,
+                     0.0f,  0.07871927f,  0.00396248f,  1.0f,
+                     0.0f,  0.08474064f,  0.01450117f,  0.0f,
+                     0.0f,  0.24826171f, 56.39490891f,  1.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,  5105,    58,     0,
+                        0,  5159,   260,     65535,
+                        0,  5553,   950,     0,
+                        0, 16270, 65535,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,  5105,     0,     0,
+                        0,  5159,   112,     65535,
+                        0,  5553,   388,     0,
+                    53461, 16270,  1982,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {    58,  5105,     0,     0,
+                      260,  5159,     0,     65535,
+                      950,  5553,     0,     0,
+                    65535, 16270,     0,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                            NB_PIXELS);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,  5105,     0,     0,
+                      112,  5159,     0,     65535,
+                      388,  5553,     0,     0,
+                     1982, 16270, 53461,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                            NB_PIXELS);
+        }
+    }
+
+    // Step 2: The 1D LUT is the first Op.
+
+    {
+        const std::string strEnd =
+            "    from_reference: !<GroupTransform>\n"
+            "      children:\n"
+            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
+            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n";
+
+        const std::string str = SIMPLE_PROFILE + strEnd;
+
+        std::istringstream is;
+        is.str(str);
+
+        OCIO::ConstConfigRcPtr config;
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+        OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+        const unsigned NB_PIXELS = 4;
+
+        const std::vector<float> f_inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1002f,  0.2509f,  0.5009f,  1.0f,
+                0.5505f,  0.7090f,  0.9099f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        {
+            const std::vector<float> resImg
+                = { -0.18999999f,  0.18999999f, -0.00019000f,  0.0f,
+                    -0.15271049f,  0.29394856f,  0.24676571f,  1.0f,
+                     0.10089212f,  0.69935059f,  1.91072320f,  1.0f,
+                    63.81000137f, 64.19000244f, 63.99980927f,  0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0, 12452,     0,     0,
+                        0, 19264, 16172, 65535,
+                     6612, 45832, 65535, 65535,
+                    65535, 65535, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        const std::vector<uint16_t> i_inImg =
+            {    0,      8,    32,  0,
+                64,    128,   256,  0,
+               512,   1024,  2048,  0,
+              5120,  20480, 65535,  0  };
+        {
+            const std::vector<float> resImg
+                = { -0.18999999f, 0.19036166f,  0.00125666f,  0.0f,
+                    -0.18812581f, 0.19271758f,  0.00389672f,  0.0f,
+                    -0.18398958f, 0.19912247f,  0.01437576f,  0.0f,
+                    -0.15969887f, 0.32105737f, 63.99980927f,  0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0, 12475,     0,     0,
+                      110, 12630,     0,     0,
+                      381, 13049,     0,     0,
+                     1973, 21040, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                            NB_PIXELS);
+        }
+    }
+
+    // Step 3: The 1D LUT is the first and the last Op.
+
+    {
+
+        const std::string strEnd =
+            "    from_reference: !<GroupTransform>\n"
+            "      children:\n"
+            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
+            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
+            "        - !<FileTransform>   { src: lut1d_4.spi1d, interpolation: linear }\n";
+
+        const std::string str = SIMPLE_PROFILE + strEnd;
+
+        std::istringstream is;
+        is.str(str);
+
+        OCIO::ConstConfigRcPtr config;
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+        OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+        const unsigned NB_PIXELS = 4;
+
+        const std::vector<float> f_inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1002f,  0.2509f,  0.5009f,  1.0f,
+                0.5505f,  0.7090f,  0.9099f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        {
+            const std::vector<float> resImg
+                = { -0.79690927f, -0.06224250f, -0.42994320f,  0.0f,
+                    -0.72481626f,  0.13872468f,  0.04750441f,  1.0f,
+                    -0.23451784f,  0.92250210f,  3.26448941f,  1.0f,
+                     3.43709063f,  3.43709063f,  3.43709063f,  0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        const std::vector<uint16_t> i_inImg =
+            {    0,      8,    32,  0,
+                64,    128,   256,  0,
+               512,   1024,  2048,  0,
+              5120,  20480, 65535,  0  };
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,     0,     0,     0,
+                        0,     0,     0,     0,
+                        0,     0,     0,     0,
+                        0, 12526, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
                           OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
                                                             &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
                                                             &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
@@ -1396,1151 +2557,2303 @@ OCIO_ADD_TEST(CPUProcessor, with_several_ops)
     }
 }
 
-OCIO_ADD_TEST(CPUProcessor, image_desc)
+OCIO_ADD_TEST(CPUProcessor, image_desc)
+{
+    // The tests validate the image description types when using the same buffer image.
+
+    const std::string SIMPLE_PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
+        "strictparsing: true\n"
+        "luma: [0.2126, 0.7152, 0.0722]\n"
+        "\n"
+        "roles:\n"
+        "  default: cs1\n"
+        "  scene_linear: cs2\n"
+        "\n"
+        "displays:\n"
+        "  sRGB:\n"
+        "    - !<View> {name: Raw, colorspace: cs1}\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs1\n"
+        "    allocation: uniform\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs2\n"
+        "    allocation: uniform\n";
+
+    const std::string strEnd =
+        "    from_reference: !<GroupTransform>\n"
+        "      children:\n"
+        "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0.5] }\n"
+        "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
+
+    const std::string str = SIMPLE_PROFILE + strEnd;
+
+    std::istringstream is;
+    is.str(str);
+
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+    const std::vector<float> f_rInImg =
+        {  -1.0000f,
+            0.1002f,
+            0.5505f,
+            1.0000f,  };
+
+    const std::vector<float> f_gInImg =
+        {            -0.8000f,
+                      0.2509f,
+                      0.7090f,
+                      1.2500f  };
+
+    const std::vector<float> f_bInImg =
+        {                       -0.1000f,
+                                 0.5009f,
+                                 0.9099f,
+                                 1.9900f  };
+
+    const std::vector<float> f_aInImg =
+        {                                   0.0f,
+                                            1.0f,
+                                            0.5f,
+                                            0.0f  };
+
+    const std::vector<float> f_rOutImg
+        = {  0.0f,
+             0.0f,
+             0.15488569f,
+             0.81575858f };
+
+    const std::vector<float> f_gOutImg
+        = {                0.0f,
+                           0.20273837f,
+                           1.69210147f,
+                          64.0f };
+
+    const std::vector<float> f_bOutImg
+        = {                              0.0f,
+                                         0.24680146f,
+                                         1.90666747f,
+                                        64.0f };
+
+    const std::vector<float> f_aOutImg
+        = {                                            0.5f,
+                                                       1.5f,
+                                                       1.0f,
+                                                       0.5f };
+
+    {
+        // Packed Image Description with RGBA image.
+
+        std::vector<float> img =
+            {  f_rInImg[0], f_gInImg[0], f_bInImg[0], f_aInImg[0],
+               f_rInImg[1], f_gInImg[1], f_bInImg[1], f_aInImg[1],
+               f_rInImg[2], f_gInImg[2], f_bInImg[2], f_aInImg[2],
+               f_rInImg[3], f_gInImg[3], f_bInImg[3], f_aInImg[3] };
+
+        const std::vector<float> res
+            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0], f_aOutImg[0],
+               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1], f_aOutImg[1],
+               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2], f_aOutImg[2],
+               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3], f_aOutImg[3] };
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PackedImageDesc desc(&img[0], 2, 2, 4);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<img.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
+        }
+    }
+
+    {
+        // Packed Image Description with RGB image.
+
+        std::vector<float> img =
+            {  f_rInImg[0], f_gInImg[0], f_bInImg[0],
+               f_rInImg[1], f_gInImg[1], f_bInImg[1],
+               f_rInImg[2], f_gInImg[2], f_bInImg[2],
+               f_rInImg[3], f_gInImg[3], f_bInImg[3] };
+
+        const std::vector<float> res
+            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0],
+               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1],
+               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2],
+               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3] };
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PackedImageDesc desc(&img[0], 4, 1, 3);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<img.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
+        }
+    }
+
+    {
+        // Planar Image Description with R/G/B/A.
+
+        std::vector<float> imgRed   = f_rInImg;
+        std::vector<float> imgGreen = f_gInImg;
+        std::vector<float> imgBlue  = f_bInImg;
+        std::vector<float> imgAlpha = f_aInImg;
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], &imgAlpha[0], 2, 2);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<imgRed.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgAlpha[idx], f_aOutImg[idx], 1e-7f);
+        }
+    }
+
+    {
+        // Planar Image Description with R/G/B.
+
+        std::vector<float> imgRed   = f_rInImg;
+        std::vector<float> imgGreen = f_gInImg;
+        std::vector<float> imgBlue  = f_bInImg;
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], nullptr, 1, 4);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<imgRed.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
+        }
+    }
+}
+
+namespace
+{
+
+constexpr const unsigned NB_PIXELS = 6;
+
+std::vector<float> inImgR =
+    {  -1.000012f,
+       -0.500012f,
+        0.100012f,
+        0.600012f,
+        1.102312f,
+        1.700012f  };
+
+std::vector<float> inImgG =
+    {              -0.800012f,
+                   -0.300012f,
+                    0.250012f,
+                    0.800012f,
+                    1.204512f,
+                    1.800012f };
+
+std::vector<float> inImgB =
+    {                          -0.600012f,
+                               -0.100012f,
+                                0.450012f,
+                                0.900012f,
+                                1.508912f,
+                                1.990012f };
+
+std::vector<float> inImgA =
+    {                                       0.005005f,
+                                            0.405005f,
+                                            0.905005f,
+                                            0.005005f,
+                                            1.005005f,
+                                            0.095005f  };
+
+std::vector<float> inImg =
+    { inImgR[0], inImgG[0], inImgB[0], inImgA[0],
+      inImgR[1], inImgG[1], inImgB[1], inImgA[1],
+      inImgR[2], inImgG[2], inImgB[2], inImgA[2],
+      inImgR[3], inImgG[3], inImgB[3], inImgA[3],
+      inImgR[4], inImgG[4], inImgB[4], inImgA[4],
+      inImgR[5], inImgG[5], inImgB[5], inImgA[5] };
+
+const std::vector<float> resImgR =
+    {  0.4001879692f,
+       0.9001880288f,
+       1.500211954f,
+       2.000211954f,
+       2.502511978f,
+       3.100212097f };
+
+const std::vector<float> resImgG =
+    {                 -0.3995119929f,
+                       0.1004880071f,
+                       0.6505119801f,
+                       1.200511932f,
+                       1.60501194f,
+                       2.200511932f };
+
+const std::vector<float> resImgB =
+    {                                 0.2006880045f,
+                                      0.7006880045f,
+                                      1.250712037f,
+                                      1.700711966f,
+                                      2.309612036f,
+                                      2.790712118f };
+
+const std::vector<float> resImgA =
+    {                                                0.5057050f,
+                                                     0.9057050f,
+                                                     1.4057050f,
+                                                     0.5057050f,
+                                                     1.5057050f,
+                                                     0.5957050f  };
+
+const std::vector<float> resImg =
+    { resImgR[0], resImgG[0], resImgB[0], resImgA[0],
+      resImgR[1], resImgG[1], resImgB[1], resImgA[1],
+      resImgR[2], resImgG[2], resImgB[2], resImgA[2],
+      resImgR[3], resImgG[3], resImgB[3], resImgA[3],
+      resImgR[4], resImgG[4], resImgB[4], resImgA[4],
+      resImgR[5], resImgG[5], resImgB[5], resImgA[5] };
+
+
+OCIO::ConstCPUProcessorRcPtr BuildCPUProcessor(OCIO::TransformDirection dir)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
+    const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5007f };
+    transform->setOffset(offset4);
+    transform->setDirection(dir);
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor(transform);
+    return processor->getDefaultCPUProcessor();
+}
+
+void Validate(const OCIO::PackedImageDesc & imgDesc, unsigned lineNo)
+{
+    const float * outImg = reinterpret_cast<float*>(imgDesc.getData());
+    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+    {
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f, lineNo);
+    }
+}
+
+void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+             const OCIO::PackedImageDesc & srcImgDesc,
+             OCIO::PackedImageDesc & dstImgDesc,
+             unsigned lineNo)
+{
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
+    Validate(dstImgDesc, lineNo);
+}
+
+void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+             OCIO::PackedImageDesc & imgDesc,
+             unsigned lineNo)
+{
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(imgDesc), lineNo);
+    Validate(imgDesc, lineNo);
+}
+
+void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+             const OCIO::PlanarImageDesc & srcImgDesc,
+             OCIO::PlanarImageDesc & dstImgDesc,
+             unsigned lineNo)
+{
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
+
+    const float * outImgR = reinterpret_cast<float*>(dstImgDesc.getRData());
+    const float * outImgG = reinterpret_cast<float*>(dstImgDesc.getGData());
+    const float * outImgB = reinterpret_cast<float*>(dstImgDesc.getBData());
+    const float * outImgA = reinterpret_cast<float*>(dstImgDesc.getAData());
+
+    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+    {
+        OCIO_CHECK_CLOSE_FROM(outImgR[pxl], resImg[4*pxl+0], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImgG[pxl], resImg[4*pxl+1], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImgB[pxl], resImg[4*pxl+2], 1e-7f, lineNo);
+        if(outImgA)
+        {
+            OCIO_CHECK_CLOSE_FROM(outImgA[pxl], resImg[4*pxl+3], 1e-7f, lineNo);
+        }
+    }
+}
+
+} // anon
+
+
+OCIO_ADD_TEST(CPUProcessor, planar_vs_packed)
 {
-    // The tests validate the image description types when using the same buffer image.
+    // The unit test validates different types for input and output imageDesc.
 
-    const std::string SIMPLE_PROFILE =
-        "ocio_profile_version: 2\n"
-        "\n"
-        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
-        "strictparsing: true\n"
-        "luma: [0.2126, 0.7152, 0.0722]\n"
-        "\n"
-        "roles:\n"
-        "  default: cs1\n"
-        "  scene_linear: cs2\n"
-        "\n"
-        "displays:\n"
-        "  sRGB:\n"
-        "    - !<View> {name: Raw, colorspace: cs1}\n"
-        "\n"
-        "colorspaces:\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs1\n"
-        "    allocation: uniform\n"
-        "\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs2\n"
-        "    allocation: uniform\n";
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
 
-    const std::string strEnd =
-        "    from_reference: !<GroupTransform>\n"
-        "      children:\n"
-        "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0.5] }\n"
-        "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
+    // 1. Process from Packed to Planar Image Desc using the forward transform.
+
+    OCIO::PackedImageDesc srcImgDesc((void*)&inImg[0], NB_PIXELS, 1, 4);
+
+    std::vector<float> outR(NB_PIXELS), outG(NB_PIXELS), outB(NB_PIXELS), outA(NB_PIXELS);
+    OCIO::PlanarImageDesc dstImgDesc((void*)&outR[0], (void*)&outG[0],
+                                     (void*)&outB[0], (void*)&outA[0],
+                                     NB_PIXELS, 1);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+    for(size_t idx=0; idx<NB_PIXELS; ++idx)
+    {
+        OCIO_CHECK_CLOSE(outR[idx], resImg[4*idx+0], 1e-7f);
+        OCIO_CHECK_CLOSE(outG[idx], resImg[4*idx+1], 1e-7f);
+        OCIO_CHECK_CLOSE(outB[idx], resImg[4*idx+2], 1e-7f);
+        OCIO_CHECK_CLOSE(outA[idx], resImg[4*idx+3], 1e-7f);
+    }
+
+    // 2. Process from Planar to Packed Image Desc using the inverse transform.
+
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_INVERSE));
+
+    std::vector<float> outImg(NB_PIXELS*4, -1.0f);
+    OCIO::PackedImageDesc dstImgDesc2((void*)&outImg[0], NB_PIXELS, 1, 4);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(dstImgDesc, dstImgDesc2));
+
+    for(size_t idx=0; idx<(NB_PIXELS*4); ++idx)
+    {
+        OCIO_CHECK_CLOSE(outImg[idx], inImg[idx], 1e-6f);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, bit_packed_image_desc)
+{
+    // The bit-packed image buffers give the same results as the 16-bit containers.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp->setValue(exp4);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(exp));
+
+    // Note: Seven pixels per line to process the SIMD and the scalar paths.
+    constexpr long width     = 7;
+    constexpr long height    = 2;
+    constexpr long numPixels = width * height;
+
+    // 1. 10-bit RGB values.
+
+    std::vector<uint16_t> values(3 * numPixels);
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        values[3 * idx + 0] = uint16_t((idx * 151 +   0) % 1024);
+        values[3 * idx + 1] = uint16_t((idx * 151 + 331) % 1024);
+        values[3 * idx + 2] = uint16_t((idx * 151 + 662) % 1024);
+    }
+
+    // Filled method A in little-endian words & filled method B in big-endian words.
+    std::vector<uint8_t> wordsA(4 * numPixels), wordsB(4 * numPixels);
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const uint32_t r = values[3 * idx + 0];
+        const uint32_t g = values[3 * idx + 1];
+        const uint32_t b = values[3 * idx + 2];
+
+        const uint32_t wordA = (r << 22) | (g << 12) | (b << 2);
+        const uint32_t wordB = (r << 20) | (g << 10) | b;
+
+        for(int byte=0; byte<4; ++byte)
+        {
+            wordsA[4 * idx + byte] = uint8_t(wordA >> (8 * byte));
+            wordsB[4 * idx + byte] = uint8_t(wordB >> (8 * (3 - byte)));
+        }
+    }
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_EXACT));
+
+    OCIO::PackedImageDesc valuesDesc(&values[0], width, height, 3, OCIO::BIT_DEPTH_UINT10,
+                                     sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+
+    std::vector<float> refImg(3 * numPixels);
+    OCIO::PackedImageDesc refImgDesc(&refImg[0], width, height, 3);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(valuesDesc, refImgDesc));
+
+    OCIO::BitPackedImageDesc descA(&wordsA[0], width, height, 3,
+                                   OCIO::BIT_PACKING_10_FILLED_A, false);
+    OCIO::BitPackedImageDesc descB(&wordsB[0], width, height, 3,
+                                   OCIO::BIT_PACKING_10_FILLED_B, true);
+
+    OCIO_CHECK_EQUAL(descA.getBitDepth(), OCIO::BIT_DEPTH_UINT10);
+    OCIO_CHECK_EQUAL(descA.getYStrideBytes(), 4 * width);
+
+    std::vector<float> outImg(3 * numPixels, -1.0f);
+    OCIO::PackedImageDesc outImgDesc(&outImg[0], width, height, 3);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(descA, outImgDesc));
+    OCIO_CHECK_ASSERT(outImg==refImg);
+
+    std::fill(outImg.begin(), outImg.end(), -1.0f);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(descB, outImgDesc));
+    OCIO_CHECK_ASSERT(outImg==refImg);
+
+    // Pack the result of the processing.
+
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_UINT10,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_EXACT));
+
+    std::vector<uint16_t> refValues(3 * numPixels);
+    OCIO::PackedImageDesc refValuesDesc(&refValues[0], width, height, 3, OCIO::BIT_DEPTH_UINT10,
+                                        sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(valuesDesc, refValuesDesc));
+
+    // Note: Process from method A to method B and in place.
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(descA, descB));
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(descA));
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const uint32_t r = refValues[3 * idx + 0];
+        const uint32_t g = refValues[3 * idx + 1];
+        const uint32_t b = refValues[3 * idx + 2];
+
+        const uint32_t wordA = (r << 22) | (g << 12) | (b << 2);
+        const uint32_t wordB = (r << 20) | (g << 10) | b;
+
+        for(int byte=0; byte<4; ++byte)
+        {
+            OCIO_CHECK_EQUAL(wordsA[4 * idx + byte], uint8_t(wordA >> (8 * byte)));
+            OCIO_CHECK_EQUAL(wordsB[4 * idx + byte], uint8_t(wordB >> (8 * (3 - byte))));
+        }
+    }
+
+    // 2. 12-bit RGB values packed in little-endian words.
+
+    // Two pixels i.e. six values in three words (the last one being partially used).
+    const uint16_t values12[6] = { 0x123, 0x456, 0x789, 0xABC, 0xDEF, 0x012 };
+    const uint32_t words12[3]  = { 0x89456123, 0x2DEFABC7, 0x00000001 };
+
+    std::vector<uint8_t> packed12(12, 0xFF);
+    OCIO::BitPackedImageDesc desc12(&packed12[0], 2, 1, 3, OCIO::BIT_PACKING_12_PACKED, false);
+
+    OCIO_CHECK_EQUAL(desc12.getBitDepth(), OCIO::BIT_DEPTH_UINT12);
+    OCIO_CHECK_EQUAL(desc12.getYStrideBytes(), 12);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = config->getProcessor(OCIO::MatrixTransform::Create())
+                ->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT12, OCIO::BIT_DEPTH_UINT12,
+                                           OCIO::OPTIMIZATION_DEFAULT,
+                                           OCIO::FINALIZATION_EXACT));
+
+    OCIO::PackedImageDesc values12Desc((void*)&values12[0], 2, 1, 3, OCIO::BIT_DEPTH_UINT12,
+                                       sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(values12Desc, desc12));
+
+    for(long idx=0; idx<12; ++idx)
+    {
+        OCIO_CHECK_EQUAL(packed12[idx], uint8_t(words12[idx / 4] >> (8 * (idx % 4))));
+    }
+
+    uint16_t unpacked12[6] = { 0 };
+    OCIO::PackedImageDesc unpacked12Desc(&unpacked12[0], 2, 1, 3, OCIO::BIT_DEPTH_UINT12,
+                                         sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc12, unpacked12Desc));
+
+    for(long idx=0; idx<6; ++idx)
+    {
+        OCIO_CHECK_EQUAL(unpacked12[idx], values12[idx]);
+    }
+
+    // 3. Faulty image buffers.
+
+    OCIO_CHECK_THROW_WHAT(OCIO::BitPackedImageDesc(&wordsA[0], width, height, 4,
+                                                   OCIO::BIT_PACKING_10_FILLED_A, false),
+                          OCIO::Exception, "Invalid channel number");
+
+    OCIO_CHECK_THROW_WHAT(OCIO::BitPackedImageDesc(&wordsA[0], width, height, 3,
+                                                   OCIO::BIT_PACKING_10_FILLED_A, false,
+                                                   4 * width - 4),
+                          OCIO::Exception, "Invalid y stride");
+
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(descA),
+                          OCIO::Exception, "Bit-depth mismatch");
+}
+
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed)
+{
+    // Test the packed image description.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> outImg(NB_PIXELS*4);
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], NB_PIXELS, 1, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], NB_PIXELS, 1, 4);
 
-    const std::string str = SIMPLE_PROFILE + strEnd;
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-    std::istringstream is;
-    is.str(str);
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 1, NB_PIXELS, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 1, NB_PIXELS, 4);
 
-    OCIO::ConstConfigRcPtr config;
-    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-    OCIO_CHECK_NO_THROW(config->sanityCheck());
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-    OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3, 4);
 
-    const std::vector<float> f_rInImg =
-        {  -1.0000f,
-            0.1002f,
-            0.5505f,
-            1.0000f,  };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-    const std::vector<float> f_gInImg =
-        {            -0.8000f,
-                      0.2509f,
-                      0.7090f,
-                      1.2500f  };
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 3, 2, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
 
-    const std::vector<float> f_bInImg =
-        {                       -0.1000f,
-                                 0.5009f,
-                                 0.9099f,
-                                 1.9900f  };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-    const std::vector<float> f_aInImg =
-        {                                   0.0f,
-                                            1.0f,
-                                            0.5f,
-                                            0.0f  };
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         OCIO::CHANNEL_ORDERING_RGBA,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         OCIO::AutoStride,
+                                         OCIO::AutoStride);
 
-    const std::vector<float> f_rOutImg
-        = {  0.0f,
-             0.0f,
-             0.15488569f,
-             0.81575858f };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-    const std::vector<float> f_gOutImg
-        = {                0.0f,
-                           0.20273837f,
-                           1.69210147f,
-                          64.0f };
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         OCIO::CHANNEL_ORDERING_RGBA,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         OCIO::AutoStride);
 
-    const std::vector<float> f_bOutImg
-        = {                              0.0f,
-                                         0.24680146f,
-                                         1.90666747f,
-                                        64.0f };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-    const std::vector<float> f_aOutImg
-        = {                                            0.5f,
-                                                       1.5f,
-                                                       1.0f,
-                                                       0.5f };
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         OCIO::AutoStride);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
     {
-        // Packed Image Description with RGBA image.
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         4*sizeof(float),
+                                         OCIO::AutoStride);
 
-        std::vector<float> img =
-            {  f_rInImg[0], f_gInImg[0], f_bInImg[0], f_aInImg[0],
-               f_rInImg[1], f_gInImg[1], f_bInImg[1], f_aInImg[1],
-               f_rInImg[2], f_gInImg[2], f_bInImg[2], f_aInImg[2],
-               f_rInImg[3], f_gInImg[3], f_bInImg[3], f_aInImg[3] };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-        const std::vector<float> res
-            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0], f_aOutImg[0],
-               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1], f_aOutImg[1],
-               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2], f_aOutImg[2],
-               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3], f_aOutImg[3] };
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         4*sizeof(float),
+                                         2*4*sizeof(float));
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-        OCIO::PackedImageDesc desc(&img[0], 2, 2, 4);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         OCIO::AutoStride,
+                                         2*4*sizeof(float));
 
-        for(size_t idx=0; idx<img.size(); ++idx)
-        {
-            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
-        }
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
     }
+}
+
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed_one_buffer)
+{
+    // Now that the previous unit test covers all cases with different buffers,
+    // let's test some cases using the same in and out buffer.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> processingImg(NB_PIXELS*4);
 
     {
-        // Packed Image Description with RGB image.
+        processingImg = inImg;
 
-        std::vector<float> img =
-            {  f_rInImg[0], f_gInImg[0], f_bInImg[0],
-               f_rInImg[1], f_gInImg[1], f_bInImg[1],
-               f_rInImg[2], f_gInImg[2], f_bInImg[2],
-               f_rInImg[3], f_gInImg[3], f_bInImg[3] };
+        OCIO::PackedImageDesc imgDesc(&processingImg[0], NB_PIXELS, 1, 4);
 
-        const std::vector<float> res
-            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0],
-               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1],
-               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2],
-               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3] };
+        Process(cpuProcessor, imgDesc, __LINE__);
+    }
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+    {
+        processingImg = inImg;
 
-        OCIO::PackedImageDesc desc(&img[0], 4, 1, 3);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+        OCIO::PackedImageDesc imgDesc(&processingImg[0], 3, 2, 4);
 
-        for(size_t idx=0; idx<img.size(); ++idx)
-        {
-            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
-        }
+        Process(cpuProcessor, imgDesc, __LINE__);
     }
 
     {
-        // Planar Image Description with R/G/B/A.
+        processingImg = inImg;
 
-        std::vector<float> imgRed   = f_rInImg;
-        std::vector<float> imgGreen = f_gInImg;
-        std::vector<float> imgBlue  = f_bInImg;
-        std::vector<float> imgAlpha = f_aInImg;
+        OCIO::PackedImageDesc imgDesc(&processingImg[0], 1, NB_PIXELS, 4);
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+        Process(cpuProcessor, imgDesc, __LINE__);
+    }
+}
 
-        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], &imgAlpha[0], 2, 2);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_planar)
+{
+    // Test the planar image description.
 
-        for(size_t idx=0; idx<imgRed.size(); ++idx)
-        {
-            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgAlpha[idx], f_aOutImg[idx], 1e-7f);
-        }
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> outImgR(NB_PIXELS);
+    std::vector<float> outImgG(NB_PIXELS);
+    std::vector<float> outImgB(NB_PIXELS);
+    std::vector<float> outImgA(NB_PIXELS);
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
     }
 
     {
-        // Planar Image Description with R/G/B.
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
 
-        std::vector<float> imgRed   = f_rInImg;
-        std::vector<float> imgGreen = f_gInImg;
-        std::vector<float> imgBlue  = f_bInImg;
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
 
-        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], nullptr, 1, 4);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-        for(size_t idx=0; idx<imgRed.size(); ++idx)
-        {
-            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
-        }
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 3, 2);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], 3, 2);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         OCIO::AutoStride);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
     }
-}
 
-namespace
-{
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
 
-constexpr const unsigned NB_PIXELS = 6;
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-std::vector<float> inImgR =
-    {  -1.000012f,
-       -0.500012f,
-        0.100012f,
-        0.600012f,
-        1.102312f,
-        1.700012f  };
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
 
-std::vector<float> inImgG =
-    {              -0.800012f,
-                   -0.300012f,
-                    0.250012f,
-                    0.800012f,
-                    1.204512f,
-                    1.800012f };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-std::vector<float> inImgB =
-    {                          -0.600012f,
-                               -0.100012f,
-                                0.450012f,
-                                0.900012f,
-                                1.508912f,
-                                1.990012f };
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
 
-std::vector<float> inImgA =
-    {                                       0.005005f,
-                                            0.405005f,
-                                            0.905005f,
-                                            0.005005f,
-                                            1.005005f,
-                                            0.095005f  };
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
 
-std::vector<float> inImg =
-    { inImgR[0], inImgG[0], inImgB[0], inImgA[0],
-      inImgR[1], inImgG[1], inImgB[1], inImgA[1],
-      inImgR[2], inImgG[2], inImgB[2], inImgA[2],
-      inImgR[3], inImgG[3], inImgB[3], inImgA[3],
-      inImgR[4], inImgG[4], inImgB[4], inImgA[4],
-      inImgR[5], inImgG[5], inImgB[5], inImgA[5] };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-const std::vector<float> resImgR =
-    {  0.4001879692f,
-       0.9001880288f,
-       1.500211954f,
-       2.000211954f,
-       2.502511978f,
-       3.100212097f };
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
 
-const std::vector<float> resImgG =
-    {                 -0.3995119929f,
-                       0.1004880071f,
-                       0.6505119801f,
-                       1.200511932f,
-                       1.60501194f,
-                       2.200511932f };
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
 
-const std::vector<float> resImgB =
-    {                                 0.2006880045f,
-                                      0.7006880045f,
-                                      1.250712037f,
-                                      1.700711966f,
-                                      2.309612036f,
-                                      2.790712118f };
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-const std::vector<float> resImgA =
-    {                                                0.5057050f,
-                                                     0.9057050f,
-                                                     1.4057050f,
-                                                     0.5057050f,
-                                                     1.5057050f,
-                                                     0.5957050f  };
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
 
-const std::vector<float> resImg =
-    { resImgR[0], resImgG[0], resImgB[0], resImgA[0],
-      resImgR[1], resImgG[1], resImgB[1], resImgA[1],
-      resImgR[2], resImgG[2], resImgB[2], resImgA[2],
-      resImgR[3], resImgG[3], resImgB[3], resImgA[3],
-      resImgR[4], resImgG[4], resImgB[4], resImgA[4],
-      resImgR[5], resImgG[5], resImgB[5], resImgA[5] };
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
 
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-OCIO::ConstCPUProcessorRcPtr BuildCPUProcessor(OCIO::TransformDirection dir)
-{
-    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], nullptr,
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
 
-    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
-    const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5007f };
-    transform->setOffset(offset4);
-    transform->setDirection(dir);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
 
-    OCIO::ConstProcessorRcPtr processor = config->getProcessor(transform);
-    return processor->getDefaultCPUProcessor();
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 }
 
-void Validate(const OCIO::PackedImageDesc & imgDesc, unsigned lineNo)
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_tile)
 {
-    const float * outImg = reinterpret_cast<float*>(imgDesc.getData());
-    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+    // Process tiles.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> outImg(NB_PIXELS*4);
+
     {
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f, lineNo);
-    }
-}
+        // Pixels are { 1, 2, 3,
+        //              4, 5, 6  }
 
-void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-             const OCIO::PackedImageDesc & srcImgDesc,
-             OCIO::PackedImageDesc & dstImgDesc,
-             unsigned lineNo)
-{
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
-    Validate(dstImgDesc, lineNo);
-}
+        // Copy the 1st pixel which should be untouched.
+        outImg[(0 * 4) + 0] = resImg[(0 * 4) + 0];
+        outImg[(0 * 4) + 1] = resImg[(0 * 4) + 1];
+        outImg[(0 * 4) + 2] = resImg[(0 * 4) + 2];
+        outImg[(0 * 4) + 3] = resImg[(0 * 4) + 3];
+        // Copy the 4th pixel which should be untouched.
+        outImg[(3 * 4) + 0] = resImg[(3 * 4) + 0];
+        outImg[(3 * 4) + 1] = resImg[(3 * 4) + 1];
+        outImg[(3 * 4) + 2] = resImg[(3 * 4) + 2];
+        outImg[(3 * 4) + 3] = resImg[(3 * 4) + 3];
 
-void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-             OCIO::PackedImageDesc & imgDesc,
-             unsigned lineNo)
-{
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(imgDesc), lineNo);
-    Validate(imgDesc, lineNo);
-}
+        // Only process the pixels = { 2, 3,
+        //                             5, 6  }
 
-void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-             const OCIO::PlanarImageDesc & srcImgDesc,
-             OCIO::PlanarImageDesc & dstImgDesc,
-             unsigned lineNo)
-{
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
+        OCIO::PackedImageDesc srcImgDesc(&inImg[4],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
 
-    const float * outImgR = reinterpret_cast<float*>(dstImgDesc.getRData());
-    const float * outImgG = reinterpret_cast<float*>(dstImgDesc.getGData());
-    const float * outImgB = reinterpret_cast<float*>(dstImgDesc.getBData());
-    const float * outImgA = reinterpret_cast<float*>(dstImgDesc.getAData());
+        OCIO::PackedImageDesc dstImgDesc(&outImg[4],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
 
-    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
-    {
-        OCIO_CHECK_CLOSE_FROM(outImgR[pxl], resImg[4*pxl+0], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImgG[pxl], resImg[4*pxl+1], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImgB[pxl], resImg[4*pxl+2], 1e-7f, lineNo);
-        if(outImgA)
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
         {
-            OCIO_CHECK_CLOSE_FROM(outImgA[pxl], resImg[4*pxl+3], 1e-7f, lineNo);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
         }
     }
-}
-
-} // anon
-
 
-OCIO_ADD_TEST(CPUProcessor, planar_vs_packed)
-{
-    // The unit test validates different types for input and output imageDesc.
+    {
+        // Pixels are { 1, 2, 3,
+        //              4, 5, 6  }
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+        // Copy the 3rd pixel which should be untouched.
+        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
+        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
+        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
+        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
+        // Copy the 6th pixel which should be untouched.
+        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
+        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
+        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
+        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
 
-    // 1. Process from Packed to Planar Image Desc using the forward transform.
+        // Only process the pixels = { 1, 2,
+        //                             4, 5 }
 
-    OCIO::PackedImageDesc srcImgDesc((void*)&inImg[0], NB_PIXELS, 1, 4);
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
 
-    std::vector<float> outR(NB_PIXELS), outG(NB_PIXELS), outB(NB_PIXELS), outA(NB_PIXELS);
-    OCIO::PlanarImageDesc dstImgDesc((void*)&outR[0], (void*)&outG[0],
-                                     (void*)&outB[0], (void*)&outA[0],
-                                     NB_PIXELS, 1);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
 
-    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
 
-    for(size_t idx=0; idx<NB_PIXELS; ++idx)
     {
-        OCIO_CHECK_CLOSE(outR[idx], resImg[4*idx+0], 1e-7f);
-        OCIO_CHECK_CLOSE(outG[idx], resImg[4*idx+1], 1e-7f);
-        OCIO_CHECK_CLOSE(outB[idx], resImg[4*idx+2], 1e-7f);
-        OCIO_CHECK_CLOSE(outA[idx], resImg[4*idx+3], 1e-7f);
-    }
+        // Pixels are { 1, 2, 3,
+        //              4, 5, 6  }
 
-    // 2. Process from Planar to Packed Image Desc using the inverse transform.
+        outImg = inImg; // Use an in-place image buffer.
 
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_INVERSE));
+        // Copy the 3rd pixel which should be untouched.
+        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
+        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
+        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
+        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
+        // Copy the 6th pixel which should be untouched.
+        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
+        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
+        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
+        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
 
-    std::vector<float> outImg(NB_PIXELS*4, -1.0f);
-    OCIO::PackedImageDesc dstImgDesc2((void*)&outImg[0], NB_PIXELS, 1, 4);
+        // Only process the pixels = { 1, 2,
+        //                             4, 5 }
 
-    OCIO_CHECK_NO_THROW(cpuProcessor->apply(dstImgDesc, dstImgDesc2));
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
 
-    for(size_t idx=0; idx<(NB_PIXELS*4); ++idx)
-    {
-        OCIO_CHECK_CLOSE(outImg[idx], inImg[idx], 1e-6f);
+        Process(cpuProcessor, dstImgDesc, dstImgDesc, __LINE__);
     }
+
 }
 
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed)
+
+OCIO_ADD_TEST(CPUProcessor, custom_scanlines)
 {
-    // Test the packed image description.
+    // Cases testing custom xStrideBytes and yStrideBytes values.
+
+    const float magicNumber = 12345.6789f;
 
     OCIO::ConstCPUProcessorRcPtr cpuProcessor;
     OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
 
-    std::vector<float> outImg(NB_PIXELS*4);
-
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], NB_PIXELS, 1, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], NB_PIXELS, 1, 4);
+        // Pixels are { RGBA, RGBA, RGBA, x,
+        //              RGBA, RGBA, RGBA, x  } where x is not a color channel.
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        std::vector<float> img
+            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3],
+                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7],
+                inImg[ 8], inImg[ 9], inImg[10], inImg[11],
+                magicNumber,
+                inImg[12], inImg[13], inImg[14], inImg[15],
+                inImg[16], inImg[17], inImg[18], inImg[19],
+                inImg[20], inImg[21], inImg[22], inImg[23],
+                magicNumber };
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 1, NB_PIXELS, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 1, NB_PIXELS, 4);
+        OCIO::PackedImageDesc srcImgDesc(&img[0],
+                                         3, 2, 4,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         OCIO::AutoStride,
+                                         // Bytes to the next line.
+                                         3*4*sizeof(float)+sizeof(float));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        std::vector<float> outImg(NB_PIXELS*4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
+        }
     }
 
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 3, 2, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
+        // Pixels are { RxGxBxAx, RxGxBxAx, RxGxBxAx,
+        //              RxGxBxAx, RxGxBxAx, RxGxBxAx  } where x is not a color channel.
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        std::vector<float> img
+            = { inImg[ 0], magicNumber, inImg[ 1], magicNumber, inImg[ 2], magicNumber, inImg[ 3], magicNumber,
+                inImg[ 4], magicNumber, inImg[ 5], magicNumber, inImg[ 6], magicNumber, inImg[ 7], magicNumber,
+                inImg[ 8], magicNumber, inImg[ 9], magicNumber, inImg[10], magicNumber, inImg[11], magicNumber,
+                inImg[12], magicNumber, inImg[13], magicNumber, inImg[14], magicNumber, inImg[15], magicNumber,
+                inImg[16], magicNumber, inImg[17], magicNumber, inImg[18], magicNumber, inImg[19], magicNumber,
+                inImg[20], magicNumber, inImg[21], magicNumber, inImg[22], magicNumber, inImg[23], magicNumber };
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         OCIO::CHANNEL_ORDERING_RGBA,
+        OCIO::PackedImageDesc srcImgDesc(&img[0],  3, 2, 4,
                                          OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
+                                         // Bytes to the next channel.
+                                         sizeof(float)+sizeof(float),
                                          OCIO::AutoStride,
                                          OCIO::AutoStride);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        std::vector<float> outImg(NB_PIXELS*3);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         OCIO::CHANNEL_ORDERING_RGBA,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+        }
     }
 
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
+        // Pixels are { RGBAx, RGBAx, RGBAx,
+        //              RGBAx, RGBAx, RGBAx  } where x is not a color channel.
+
+        std::vector<float> img
+            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
+                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
+                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
+                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
+                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
+                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber };
+
+        OCIO::PackedImageDesc srcImgDesc(&img[0], 3, 2, 4,
                                          OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
+                                         OCIO::AutoStride,
+                                         // Bytes to the next pixel.
+                                         4*sizeof(float)+sizeof(float),
                                          OCIO::AutoStride);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        std::vector<float> outImg(NB_PIXELS*3);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+        }
     }
 
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
+        // Pixels are { RGBAx, RGBAx, RGBAx, x
+        //              RGBAx, RGBAx, RGBAx, x  } where x is not a color channel.
+
+        std::vector<float> img
+            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
+                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
+                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
+                magicNumber,
+                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
+                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
+                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber,
+                magicNumber };
+
+        OCIO::PackedImageDesc srcImgDesc(&img[0],
+                                         3, 2, 4,
                                          OCIO::BIT_DEPTH_F32,
                                          OCIO::AutoStride,
-                                         4*sizeof(float),
-                                         OCIO::AutoStride);
+                                         // Bytes to the next pixel.
+                                         4*sizeof(float)+sizeof(float),
+                                         // Bytes to the next line.
+                                         3*(4*sizeof(float)+sizeof(float))+sizeof(float));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        std::vector<float> outImg(NB_PIXELS*3);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+        }
     }
 
+}
+
+OCIO_ADD_TEST(CPUProcessor, one_pixel)
+{
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    // The CPU Processor only includes a Matrix with offset:
+    //   const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5007f };
+
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         4*sizeof(float),
-                                         2*4*sizeof(float));
+        float pixel[4]{ 0.1f, 0.3f, 0.9f, 1.0f };
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(pixel));
+
+        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
+        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
+        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
+        OCIO_CHECK_EQUAL(pixel[3], 1.0f + 0.5007f);
     }
 
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         OCIO::AutoStride,
-                                         2*4*sizeof(float));
+        float pixel[3]{ 0.1f, 0.3f, 0.9f };
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGB(pixel));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
+        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
+        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
     }
 }
 
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed_one_buffer)
+namespace
 {
-    // Now that the previous unit test covers all cases with different buffers,
-    // let's test some cases using the same in and out buffer.
+
+template<OCIO::BitDepth inBD, OCIO::BitDepth outBD>
+void ComputeImage(unsigned width, unsigned height, unsigned nChannels,
+                   const void * inBuf, void * outBuf,
+                   unsigned line)
+{
+    typedef typename OCIO::BitDepthInfo<inBD>::Type InType;
+    typedef typename OCIO::BitDepthInfo<outBD>::Type OutType;
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
+    const float offset4[4] = { 1.2002f, 0.4005f, 0.8007f, 0.5f };
+    transform->setOffset( offset4 );
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
 
     OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(inBD, outBD,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
 
-    std::vector<float> processingImg(NB_PIXELS*4);
+    const OCIO::PackedImageDesc srcImgDesc((void *)inBuf,
+                                           width, height, nChannels,
+                                           inBD,
+                                           sizeof(InType),
+                                           OCIO::AutoStride,
+                                           OCIO::AutoStride);
 
-    {
-        processingImg = inImg;
+    OCIO::PackedImageDesc dstImgDesc(outBuf,
+                                     width, height, nChannels,
+                                     outBD,
+                                     sizeof(OutType),
+                                     OCIO::AutoStride,
+                                     OCIO::AutoStride);
 
-        OCIO::PackedImageDesc imgDesc(&processingImg[0], NB_PIXELS, 1, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
 
-        Process(cpuProcessor, imgDesc, __LINE__);
-    }
 
-    {
-        processingImg = inImg;
+    const InType * inValues  = (const InType *)inBuf;
+    OutType * outValues = (OutType *)outBuf;
 
-        OCIO::PackedImageDesc imgDesc(&processingImg[0], 3, 2, 4);
+    const float inScale = float(GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32)
+                                    / GetBitDepthMaxValue(inBD));
 
-        Process(cpuProcessor, imgDesc, __LINE__);
-    }
+    const float outScale = float( GetBitDepthMaxValue(outBD)
+                                    / GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32));
 
+    for(size_t idx=0; idx<(width*height);)
     {
-        processingImg = inImg;
+        // Manual computation of the results.
 
-        OCIO::PackedImageDesc imgDesc(&processingImg[0], 1, NB_PIXELS, 4);
+        const float pxl[4]{ (float(inValues[idx+0]) * inScale + offset4[0]) * outScale,
+                            (float(inValues[idx+1]) * inScale + offset4[1]) * outScale,
+                            (float(inValues[idx+2]) * inScale + offset4[2]) * outScale,
+                            nChannels==4 
+                                ? ((float(inValues[idx+3]) * inScale + offset4[3]) * outScale) 
+                                : 0.0f 
+                          };
 
-        Process(cpuProcessor, imgDesc, __LINE__);
+        // Validate all the results.
+
+        if(OCIO::BitDepthInfo<outBD>::isFloat)
+        {
+            OCIO_CHECK_CLOSE_FROM(outValues[idx+0], pxl[0], 1e-6f, line);
+            OCIO_CHECK_CLOSE_FROM(outValues[idx+1], pxl[1], 1e-6f, line);
+            OCIO_CHECK_CLOSE_FROM(outValues[idx+2], pxl[2], 1e-6f, line);
+            if(nChannels==4)
+            {
+                OCIO_CHECK_CLOSE_FROM(outValues[idx+3], pxl[3], 1e-6f, line);
+            }
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL_FROM(outValues[idx+0], OCIO::Converter<outBD>::CastValue(pxl[0]), line);
+            OCIO_CHECK_EQUAL_FROM(outValues[idx+1], OCIO::Converter<outBD>::CastValue(pxl[1]), line);
+            OCIO_CHECK_EQUAL_FROM(outValues[idx+2], OCIO::Converter<outBD>::CastValue(pxl[2]), line);
+            if(nChannels==4)
+            {
+                OCIO_CHECK_EQUAL_FROM(outValues[idx+3], OCIO::Converter<outBD>::CastValue(pxl[3]), line);
+            }
+        }
+
+        idx += nChannels;
     }
 }
 
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_planar)
-{
-    // Test the planar image description.
+}; //anon
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+OCIO_ADD_TEST(CPUProcessor, optimizations)
+{
+    // The unit test validates some 'optimization' paths now implemented
+    // by the ScanlineHelper class. To fully validate these paths a 'normal' image
+    // must be used (i.e. 'few pixels' image is not enough).
 
-    std::vector<float> outImgR(NB_PIXELS);
-    std::vector<float> outImgG(NB_PIXELS);
-    std::vector<float> outImgB(NB_PIXELS);
-    std::vector<float> outImgA(NB_PIXELS);
+    constexpr static const unsigned width     = 640;
+    constexpr static const unsigned height    = 480;
+    constexpr static const unsigned nChannels = 4;
 
+    // Input and Output are not packed RGBA i.e no optimizations.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        std::vector<uint16_t> inBuf(width*height*3);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+        }
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
+        std::vector<uint16_t> outBuf(width*height*3);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, 3,
+                                                                     &inBuf[0], &outBuf[0],
+                                                                     __LINE__);
     }
 
+    // Input and Output are packed RGBA but not F32.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        std::vector<uint16_t> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+        }
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 3, 2);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], 3, 2);
+        std::vector<uint16_t> outBuf(width*height*nChannels);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
+                                                                     &inBuf[0], &outBuf[0],
+                                                                     __LINE__);
     }
 
+    // Input is packed RGBA but not F32, and output is packed RGBA F32.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         OCIO::AutoStride);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        std::vector<uint16_t> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+        }
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
+        std::vector<float> outBuf(width*height*nChannels);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
+                                                                  &inBuf[0], &outBuf[0],
+                                                                  __LINE__);
     }
 
+    // Input is packed RGBA F32, and output is packed RGBA but not F32.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+        std::vector<float> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = float(idx) / float(inBuf.size());
+        }
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        std::vector<uint16_t> outBuf(width*height*nChannels);
+
+        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
+                                                                  &inBuf[0], &outBuf[0],
+                                                                  __LINE__);
     }
 
+    // Input and output are both packed RGBA F32.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+        std::vector<float> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = float(idx) / float(inBuf.size());
+        }
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+        std::vector<float> outBuf(width*height*nChannels);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
+                                                               &inBuf[0], &outBuf[0],
+                                                               __LINE__);
     }
+}
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+OCIO_ADD_TEST(CPUProcessor, statistics)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp->setValue(exp4);
+    group->push_back(exp);
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    group->push_back(log);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double offset4[4] = { 0.1, 0.2, 0.3, 0.0 };
+    matrix->setOffset(offset4);
+    group->push_back(matrix);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
 
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor 
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::OPTIMIZATION_NONE,
+                                              OCIO::FINALIZATION_EXACT));
+
+    // The unpacking, the three ops and the packing.
+    OCIO_REQUIRE_EQUAL(cpuProcessor->getNumStatistics(), 5);
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(0)), "Unpack 8ui");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(1)), "<ExponentOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(2)), "<LogOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(3)), "<MatrixOffsetOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(4)), "Pack 16ui");
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->getStatisticName(5), OCIO::Exception,
+                          "Invalid statistic index 5");
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->getStatisticTime(-1), OCIO::Exception,
+                          "Invalid statistic index -1");
+
+    constexpr static const long width  = 16;
+    constexpr static const long height = 4;
+    constexpr static const long numPixels = width * height;
+
+    std::vector<uint8_t> inImg(numPixels * 4);
+    for (size_t idx = 0; idx < inImg.size(); ++idx)
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], nullptr,
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
+        inImg[idx] = uint8_t(idx % 256);
+    }
+    std::vector<uint16_t> outImg(numPixels * 3);
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+    OCIO::PackedImageDesc srcImgDesc(&inImg[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                     sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc dstImgDesc(&outImg[0], width, height, 3, OCIO::BIT_DEPTH_UINT16,
+                                     sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    // Statistics are opt-in.
+    OCIO_CHECK_ASSERT(!cpuProcessor->isStatisticsEnabled());
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    for (int idx = 0; idx < cpuProcessor->getNumStatistics(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumPixels(idx), 0);
+        OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumBytes(idx), 0);
+        OCIO_CHECK_EQUAL(cpuProcessor->getStatisticTime(idx), 0.0);
     }
-}
 
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_tile)
-{
-    // Process tiles.
+    const std::vector<uint16_t> refImg = outImg;
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(cpuProcessor 
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::OPTIMIZATION_NONE,
+                                              (OCIO::FinalizationFlags)(OCIO::FINALIZATION_EXACT
+                                                  | OCIO::FINALIZATION_STATISTICS)));
+    OCIO_CHECK_ASSERT(cpuProcessor->isStatisticsEnabled());
+    OCIO_REQUIRE_EQUAL(cpuProcessor->getNumStatistics(), 5);
 
-    std::vector<float> outImg(NB_PIXELS*4);
+    std::fill(outImg.begin(), outImg.end(), uint16_t(0));
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    OCIO_CHECK_ASSERT(outImg == refImg);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
 
+    // Unpacking reads 4 x 8-bit channels & writes RGBA float.
+    OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumPixels(0), 2 * numPixels);
+    OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumBytes(0), 2 * numPixels * (4 + 16));
+    for (int idx = 1; idx < 4; ++idx)
     {
-        // Pixels are { 1, 2, 3,
-        //              4, 5, 6  }
+        OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumPixels(idx), 2 * numPixels);
+        OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumBytes(idx), 2 * numPixels * 32);
+        OCIO_CHECK_ASSERT(cpuProcessor->getStatisticTime(idx) >= 0.0);
+    }
+    // Packing reads RGBA float & writes 3 x 16-bit channels.
+    OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumPixels(4), 2 * numPixels);
+    OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumBytes(4), 2 * numPixels * (16 + 6));
+
+    std::ostringstream oss;
+    OCIO_CHECK_NO_THROW(cpuProcessor->serializeStatistics(oss));
+    const std::string json = oss.str();
+    OCIO_CHECK_ASSERT(json.find("\"steps\": [") != std::string::npos);
+    OCIO_CHECK_ASSERT(json.find("{ \"name\": \"<LogOp>\", \"time\": ") != std::string::npos);
+    OCIO_CHECK_ASSERT(json.find("\"pixels\": 128, \"bytes\": 4096 }") != std::string::npos);
+
+    cpuProcessor->resetStatistics();
+    for (int idx = 0; idx < cpuProcessor->getNumStatistics(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(cpuProcessor->getStatisticNumPixels(idx), 0);
+        OCIO_CHECK_EQUAL(cpuProcessor->getStatisticTime(idx), 0.0);
+    }
 
-        // Copy the 1st pixel which should be untouched.
-        outImg[(0 * 4) + 0] = resImg[(0 * 4) + 0];
-        outImg[(0 * 4) + 1] = resImg[(0 * 4) + 1];
-        outImg[(0 * 4) + 2] = resImg[(0 * 4) + 2];
-        outImg[(0 * 4) + 3] = resImg[(0 * 4) + 3];
-        // Copy the 4th pixel which should be untouched.
-        outImg[(3 * 4) + 0] = resImg[(3 * 4) + 0];
-        outImg[(3 * 4) + 1] = resImg[(3 * 4) + 1];
-        outImg[(3 * 4) + 2] = resImg[(3 * 4) + 2];
-        outImg[(3 * 4) + 3] = resImg[(3 * 4) + 3];
+    // A float input fuses the first op into the unpacking step.
+    OCIO_CHECK_NO_THROW(cpuProcessor 
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_NONE,
+                                              OCIO::FINALIZATION_EXACT));
+    OCIO_REQUIRE_EQUAL(cpuProcessor->getNumStatistics(), 3);
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(0)), "Unpack 32f, <ExponentOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(1)), "<LogOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(2)), "Pack 32f, <MatrixOffsetOp>");
+}
 
-        // Only process the pixels = { 2, 3,
-        //                             5, 6  }
+OCIO_ADD_TEST(CPUProcessor, matrix_range_fusion)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        OCIO::PackedImageDesc srcImgDesc(&inImg[4],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp->setValue(exp4);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                                       0.2, 0.7, 0.1, 0.0,
+                                       0.0, 0.3, 0.6, 0.0,
+                                       0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+    constexpr const double offset4[4] = { 0.1, 0.2, 0.3, 0.0 };
+    matrix->setOffset(offset4);
+
+    OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+    range->setMinInValue(0.2);
+    range->setMaxInValue(0.9);
+    range->setMinOutValue(0.1);
+    range->setMaxOutValue(0.8);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(exp);
+    group->push_back(matrix);
+    group->push_back(range);
 
-        OCIO::PackedImageDesc dstImgDesc(&outImg[4],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    // The Range is fused into the Matrix renderer.
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor 
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::OPTIMIZATION_NONE,
+                                              OCIO::FINALIZATION_EXACT));
+    OCIO_REQUIRE_EQUAL(cpuProcessor->getNumStatistics(), 4);
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(1)), "<ExponentOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(2)),
+                     "<MatrixOffsetOp> + <RangeOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(3)), "Pack 16ui");
+
+    OCIO_CHECK_NO_THROW(cpuProcessor 
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_NONE,
+                                              OCIO::FINALIZATION_EXACT));
+    OCIO_REQUIRE_EQUAL(cpuProcessor->getNumStatistics(), 2);
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(0)), "Unpack 32f, <ExponentOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getStatisticName(1)),
+                     "Pack 32f, <MatrixOffsetOp> + <RangeOp>");
+
+    // The fused renderer gives the same results as the separate renderers.
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf  = std::numeric_limits<float>::infinity();
+
+    constexpr static const long numPixels = 6;
+    float img[4 * numPixels] = { 0.00f,  0.10f, 0.20f, 1.0f,
+                                 0.50f,  0.60f, 0.70f, 0.5f,
+                                 0.90f,  1.00f, 1.10f, 0.0f,
+                                 -0.5f,  2.00f, 0.30f, 1.0f,
+                                  qnan,  0.40f, 0.80f, 1.0f,
+                                   inf,  -inf,  0.25f, 1.0f };
+    float ref[4 * numPixels];
+    std::copy(img, img + 4 * numPixels, ref);
+
+    OCIO::PackedImageDesc imgDesc(img, numPixels, 1, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
+
+    for (const OCIO::ConstTransformRcPtr & t : { OCIO::ConstTransformRcPtr(exp),
+                                                 OCIO::ConstTransformRcPtr(matrix),
+                                                 OCIO::ConstTransformRcPtr(range) })
+    {
+        OCIO::ConstCPUProcessorRcPtr proc;
+        OCIO_CHECK_NO_THROW(proc = config->getProcessor(t)->getOptimizedCPUProcessor(
+                                       OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                       OCIO::OPTIMIZATION_NONE,
+                                       OCIO::FINALIZATION_EXACT));
+        OCIO_REQUIRE_EQUAL(proc->getNumStatistics(), 2);
+        OCIO::PackedImageDesc refDesc(ref, numPixels, 1, 4);
+        OCIO_CHECK_NO_THROW(proc->apply(refDesc));
+    }
+
+    for (long idx = 0; idx < 4 * numPixels; ++idx)
+    {
+        if (OCIO::IsNan(ref[idx]))
         {
-            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
+            OCIO_CHECK_ASSERT(OCIO::IsNan(img[idx]));
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL(img[idx], ref[idx]);
         }
     }
+}
 
-    {
-        // Pixels are { 1, 2, 3,
-        //              4, 5, 6  }
+OCIO_ADD_TEST(CPUProcessor, half_domain_lut1d_direct)
+{
+    // A half-domain 1D LUT alone directly processes the packed RGBA F16 images
+    // i.e. the LUT is indexed by the half codes without the F32 intermediate buffer.
 
-        // Copy the 3rd pixel which should be untouched.
-        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
-        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
-        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
-        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
-        // Copy the 6th pixel which should be untouched.
-        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
-        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
-        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
-        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
+    const std::string filePath
+        = std::string(OCIO::getTestFilesDir()) + "/lut1d_half_domain_raw_half_set.clf";
 
-        // Only process the pixels = { 1, 2,
-        //                             4, 5 }
+    OCIO::FileTransformRcPtr transform = OCIO::FileTransform::Create();
+    transform->setSrc(filePath.c_str());
+    transform->setInterpolation(OCIO::INTERP_LINEAR);
 
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    // All the half codes (i.e. including the infinities and the NaNs).
+    constexpr static const long width  = 128;
+    constexpr static const long height = 128;
+    constexpr static const long numValues = width * height * 4;
+
+    std::vector<half> inImg(numValues);
+    for (long idx = 0; idx < numValues; ++idx)
+    {
+        inImg[idx].setBits((unsigned short)idx);
     }
 
+    OCIO::PackedImageDesc srcImgDesc(&inImg[0], width, height, 4, OCIO::BIT_DEPTH_F16,
+                                     sizeof(half), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_ASSERT(srcImgDesc.isRGBAPacked());
+
     {
-        // Pixels are { 1, 2, 3,
-        //              4, 5, 6  }
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F16,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_EXACT));
+
+        std::vector<half> outImg(numValues);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], width, height, 4, OCIO::BIT_DEPTH_F16,
+                                         sizeof(half), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
 
-        outImg = inImg; // Use an in-place image buffer.
+        // The statistics are only available from the generic processing.
+        OCIO::ConstCPUProcessorRcPtr refProcessor;
+        OCIO_CHECK_NO_THROW(refProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F16,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  (OCIO::FinalizationFlags)(OCIO::FINALIZATION_EXACT
+                                                      | OCIO::FINALIZATION_STATISTICS)));
 
-        // Copy the 3rd pixel which should be untouched.
-        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
-        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
-        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
-        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
-        // Copy the 6th pixel which should be untouched.
-        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
-        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
-        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
-        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
+        std::vector<half> refImg(numValues);
+        OCIO::PackedImageDesc refImgDesc(&refImg[0], width, height, 4, OCIO::BIT_DEPTH_F16,
+                                         sizeof(half), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(refProcessor->apply(srcImgDesc, refImgDesc));
 
-        // Only process the pixels = { 1, 2,
-        //                             4, 5 }
+        OCIO_CHECK_EQUAL(memcmp(&outImg[0], &refImg[0], numValues * sizeof(half)), 0);
 
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+        // In-place processing.
+        std::vector<half> img = inImg;
+        OCIO::PackedImageDesc imgDesc(&img[0], width, height, 4, OCIO::BIT_DEPTH_F16,
+                                      sizeof(half), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
 
-        Process(cpuProcessor, dstImgDesc, dstImgDesc, __LINE__);
+        OCIO_CHECK_EQUAL(memcmp(&img[0], &refImg[0], numValues * sizeof(half)), 0);
     }
 
-}
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F32,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_EXACT));
+
+        std::vector<float> outImg(numValues);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
 
+        OCIO::ConstCPUProcessorRcPtr refProcessor;
+        OCIO_CHECK_NO_THROW(refProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F32,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  (OCIO::FinalizationFlags)(OCIO::FINALIZATION_EXACT
+                                                      | OCIO::FINALIZATION_STATISTICS)));
 
-OCIO_ADD_TEST(CPUProcessor, custom_scanlines)
+        std::vector<float> refImg(numValues);
+        OCIO::PackedImageDesc refImgDesc(&refImg[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(refProcessor->apply(srcImgDesc, refImgDesc));
+
+        OCIO_CHECK_EQUAL(memcmp(&outImg[0], &refImg[0], numValues * sizeof(float)), 0);
+    }
+}
+
+namespace
 {
-    // Cases testing custom xStrideBytes and yStrideBytes values.
 
-    const float magicNumber = 12345.6789f;
+template<OCIO::BitDepth inBD, OCIO::BitDepth outBD>
+void ValidateIntegerLookup(OCIO::ConstProcessorRcPtr & processor, unsigned line)
+{
+    typedef typename OCIO::BitDepthInfo<inBD>::Type InType;
+    typedef typename OCIO::BitDepthInfo<outBD>::Type OutType;
 
     OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor
+        = processor->getOptimizedCPUProcessor(inBD, outBD,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_EXACT), line);
+
+    // All the codes of the input bit-depth, with different codes in each channel.
+    constexpr long width = 256;
+    const long numCodes = long(OCIO::BitDepthInfo<inBD>::maxValue) + 1;
+
+    // When the storage type holds more codes than the bit-depth (e.g. a 10-bit image
+    // in 16-bit integers), an extra row mixes in range and out of range codes.
+    const bool outOfRange = numCodes <= long(std::numeric_limits<InType>::max());
+    const long numPixels = outOfRange ? numCodes + width : numCodes;
+    const long height = numPixels / width;
 
+    std::vector<InType> inImg(4 * numPixels);
+    for (long idx = 0; idx < numCodes; ++idx)
     {
-        // Pixels are { RGBA, RGBA, RGBA, x,
-        //              RGBA, RGBA, RGBA, x  } where x is not a color channel.
+        for (long c = 0; c < 4; ++c)
+        {
+            inImg[4 * idx + c] = InType((idx + c * 97) % numCodes);
+        }
+    }
+    for (long idx = numCodes; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            inImg[4 * idx + c] = (idx + c) % 3 == 0
+                ? InType((idx * 7) % numCodes)
+                : InType(std::min(numCodes + (idx - numCodes) * 251 + c,
+                                  long(std::numeric_limits<InType>::max())));
+        }
+    }
 
-        std::vector<float> img
-            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3],
-                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7],
-                inImg[ 8], inImg[ 9], inImg[10], inImg[11],
-                magicNumber,
-                inImg[12], inImg[13], inImg[14], inImg[15],
-                inImg[16], inImg[17], inImg[18], inImg[19],
-                inImg[20], inImg[21], inImg[22], inImg[23],
-                magicNumber };
+    OCIO::PackedImageDesc srcImgDesc(&inImg[0], width, height, 4, inBD,
+                                     sizeof(InType), OCIO::AutoStride, OCIO::AutoStride);
 
-        OCIO::PackedImageDesc srcImgDesc(&img[0],
-                                         3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         OCIO::AutoStride,
-                                         // Bytes to the next line.
-                                         3*4*sizeof(float)+sizeof(float));
+    std::vector<OutType> outImg(4 * numPixels);
+    OCIO::PackedImageDesc dstImgDesc(&outImg[0], width, height, 4, outBD,
+                                     sizeof(OutType), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), line);
 
-        std::vector<float> outImg(NB_PIXELS*4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
+    // The statistics are only available from the generic processing.
+    OCIO::ConstCPUProcessorRcPtr refProcessor;
+    OCIO_CHECK_NO_THROW_FROM(refProcessor
+        = processor->getOptimizedCPUProcessor(inBD, outBD,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              (OCIO::FinalizationFlags)(OCIO::FINALIZATION_EXACT
+                                                  | OCIO::FINALIZATION_STATISTICS)), line);
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    std::vector<OutType> refImg(4 * numPixels);
+    OCIO::PackedImageDesc refImgDesc(&refImg[0], width, height, 4, outBD,
+                                     sizeof(OutType), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW_FROM(refProcessor->apply(srcImgDesc, refImgDesc), line);
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
-        {
-            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
-        }
-    }
+    OCIO_CHECK_EQUAL_FROM(memcmp(&outImg[0], &refImg[0], outImg.size() * sizeof(OutType)),
+                          0, line);
+}
 
-    {
-        // Pixels are { RxGxBxAx, RxGxBxAx, RxGxBxAx,
-        //              RxGxBxAx, RxGxBxAx, RxGxBxAx  } where x is not a color channel.
+}
 
-        std::vector<float> img
-            = { inImg[ 0], magicNumber, inImg[ 1], magicNumber, inImg[ 2], magicNumber, inImg[ 3], magicNumber,
-                inImg[ 4], magicNumber, inImg[ 5], magicNumber, inImg[ 6], magicNumber, inImg[ 7], magicNumber,
-                inImg[ 8], magicNumber, inImg[ 9], magicNumber, inImg[10], magicNumber, inImg[11], magicNumber,
-                inImg[12], magicNumber, inImg[13], magicNumber, inImg[14], magicNumber, inImg[15], magicNumber,
-                inImg[16], magicNumber, inImg[17], magicNumber, inImg[18], magicNumber, inImg[19], magicNumber,
-                inImg[20], magicNumber, inImg[21], magicNumber, inImg[22], magicNumber, inImg[23], magicNumber };
+OCIO_ADD_TEST(CPUProcessor, integer_lookup)
+{
+    // A separable color processing of integer images is a look-up indexed by the
+    // integer codes, giving the same results as the generic processing.
 
-        OCIO::PackedImageDesc srcImgDesc(&img[0],  3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         // Bytes to the next channel.
-                                         sizeof(float)+sizeof(float),
-                                         OCIO::AutoStride,
-                                         OCIO::AutoStride);
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        std::vector<float> outImg(NB_PIXELS*3);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.2, 2.4, 2.6, 1.0 };
+    exp->setValue(exp4);
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double m44[16] = { 0.9, 0.0, 0.0, 0.0,
+                                       0.0, 1.1, 0.0, 0.0,
+                                       0.0, 0.0, 0.8, 0.0,
+                                       0.0, 0.0, 0.0, 0.5 };
+    matrix->setMatrix(m44);
+    constexpr const double offset4[4] = { 0.01, -0.02, 0.03, 0.0 };
+    matrix->setOffset(offset4);
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
-        {
-            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
-        }
+    OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+    range->setMinInValue(0.0);
+    range->setMinOutValue(0.0);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(exp);
+    group->push_back(matrix);
+    group->push_back(range);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT8,  OCIO::BIT_DEPTH_UINT8 >(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT8,  OCIO::BIT_DEPTH_UINT16>(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT8,  OCIO::BIT_DEPTH_F32   >(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_UINT10>(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_F32   >(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT12, OCIO::BIT_DEPTH_F16   >(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT8 >(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F16   >(processor, __LINE__);
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32   >(processor, __LINE__);
+
+    // A color processing with channel crosstalk keeps the generic processing.
+    OCIO::MatrixTransformRcPtr mix = OCIO::MatrixTransform::Create();
+    constexpr const double mix44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                         0.1, 0.8, 0.1, 0.0,
+                                         0.1, 0.1, 0.8, 0.0,
+                                         0.0, 0.0, 0.0, 1.0 };
+    mix->setMatrix(mix44);
+    group->push_back(mix);
+
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    ValidateIntegerLookup<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(processor, __LINE__);
+
+    // The generic processing also clamps the out of range codes.
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = OCIO::Config::Create()->getProcessor(mix)->getOptimizedCPUProcessor(
+            OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_F32,
+            OCIO::OPTIMIZATION_DEFAULT, OCIO::FINALIZATION_EXACT));
+
+    uint16_t codes[8] = { 1023, 1023, 1023, 1023,  2000, 1024, 65535, 4095 };
+    float values[8];
+    OCIO::PackedImageDesc srcImgDesc(codes, 2, 1, 4, OCIO::BIT_DEPTH_UINT10,
+                                     sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc dstImgDesc(values, 2, 1, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+    for (size_t idx = 0; idx < 4; ++idx)
+    {
+        OCIO_CHECK_EQUAL(values[idx + 4], values[idx]);
     }
+}
+
+OCIO_ADD_TEST(CPUProcessor, premultiplied_alpha)
+{
+    // The color values of a premultiplied image are processed as straight color values
+    // (i.e. divided by alpha) and then premultiplied by the processed alpha.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.0, 2.0, 2.0, 1.0 };
+    exp->setValue(exp4);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double m44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                       0.1, 0.8, 0.1, 0.0,
+                                       0.1, 0.1, 0.8, 0.0,
+                                       0.0, 0.0, 0.0, 0.9 };
+    matrix->setMatrix(m44);
+    constexpr const double offset4[4] = { 0.01, 0.02, 0.03, 0.0 };
+    matrix->setOffset(offset4);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(exp);
+    group->push_back(matrix);
 
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    constexpr long numPixels = 4;
+    const std::vector<float> inImg = { 0.25f, 0.50f, 0.125f, 0.50f,
+                                       0.10f, 0.20f, 0.300f, 0.00f,  // Fully transparent.
+                                       0.80f, 0.60f, 0.400f, 1.00f,
+                                       0.05f, 0.10f, 0.150f, 0.25f };
+
+    // Process the straight color values.
+    std::vector<float> resImg(inImg);
+    for(long idx=0; idx<numPixels; ++idx)
     {
-        // Pixels are { RGBAx, RGBAx, RGBAx,
-        //              RGBAx, RGBAx, RGBAx  } where x is not a color channel.
+        float * pix = &resImg[4 * idx];
+        const float alpha = pix[3];
 
-        std::vector<float> img
-            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
-                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
-                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
-                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
-                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
-                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber };
+        if(alpha > 0.0f)
+        {
+            pix[0] /= alpha;
+            pix[1] /= alpha;
+            pix[2] /= alpha;
 
-        OCIO::PackedImageDesc srcImgDesc(&img[0], 3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         // Bytes to the next pixel.
-                                         4*sizeof(float)+sizeof(float),
-                                         OCIO::AutoStride);
+            cpuProcessor->applyRGBA(pix);
+
+            pix[0] *= pix[3];
+            pix[1] *= pix[3];
+            pix[2] *= pix[3];
+        }
+    }
 
-        std::vector<float> outImg(NB_PIXELS*3);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+    // 1. 32-bit float images i.e. the first and last ops are fused into the bit-depth
+    //    conversions of the straight processing.
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    std::vector<float> outImg(4 * numPixels, -1.0f);
+    OCIO::PackedImageDesc srcImgDesc((void*)&inImg[0], numPixels, 1, 4);
+    OCIO::PackedImageDesc dstImgDesc(&outImg[0], numPixels, 1, 4);
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
-        {
-            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
-        }
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc, OCIO::ALPHA_PREMULTIPLIED));
+
+    for(long idx=0; idx<4*numPixels; ++idx)
+    {
+        OCIO_CHECK_CLOSE(outImg[idx], resImg[idx], 1e-6f);
     }
 
+    outImg = inImg;
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(dstImgDesc, OCIO::ALPHA_PREMULTIPLIED));
+
+    for(long idx=0; idx<4*numPixels; ++idx)
     {
-        // Pixels are { RGBAx, RGBAx, RGBAx, x
-        //              RGBAx, RGBAx, RGBAx, x  } where x is not a color channel.
+        OCIO_CHECK_CLOSE(outImg[idx], resImg[idx], 1e-6f);
+    }
 
-        std::vector<float> img
-            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
-                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
-                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
-                magicNumber,
-                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
-                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
-                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber,
-                magicNumber };
+    // 2. 16-bit integer images.
 
-        OCIO::PackedImageDesc srcImgDesc(&img[0],
-                                         3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         // Bytes to the next pixel.
-                                         4*sizeof(float)+sizeof(float),
-                                         // Bytes to the next line.
-                                         3*(4*sizeof(float)+sizeof(float))+sizeof(float));
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_EXACT));
 
-        std::vector<float> outImg(NB_PIXELS*3);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+    std::vector<uint16_t> inImg16(4 * numPixels), outImg16(4 * numPixels);
+    for(long idx=0; idx<4*numPixels; ++idx)
+    {
+        inImg16[idx] = uint16_t(inImg[idx] * 65535.0f + 0.5f);
+    }
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    OCIO::PackedImageDesc srcImgDesc16(&inImg16[0], numPixels, 1, 4, OCIO::BIT_DEPTH_UINT16,
+                                       sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc dstImgDesc16(&outImg16[0], numPixels, 1, 4, OCIO::BIT_DEPTH_UINT16,
+                                       sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
-        {
-            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
-        }
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc16, dstImgDesc16,
+                                            OCIO::ALPHA_PREMULTIPLIED));
+
+    for(long idx=0; idx<4*numPixels; ++idx)
+    {
+        OCIO_CHECK_CLOSE(outImg16[idx] / 65535.0f, resImg[idx], 2e-5f);
     }
 
+    // 3. Without alpha, the color values are not premultiplied.
+
+    std::vector<float> rgbImg = { 0.25f, 0.5f, 0.125f, 0.8f, 0.6f, 0.4f };
+    std::vector<float> rgbRes(rgbImg), rgbOut(rgbImg.size(), -1.0f);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    OCIO::PackedImageDesc rgbResDesc(&rgbRes[0], 2, 1, 3);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(rgbResDesc));
+
+    OCIO::PackedImageDesc rgbImgDesc(&rgbImg[0], 2, 1, 3);
+    OCIO::PackedImageDesc rgbOutDesc(&rgbOut[0], 2, 1, 3);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(rgbImgDesc, rgbOutDesc, OCIO::ALPHA_PREMULTIPLIED));
+
+    OCIO_CHECK_ASSERT(rgbOut==rgbRes);
 }
 
-OCIO_ADD_TEST(CPUProcessor, one_pixel)
+OCIO_ADD_TEST(CPUProcessor, alpha_pass_through)
 {
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    // When the ops leave the alpha channel unchanged, the alpha values of an in-place
+    // image buffer are not packed back.
 
-    // The CPU Processor only includes a Matrix with offset:
-    //   const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5007f };
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double m44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                       0.1, 0.8, 0.1, 0.0,
+                                       0.1, 0.1, 0.8, 0.0,
+                                       0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+
+    constexpr long numPixels = 3;
+    const std::vector<uint16_t> inImg = {     0, 16384, 32768,     0,
+                                          65535, 50000, 10000, 40000,
+                                          20000, 30000, 40000, 65535 };
 
+    for(int alphaExp=1; alphaExp<=2; ++alphaExp)
     {
-        float pixel[4]{ 0.1f, 0.3f, 0.9f, 1.0f };
+        OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+        const double exp4[4] = { 2.0, 2.0, 2.0, double(alphaExp) };
+        exp->setValue(exp4);
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(pixel));
+        OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+        group->push_back(exp);
+        group->push_back(matrix);
 
-        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
-        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
-        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
-        OCIO_CHECK_EQUAL(pixel[3], 1.0f + 0.5007f);
-    }
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16,
+                                                  OCIO::BIT_DEPTH_UINT16,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_EXACT));
+
+        // Process a packed RGBA image buffer.
+        std::vector<uint16_t> resImg(inImg);
+        OCIO::PackedImageDesc resImgDesc(&resImg[0], numPixels, 1, 4,
+                                         OCIO::BIT_DEPTH_UINT16, sizeof(uint16_t),
+                                         OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(resImgDesc));
+
+        // Process in-place the same image buffer but with a planar layout.
+        std::vector<uint16_t> r(numPixels), g(numPixels), b(numPixels), a(numPixels);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            r[idx] = inImg[4 * idx + 0];
+            g[idx] = inImg[4 * idx + 1];
+            b[idx] = inImg[4 * idx + 2];
+            a[idx] = inImg[4 * idx + 3];
+        }
 
-    {
-        float pixel[3]{ 0.1f, 0.3f, 0.9f };
+        OCIO::PlanarImageDesc imgDesc(&r[0], &g[0], &b[0], &a[0], numPixels, 1,
+                                      OCIO::BIT_DEPTH_UINT16, sizeof(uint16_t),
+                                      OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGB(pixel));
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            OCIO_CHECK_EQUAL(r[idx], resImg[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(g[idx], resImg[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(b[idx], resImg[4 * idx + 2]);
+            OCIO_CHECK_EQUAL(a[idx], resImg[4 * idx + 3]);
 
-        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
-        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
-        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
+            if(alphaExp==1)
+            {
+                OCIO_CHECK_EQUAL(a[idx], inImg[4 * idx + 3]);
+            }
+        }
+
+        if(alphaExp==2)
+        {
+            // The alpha is squared.
+            OCIO_CHECK_EQUAL(a[1], 24414);
+        }
     }
 }
 
-namespace
-{
-
-template<OCIO::BitDepth inBD, OCIO::BitDepth outBD>
-void ComputeImage(unsigned width, unsigned height, unsigned nChannels,
-                   const void * inBuf, void * outBuf,
-                   unsigned line)
+OCIO_ADD_TEST(CPUProcessor, run_detection)
 {
-    typedef typename OCIO::BitDepthInfo<inBD>::Type InType;
-    typedef typename OCIO::BitDepthInfo<outBD>::Type OutType;
+    // The runs of identical pixels are only processed once, with the same results.
 
     OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
-    const float offset4[4] = { 1.2002f, 0.4005f, 0.8007f, 0.5f };
-    transform->setOffset( offset4 );
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp->setValue(exp4);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double m44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                       0.1, 0.8, 0.1, 0.0,
+                                       0.1, 0.1, 0.8, 0.0,
+                                       0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+    constexpr const double offset4[4] = { 0.01, 0.02, 0.03, 0.0 };
+    matrix->setOffset(offset4);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(exp);
+    group->push_back(matrix);
 
     OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
 
     OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+    OCIO_CHECK_ASSERT(!cpuProcessor->isRunDetectionEnabled());
+
+    const OCIO::FinalizationFlags runFlags
+        = (OCIO::FinalizationFlags)(OCIO::FINALIZATION_EXACT | OCIO::FINALIZATION_RUN_DETECTION);
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+
+    constexpr long width  = 6;
+    constexpr long height = 3;
+    const std::vector<float> inImg
+        = { // A black bar.
+            0.0f, 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 0.0f, 1.0f,
+            0.0f, 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 0.0f, 1.0f,
+            // A few runs, including NaNs.
+            0.0f, 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 0.0f, 1.0f,  qnan, 0.4f, 0.3f, 0.5f,
+            qnan, 0.4f, 0.3f, 0.5f,  0.5f, 0.4f, 0.3f, 1.0f,  0.5f, 0.4f, 0.3f, 1.0f,
+            // Too many runs i.e. the line is processed as usual.
+            0.1f, 0.2f, 0.3f, 1.0f,  0.2f, 0.3f, 0.4f, 1.0f,  0.3f, 0.4f, 0.5f, 1.0f,
+            0.4f, 0.5f, 0.6f, 1.0f,  0.4f, 0.5f, 0.6f, 1.0f,  0.6f, 0.7f, 0.8f, 0.5f };
+
+    std::vector<float> resImg(inImg);
+    OCIO::PackedImageDesc resImgDesc(&resImg[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(resImgDesc));
+    OCIO_CHECK_EQUAL(cpuProcessor->getRunDetectionNumLines(), 0);
+
+    // Note: The first & last ops of the chain are also processed once per run.
     OCIO_CHECK_NO_THROW(cpuProcessor
-        = processor->getOptimizedCPUProcessor(inBD, outBD,
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT, runFlags));
+    OCIO_CHECK_ASSERT(cpuProcessor->isRunDetectionEnabled());
+
+    std::vector<float> outImg(inImg.size(), -1.0f);
+    OCIO::PackedImageDesc srcImgDesc((void*)&inImg[0], width, height, 4);
+    OCIO::PackedImageDesc dstImgDesc(&outImg[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+    // The last line has too many runs.
+    OCIO_CHECK_EQUAL(cpuProcessor->getRunDetectionNumLines(), 2);
+    cpuProcessor->resetStatistics();
+    OCIO_CHECK_EQUAL(cpuProcessor->getRunDetectionNumLines(), 0);
+
+    for(size_t idx=0; idx<inImg.size(); ++idx)
+    {
+        if(OCIO::IsNan(resImg[idx]))
+        {
+            OCIO_CHECK_ASSERT(OCIO::IsNan(outImg[idx]));
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL(outImg[idx], resImg[idx]);
+        }
+    }
+
+    // The integer images.
+
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT8,
                                               OCIO::OPTIMIZATION_DEFAULT,
-                                              OCIO::FINALIZATION_DEFAULT));
+                                              OCIO::FINALIZATION_EXACT));
 
-    const OCIO::PackedImageDesc srcImgDesc((void *)inBuf,
-                                           width, height, nChannels,
-                                           inBD,
-                                           sizeof(InType),
-                                           OCIO::AutoStride,
-                                           OCIO::AutoStride);
+    std::vector<uint16_t> inImg16(inImg.size());
+    for(size_t idx=0; idx<inImg.size(); ++idx)
+    {
+        inImg16[idx] = OCIO::IsNan(inImg[idx]) ? 0 : uint16_t(inImg[idx] * 65535.0f + 0.5f);
+    }
 
-    OCIO::PackedImageDesc dstImgDesc(outBuf,
-                                     width, height, nChannels,
-                                     outBD,
-                                     sizeof(OutType),
-                                     OCIO::AutoStride,
-                                     OCIO::AutoStride);
+    OCIO::PackedImageDesc srcImgDesc16(&inImg16[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                       sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
 
-    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    std::vector<uint8_t> resImg8(inImg.size()), outImg8(inImg.size());
+    OCIO::PackedImageDesc resImgDesc8(&resImg8[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc16, resImgDesc8));
 
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT8,
+                                              OCIO::OPTIMIZATION_DEFAULT, runFlags));
 
-    const InType * inValues  = (const InType *)inBuf;
-    OutType * outValues = (OutType *)outBuf;
+    OCIO::PackedImageDesc outImgDesc8(&outImg8[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc16, outImgDesc8));
+    OCIO_CHECK_EQUAL(cpuProcessor->getRunDetectionNumLines(), 2);
 
-    const float inScale = float(GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32)
-                                    / GetBitDepthMaxValue(inBD));
+    OCIO_CHECK_ASSERT(outImg8==resImg8);
 
-    const float outScale = float( GetBitDepthMaxValue(outBD)
-                                    / GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32));
+    // A single op chain.
 
-    for(size_t idx=0; idx<(width*height);)
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(exp));
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT, runFlags));
+
+    resImg = inImg;
+    OCIO_CHECK_NO_THROW(processor->getDefaultCPUProcessor()->apply(resImgDesc));
+
+    outImg.assign(inImg.size(), -1.0f);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    OCIO_CHECK_EQUAL(cpuProcessor->getRunDetectionNumLines(), 2);
+
+    for(size_t idx=0; idx<inImg.size(); ++idx)
     {
-        // Manual computation of the results.
+        if(!OCIO::IsNan(resImg[idx]))
+        {
+            OCIO_CHECK_EQUAL(outImg[idx], resImg[idx]);
+        }
+    }
+}
 
-        const float pxl[4]{ (float(inValues[idx+0]) * inScale + offset4[0]) * outScale,
-                            (float(inValues[idx+1]) * inScale + offset4[1]) * outScale,
-                            (float(inValues[idx+2]) * inScale + offset4[2]) * outScale,
-                            nChannels==4 
-                                ? ((float(inValues[idx+3]) * inScale + offset4[3]) * outScale) 
-                                : 0.0f 
-                          };
+OCIO_ADD_TEST(CPUProcessor, constant_fill)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        // Validate all the results.
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp->setValue(exp4);
 
-        if(OCIO::BitDepthInfo<outBD>::isFloat)
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double m44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                       0.1, 0.8, 0.1, 0.0,
+                                       0.1, 0.1, 0.8, 0.0,
+                                       0.0, 0.0, 0.0, 0.5 };
+    matrix->setMatrix(m44);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(exp);
+    group->push_back(matrix);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    const float color[4] = { 0.5f, 0.25f, 0.75f, 0.8f };
+
+    float res[4] = { color[0], color[1], color[2], color[3] };
+    OCIO_CHECK_NO_THROW(processor->getDefaultCPUProcessor()->applyRGBA(res));
+
+    constexpr long width  = 5;
+    constexpr long height = 3;
+
+    // 1. Packed RGBA 16-bit integer image (i.e. whatever the input bit-depth).
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT16,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_EXACT));
+
+        std::vector<uint16_t> img(4 * width * height, 0);
+        OCIO::PackedImageDesc imgDesc(&img[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyConstantRGBA(color, imgDesc));
+
+        for(long idx=0; idx<width*height; ++idx)
         {
-            OCIO_CHECK_CLOSE_FROM(outValues[idx+0], pxl[0], 1e-6f, line);
-            OCIO_CHECK_CLOSE_FROM(outValues[idx+1], pxl[1], 1e-6f, line);
-            OCIO_CHECK_CLOSE_FROM(outValues[idx+2], pxl[2], 1e-6f, line);
-            if(nChannels==4)
+            for(long c=0; c<4; ++c)
             {
-                OCIO_CHECK_CLOSE_FROM(outValues[idx+3], pxl[3], 1e-6f, line);
+                OCIO_CHECK_EQUAL(img[4 * idx + c], uint16_t(res[c] * 65535.0f + 0.5f));
             }
         }
-        else
+    }
+
+    // 2. Planar RGB 32-bit float image with a line padding.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+        constexpr long yStride = width + 2;
+        std::vector<float> r(yStride * height, -1.0f);
+        std::vector<float> g(yStride * height, -1.0f);
+        std::vector<float> b(yStride * height, -1.0f);
+
+        OCIO::PlanarImageDesc imgDesc(&r[0], &g[0], &b[0], nullptr, width, height,
+                                      OCIO::BIT_DEPTH_F32, sizeof(float),
+                                      yStride * sizeof(float));
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyConstantRGBA(color, imgDesc));
+
+        for(long y=0; y<height; ++y)
         {
-            OCIO_CHECK_EQUAL_FROM(outValues[idx+0], OCIO::Converter<outBD>::CastValue(pxl[0]), line);
-            OCIO_CHECK_EQUAL_FROM(outValues[idx+1], OCIO::Converter<outBD>::CastValue(pxl[1]), line);
-            OCIO_CHECK_EQUAL_FROM(outValues[idx+2], OCIO::Converter<outBD>::CastValue(pxl[2]), line);
-            if(nChannels==4)
+            for(long x=0; x<yStride; ++x)
             {
-                OCIO_CHECK_EQUAL_FROM(outValues[idx+3], OCIO::Converter<outBD>::CastValue(pxl[3]), line);
+                const long idx = y * yStride + x;
+                if(x<width)
+                {
+                    OCIO_CHECK_CLOSE(r[idx], res[0], 1e-6f);
+                    OCIO_CHECK_CLOSE(g[idx], res[1], 1e-6f);
+                    OCIO_CHECK_CLOSE(b[idx], res[2], 1e-6f);
+                }
+                else
+                {
+                    // The padding is untouched.
+                    OCIO_CHECK_EQUAL(r[idx], -1.0f);
+                    OCIO_CHECK_EQUAL(g[idx], -1.0f);
+                    OCIO_CHECK_EQUAL(b[idx], -1.0f);
+                }
             }
         }
-
-        idx += nChannels;
     }
 }
 
-}; //anon
-
-OCIO_ADD_TEST(CPUProcessor, optimizations)
+OCIO_ADD_TEST(CPUProcessor, color_cache)
 {
-    // The unit test validates some 'optimization' paths now implemented
-    // by the ScanlineHelper class. To fully validate these paths a 'normal' image
-    // must be used (i.e. 'few pixels' image is not enough).
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-    constexpr static const unsigned width     = 640;
-    constexpr static const unsigned height    = 480;
-    constexpr static const unsigned nChannels = 4;
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    constexpr const double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp->setValue(exp4);
 
-    // Input and Output are not packed RGBA i.e no optimizations.
-    {
-        std::vector<uint16_t> inBuf(width*height*3);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
-        {
-            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
-        }
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr const double m44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                       0.1, 0.8, 0.1, 0.0,
+                                       0.1, 0.1, 0.8, 0.0,
+                                       0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
 
-        std::vector<uint16_t> outBuf(width*height*3);
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(exp);
+    group->push_back(matrix);
 
-        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, 3,
-                                                                     &inBuf[0], &outBuf[0],
-                                                                     __LINE__);
-    }
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
 
-    // Input and Output are packed RGBA but not F32.
+    OCIO::ConstCPUProcessorRcPtr refProcessor;
+    OCIO_CHECK_NO_THROW(refProcessor = processor->getDefaultCPUProcessor());
+    OCIO_CHECK_ASSERT(!refProcessor->isColorCacheEnabled());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              (OCIO::FinalizationFlags)(OCIO::FINALIZATION_DEFAULT
+                                                  | OCIO::FINALIZATION_COLOR_CACHE)));
+    OCIO_CHECK_ASSERT(cpuProcessor->isColorCacheEnabled());
+
+    // 1. An image with a palette of 8 colors (without any run of identical pixels).
     {
-        std::vector<uint16_t> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        constexpr long width  = 64;
+        constexpr long height = 4;
+
+        std::vector<float> img(4 * width * height);
+        for(long idx=0; idx<width*height; ++idx)
         {
-            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+            const long color = idx % 8;
+            img[4 * idx + 0] = 0.1f * float(color & 1) + 0.05f;
+            img[4 * idx + 1] = 0.2f * float((color >> 1) & 1) + 0.05f;
+            img[4 * idx + 2] = 0.3f * float((color >> 2) & 1) + 0.05f;
+            img[4 * idx + 3] = 1.0f;
         }
 
-        std::vector<uint16_t> outBuf(width*height*nChannels);
+        std::vector<float> ref(img);
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(refProcessor->apply(refDesc));
 
-        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
-                                                                     &inBuf[0], &outBuf[0],
-                                                                     __LINE__);
-    }
+        OCIO::PackedImageDesc imgDesc(&img[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
 
-    // Input is packed RGBA but not F32, and output is packed RGBA F32.
-    {
-        std::vector<uint16_t> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        for(size_t idx=0; idx<img.size(); ++idx)
         {
-            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+            OCIO_CHECK_CLOSE(img[idx], ref[idx], 1e-6f);
         }
 
-        std::vector<float> outBuf(width*height*nChannels);
-
-        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
-                                                                  &inBuf[0], &outBuf[0],
-                                                                  __LINE__);
+        // The colors of the first line are all processed as the cache is only
+        // updated once a line is processed.
+        OCIO_CHECK_EQUAL(cpuProcessor->getColorCacheNumLookups(), width * height);
+        OCIO_CHECK_EQUAL(cpuProcessor->getColorCacheNumHits(), width * (height - 1));
     }
 
-    // Input is packed RGBA F32, and output is packed RGBA but not F32.
+    cpuProcessor->resetStatistics();
+    OCIO_CHECK_EQUAL(cpuProcessor->getColorCacheNumLookups(), 0);
+    OCIO_CHECK_EQUAL(cpuProcessor->getColorCacheNumHits(), 0);
+
+    // 2. An image without any repeated color i.e. the cache is bypassed.
     {
-        std::vector<float> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        constexpr long width  = 128;
+        constexpr long height = 64;
+
+        std::vector<float> img(4 * width * height);
+        for(long idx=0; idx<width*height; ++idx)
         {
-            inBuf[idx] = float(idx) / float(inBuf.size());
+            img[4 * idx + 0] = float(idx) / float(width * height);
+            img[4 * idx + 1] = 0.5f;
+            img[4 * idx + 2] = 1.0f - float(idx) / float(width * height);
+            img[4 * idx + 3] = 1.0f;
         }
 
-        std::vector<uint16_t> outBuf(width*height*nChannels);
+        std::vector<float> ref(img);
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(refProcessor->apply(refDesc));
 
-        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
-                                                                  &inBuf[0], &outBuf[0],
-                                                                  __LINE__);
-    }
+        OCIO::PackedImageDesc imgDesc(&img[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
 
-    // Input and output are both packed RGBA F32.
-    {
-        std::vector<float> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        for(size_t idx=0; idx<img.size(); ++idx)
         {
-            inBuf[idx] = float(idx) / float(inBuf.size());
+            OCIO_CHECK_CLOSE(img[idx], ref[idx], 1e-6f);
         }
 
-        std::vector<float> outBuf(width*height*nChannels);
-
-        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
-                                                               &inBuf[0], &outBuf[0],
-                                                               __LINE__);
+        // The cache stops being used after 4096 lookups without any hit.
+        OCIO_CHECK_EQUAL(cpuProcessor->getColorCacheNumLookups(), 4096);
+        OCIO_CHECK_EQUAL(cpuProcessor->getColorCacheNumHits(), 0);
     }
 }
 
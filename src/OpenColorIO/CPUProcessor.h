@@ -6,6 +6,8 @@
 #define INCLUDED_OCIO_CPUPROCESSOR_H
 
 
+#include <atomic>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Op.h"
@@ -16,6 +18,17 @@ OCIO_NAMESPACE_ENTER
 
 class ScanlineHelper;
 
+// Accumulated statistics of one processing step of the CPU processor.
+struct CPUProcessorStatistic
+{
+    std::string m_name;         // Description of the processing step.
+    double      m_time = 0.0;   // Wall time in seconds.
+    long long   m_numPixels = 0;
+    long long   m_numBytes = 0; // Bytes read & written.
+};
+
+typedef std::vector<CPUProcessorStatistic> CPUProcessorStatistics;
+
 class CPUProcessor::Impl
 {
 public:
@@ -34,14 +47,33 @@ public:
 
     DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
 
-    void apply(ImageDesc & imgDesc) const;
-    void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
+    void apply(ImageDesc & imgDesc, AlphaMode alphaMode) const;
+    void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc, AlphaMode alphaMode) const;
 
     // Note that the method only accepts one packed RGB and 32-bit float pixel.
     void applyRGB(float * pixel) const;
     // Note that the method only accepts one packed RGBA and 32-bit float pixel.
     void applyRGBA(float * pixel) const;
 
+    void applyConstantRGBA(const float * pixel, ImageDesc & dstImgDesc) const;
+
+    bool isRunDetectionEnabled() const noexcept { return m_runDetectionEnabled; }
+    long long getRunDetectionNumLines() const noexcept { return m_runDetectionNumLines; }
+
+    bool isColorCacheEnabled() const noexcept { return m_colorCacheEnabled; }
+    long long getColorCacheNumLookups() const noexcept { return m_colorCacheNumLookups; }
+    long long getColorCacheNumHits() const noexcept { return m_colorCacheNumHits; }
+
+    bool isStatisticsEnabled() const noexcept { return m_statisticsEnabled; }
+    void resetStatistics() const;
+
+    int getNumStatistics() const noexcept { return (int)m_statistics.size(); }
+    const char * getStatisticName(int index) const;
+    // Note that the method returns a copy as apply() could update the statistics.
+    CPUProcessorStatistic getStatistic(int index) const;
+
+    void serializeStatistics(std::ostream & os) const;
+
     ////////////////////////////////////////////
     //
     // Functions not exposed to the OCIO public API.
@@ -50,17 +82,67 @@ public:
                   BitDepth in, BitDepth out,
                   OptimizationFlags oFlags, FinalizationFlags fFlags);
 
+protected:
+    // Process all the scanlines of the image with the CPU ops.
+    void applyScanlines(ScanlineHelper & scanlineBuilder, const ConstOpCPURcPtrVec & cpuOps) const;
+
+    // Process the image while recording the statistics of each step.
+    void applyWithStatistics(ScanlineHelper & scanlineBuilder,
+                             size_t inPixelBytes, size_t outPixelBytes) const;
+
+    const CPUProcessorStatistic & getStatisticRef(int index) const;
+
+    // Process the packed RGBA image buffers with the direct op, if any.  Returns false
+    // when the generic processing is needed.
+    bool applyDirect(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
+
+    // Process the images using the generic processing (e.g. when the color channels are
+    // premultiplied by alpha, or when the run detection or the color cache covers the
+    // complete chain of ops).
+    void applyGeneric(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                      bool inPlace, AlphaMode alphaMode) const;
+
+    // Get the generic processing i.e. bit-depth casts & all the ops as 32-bit float CPU ops.
+    void getGenericEngine(ConstOpCPURcPtr & inBitDepthOp,
+                          ConstOpCPURcPtrVec & cpuOps,
+                          ConstOpCPURcPtr & outBitDepthOp) const;
+
 private:
     ConstOpCPURcPtr    m_inBitDepthOp; // Converts from in to F32. It could be done by the first op.
     ConstOpCPURcPtrVec m_cpuOps;       // It could be empty if the OpVec only contains a 1D LUT op
                                        // (e.g. the 1D LUT CPUOp instance would be in the m_inBitDepthOp).
     ConstOpCPURcPtr    m_outBitDepthOp;// Converts from F32 to out. It could be done by the last op.
+    ConstOpCPURcPtr    m_directOp;     // Converts from in to out without the F32 intermediate
+                                       // buffer (e.g. a 1D LUT indexed by the F16 half codes).
+
+    // The generic processing only uses bit-depth casts for the unpacking & packing steps
+    // so all the ops are CPU ops processing 32-bit float values (e.g. the color values
+    // of the premultiplied images are divided & multiplied by alpha in 32-bit float).
+    // It is only created when needed.
+    OpRcPtrVec                 m_ops;
+    mutable ConstOpCPURcPtr    m_genericInBitDepthOp;
+    mutable ConstOpCPURcPtrVec m_genericCpuOps;
+    mutable ConstOpCPURcPtr    m_genericOutBitDepthOp;
+    mutable Mutex              m_genericMutex;
 
     BitDepth           m_inBitDepth = BIT_DEPTH_F32;
     BitDepth           m_outBitDepth = BIT_DEPTH_F32;
     bool               m_hasChannelCrosstalk = true;
+    bool               m_modifiesAlpha = true; // Do the ops change the alpha channel?
     std::string        m_cacheID;
     Mutex              m_mutex;
+
+    bool                           m_runDetectionEnabled = false;
+    mutable std::atomic<long long> m_runDetectionNumLines{ 0 };
+
+    bool                           m_colorCacheEnabled = false;
+    mutable std::atomic<long long> m_colorCacheNumLookups{ 0 };
+    mutable std::atomic<long long> m_colorCacheNumHits{ 0 };
+
+    bool                           m_statisticsEnabled = false;
+    // The first step is the unpacking, then the CPU ops and finally the packing.
+    mutable CPUProcessorStatistics m_statistics;
+    mutable Mutex                  m_statisticsMutex;
 };
 
 
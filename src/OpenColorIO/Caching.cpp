@@ -3,8 +3,9 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
-#include "transforms/CDLTransform.h"
+#include "GpuShader.h"
 #include "PathUtils.h"
+#include "transforms/CDLTransform.h"
 #include "transforms/FileTransform.h"
 
 OCIO_NAMESPACE_ENTER
@@ -17,6 +18,7 @@ OCIO_NAMESPACE_ENTER
         ClearPathCaches();
         ClearFileTransformCaches();
         ClearCDLTransformFileCache();
+        GpuShaderCache::Clear();
     }
 }
 OCIO_NAMESPACE_EXIT
@@ -121,6 +121,12 @@ void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
         op->setOutputBitDepth(BIT_DEPTH_F32);
     }
 
+    m_rawOps = m_ops.clone();
+    m_oFlags = oFlags;
+    m_fFlags = fFlags;
+    m_parameterOps.clear();
+    m_hasParameterOps = false;
+
     OptimizeOpVec(m_ops, oFlags);
     FinalizeOpVec(m_ops, fFlags);
     UnifyDynamicProperties(m_ops);
@@ -151,16 +157,70 @@ void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     m_cacheID = ss.str();
 }
 
+const OpRcPtrVec & GPUProcessor::Impl::getParameterOps() const
+{
+    if(!m_hasParameterOps)
+    {
+        // The optimizations removing or merging ops depend on the parameter
+        // values (e.g. an identity matrix is removed) so they would change the
+        // uniforms, and hence the shader program, with the values.
+        m_parameterOps = m_rawOps.clone();
+        OptimizeOpVecKeepingParameters(m_parameterOps, m_oFlags);
+        FinalizeOpVec(m_parameterOps, m_fFlags);
+
+        // Share the dynamic properties with the processor ops.
+        OpRcPtrVec allOps;
+        allOps += m_ops;
+        allOps += m_parameterOps;
+        UnifyDynamicProperties(allOps);
+
+        m_hasParameterOps = true;
+    }
+
+    return m_parameterOps;
+}
+
 void GPUProcessor::Impl::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const
 {
     AutoMutex lock(m_mutex);
 
+    // Shader programs are cached as the extraction could be expensive
+    // (e.g. the legacy shader description bakes a 3D LUT).
+    const bool cacheable = GpuShaderCache::IsCacheable(*shaderDesc);
+    if(cacheable && GpuShaderCache::Get(m_cacheID, *shaderDesc))
+    {
+        // The uniforms hold a copy of the dynamic properties taken at the
+        // extraction so refresh them with the current values.  Op parameters
+        // are part of the processor cache id so they are already up to date.
+        for(unsigned idx = 0; idx < shaderDesc->getNumUniforms(); ++idx)
+        {
+            const char * name = nullptr;
+            DynamicPropertyRcPtr value;
+            shaderDesc->getUniform(idx, name, value);
+            if(value->getType() != DYNAMIC_PROPERTY_PARAMETER)
+            {
+                value->setValue(getDynamicProperty(value->getType())->getDoubleValue());
+            }
+        }
+
+        if(IsDebugLoggingEnabled())
+        {
+            LogDebug("GPU Shader (cached)");
+            LogDebug(shaderDesc->getShaderText());
+        }
+        return;
+    }
+
+    const bool parameterUniforms
+        = shaderDesc->getParameterMode() != GpuShaderDesc::PARAMETER_CONSTANT;
+    const OpRcPtrVec & ops = parameterUniforms ? getParameterOps() : m_ops;
+
     OpRcPtrVec gpuOps;
 
     LegacyGpuShaderDesc * legacy = dynamic_cast<LegacyGpuShaderDesc*>(shaderDesc.get());
     if(legacy)
     {
-        gpuOps = m_ops.clone();
+        gpuOps = ops.clone();
 
         // GPU Process setup
         //
@@ -193,12 +253,19 @@ void GPUProcessor::Impl::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) c
         gpuOps += gpuLut;
         gpuOps += gpuOpsHwPostProcess;
 
-        OptimizeOpVec(gpuOps, OPTIMIZATION_DEFAULT);
+        if(parameterUniforms)
+        {
+            OptimizeOpVecKeepingParameters(gpuOps, OPTIMIZATION_DEFAULT);
+        }
+        else
+        {
+            OptimizeOpVec(gpuOps, OPTIMIZATION_DEFAULT);
+        }
         FinalizeOpVec(gpuOps, FINALIZATION_DEFAULT);
     }
     else
     {
-        gpuOps = m_ops;
+        gpuOps = ops;
     }
 
     // Create the shader program information
@@ -207,11 +274,18 @@ void GPUProcessor::Impl::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) c
         op->extractGpuShaderInfo(shaderDesc);
     }
 
+    DeclareParameterBlock(shaderDesc);
+
     WriteShaderHeader(shaderDesc);
     WriteShaderFooter(shaderDesc);
 
     shaderDesc->finalize();
 
+    if(cacheable)
+    {
+        GpuShaderCache::Add(m_cacheID, *shaderDesc);
+    }
+
     if(IsDebugLoggingEnabled())
     {
         LogDebug("GPU Shader");
@@ -38,10 +38,20 @@ public:
                   OptimizationFlags oFlags, FinalizationFlags fFlags);
 
 private:
+    // The ops used when the shader parameters are uniforms.
+    const OpRcPtrVec & getParameterOps() const;
+
     OpRcPtrVec    m_ops;
     bool          m_hasChannelCrosstalk = true;
     std::string   m_cacheID;
     mutable Mutex m_mutex;
+
+    // The ops before their optimization, kept to lazily build m_parameterOps.
+    OpRcPtrVec         m_rawOps;
+    OptimizationFlags  m_oFlags = OPTIMIZATION_DEFAULT;
+    FinalizationFlags  m_fFlags = FINALIZATION_DEFAULT;
+    mutable OpRcPtrVec m_parameterOps;
+    mutable bool       m_hasParameterOps = false;
 };
 
 
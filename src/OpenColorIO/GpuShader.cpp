@@ -2,6 +2,11 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -11,7 +16,9 @@
 #include "DynamicProperty.h"
 #include "GpuShader.h"
 #include "HashUtils.h"
+#include "Mutex.h"
 #include "ops/Lut3D/Lut3DOpData.h"
+#include "OpenEXR/half.h"
 #include "Platform.h"
 
 
@@ -21,20 +28,87 @@ OCIO_NAMESPACE_ENTER
 namespace
 {
 
-static void  CreateArray(const float * buf, 
-                         unsigned w, unsigned h, unsigned d, 
-                         GpuShaderDesc::TextureType type, 
-                         std::vector<float> & res)
+// Copy the buffer into a new immutable payload.  Note that an invalid buffer or
+// size returns an empty payload to let the texture validation report the error.
+GpuTextureValuesRcPtr CreateArray(const float * buf,
+                                  unsigned w, unsigned h, unsigned d,
+                                  GpuShaderDesc::TextureType type)
 {
-    if(buf==nullptr)
+    const size_t size 
+        = w * h * d * (type==GpuShaderDesc::TEXTURE_RGB_CHANNEL ? 3 : 1);
+
+    if(buf==nullptr || size==0)
     {
-        throw Exception("The buffer is invalid");
+        return GpuTextureValuesRcPtr();
     }
 
-    const size_t size 
-        = w * h * d * (type==GpuShaderDesc::TEXTURE_RGB_CHANNEL ? 3 : 1);
-    res.resize(size);
-    memcpy(&res[0], buf, size * sizeof(float));
+    OCIO_SHARED_PTR<std::vector<float>> res = std::make_shared<std::vector<float>>(size);
+    memcpy(&(*res)[0], buf, size * sizeof(float));
+
+    return GpuTextureValuesRcPtr(res, res->data());
+}
+
+typedef OCIO_SHARED_PTR<const unsigned short> GpuTexturePackedValuesRcPtr;
+
+// Pack the values in half floats, returning the largest absolute error.
+GpuTexturePackedValuesRcPtr PackFloat16(const float * values, size_t numValues,
+                                        float & maxError)
+{
+    OCIO_SHARED_PTR<std::vector<unsigned short>> res
+        = std::make_shared<std::vector<unsigned short>>(numValues);
+
+    maxError = 0.0f;
+    for(size_t idx=0; idx<numValues; ++idx)
+    {
+        const float v = values[idx];
+        if(std::isnan(v))
+        {
+            (*res)[idx] = half(v).bits();
+            continue;
+        }
+
+        // Out of range values are clamped to the largest half instead of infinity.
+        const half h(std::isinf(v) ? v : std::max(-HALF_MAX, std::min(v, HALF_MAX)));
+        (*res)[idx] = h.bits();
+
+        if(!std::isinf(v))
+        {
+            maxError = std::max(maxError, std::fabs((float)h - v));
+        }
+    }
+
+    return GpuTexturePackedValuesRcPtr(res, res->data());
+}
+
+// Pack the values in 16-bit normalized integers, returning the largest absolute error.
+GpuTexturePackedValuesRcPtr PackUnorm16(const float * values, size_t numValues,
+                                        float scale, float offset, float & maxError)
+{
+    OCIO_SHARED_PTR<std::vector<unsigned short>> res
+        = std::make_shared<std::vector<unsigned short>>(numValues);
+
+    maxError = 0.0f;
+    for(size_t idx=0; idx<numValues; ++idx)
+    {
+        const float v = values[idx];
+
+        float normalized = 0.0f;
+        if(scale > 0.0f && !std::isnan(v))
+        {
+            normalized = std::max(0.0f, std::min((v - offset) / scale, 1.0f));
+        }
+
+        const unsigned short packed = (unsigned short)(normalized * 65535.0f + 0.5f);
+        (*res)[idx] = packed;
+
+        if(std::isfinite(v))
+        {
+            const float decoded = scale * ((float)packed / 65535.0f) + offset;
+            maxError = std::max(maxError, std::fabs(decoded - v));
+        }
+    }
+
+    return GpuTexturePackedValuesRcPtr(res, res->data());
 }
 
 class PrivateImpl
@@ -45,14 +119,16 @@ public:
         Texture(const char * name, const char * identifier, 
                 unsigned w, unsigned h, unsigned d,
                 GpuShaderDesc::TextureType channel, 
+                GpuShaderDesc::TextureFormat format,
                 Interpolation interpolation, 
-                const float * v)
+                const GpuTextureValuesRcPtr & v)
             :   m_name(name)
             ,   m_id(identifier)
             ,   m_width(w)
             ,   m_height(h)
             ,   m_depth(d)
             ,   m_type(channel)
+            ,   m_format(format)
             ,   m_interp(interpolation)
         {
             if(!name || !*name)
@@ -69,10 +145,36 @@ public:
                 throw Exception(ss.str().c_str());
             }
 
-            // An unfortunate copy is mandatory to allow the creation of a GPU shader cache. 
-            // The cache needs a decoupling of the processor and shader instances forbidding
-            // shared naked pointer usage.
-            CreateArray(v, m_width, m_height, m_depth, m_type, m_values);
+            if(!v)
+            {
+                throw Exception("The buffer is invalid");
+            }
+
+            // The payload is immutable so the copies of the texture (e.g. the ones
+            // held by the GPU shader cache) share it instead of duplicating it.
+            m_values = v;
+
+            const size_t numValues 
+                = m_width * m_height * m_depth
+                    * (m_type==GpuShaderDesc::TEXTURE_RGB_CHANNEL ? 3 : 1);
+
+            if(m_format==GpuShaderDesc::TEXTURE_FORMAT_FLOAT16)
+            {
+                m_packedValues = PackFloat16(m_values.get(), numValues, m_maxError);
+            }
+            else if(m_format==GpuShaderDesc::TEXTURE_FORMAT_UNORM16)
+            {
+                GetUnorm16TextureRange(m_values.get(), numValues, m_scale, m_offset);
+                m_packedValues
+                    = PackUnorm16(m_values.get(), numValues, m_scale, m_offset, m_maxError);
+            }
+        }
+
+        void getPackingInfo(float & maxError, float & scale, float & offset) const
+        {
+            maxError = m_maxError;
+            scale    = m_scale;
+            offset   = m_offset;
         }
 
         std::string m_name;
@@ -81,9 +183,16 @@ public:
         unsigned m_height;
         unsigned m_depth;
         GpuShaderDesc::TextureType m_type;
+        GpuShaderDesc::TextureFormat m_format;
         Interpolation m_interp;
 
-        std::vector<float> m_values;
+        GpuTextureValuesRcPtr m_values;
+
+        // 16-bit values (i.e. half or unsigned short depending on the format).
+        GpuTexturePackedValuesRcPtr m_packedValues;
+        float m_maxError = 0.0f;
+        float m_scale    = 1.0f;
+        float m_offset   = 0.0f;
 
         Texture() = delete;
     };
@@ -135,9 +244,7 @@ public:
     inline unsigned get1dLutMaxWidth() const { return m_max1DLUTWidth; }
     inline void set1dLutMaxWidth(unsigned maxWidth) { m_max1DLUTWidth = maxWidth; }
 
-    void addTexture(const char * name, const char * id, unsigned width, unsigned height, 
-                    GpuShaderDesc::TextureType channel,
-                    Interpolation interpolation, const float * values)
+    void check1dLutWidth(unsigned width) const
     {
         if(width > get1dLutMaxWidth())
         {
@@ -146,11 +253,31 @@ public:
                 << width << " > " << get1dLutMaxWidth();
             throw Exception(ss.str().c_str());
         }
+    }
 
-        Texture t(name, id, width, height, 1, channel, interpolation, values);
+    void addTexture(const char * name, const char * id, unsigned width, unsigned height, 
+                    GpuShaderDesc::TextureType channel,
+                    GpuShaderDesc::TextureFormat format,
+                    Interpolation interpolation, const GpuTextureValuesRcPtr & values)
+    {
+        check1dLutWidth(width);
+
+        Texture t(name, id, width, height, 1, channel, format, interpolation, values);
         m_textures.push_back(t);
     }
 
+    void addTexture(const char * name, const char * id, unsigned width, unsigned height, 
+                    GpuShaderDesc::TextureType channel,
+                    GpuShaderDesc::TextureFormat format,
+                    Interpolation interpolation, const float * values)
+    {
+        // Validate the size before copying the values.
+        check1dLutWidth(width);
+
+        addTexture(name, id, width, height, channel, format, interpolation,
+                   CreateArray(values, width, height, 1, channel));
+    }
+
     void getTexture(unsigned index, const char *& name, const char *& id, 
                     unsigned & width, unsigned & height, 
                     GpuShaderDesc::TextureType & channel, 
@@ -184,11 +311,37 @@ public:
         }
 
         const Texture & t = m_textures[index];
-        values   = &t.m_values[0];
+        values   = t.m_values.get();
     }
 
-    void add3DTexture(const char * name, const char * id, unsigned dimension, 
-                      Interpolation interpolation, const float * values)
+    void getTexturePackedValues(unsigned index, const void *& values) const
+    {
+        if(index >= m_textures.size())
+        {
+            std::ostringstream ss;
+            ss << "1D LUT access error: index = " << index
+               << " where size = " << m_textures.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        values = m_textures[index].m_packedValues.get();
+    }
+
+    void getTexturePackingInfo(unsigned index, float & maxError,
+                               float & scale, float & offset) const
+    {
+        if(index >= m_textures.size())
+        {
+            std::ostringstream ss;
+            ss << "1D LUT access error: index = " << index
+               << " where size = " << m_textures.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        m_textures[index].getPackingInfo(maxError, scale, offset);
+    }
+
+    void check3dLutDimension(unsigned dimension) const
     {
         if(dimension > get3dLutMaxDimension())
         {
@@ -197,10 +350,29 @@ public:
                 << dimension << " > " << get3dLutMaxDimension();
             throw Exception(ss.str().c_str());
         }
+    }
+
+    void add3DTexture(const char * name, const char * id, unsigned dimension, 
+                      GpuShaderDesc::TextureFormat format,
+                      Interpolation interpolation, const float * values)
+    {
+        // Validate the size before copying the values.
+        check3dLutDimension(dimension);
+
+        add3DTexture(name, id, dimension, format, interpolation,
+                     CreateArray(values, dimension, dimension, dimension,
+                                 GpuShaderDesc::TEXTURE_RGB_CHANNEL));
+    }
+
+    void add3DTexture(const char * name, const char * id, unsigned dimension, 
+                      GpuShaderDesc::TextureFormat format,
+                      Interpolation interpolation, const GpuTextureValuesRcPtr & values)
+    {
+        check3dLutDimension(dimension);
 
         Texture t(
             name, id, dimension, dimension, dimension, 
-            GpuShaderDesc::TEXTURE_RGB_CHANNEL, 
+            GpuShaderDesc::TEXTURE_RGB_CHANNEL, format,
             interpolation, values);
         m_textures3D.push_back(t);
     }
@@ -235,7 +407,34 @@ public:
         }
 
         const Texture & t = m_textures3D[index];
-        values = &t.m_values[0];
+        values = t.m_values.get();
+    }
+
+    void get3DTexturePackedValues(unsigned index, const void *& values) const
+    {
+        if(index >= m_textures3D.size())
+        {
+            std::ostringstream ss;
+            ss << "3D LUT access error: index = " << index
+               << " where size = " << m_textures3D.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        values = m_textures3D[index].m_packedValues.get();
+    }
+
+    void get3DTexturePackingInfo(unsigned index, float & maxError,
+                                 float & scale, float & offset) const
+    {
+        if(index >= m_textures3D.size())
+        {
+            std::ostringstream ss;
+            ss << "3D LUT access error: index = " << index
+               << " where size = " << m_textures3D.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        m_textures3D[index].getPackingInfo(maxError, scale, offset);
     }
 
     unsigned getNumUniforms() const
@@ -259,19 +458,23 @@ public:
 
     bool addUniform(const char * name, const DynamicPropertyRcPtr & value)
     {
-        for (auto u : m_uniforms)
+        // Op parameters of the same type are distinct uniforms.
+        if (value->getType() != DYNAMIC_PROPERTY_PARAMETER)
         {
-            if (*u.m_value == *value)
+            for (auto u : m_uniforms)
             {
-                if(std::string(name)!=u.m_name)
+                if (*u.m_value == *value)
                 {
-                    std::string err("Same dynamic properties must have the same name: ");
-                    err += u.m_name + " vs. " + name;
-                    throw Exception(err.c_str());
+                    if(std::string(name)!=u.m_name)
+                    {
+                        std::string err("Same dynamic properties must have the same name: ");
+                        err += u.m_name + " vs. " + name;
+                        throw Exception(err.c_str());
+                    }
+
+                    // Uniform is already there.
+                    return false;
                 }
-
-                // Uniform is already there.
-                return false;
             }
         }
         m_uniforms.emplace_back(name, value);
@@ -284,7 +487,19 @@ public:
                           const char * shaderFunctionBody,
                           const char * shaderFunctionFooter)
     {
+        const char * parts[] = { shaderDeclarations, shaderHelperMethods,
+                                 shaderFunctionHeader, shaderFunctionBody,
+                                 shaderFunctionFooter };
+
+        // Allocate the complete shader program at once.
+        size_t length = 0;
+        for (const char * part : parts)
+        {
+            length += part ? strlen(part) : 0;
+        }
+
         m_shaderCode.resize(0);
+        m_shaderCode.reserve(length);
         m_shaderCode += (shaderDeclarations   && *shaderDeclarations)   ? shaderDeclarations   : "";
         m_shaderCode += (shaderHelperMethods  && *shaderHelperMethods)  ? shaderHelperMethods  : "";
         m_shaderCode += (shaderFunctionHeader && *shaderFunctionHeader) ? shaderFunctionHeader : "";
@@ -303,30 +518,64 @@ public:
                          m_functionBody.c_str(), 
                          m_functionFooter.c_str());
 
-        // Compute the identifier
-        std::ostringstream os;
-        os << m_shaderCode;
-        os << "T3D: " << m_textures3D.size();
+        // Compute the identifier (without streaming the complete shader program).
+        std::string id;
+        id.reserve(m_shaderCode.size() + 64 * (m_textures3D.size() + m_textures.size())
+                   + 32 * m_uniforms.size() + 32);
+        id += m_shaderCode;
+        id += "T3D: " + std::to_string(m_textures3D.size());
         for(auto & t : m_textures3D)
         {
-            os << t.m_id << " ";
+            id += t.m_id + " ";
         }
-        os << "T1D: " << m_textures.size();
+        id += "T1D: " + std::to_string(m_textures.size());
         for(auto & t : m_textures)
         {
-            os << t.m_id << " ";
+            id += t.m_id + " ";
         }
-        os << "U: " << m_uniforms.size();
+        id += "U: " + std::to_string(m_uniforms.size());
         for (auto & u : m_uniforms)
         {
-            os << u.m_name << " ";
+            id += u.m_name + " ";
         }
 
-        const std::string id = os.str();
         m_shaderCodeID = cacheID 
             + CacheIDHash(id.c_str(), unsigned(id.length()));
     }
 
+    // Nothing was added to the shader program yet.
+    bool isEmpty() const
+    {
+        return m_declarations.empty() && m_helperMethods.empty()
+            && m_functionHeader.empty() && m_functionBody.empty()
+            && m_functionFooter.empty() && m_shaderCode.empty()
+            && m_textures.empty() && m_textures3D.empty() && m_uniforms.empty();
+    }
+
+    void copyFrom(const PrivateImpl & rhs)
+    {
+        m_declarations   = rhs.m_declarations;
+        m_helperMethods  = rhs.m_helperMethods;
+        m_functionHeader = rhs.m_functionHeader;
+        m_functionBody   = rhs.m_functionBody;
+        m_functionFooter = rhs.m_functionFooter;
+
+        m_shaderCode   = rhs.m_shaderCode;
+        m_shaderCodeID = rhs.m_shaderCodeID;
+
+        m_textures   = rhs.m_textures;
+        m_textures3D = rhs.m_textures3D;
+
+        // The uniforms own a copy of the dynamic property.
+        m_uniforms.clear();
+        for (const auto & u : rhs.m_uniforms)
+        {
+            m_uniforms.emplace_back(u.m_name.c_str(), u.m_value);
+        }
+
+        m_max1DLUTWidth = rhs.m_max1DLUTWidth;
+    }
+
     std::string m_declarations;
     std::string m_helperMethods;
     std::string m_functionHeader;
@@ -364,6 +613,23 @@ public:
 
     inline unsigned getEdgelen() const { return m_edgelen; }
 
+    void checkLegacy3DTexture(unsigned dimension) const
+    {
+        if(dimension!=getEdgelen())
+        {
+            std::ostringstream ss;
+            ss << "3D Texture size unexpected: " << dimension
+               << " instead of " << getEdgelen();
+            throw Exception(ss.str().c_str());
+        }
+
+        if(m_textures3D.size()!=0)
+        {
+            const std::string ss("3D Texture error: only one 3D texture allowed");
+            throw Exception(ss.c_str());
+        }
+    }
+
 private:
     unsigned m_edgelen;
 };
@@ -439,6 +705,16 @@ void LegacyGpuShaderDesc::getTextureValues(unsigned, const float *&) const
     throw Exception("1D LUTs are not supported");
 }
 
+void LegacyGpuShaderDesc::getTexturePackedValues(unsigned, const void *&) const
+{
+    throw Exception("1D LUTs are not supported");
+}
+
+void LegacyGpuShaderDesc::getTexturePackingInfo(unsigned, float &, float &, float &) const
+{
+    throw Exception("1D LUTs are not supported");
+}
+
 unsigned LegacyGpuShaderDesc::getNum3DTextures() const
 {
     return unsigned(getImpl()->m_textures3D.size());
@@ -447,21 +723,17 @@ unsigned LegacyGpuShaderDesc::getNum3DTextures() const
 void LegacyGpuShaderDesc::add3DTexture(const char * name, const char * id, unsigned dimension, 
                                        Interpolation interpolation, const float * values)
 {
-    if(dimension!=getImpl()->getEdgelen())
-    {
-        std::ostringstream ss;
-        ss << "3D Texture size unexpected: " << dimension
-           << " instead of " << getImpl()->getEdgelen();
-        throw Exception(ss.str().c_str());
-    }
-
-    if(getImpl()->m_textures3D.size()!=0)
-    {
-        const std::string ss("3D Texture error: only one 3D texture allowed");
-        throw Exception(ss.c_str());
-    }
+    getImpl()->checkLegacy3DTexture(dimension);
+    getImpl()->add3DTexture(name, id, dimension, getTextureFormat(), interpolation, values);
+}
 
-    getImpl()->add3DTexture(name, id, dimension, interpolation, values);
+void LegacyGpuShaderDesc::addShared3DTexture(const char * name, const char * id,
+                                             unsigned dimension,
+                                             Interpolation interpolation,
+                                             const GpuTextureValuesRcPtr & values)
+{
+    getImpl()->checkLegacy3DTexture(dimension);
+    getImpl()->add3DTexture(name, id, dimension, getTextureFormat(), interpolation, values);
 }
 
 void LegacyGpuShaderDesc::get3DTexture(unsigned index, const char *& name, 
@@ -476,6 +748,17 @@ void LegacyGpuShaderDesc::get3DTextureValues(unsigned index, const float *& valu
     getImpl()->get3DTextureValues(index, values);
 }
 
+void LegacyGpuShaderDesc::get3DTexturePackedValues(unsigned index, const void *& values) const
+{
+    getImpl()->get3DTexturePackedValues(index, values);
+}
+
+void LegacyGpuShaderDesc::get3DTexturePackingInfo(unsigned index, float & maxError,
+                                                  float & scale, float & offset) const
+{
+    getImpl()->get3DTexturePackingInfo(index, maxError, scale, offset);
+}
+
 const char * LegacyGpuShaderDesc::getShaderText() const
 {
     return getImpl()->m_shaderCode.c_str();
@@ -600,7 +883,18 @@ void GenericGpuShaderDesc::addTexture(const char * name, const char * id,
                                       Interpolation interpolation,
                                       const float * values)
 {
-    getImpl()->addTexture(name, id, width, height, channel, interpolation, values);
+    getImpl()->addTexture(name, id, width, height, channel, getTextureFormat(),
+                          interpolation, values);
+}
+
+void GenericGpuShaderDesc::addSharedTexture(const char * name, const char * id,
+                                            unsigned width, unsigned height,
+                                            TextureType channel,
+                                            Interpolation interpolation,
+                                            const GpuTextureValuesRcPtr & values)
+{
+    getImpl()->addTexture(name, id, width, height, channel, getTextureFormat(),
+                          interpolation, values);
 }
 
 void GenericGpuShaderDesc::getTexture(unsigned index, const char *& name, 
@@ -616,6 +910,17 @@ void GenericGpuShaderDesc::getTextureValues(unsigned index, const float *& value
     getImpl()->getTextureValues(index, values);
 }
 
+void GenericGpuShaderDesc::getTexturePackedValues(unsigned index, const void *& values) const
+{
+    getImpl()->getTexturePackedValues(index, values);
+}
+
+void GenericGpuShaderDesc::getTexturePackingInfo(unsigned index, float & maxError,
+                                                 float & scale, float & offset) const
+{
+    getImpl()->getTexturePackingInfo(index, maxError, scale, offset);
+}
+
 unsigned GenericGpuShaderDesc::getNum3DTextures() const
 {
     return unsigned(getImpl()->m_textures3D.size());
@@ -625,7 +930,15 @@ void GenericGpuShaderDesc::add3DTexture(
     const char * name, const char * id, unsigned edgelen, 
     Interpolation interpolation, const float * values)
 {
-    getImpl()->add3DTexture(name, id, edgelen, interpolation, values);
+    getImpl()->add3DTexture(name, id, edgelen, getTextureFormat(), interpolation, values);
+}
+
+void GenericGpuShaderDesc::addShared3DTexture(const char * name, const char * id,
+                                              unsigned edgelen,
+                                              Interpolation interpolation,
+                                              const GpuTextureValuesRcPtr & values)
+{
+    getImpl()->add3DTexture(name, id, edgelen, getTextureFormat(), interpolation, values);
 }
 
 void GenericGpuShaderDesc::get3DTexture(unsigned index, const char *& name, 
@@ -640,6 +953,17 @@ void GenericGpuShaderDesc::get3DTextureValues(unsigned index, const float *& val
     getImpl()->get3DTextureValues(index, values);
 }
 
+void GenericGpuShaderDesc::get3DTexturePackedValues(unsigned index, const void *& values) const
+{
+    getImpl()->get3DTexturePackedValues(index, values);
+}
+
+void GenericGpuShaderDesc::get3DTexturePackingInfo(unsigned index, float & maxError,
+                                                   float & scale, float & offset) const
+{
+    getImpl()->get3DTexturePackingInfo(index, maxError, scale, offset);
+}
+
 const char * GenericGpuShaderDesc::getShaderText() const
 {
     return getImpl()->m_shaderCode.c_str();
@@ -705,6 +1029,251 @@ void GenericGpuShaderDesc::Deleter(GenericGpuShaderDesc* c)
     delete c;
 }
 
+
+void GetUnorm16TextureRange(const float * values, size_t numValues,
+                            float & scale, float & offset)
+{
+    float minValue = std::numeric_limits<float>::max();
+    float maxValue = -std::numeric_limits<float>::max();
+    for(size_t idx=0; idx<numValues; ++idx)
+    {
+        if(std::isfinite(values[idx]))
+        {
+            minValue = std::min(minValue, values[idx]);
+            maxValue = std::max(maxValue, values[idx]);
+        }
+    }
+
+    if(minValue > maxValue)
+    {
+        // No finite values.
+        scale  = 1.0f;
+        offset = 0.0f;
+    }
+    else
+    {
+        scale  = maxValue - minValue;
+        offset = minValue;
+    }
+}
+
+void AddSharedTexture(GpuShaderDesc & shaderDesc, const char * name, const char * id,
+                      unsigned width, unsigned height,
+                      GpuShaderDesc::TextureType channel,
+                      Interpolation interpolation,
+                      const GpuTextureValuesRcPtr & values)
+{
+    if (GenericGpuShaderDesc * generic = dynamic_cast<GenericGpuShaderDesc*>(&shaderDesc))
+    {
+        generic->addSharedTexture(name, id, width, height, channel, interpolation, values);
+    }
+    else
+    {
+        shaderDesc.addTexture(name, id, width, height, channel, interpolation, values.get());
+    }
+}
+
+void AddShared3DTexture(GpuShaderDesc & shaderDesc, const char * name, const char * id,
+                        unsigned edgelen, Interpolation interpolation,
+                        const GpuTextureValuesRcPtr & values)
+{
+    if (GenericGpuShaderDesc * generic = dynamic_cast<GenericGpuShaderDesc*>(&shaderDesc))
+    {
+        generic->addShared3DTexture(name, id, edgelen, interpolation, values);
+    }
+    else if (LegacyGpuShaderDesc * legacy = dynamic_cast<LegacyGpuShaderDesc*>(&shaderDesc))
+    {
+        legacy->addShared3DTexture(name, id, edgelen, interpolation, values);
+    }
+    else
+    {
+        shaderDesc.add3DTexture(name, id, edgelen, interpolation, values.get());
+    }
+}
+
+
+namespace
+{
+// The entries are ordered from the most to the least recently used.
+typedef std::pair<std::string, GpuShaderDescRcPtr> GpuShaderCacheEntry;
+typedef std::list<GpuShaderCacheEntry> GpuShaderCacheList;
+typedef std::map<std::string, GpuShaderCacheList::iterator> GpuShaderCacheMap;
+
+const size_t DEFAULT_GPU_SHADER_CACHE_MAX_ENTRIES = 64;
+
+GpuShaderCacheList g_gpuShaderCacheEntries;
+GpuShaderCacheMap g_gpuShaderCache;
+size_t g_gpuShaderCacheMaxEntries = DEFAULT_GPU_SHADER_CACHE_MAX_ENTRIES;
+Mutex g_gpuShaderCacheLock;
+
+// The lock must be held by the caller.
+void EvictGpuShaderCacheEntries(size_t maxEntries)
+{
+    while (g_gpuShaderCacheEntries.size() > maxEntries)
+    {
+        g_gpuShaderCache.erase(g_gpuShaderCacheEntries.back().first);
+        g_gpuShaderCacheEntries.pop_back();
+    }
+}
+}
+
+std::string GpuShaderCache::GetKey(const GpuShaderDesc & shaderDesc)
+{
+    std::ostringstream os;
+
+    if (auto legacy = dynamic_cast<const LegacyGpuShaderDesc *>(&shaderDesc))
+    {
+        if (!legacy->getImpl()->isEmpty())
+        {
+            return "";
+        }
+        os << "Legacy " << legacy->getEdgelen();
+    }
+    else if (auto generic = dynamic_cast<const GenericGpuShaderDesc *>(&shaderDesc))
+    {
+        if (!generic->getImpl()->isEmpty())
+        {
+            return "";
+        }
+        os << "Generic " << generic->getTextureMaxWidth();
+    }
+    else
+    {
+        return "";
+    }
+
+    os << " " << shaderDesc.GpuShaderDesc::getCacheID();
+    return os.str();
+}
+
+void GpuShaderCache::Copy(const GpuShaderDesc & src, GpuShaderDesc & dst)
+{
+    auto legacySrc = dynamic_cast<const LegacyGpuShaderDesc *>(&src);
+    auto legacyDst = dynamic_cast<LegacyGpuShaderDesc *>(&dst);
+    auto genericSrc = dynamic_cast<const GenericGpuShaderDesc *>(&src);
+    auto genericDst = dynamic_cast<GenericGpuShaderDesc *>(&dst);
+
+    if (legacySrc && legacyDst)
+    {
+        legacyDst->getImpl()->copyFrom(*legacySrc->getImpl());
+    }
+    else if (genericSrc && genericDst)
+    {
+        genericDst->getImpl()->copyFrom(*genericSrc->getImpl());
+    }
+    else
+    {
+        throw Exception("Cannot copy shader descriptions of different types.");
+    }
+}
+
+bool GpuShaderCache::IsCacheable(const GpuShaderDesc & shaderDesc)
+{
+    return !GetKey(shaderDesc).empty();
+}
+
+bool GpuShaderCache::Get(const std::string & processorCacheID, GpuShaderDesc & shaderDesc)
+{
+    const std::string key = GetKey(shaderDesc);
+    if (key.empty())
+    {
+        return false;
+    }
+
+    GpuShaderDescRcPtr cached;
+    {
+        AutoMutex lock(g_gpuShaderCacheLock);
+        GpuShaderCacheMap::const_iterator iter
+            = g_gpuShaderCache.find(processorCacheID + " " + key);
+        if (iter == g_gpuShaderCache.end())
+        {
+            return false;
+        }
+        // Move the entry to the front i.e. most recently used.
+        g_gpuShaderCacheEntries.splice(g_gpuShaderCacheEntries.begin(),
+                                       g_gpuShaderCacheEntries, iter->second);
+        cached = iter->second->second;
+    }
+
+    // Cached entries are never modified, only replaced.
+    Copy(*cached, shaderDesc);
+    return true;
+}
+
+void GpuShaderCache::Add(const std::string & processorCacheID, const GpuShaderDesc & shaderDesc)
+{
+    GpuShaderDescRcPtr cached;
+    if (auto legacy = dynamic_cast<const LegacyGpuShaderDesc *>(&shaderDesc))
+    {
+        cached = LegacyGpuShaderDesc::Create(legacy->getEdgelen());
+    }
+    else if (dynamic_cast<const GenericGpuShaderDesc *>(&shaderDesc))
+    {
+        cached = GenericGpuShaderDesc::Create();
+        cached->setTextureMaxWidth(shaderDesc.getTextureMaxWidth());
+    }
+    else
+    {
+        return;
+    }
+
+    cached->setLanguage(shaderDesc.getLanguage());
+    cached->setFunctionName(shaderDesc.getFunctionName());
+    cached->setPixelName(shaderDesc.getPixelName());
+    cached->setResourcePrefix(shaderDesc.getResourcePrefix());
+    cached->setTextureFormat(shaderDesc.getTextureFormat());
+    cached->setParameterMode(shaderDesc.getParameterMode());
+
+    // The key must be computed before the copy i.e. on an empty description.
+    const std::string key = processorCacheID + " " + GetKey(*cached);
+
+    Copy(shaderDesc, *cached);
+
+    AutoMutex lock(g_gpuShaderCacheLock);
+    GpuShaderCacheMap::iterator iter = g_gpuShaderCache.find(key);
+    if (iter != g_gpuShaderCache.end())
+    {
+        g_gpuShaderCacheEntries.erase(iter->second);
+        g_gpuShaderCache.erase(iter);
+    }
+
+    if (g_gpuShaderCacheMaxEntries == 0)
+    {
+        return;
+    }
+
+    EvictGpuShaderCacheEntries(g_gpuShaderCacheMaxEntries - 1);
+
+    g_gpuShaderCacheEntries.emplace_front(key, cached);
+    g_gpuShaderCache[key] = g_gpuShaderCacheEntries.begin();
+}
+
+size_t GpuShaderCache::GetNumEntries()
+{
+    AutoMutex lock(g_gpuShaderCacheLock);
+    return g_gpuShaderCache.size();
+}
+
+void GpuShaderCache::Clear()
+{
+    AutoMutex lock(g_gpuShaderCacheLock);
+    g_gpuShaderCache.clear();
+    g_gpuShaderCacheEntries.clear();
+}
+
+size_t GpuShaderCache::GetMaxEntries()
+{
+    AutoMutex lock(g_gpuShaderCacheLock);
+    return g_gpuShaderCacheMaxEntries;
+}
+
+void GpuShaderCache::SetMaxEntries(size_t maxEntries)
+{
+    AutoMutex lock(g_gpuShaderCacheLock);
+    g_gpuShaderCacheMaxEntries = maxEntries;
+    EvictGpuShaderCacheEntries(maxEntries);
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -979,4 +1548,590 @@ OCIO_ADD_TEST(GpuShader, legacy_shader)
 }
 
 
+OCIO_ADD_TEST(GpuShader, shader_cache)
+{
+    OCIO::GpuShaderCache::Clear();
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->setStyle(OCIO::EXPOSURE_CONTRAST_LINEAR);
+    ec->setExposure(0.5);
+    ec->makeExposureDynamic();
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const float m44[16] = { 0.8f, 0.1f, 0.1f, 0.0f,
+                            0.2f, 0.7f, 0.1f, 0.0f,
+                            0.1f, 0.1f, 0.8f, 0.0f,
+                            0.0f, 0.0f, 0.0f, 1.0f };
+    matrix->setMatrix(m44);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(ec);
+    group->push_back(matrix);
+
+    OCIO::ConstProcessorRcPtr proc = config->getProcessor(group);
+
+    OCIO::ConstGPUProcessorRcPtr gpu1 = proc->getDefaultGPUProcessor();
+    OCIO::GpuShaderDescRcPtr desc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(desc1));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 1U);
+    OCIO_REQUIRE_EQUAL(desc1->getNumUniforms(), 1U);
+
+    // An identical request from another GPU processor instance is found in the cache.
+    OCIO::ConstGPUProcessorRcPtr gpu2 = proc->getDefaultGPUProcessor();
+    OCIO::GpuShaderDescRcPtr desc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(desc2));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 1U);
+
+    OCIO_CHECK_EQUAL(std::string(desc1->getShaderText()), std::string(desc2->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(desc1->getCacheID()), std::string(desc2->getCacheID()));
+    OCIO_REQUIRE_EQUAL(desc2->getNumUniforms(), 1U);
+
+    const char * name = nullptr;
+    OCIO::DynamicPropertyRcPtr value1;
+    OCIO::DynamicPropertyRcPtr value2;
+    OCIO_CHECK_NO_THROW(desc1->getUniform(0, name, value1));
+    OCIO_CHECK_NO_THROW(desc2->getUniform(0, name, value2));
+    OCIO_CHECK_EQUAL(value2->getDoubleValue(), 0.5);
+    // Each shader description owns its uniforms.
+    OCIO_CHECK_NE(value1.get(), value2.get());
+
+    // The uniforms of a cached shader hold the current dynamic property values.
+    OCIO::DynamicPropertyRcPtr exposure
+        = gpu2->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE);
+    exposure->setValue(1.5);
+
+    OCIO::GpuShaderDescRcPtr desc3 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc3->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(desc3));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 1U);
+    OCIO::DynamicPropertyRcPtr value3;
+    OCIO_CHECK_NO_THROW(desc3->getUniform(0, name, value3));
+    OCIO_CHECK_EQUAL(value3->getDoubleValue(), 1.5);
+    OCIO_CHECK_EQUAL(value2->getDoubleValue(), 0.5);
+
+    // Other shader description parameters.
+    OCIO::GpuShaderDescRcPtr desc4 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc4->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc4->setFunctionName("OCIOOther");
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(desc4));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 2U);
+    OCIO_CHECK_NE(std::string(desc1->getShaderText()), std::string(desc4->getShaderText()));
+
+    // A shader description which is not empty is not cached.
+    OCIO::GpuShaderDescRcPtr desc5 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc5->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc5->addToHelperShaderCode("// Client helper\n");
+    OCIO_CHECK_ASSERT(!OCIO::GpuShaderCache::IsCacheable(*desc5));
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(desc5));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 2U);
+    OCIO_CHECK_NE(std::string(desc5->getShaderText()).find("// Client helper"),
+                  std::string::npos);
+
+    // Legacy shader description (which does not support uniforms).
+    proc = config->getProcessor(matrix);
+    gpu1 = proc->getDefaultGPUProcessor();
+    gpu2 = proc->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr legacy1 = OCIO::GpuShaderDesc::CreateLegacyShaderDesc(8);
+    legacy1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(legacy1));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 3U);
+
+    OCIO::GpuShaderDescRcPtr legacy2 = OCIO::GpuShaderDesc::CreateLegacyShaderDesc(8);
+    legacy2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(legacy2));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 3U);
+
+    OCIO_CHECK_EQUAL(std::string(legacy1->getShaderText()),
+                     std::string(legacy2->getShaderText()));
+    OCIO_CHECK_EQUAL(legacy1->getNum3DTextures(), legacy2->getNum3DTextures());
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 0U);
+}
+
+OCIO_ADD_TEST(GpuShader, shader_cache_eviction)
+{
+    OCIO::GpuShaderCache::Clear();
+    const size_t defaultMaxEntries = OCIO::GpuShaderCache::GetMaxEntries();
+    OCIO_CHECK_EQUAL(defaultMaxEntries, 64U);
+    OCIO::GpuShaderCache::SetMaxEntries(2);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0.0 };
+    matrix->setOffset(offset);
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(matrix)->getDefaultGPUProcessor();
+
+    // Each function name is a different entry.
+    auto extract = [&gpu](const char * functionName)
+    {
+        OCIO::GpuShaderDescRcPtr desc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        desc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+        desc->setFunctionName(functionName);
+        OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc));
+    };
+    auto isCached = [&gpu](const char * functionName)
+    {
+        OCIO::GpuShaderDescRcPtr desc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        desc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+        desc->setFunctionName(functionName);
+        return OCIO::GpuShaderCache::Get(gpu->getCacheID(), *desc);
+    };
+
+    extract("OCIOFirst");
+    extract("OCIOSecond");
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 2U);
+
+    // Use the first entry so the second one is the least recently used.
+    OCIO_CHECK_ASSERT(isCached("OCIOFirst"));
+
+    extract("OCIOThird");
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 2U);
+    OCIO_CHECK_ASSERT(isCached("OCIOFirst"));
+    OCIO_CHECK_ASSERT(!isCached("OCIOSecond"));
+    OCIO_CHECK_ASSERT(isCached("OCIOThird"));
+
+    // Using a cached entry does not evict another one.
+    extract("OCIOFirst");
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 2U);
+    OCIO_CHECK_ASSERT(isCached("OCIOThird"));
+
+    // A smaller cap evicts the least recently used entries.
+    OCIO::GpuShaderCache::SetMaxEntries(1);
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 1U);
+    OCIO_CHECK_ASSERT(isCached("OCIOThird"));
+    OCIO_CHECK_ASSERT(!isCached("OCIOFirst"));
+
+    // No entries at all.
+    OCIO::GpuShaderCache::SetMaxEntries(0);
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 0U);
+    extract("OCIOFirst");
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 0U);
+
+    OCIO::GpuShaderCache::SetMaxEntries(defaultMaxEntries);
+}
+
+OCIO_ADD_TEST(GpuShader, shared_textures)
+{
+    // The texture values are shared with the buffer owner.
+    OCIO_SHARED_PTR<std::vector<float>> values
+        = std::make_shared<std::vector<float>>(2 * 2 * 2 * 3, 0.5f);
+    const OCIO::GpuTextureValuesRcPtr payload(values, values->data());
+
+    OCIO::GpuShaderDescRcPtr generic = OCIO::GpuShaderDesc::CreateShaderDesc();
+    OCIO_CHECK_NO_THROW(OCIO::AddShared3DTexture(*generic, "lut3d", "1234", 2,
+                                                 OCIO::INTERP_TETRAHEDRAL, payload));
+    OCIO_CHECK_NO_THROW(OCIO::AddSharedTexture(*generic, "lut1d", "5678", 4, 2,
+                                               OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                                               OCIO::INTERP_LINEAR, payload));
+
+    const float * vals = nullptr;
+    OCIO_CHECK_NO_THROW(generic->get3DTextureValues(0, vals));
+    OCIO_CHECK_EQUAL(vals, values->data());
+    OCIO_CHECK_NO_THROW(generic->getTextureValues(0, vals));
+    OCIO_CHECK_EQUAL(vals, values->data());
+
+    OCIO::GpuShaderDescRcPtr legacy = OCIO::GpuShaderDesc::CreateLegacyShaderDesc(2);
+    OCIO_CHECK_NO_THROW(OCIO::AddShared3DTexture(*legacy, "lut3d", "1234", 2,
+                                                 OCIO::INTERP_TETRAHEDRAL, payload));
+    OCIO_CHECK_NO_THROW(legacy->get3DTextureValues(0, vals));
+    OCIO_CHECK_EQUAL(vals, values->data());
+    OCIO_CHECK_THROW_WHAT(OCIO::AddShared3DTexture(*legacy, "lut3d", "1234", 2,
+                                                   OCIO::INTERP_TETRAHEDRAL, payload),
+                          OCIO::Exception,
+                          "only one 3D texture allowed");
+
+    // The payload outlives its owner.
+    values.reset();
+    OCIO_CHECK_EQUAL(vals[0], 0.5f);
+
+    OCIO_CHECK_THROW_WHAT(OCIO::AddShared3DTexture(*generic, "lut3d", "1234", 2,
+                                                   OCIO::INTERP_TETRAHEDRAL,
+                                                   OCIO::GpuTextureValuesRcPtr()),
+                          OCIO::Exception,
+                          "The buffer is invalid");
+
+    // The shader descriptions extracted from the same GPU processor share the
+    // LUT textures.
+    OCIO::GpuShaderCache::Clear();
+
+    OCIO::LUT3DTransformRcPtr lut3d = OCIO::LUT3DTransform::Create(17);
+    lut3d->setValue(16, 16, 16, 0.5f, 0.6f, 0.7f);
+    OCIO::LUT1DTransformRcPtr lut1d = OCIO::LUT1DTransform::Create(1024, false);
+    lut1d->setValue(1023, 0.9f, 0.8f, 0.7f);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(lut1d);
+    group->push_back(lut3d);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::ConstProcessorRcPtr proc = config->getProcessor(group);
+    OCIO::ConstGPUProcessorRcPtr gpu = proc->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr desc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO::GpuShaderDescRcPtr desc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc1));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc2));
+    OCIO_REQUIRE_EQUAL(desc1->getNumTextures(), 1U);
+    OCIO_REQUIRE_EQUAL(desc1->getNum3DTextures(), 1U);
+
+    const float * vals1 = nullptr;
+    const float * vals2 = nullptr;
+    OCIO_CHECK_NO_THROW(desc1->getTextureValues(0, vals1));
+    OCIO_CHECK_NO_THROW(desc2->getTextureValues(0, vals2));
+    OCIO_CHECK_EQUAL(vals1, vals2);
+
+    OCIO_CHECK_NO_THROW(desc1->get3DTextureValues(0, vals1));
+    OCIO_CHECK_NO_THROW(desc2->get3DTextureValues(0, vals2));
+    OCIO_CHECK_EQUAL(vals1, vals2);
+    OCIO_CHECK_EQUAL(vals1[17 * 17 * 17 * 3 - 3], 0.5f);
+
+    OCIO::GpuShaderCache::Clear();
+}
+
+OCIO_ADD_TEST(GpuShader, texture_formats)
+{
+    const unsigned edgelen = 2;
+    const unsigned size = edgelen*edgelen*edgelen*3;
+    const float values[size]
+        = { 0.1f, 0.2f, 0.3f,  0.4f, 0.5f, 0.6f,  0.7f, 0.8f, 0.9f,  -0.5f, 1.5f, 2.0f,
+            0.1f, 0.2f, 0.3f,  0.4f, 0.5f, 0.6f,  0.7f, 0.8f, 0.9f,  1e6f, 0.0f, 0.123456f };
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    OCIO_CHECK_EQUAL(shaderDesc->getTextureFormat(), OCIO::GpuShaderDesc::TEXTURE_FORMAT_FLOAT32);
+    // The texture format is part of the shader description parameters.
+    const std::string floatID(shaderDesc->OCIO::GpuShaderDesc::getCacheID());
+
+    // No packed values for 32-bit float textures.
+
+    OCIO_CHECK_NO_THROW(shaderDesc->add3DTexture("lut1", "1234", edgelen, 
+                                                 OCIO::INTERP_TETRAHEDRAL, &values[0]));
+    const void * packed = &values[0];
+    OCIO_CHECK_NO_THROW(shaderDesc->get3DTexturePackedValues(0, packed));
+    OCIO_CHECK_ASSERT(packed == nullptr);
+
+    float maxError = -1.0f;
+    float scale = 0.0f;
+    float offset = 1.0f;
+    OCIO_CHECK_NO_THROW(shaderDesc->get3DTexturePackingInfo(0, maxError, scale, offset));
+    OCIO_CHECK_EQUAL(maxError, 0.0f);
+
+    // Half float textures.
+
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_FLOAT16);
+    OCIO_CHECK_NE(std::string(shaderDesc->OCIO::GpuShaderDesc::getCacheID()), floatID);
+
+    OCIO_CHECK_NO_THROW(shaderDesc->add3DTexture("lut2", "1234", edgelen, 
+                                                 OCIO::INTERP_TETRAHEDRAL, &values[0]));
+    OCIO_CHECK_NO_THROW(shaderDesc->get3DTexturePackedValues(1, packed));
+    OCIO_REQUIRE_ASSERT(packed != nullptr);
+    OCIO_CHECK_NO_THROW(shaderDesc->get3DTexturePackingInfo(1, maxError, scale, offset));
+
+    // The float values are still available.
+    const float * vals = nullptr;
+    OCIO_CHECK_NO_THROW(shaderDesc->get3DTextureValues(1, vals));
+    OCIO_CHECK_EQUAL(vals[3], values[3]);
+
+    const unsigned short * halfs = static_cast<const unsigned short *>(packed);
+    float error = 0.0f;
+    for(unsigned idx=0; idx<size; ++idx)
+    {
+        half h;
+        h.setBits(halfs[idx]);
+        if(values[idx] > HALF_MAX)
+        {
+            // Out of range values are clamped.
+            OCIO_CHECK_EQUAL((float)h, HALF_MAX);
+        }
+        error = std::max(error, std::fabs((float)h - values[idx]));
+    }
+    OCIO_CHECK_EQUAL(error, maxError);
+    OCIO_CHECK_GT(maxError, 0.0f);
+
+    // 16-bit normalized textures.
+
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+
+    const float values1D[6] = { -0.25f, 0.0f, 0.5f,  1.0f, 0.75f, 0.3333333f };
+    OCIO_CHECK_NO_THROW(shaderDesc->addTexture("lut3", "1234", 2, 1,
+                                               OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL, 
+                                               OCIO::INTERP_LINEAR, &values1D[0]));
+    OCIO_CHECK_NO_THROW(shaderDesc->getTexturePackedValues(0, packed));
+    OCIO_REQUIRE_ASSERT(packed != nullptr);
+    OCIO_CHECK_NO_THROW(shaderDesc->getTexturePackingInfo(0, maxError, scale, offset));
+    OCIO_CHECK_EQUAL(scale, 1.25f);
+    OCIO_CHECK_EQUAL(offset, -0.25f);
+    OCIO_CHECK_LT(maxError, 1e-5f);
+
+    const unsigned short * unorms = static_cast<const unsigned short *>(packed);
+    OCIO_CHECK_EQUAL(unorms[0], 0);
+    OCIO_CHECK_EQUAL(unorms[3], 65535);
+    for(unsigned idx=0; idx<6; ++idx)
+    {
+        const float decoded = scale * ((float)unorms[idx] / 65535.0f) + offset;
+        OCIO_CHECK_ASSERT(std::fabs(decoded - values1D[idx]) <= maxError);
+    }
+
+    // The shader program decodes the normalized values.
+
+    OCIO::GpuShaderCache::Clear();
+
+    OCIO::LUT3DTransformRcPtr lut = OCIO::LUT3DTransform::Create(2);
+    lut->setValue(1, 1, 1, 2.0f, 2.0f, 2.0f);
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(lut)->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr desc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc));
+    OCIO_REQUIRE_EQUAL(desc->getNum3DTextures(), 1U);
+    OCIO_CHECK_NO_THROW(desc->get3DTexturePackingInfo(0, maxError, scale, offset));
+    OCIO_CHECK_EQUAL(scale, 2.0f);
+    OCIO_CHECK_EQUAL(offset, 0.0f);
+    OCIO_CHECK_NE(std::string(desc->getShaderText()).find("outColor.rgb = outColor.rgb * vec3(2"),
+                  std::string::npos);
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 1U);
+
+    // A later request with the default texture format must not find the normalized shader.
+
+    OCIO::GpuShaderDescRcPtr floatDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    floatDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(floatDesc));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 2U);
+    OCIO_REQUIRE_EQUAL(floatDesc->getNum3DTextures(), 1U);
+    OCIO_CHECK_NO_THROW(floatDesc->get3DTexturePackedValues(0, packed));
+    OCIO_CHECK_ASSERT(packed == nullptr);
+    OCIO_CHECK_EQUAL(std::string(floatDesc->getShaderText()).find("outColor.rgb * vec3(2"),
+                     std::string::npos);
+
+    // Each request is then found in the cache.
+
+    OCIO::GpuShaderDescRcPtr unormDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    unormDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    unormDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(unormDesc));
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderCache::GetNumEntries(), 2U);
+    OCIO_CHECK_EQUAL(std::string(unormDesc->getShaderText()), std::string(desc->getShaderText()));
+
+    OCIO::GpuShaderCache::Clear();
+}
+
+OCIO_ADD_TEST(GpuShader, parameter_uniforms)
+{
+    OCIO::GpuShaderCache::Clear();
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    OCIO::CDLTransformRcPtr cdl1 = OCIO::CDLTransform::Create();
+    const double slope1[3] = { 1.5, 1.2, 1.1 };
+    const double power1[3] = { 1.2, 1.0, 0.9 };
+    cdl1->setSlope(slope1);
+    cdl1->setPower(power1);
+    cdl1->setSat(0.8);
+
+    OCIO::CDLTransformRcPtr cdl2 = OCIO::CDLTransform::Create();
+    const double slope2[3] = { 0.5, 0.7, 0.9 };
+    const double power2[3] = { 0.9, 1.1, 1.0 };
+    cdl2->setSlope(slope2);
+    cdl2->setPower(power2);
+    cdl2->setSat(1.2);
+
+    OCIO::ConstGPUProcessorRcPtr gpu1 = config->getProcessor(cdl1)->getDefaultGPUProcessor();
+    OCIO::ConstGPUProcessorRcPtr gpu2 = config->getProcessor(cdl2)->getDefaultGPUProcessor();
+
+    // Constant parameters.
+
+    OCIO::GpuShaderDescRcPtr desc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_EQUAL(desc->getParameterMode(), OCIO::GpuShaderDesc::PARAMETER_CONSTANT);
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(desc));
+    OCIO_CHECK_EQUAL(desc->getNumUniforms(), 0U);
+    OCIO_CHECK_NE(std::string(desc->getShaderText()).find("vec3 slope = vec3(1.5, "),
+                  std::string::npos);
+
+    // Uniform parameters i.e. the same shader program for different values.
+
+    OCIO::GpuShaderDescRcPtr desc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc1->setParameterMode(OCIO::GpuShaderDesc::PARAMETER_UNIFORM);
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(desc1));
+
+    OCIO::GpuShaderDescRcPtr desc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc2->setParameterMode(OCIO::GpuShaderDesc::PARAMETER_UNIFORM);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(desc2));
+
+    const std::string text(desc1->getShaderText());
+    OCIO_CHECK_EQUAL(text, std::string(desc2->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(desc1->getCacheID()), std::string(desc2->getCacheID()));
+    OCIO_CHECK_NE(text.find("uniform float ocio_slope_r_0;"), std::string::npos);
+    OCIO_CHECK_NE(text.find("float saturation = ocio_saturation_9;"), std::string::npos);
+
+    // Slope, offset & power vectors and the saturation.
+    OCIO_REQUIRE_EQUAL(desc1->getNumUniforms(), 10U);
+    OCIO_REQUIRE_EQUAL(desc2->getNumUniforms(), 10U);
+
+    const char * name = nullptr;
+    OCIO::DynamicPropertyRcPtr value1;
+    OCIO::DynamicPropertyRcPtr value2;
+    desc1->getUniform(0, name, value1);
+    OCIO_CHECK_EQUAL(std::string(name), "ocio_slope_r_0");
+    OCIO_CHECK_EQUAL(value1->getType(), OCIO::DYNAMIC_PROPERTY_PARAMETER);
+    desc2->getUniform(0, name, value2);
+    OCIO_CHECK_CLOSE(value1->getDoubleValue(), 1.5, 1e-6);
+    OCIO_CHECK_CLOSE(value2->getDoubleValue(), 0.5, 1e-6);
+
+    desc1->getUniform(9, name, value1);
+    desc2->getUniform(9, name, value2);
+    OCIO_CHECK_CLOSE(value1->getDoubleValue(), 0.8, 1e-6);
+    OCIO_CHECK_CLOSE(value2->getDoubleValue(), 1.2, 1e-6);
+
+    // A cached shader program holds the values of its processor.
+    OCIO::GpuShaderDescRcPtr desc3 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc3->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc3->setParameterMode(OCIO::GpuShaderDesc::PARAMETER_UNIFORM);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(desc3));
+    OCIO_REQUIRE_EQUAL(desc3->getNumUniforms(), 10U);
+    desc3->getUniform(0, name, value2);
+    OCIO_CHECK_CLOSE(value2->getDoubleValue(), 0.5, 1e-6);
+
+    // A later request with constant parameters must not find the uniform shader.
+
+    OCIO::GpuShaderDescRcPtr constDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    constDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(constDesc));
+    OCIO_CHECK_EQUAL(constDesc->getNumUniforms(), 0U);
+    OCIO_CHECK_EQUAL(std::string(constDesc->getShaderText()).find("uniform float"),
+                     std::string::npos);
+    OCIO_CHECK_NE(std::string(constDesc->getShaderText()).find("vec3 slope = vec3(0.5, "),
+                  std::string::npos);
+
+    // Uniform block.
+
+    OCIO::GpuShaderDescRcPtr desc4 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc4->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    desc4->setParameterMode(OCIO::GpuShaderDesc::PARAMETER_UNIFORM_BLOCK);
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(desc4));
+    OCIO_CHECK_EQUAL(desc4->getNumUniforms(), 10U);
+
+    const std::string blockText(desc4->getShaderText());
+    OCIO_CHECK_NE(blockText.find("layout(std140) uniform ocio_parameters"), std::string::npos);
+    OCIO_CHECK_NE(blockText.find("float ocio_saturation_9;"), std::string::npos);
+    OCIO_CHECK_EQUAL(blockText.find("uniform float"), std::string::npos);
+
+    OCIO::GpuShaderDescRcPtr desc5 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc5->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc5->setParameterMode(OCIO::GpuShaderDesc::PARAMETER_UNIFORM_BLOCK);
+    OCIO_CHECK_THROW_WHAT(gpu1->extractGpuShaderInfo(desc5), OCIO::Exception,
+                          "Uniform blocks are not supported by the shader language");
+
+    OCIO::GpuShaderCache::Clear();
+}
+
+namespace
+{
+OCIO::ConstGPUProcessorRcPtr CreateMatricesCDL(const float * m44, const double * slope)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    OCIO::MatrixTransformRcPtr matrix1 = OCIO::MatrixTransform::Create();
+    matrix1->setMatrix(m44);
+
+    OCIO::MatrixTransformRcPtr matrix2 = OCIO::MatrixTransform::Create();
+    matrix2->setMatrix(m44);
+
+    OCIO::CDLTransformRcPtr cdl = OCIO::CDLTransform::Create();
+    cdl->setSlope(slope);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(matrix1);
+    group->push_back(matrix2);
+    group->push_back(cdl);
+
+    return config->getProcessor(group)->getDefaultGPUProcessor();
+}
+}
+
+OCIO_ADD_TEST(GpuShader, parameter_uniforms_identity)
+{
+    OCIO::GpuShaderCache::Clear();
+
+    const float identity[16] = { 1.0f, 0.0f, 0.0f, 0.0f,
+                                 0.0f, 1.0f, 0.0f, 0.0f,
+                                 0.0f, 0.0f, 1.0f, 0.0f,
+                                 0.0f, 0.0f, 0.0f, 1.0f };
+    const double identitySlope[3] = { 1.0, 1.0, 1.0 };
+
+    const float m44[16] = { 0.8f, 0.1f, 0.1f, 0.0f,
+                            0.2f, 0.7f, 0.1f, 0.0f,
+                            0.1f, 0.1f, 0.8f, 0.0f,
+                            0.0f, 0.0f, 0.0f, 1.0f };
+    const double slope[3] = { 1.5, 1.2, 1.1 };
+
+    OCIO::ConstGPUProcessorRcPtr gpu1 = CreateMatricesCDL(identity, identitySlope);
+    OCIO::ConstGPUProcessorRcPtr gpu2 = CreateMatricesCDL(m44, slope);
+
+    // With constant parameters, the identity matrices are removed whereas the
+    // others are combined into a single matrix.
+
+    OCIO::GpuShaderDescRcPtr constDesc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    constDesc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(constDesc1));
+
+    OCIO::GpuShaderDescRcPtr constDesc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    constDesc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(constDesc2));
+
+    OCIO_CHECK_NE(std::string(constDesc1->getShaderText()),
+                  std::string(constDesc2->getShaderText()));
+
+    // With uniform parameters, the shader program does not depend on the values.
+
+    OCIO::GpuShaderDescRcPtr desc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc1->setParameterMode(OCIO::GpuShaderDesc::PARAMETER_UNIFORM);
+    OCIO_CHECK_NO_THROW(gpu1->extractGpuShaderInfo(desc1));
+
+    OCIO::GpuShaderDescRcPtr desc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    desc2->setParameterMode(OCIO::GpuShaderDesc::PARAMETER_UNIFORM);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(desc2));
+
+    OCIO_CHECK_EQUAL(std::string(desc1->getShaderText()), std::string(desc2->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(desc1->getCacheID()), std::string(desc2->getCacheID()));
+
+    // The two matrices and the CDL are all kept.
+    OCIO_CHECK_EQUAL(desc1->getNumUniforms(), 2 * 20U + 10U);
+    OCIO_CHECK_EQUAL(desc2->getNumUniforms(), desc1->getNumUniforms());
+
+    const char * name1 = nullptr;
+    const char * name2 = nullptr;
+    OCIO::DynamicPropertyRcPtr value1;
+    OCIO::DynamicPropertyRcPtr value2;
+    for (unsigned idx = 0; idx < desc1->getNumUniforms(); ++idx)
+    {
+        desc1->getUniform(idx, name1, value1);
+        desc2->getUniform(idx, name2, value2);
+        OCIO_CHECK_EQUAL(std::string(name1), std::string(name2));
+    }
+
+    desc1->getUniform(0, name1, value1);
+    desc2->getUniform(0, name2, value2);
+    OCIO_CHECK_CLOSE(value1->getDoubleValue(), 1.0, 1e-6);
+    OCIO_CHECK_CLOSE(value2->getDoubleValue(), 0.8, 1e-6);
+
+    OCIO::GpuShaderCache::Clear();
+}
+
 #endif
\ No newline at end of file
@@ -11,6 +11,11 @@
 OCIO_NAMESPACE_ENTER
 {
 
+// Immutable texture values.  The payload is shared (i.e. not copied) between
+// the shader descriptions holding the texture, and with its owner (e.g. the
+// LUT op data) when created from an existing buffer.
+typedef OCIO_SHARED_PTR<const float> GpuTextureValuesRcPtr;
+
 ///////////////////////////////////////////////////////////////////////////
 
 // LegacyGpuShaderDesc
@@ -36,6 +41,13 @@ public:
                       const char *& id, unsigned & edgelen, 
                       Interpolation & interpolation) const override;
     void get3DTextureValues(unsigned index, const float *& value) const override;
+    void get3DTexturePackedValues(unsigned index, const void *& values) const override;
+    void get3DTexturePackingInfo(unsigned index, float & maxError,
+                                 float & scale, float & offset) const override;
+    // Add a 3D texture sharing the values instead of copying them
+    void addShared3DTexture(const char * name, const char * id, unsigned edgelen,
+                            Interpolation interpolation,
+                            const GpuTextureValuesRcPtr & values);
 
     // Get the complete shader text
     const char * getShaderText() const override;
@@ -87,6 +99,9 @@ protected:
                     Interpolation & interpolation) const override;
     // Get the texture 1D or 2D values only
     void getTextureValues(unsigned index, const float *& values) const override;
+    void getTexturePackedValues(unsigned index, const void *& values) const override;
+    void getTexturePackingInfo(unsigned index, float & maxError,
+                               float & scale, float & offset) const override;
 
 private:
     LegacyGpuShaderDesc();
@@ -100,6 +115,7 @@ private:
     
     class Impl;
     friend class Impl;
+    friend class GpuShaderCache;
     Impl * m_impl;
     Impl * getImpl() { return m_impl; }
     const Impl * getImpl() const { return m_impl; }
@@ -143,6 +159,14 @@ public:
                     TextureType & channel,
                     Interpolation & interpolation) const override;
     void getTextureValues(unsigned index, const float *& values) const override;
+    void getTexturePackedValues(unsigned index, const void *& values) const override;
+    void getTexturePackingInfo(unsigned index, float & maxError,
+                               float & scale, float & offset) const override;
+    // Add a texture sharing the values instead of copying them
+    void addSharedTexture(const char * name, const char * id,
+                          unsigned width, unsigned height, TextureType channel,
+                          Interpolation interpolation,
+                          const GpuTextureValuesRcPtr & values);
 
     // Accessors to the 3D textures built from 3D LUT
     //
@@ -153,6 +177,13 @@ public:
                       const char *& id, unsigned & edgelen, 
                       Interpolation & interpolation) const override;
     void get3DTextureValues(unsigned index, const float *& value) const override;
+    void get3DTexturePackedValues(unsigned index, const void *& values) const override;
+    void get3DTexturePackingInfo(unsigned index, float & maxError,
+                                 float & scale, float & offset) const override;
+    // Add a 3D texture sharing the values instead of copying them
+    void addShared3DTexture(const char * name, const char * id, unsigned edgelen,
+                            Interpolation interpolation,
+                            const GpuTextureValuesRcPtr & values);
 
     // Get the complete shader text
     const char * getShaderText() const override;
@@ -189,11 +220,83 @@ private:
     
     class Impl;
     friend class Impl;
+    friend class GpuShaderCache;
     Impl * m_impl;
     Impl * getImpl() { return m_impl; }
     const Impl * getImpl() const { return m_impl; }
 };
 
+
+///////////////////////////////////////////////////////////////////////////
+
+// Range of the finite texture values used by the GpuShaderDesc::TEXTURE_FORMAT_UNORM16
+// texture format i.e. value = scale * normalized + offset.  The shader programs
+// reading such a texture must decode the sampled values with it.
+void GetUnorm16TextureRange(const float * values, size_t numValues,
+                            float & scale, float & offset);
+
+// Add a texture to the shader description sharing the values when it is one
+// created by OCIO, or copying them otherwise (i.e. custom implementation).
+void AddSharedTexture(GpuShaderDesc & shaderDesc, const char * name, const char * id,
+                      unsigned width, unsigned height,
+                      GpuShaderDesc::TextureType channel,
+                      Interpolation interpolation,
+                      const GpuTextureValuesRcPtr & values);
+
+void AddShared3DTexture(GpuShaderDesc & shaderDesc, const char * name, const char * id,
+                        unsigned edgelen, Interpolation interpolation,
+                        const GpuTextureValuesRcPtr & values);
+
+
+///////////////////////////////////////////////////////////////////////////
+
+// GpuShaderCache
+// *************
+// 
+// Global cache of the shader programs extracted from the GPU processors. An entry
+// holds everything produced by the extraction (i.e. the shader text, the textures
+// and the uniforms) and is identified by the GPU processor cache identifier and
+// the shader description parameters (i.e. type, language, function name, pixel
+// name and resource prefix).
+//
+// Only the shader descriptions created by OCIO are cached, and only when they are
+// still empty before the extraction, as a custom implementation could hold
+// anything.
+//
+// The number of entries is capped, the least recently used entry being evicted
+// when a new one is added to a full cache.
+// 
+
+class GpuShaderCache
+{
+public:
+    // Can the shader description be filled from, or added to, the cache?
+    static bool IsCacheable(const GpuShaderDesc & shaderDesc);
+
+    // Fill the shader description from the cache, returns false if not found.
+    static bool Get(const std::string & processorCacheID, GpuShaderDesc & shaderDesc);
+
+    // Add a copy of the finalized shader description to the cache.
+    static void Add(const std::string & processorCacheID, const GpuShaderDesc & shaderDesc);
+
+    static size_t GetNumEntries();
+    static void Clear();
+
+    // Maximum number of entries, a smaller one evicts the least recently used
+    // entries in excess.
+    static size_t GetMaxEntries();
+    static void SetMaxEntries(size_t maxEntries);
+
+private:
+    // Identify the parameters of a shader description, or return an empty
+    // string for a shader description which can't be cached.
+    static std::string GetKey(const GpuShaderDesc & shaderDesc);
+
+    // Copy the content of a shader description created by OCIO into another one
+    // of the same type.
+    static void Copy(const GpuShaderDesc & src, GpuShaderDesc & dst);
+};
+
 }
 OCIO_NAMESPACE_EXIT
 
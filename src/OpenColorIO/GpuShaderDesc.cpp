@@ -17,6 +17,8 @@ OCIO_NAMESPACE_ENTER
         std::string functionName_;
         std::string resourcePrefix_;
         std::string pixelName_;
+        TextureFormat textureFormat_;
+        ParameterMode parameterMode_;
         
         mutable std::string cacheID_;
         mutable Mutex cacheIDMutex_;
@@ -26,6 +28,8 @@ OCIO_NAMESPACE_ENTER
             ,   functionName_("OCIOMain")
             ,   resourcePrefix_("ocio")
             ,   pixelName_("outColor")
+            ,   textureFormat_(TEXTURE_FORMAT_FLOAT32)
+            ,   parameterMode_(PARAMETER_CONSTANT)
         {
         }
         
@@ -40,6 +44,8 @@ OCIO_NAMESPACE_ENTER
                 functionName_ = rhs.functionName_;
                 resourcePrefix_ = rhs.resourcePrefix_;
                 pixelName_ = rhs.pixelName_;
+                textureFormat_ = rhs.textureFormat_;
+                parameterMode_ = rhs.parameterMode_;
                 cacheID_ = rhs.cacheID_;
             }
             return *this;
@@ -117,6 +123,59 @@ OCIO_NAMESPACE_ENTER
         return getImpl()->pixelName_.c_str();
     }
 
+    void GpuShaderDesc::setTextureFormat(TextureFormat format)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->textureFormat_ = format;
+        getImpl()->cacheID_       = "";
+    }
+
+    GpuShaderDesc::TextureFormat GpuShaderDesc::getTextureFormat() const
+    {
+        return getImpl()->textureFormat_;
+    }
+
+    void GpuShaderDesc::setParameterMode(ParameterMode mode)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->parameterMode_ = mode;
+        getImpl()->cacheID_       = "";
+    }
+
+    GpuShaderDesc::ParameterMode GpuShaderDesc::getParameterMode() const
+    {
+        return getImpl()->parameterMode_;
+    }
+
+    // The 16-bit texture formats are optional for a shader description implementation
+    // so, by default, there are no packed values to decode.
+
+    void GpuShaderDesc::getTexturePackedValues(unsigned, const void *& values) const
+    {
+        values = nullptr;
+    }
+
+    void GpuShaderDesc::getTexturePackingInfo(unsigned, float & maxError,
+                                              float & scale, float & offset) const
+    {
+        maxError = 0.0f;
+        scale    = 1.0f;
+        offset   = 0.0f;
+    }
+
+    void GpuShaderDesc::get3DTexturePackedValues(unsigned, const void *& values) const
+    {
+        values = nullptr;
+    }
+
+    void GpuShaderDesc::get3DTexturePackingInfo(unsigned, float & maxError,
+                                                float & scale, float & offset) const
+    {
+        maxError = 0.0f;
+        scale    = 1.0f;
+        offset   = 0.0f;
+    }
+
     const char * GpuShaderDesc::getCacheID() const
     {
         AutoMutex lock(getImpl()->cacheIDMutex_);
@@ -128,6 +187,22 @@ OCIO_NAMESPACE_ENTER
             os << getImpl()->functionName_ << " ";
             os << getImpl()->resourcePrefix_ << " ";
             os << getImpl()->pixelName_ << " ";
+            if(getImpl()->textureFormat_==TEXTURE_FORMAT_FLOAT16)
+            {
+                os << "half ";
+            }
+            else if(getImpl()->textureFormat_==TEXTURE_FORMAT_UNORM16)
+            {
+                os << "unorm16 ";
+            }
+            if(getImpl()->parameterMode_==PARAMETER_UNIFORM)
+            {
+                os << "uniforms ";
+            }
+            else if(getImpl()->parameterMode_==PARAMETER_UNIFORM_BLOCK)
+            {
+                os << "block ";
+            }
             getImpl()->cacheID_ = os.str();
         }
         
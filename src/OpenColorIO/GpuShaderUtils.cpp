@@ -3,10 +3,12 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "DynamicProperty.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 
 #include <math.h>
+#include <vector>
 
 
 OCIO_NAMESPACE_ENTER
@@ -34,6 +36,12 @@ OCIO_NAMESPACE_ENTER
         return oss.str();
     }
 
+    // Strings are already formatted (e.g. uniform names).
+    std::string getFloatString(const std::string & v, GpuLanguage)
+    {
+        return v;
+    }
+
     template<int N>
     std::string getVecKeyword(GpuLanguage lang)
     {
@@ -186,32 +194,32 @@ OCIO_NAMESPACE_ENTER
     {
         if (str)
         {
-            m_text->m_ossLine << str;
+            m_text->m_line += str;
         }
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(float value)
     {
-        m_text->m_ossLine << getFloatString(value, m_text->m_lang);
+        m_text->m_line += getFloatString(value, m_text->m_lang);
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(double value)
     {
-        m_text->m_ossLine << getFloatString(value, m_text->m_lang);
+        m_text->m_line += getFloatString(value, m_text->m_lang);
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(unsigned value)
     {
-        m_text->m_ossLine << value;
+        m_text->m_line += std::to_string(value);
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(const std::string& str)
     {
-        m_text->m_ossLine << str;
+        m_text->m_line += str;
         return *this;
     }
 
@@ -228,8 +236,9 @@ OCIO_NAMESPACE_ENTER
         :   m_lang(lang)
         ,   m_indent(0)
     {
-        m_ossText.precision(16);
-        m_ossLine.precision(16);
+        // Most op shader programs fit without any reallocation.
+        m_text.reserve(1024);
+        m_line.reserve(256);
     }
 
     void GpuShaderText::setIndent(unsigned i)
@@ -252,21 +261,20 @@ OCIO_NAMESPACE_ENTER
         return GpuShaderText::GpuShaderLine(this);
     }
 
-    std::string GpuShaderText::string() const
+    const std::string & GpuShaderText::string() const
     {
-        return m_ossText.str();
+        return m_text;
     }
 
     void GpuShaderText::flushLine()
     {
         static const unsigned tabSize = 2;
 
-        m_ossText << std::string(tabSize * m_indent, ' ')
-                  << m_ossLine.str()
-                  << std::endl;
+        m_text.append(tabSize * m_indent, ' ');
+        m_text += m_line;
+        m_text += '\n';
 
-        m_ossLine.str("");
-        m_ossLine.clear();
+        m_line.clear();
     }
 
     void GpuShaderText::declareVar(const std::string & name, float v)
@@ -598,6 +606,12 @@ OCIO_NAMESPACE_ENTER
         return matrix4Mul<double>(m4x4, vecName, m_lang);
     }
 
+    std::string GpuShaderText::mat4fMul(const std::string * m4x4, 
+                                        const std::string & vecName) const
+    {
+        return matrix4Mul<std::string>(m4x4, vecName, m_lang);
+    }
+
     std::string GpuShaderText::lerp(const std::string & x, 
                                     const std::string & y, 
                                     const std::string & a) const
@@ -688,6 +702,135 @@ OCIO_NAMESPACE_ENTER
         }
         return kw.str();
     }
+
+    namespace
+    {
+        template<typename T>
+        std::string AddParameterT(GpuShaderDescRcPtr & shaderDesc,
+                                  const std::string & name, T value)
+        {
+            const GpuShaderDesc::ParameterMode mode = shaderDesc->getParameterMode();
+            if (mode == GpuShaderDesc::PARAMETER_CONSTANT)
+            {
+                return getFloatString(value, shaderDesc->getLanguage());
+            }
+
+            // The uniform index makes the name unique.
+            std::ostringstream oss;
+            oss << shaderDesc->getResourcePrefix() << "_" << name
+                << "_" << shaderDesc->getNumUniforms();
+            const std::string uniformName = oss.str();
+
+            DynamicPropertyRcPtr prop
+                = std::make_shared<DynamicPropertyImpl>(DYNAMIC_PROPERTY_PARAMETER,
+                                                        (double)value, true);
+            shaderDesc->addUniform(uniformName.c_str(), prop);
+
+            // The uniform block is declared once all the parameters are known.
+            if (mode == GpuShaderDesc::PARAMETER_UNIFORM)
+            {
+                GpuShaderText st(shaderDesc->getLanguage());
+                st.declareUniformFloat(uniformName);
+                shaderDesc->addToDeclareShaderCode(st.string().c_str());
+            }
+
+            return uniformName;
+        }
+    }
+
+    std::string AddParameter(GpuShaderDescRcPtr & shaderDesc,
+                             const std::string & name, float value)
+    {
+        return AddParameterT(shaderDesc, name, value);
+    }
+
+    std::string AddParameter(GpuShaderDescRcPtr & shaderDesc,
+                             const std::string & name, double value)
+    {
+        return AddParameterT(shaderDesc, name, value);
+    }
+
+    void DeclareVec3fParameter(GpuShaderDescRcPtr & shaderDesc, GpuShaderText & st,
+                               const std::string & name, float x, float y, float z)
+    {
+        // The uniforms are added in the channel order.
+        const std::string r = AddParameter(shaderDesc, name + "_r", x);
+        const std::string g = AddParameter(shaderDesc, name + "_g", y);
+        const std::string b = AddParameter(shaderDesc, name + "_b", z);
+        st.declareVec3f(name, r, g, b);
+    }
+
+    void DeclareVec3fParameter(GpuShaderDescRcPtr & shaderDesc, GpuShaderText & st,
+                               const std::string & name, double x, double y, double z)
+    {
+        const std::string r = AddParameter(shaderDesc, name + "_r", x);
+        const std::string g = AddParameter(shaderDesc, name + "_g", y);
+        const std::string b = AddParameter(shaderDesc, name + "_b", z);
+        st.declareVec3f(name, r, g, b);
+    }
+
+    void DeclareParameterBlock(GpuShaderDescRcPtr & shaderDesc)
+    {
+        if (shaderDesc->getParameterMode() != GpuShaderDesc::PARAMETER_UNIFORM_BLOCK)
+        {
+            return;
+        }
+
+        std::vector<std::string> members;
+        for (unsigned idx = 0; idx < shaderDesc->getNumUniforms(); ++idx)
+        {
+            const char * name = nullptr;
+            DynamicPropertyRcPtr value;
+            shaderDesc->getUniform(idx, name, value);
+            if (value->getType() == DYNAMIC_PROPERTY_PARAMETER)
+            {
+                members.push_back(name);
+            }
+        }
+
+        if (members.empty())
+        {
+            return;
+        }
+
+        const std::string blockName = std::string(shaderDesc->getResourcePrefix()) + "_parameters";
+
+        GpuShaderText st(shaderDesc->getLanguage());
+        switch (shaderDesc->getLanguage())
+        {
+            case GPU_LANGUAGE_GLSL_4_0:
+            {
+                st.newLine() << "layout(std140) uniform " << blockName;
+                break;
+            }
+            case GPU_LANGUAGE_HLSL_DX11:
+            {
+                // Consecutive floats are packed as with std140.
+                st.newLine() << "cbuffer " << blockName;
+                break;
+            }
+
+            case GPU_LANGUAGE_GLSL_1_0:
+            case GPU_LANGUAGE_GLSL_1_3:
+            case GPU_LANGUAGE_CG:
+            case GPU_LANGUAGE_UNKNOWN:
+            default:
+            {
+                throw Exception("Uniform blocks are not supported by the shader language");
+            }
+        }
+
+        st.newLine() << "{";
+        st.indent();
+        for (const auto & member : members)
+        {
+            st.newLine() << "float " << member << ";";
+        }
+        st.dedent();
+        st.newLine() << "};";
+
+        shaderDesc->addToDeclareShaderCode(st.string().c_str());
+    }
 }
 OCIO_NAMESPACE_EXIT
 
@@ -709,4 +852,26 @@ OCIO_ADD_TEST(GpuShaderUtils, FloatToString)
     OCIO_CHECK_EQUAL(OCIO::getFloatString((float)1, OCIO::GPU_LANGUAGE_GLSL_1_3), "1.");
 }
 
+OCIO_ADD_TEST(GpuShaderUtils, ShaderText)
+{
+    OCIO::GpuShaderText st(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    st.newLine() << "{";
+    st.indent();
+    st.newLine() << "float v = " << 0.5f << " * " << 2.0 << ";";
+    st.newLine() << "int i = " << 12u << ";";
+    st.dedent();
+    st.newLine() << "}";
+
+    OCIO_CHECK_EQUAL(st.string(), "{\n  float v = 0.5 * 2.;\n  int i = 12;\n}\n");
+
+    // Lines longer than the reserved sizes.
+    const std::string name(300, 'a');
+    for (unsigned idx = 0; idx < 10; ++idx)
+    {
+        st.newLine() << name;
+    }
+    OCIO_CHECK_EQUAL(st.string().size(), 40 + 10 * 301U);
+    OCIO_CHECK_EQUAL(st.string().substr(40, 301), name + "\n");
+}
+
 #endif // OCIO_UNIT_TEST
@@ -52,7 +52,7 @@ OCIO_NAMESPACE_ENTER
         GpuShaderLine newLine();
 
         // Get the shader string produced so far
-        std::string string() const;
+        const std::string & string() const;
 
         //
         // Indentation helper functions
@@ -163,6 +163,7 @@ OCIO_NAMESPACE_ENTER
         // Get the string for multiplying a 4x4 matrix and a four-element vector
         std::string mat4fMul(const float * m4x4, const std::string & vecName) const;
         std::string mat4fMul(const double * m4x4, const std::string & vecName) const;
+        std::string mat4fMul(const std::string * m4x4, const std::string & vecName) const;
 
         //
         // Special function helpers
@@ -192,21 +193,46 @@ OCIO_NAMESPACE_ENTER
     private:
         // Shader language to use in the various shader text builder methods.
         GpuLanguage m_lang; 
-        // String stream containing the current shader text.
-        std::ostringstream m_ossText;
-
-        // In order to avoid repeated allocations of an output string stream 
-        // for multiple shader lines, create a single ostringstream instance 
-        // on the shader text and just reset it after a line has  been added 
-        // to the text. This should not pose a racing problem since we're only 
-        // creating a single line at a time for a given shader text.
+        // Current shader text.  The lines are directly appended to a reserved
+        // string to avoid the string stream overhead (i.e. extra copies).
+        std::string m_text;
+
+        // In order to avoid repeated allocations for multiple shader lines,
+        // create a single string instance on the shader text and just clear it
+        // (i.e. keeping its capacity) after a line has been added to the text.
+        // This should not pose a racing problem since we're only creating a
+        // single line at a time for a given shader text.
         
-        // String stream containing the current shader line.
-        std::ostringstream m_ossLine;
+        // Current shader line.
+        std::string m_line;
 
         // Indentation level to use for the next line.
         unsigned m_indent;
     };
+
+    //
+    // Op parameter helpers
+    //
+    // Depending on the parameter mode of the shader description (refer to
+    // GpuShaderDesc::setParameterMode), an op parameter is either a constant
+    // or held by a uniform named from the parameter name and the uniform index.
+    //
+
+    // Get the string of the op parameter value i.e. a constant or a uniform name.
+    std::string AddParameter(GpuShaderDescRcPtr & shaderDesc,
+                             const std::string & name, float value);
+    std::string AddParameter(GpuShaderDescRcPtr & shaderDesc,
+                             const std::string & name, double value);
+
+    // Declare and initialize a vector with three elements from op parameters.
+    void DeclareVec3fParameter(GpuShaderDescRcPtr & shaderDesc, GpuShaderText & st,
+                               const std::string & name, float x, float y, float z);
+    void DeclareVec3fParameter(GpuShaderDescRcPtr & shaderDesc, GpuShaderText & st,
+                               const std::string & name, double x, double y, double z);
+
+    // Declare the uniform block holding the op parameters, if any, when requested
+    // by the shader description.  Must be called once all the ops were processed.
+    void DeclareParameterBlock(GpuShaderDescRcPtr & shaderDesc);
 }
 OCIO_NAMESPACE_EXIT
 
@@ -41,6 +41,18 @@ OCIO_NAMESPACE_ENTER
             os << "yStrideBytes=" << planarImg->getYStrideBytes() << "";
             os << ">";
         }
+        else if(const BitPackedImageDesc * bitPackedImg = dynamic_cast<const BitPackedImageDesc*>(&img))
+        {
+            os << "<BitPackedImageDesc ";
+            os << "data=" << bitPackedImg->getData() << ", ";
+            os << "bitPacking=" << bitPackedImg->getBitPacking() << ", ";
+            os << "bigEndian=" << (bitPackedImg->isBigEndian() ? "true" : "false") << ", ";
+            os << "width=" << bitPackedImg->getWidth() << ", ";
+            os << "height=" << bitPackedImg->getHeight() << ", ";
+            os << "numChannels=" << bitPackedImg->getNumChannels() << ", ";
+            os << "yStrideBytes=" << bitPackedImg->getYStrideBytes() << "";
+            os << ">";
+        }
         else
         {
             os << "<ImageDesc ";
@@ -90,6 +102,18 @@ OCIO_NAMESPACE_ENTER
         m_isRGBAPacked = img.isRGBAPacked();
         m_isFloat      = img.isFloat();
 
+        if(const BitPackedImageDesc * bitPackedImg = dynamic_cast<const BitPackedImageDesc*>(&img))
+        {
+            m_isBitPacked = true;
+            m_bitPacking  = bitPackedImg->getBitPacking();
+            m_numChannels = bitPackedImg->getNumChannels();
+            m_swapBytes   = bitPackedImg->isBigEndian()!=IsHostBigEndian();
+        }
+        else
+        {
+            m_isBitPacked = false;
+        }
+
         if(img.getBitDepth()!=bitDepth)
         {
             throw Exception("Bit-depth mismatch between the image buffer and the finalization setting.");
@@ -111,6 +135,11 @@ OCIO_NAMESPACE_ENTER
         return m_isFloat;
     }
 
+    bool GenericImageDesc::hasAlpha() const
+    {
+        return m_isBitPacked ? m_numChannels==4 : m_aData!=nullptr;
+    }
+
 
     ///////////////////////////////////////////////////////////////////////////
 
@@ -199,8 +228,11 @@ OCIO_NAMESPACE_ENTER
                     }
                     break;
                 }
+                case BIT_DEPTH_UINT10:
+                case BIT_DEPTH_UINT12:
                 case BIT_DEPTH_UINT16:
                 {
+                    // Note: The 10 and 12-bit values are stored in 16-bit containers.
                     if(m_chanStrideBytes!=sizeof(BitDepthInfo<BIT_DEPTH_UINT16>::Type))
                     {
                         return false;
@@ -213,6 +245,7 @@ OCIO_NAMESPACE_ENTER
                     {
                         return false;
                     }
+                    break;
                 }
                 case BIT_DEPTH_F32:
                 {
@@ -760,5 +793,172 @@ OCIO_NAMESPACE_ENTER
     {
         return getImpl()->m_isFloat;
     }
+
+
+    ///////////////////////////////////////////////////////////////////////////
+
+
+    struct BitPackedImageDesc::Impl
+    {
+        void * m_data = nullptr;
+
+        BitPacking m_bitPacking = BIT_PACKING_10_FILLED_A;
+        bool m_bigEndian = false;
+
+        long m_width = 0;
+        long m_height = 0;
+        long m_numChannels = 0;
+
+        ptrdiff_t m_yStrideBytes = 0;
+
+        BitDepth getBitDepth() const
+        {
+            return m_bitPacking==BIT_PACKING_12_PACKED ? BIT_DEPTH_UINT12 : BIT_DEPTH_UINT10;
+        }
+
+        // Number of bytes of the words holding one line.
+        ptrdiff_t getLineBytes() const
+        {
+            const ptrdiff_t numWords
+                = m_bitPacking==BIT_PACKING_12_PACKED ? (m_width * m_numChannels * 12 + 31) / 32
+                                                      : m_width;
+
+            return numWords * sizeof(uint32_t);
+        }
+
+        void validate() const
+        {
+            if(m_data==nullptr)
+            {
+                throw Exception("BitPackedImageDesc Error: Invalid image buffer.");
+            }
+
+            if(m_width<=0 || m_height<=0)
+            {
+                throw Exception("BitPackedImageDesc Error: Invalid image dimensions.");
+            }
+
+            if(m_bitPacking!=BIT_PACKING_10_FILLED_A
+                && m_bitPacking!=BIT_PACKING_10_FILLED_B
+                && m_bitPacking!=BIT_PACKING_12_PACKED)
+            {
+                throw Exception("BitPackedImageDesc Error: Unknown bit packing.");
+            }
+
+            if(m_bitPacking==BIT_PACKING_12_PACKED ? (m_numChannels<3 || m_numChannels>4)
+                                                   : m_numChannels!=3)
+            {
+                throw Exception("BitPackedImageDesc Error: Invalid channel number.");
+            }
+
+            if(m_yStrideBytes<getLineBytes() || m_yStrideBytes%sizeof(uint32_t)!=0)
+            {
+                throw Exception("BitPackedImageDesc Error: Invalid y stride.");
+            }
+        }
+    };
+
+    BitPackedImageDesc::BitPackedImageDesc(void * data,
+                                           long width, long height,
+                                           long numChannels,
+                                           BitPacking packing,
+                                           bool bigEndian,
+                                           ptrdiff_t yStrideBytes)
+        :   ImageDesc()
+        ,   m_impl(new BitPackedImageDesc::Impl)
+    {
+        getImpl()->m_data        = data;
+        getImpl()->m_width       = width;
+        getImpl()->m_height      = height;
+        getImpl()->m_numChannels = numChannels;
+        getImpl()->m_bitPacking  = packing;
+        getImpl()->m_bigEndian   = bigEndian;
+
+        getImpl()->m_yStrideBytes = (yStrideBytes == AutoStride)
+            ? getImpl()->getLineBytes() : yStrideBytes;
+
+        getImpl()->validate();
+    }
+
+    BitPackedImageDesc::~BitPackedImageDesc()
+    {
+        delete m_impl;
+        m_impl = nullptr;
+    }
+
+    BitPacking BitPackedImageDesc::getBitPacking() const
+    {
+        return getImpl()->m_bitPacking;
+    }
+
+    bool BitPackedImageDesc::isBigEndian() const
+    {
+        return getImpl()->m_bigEndian;
+    }
+
+    BitDepth BitPackedImageDesc::getBitDepth() const
+    {
+        return getImpl()->getBitDepth();
+    }
+
+    void * BitPackedImageDesc::getData() const
+    {
+        return getImpl()->m_data;
+    }
+
+    void * BitPackedImageDesc::getRData() const
+    {
+        return getImpl()->m_data;
+    }
+
+    void * BitPackedImageDesc::getGData() const
+    {
+        return nullptr;
+    }
+
+    void * BitPackedImageDesc::getBData() const
+    {
+        return nullptr;
+    }
+
+    void * BitPackedImageDesc::getAData() const
+    {
+        return nullptr;
+    }
+
+    long BitPackedImageDesc::getWidth() const
+    {
+        return getImpl()->m_width;
+    }
+
+    long BitPackedImageDesc::getHeight() const
+    {
+        return getImpl()->m_height;
+    }
+
+    long BitPackedImageDesc::getNumChannels() const
+    {
+        return getImpl()->m_numChannels;
+    }
+
+    ptrdiff_t BitPackedImageDesc::getXStrideBytes() const
+    {
+        return 0;
+    }
+
+    ptrdiff_t BitPackedImageDesc::getYStrideBytes() const
+    {
+        return getImpl()->m_yStrideBytes;
+    }
+
+    bool BitPackedImageDesc::isRGBAPacked() const
+    {
+        return false;
+    }
+
+    bool BitPackedImageDesc::isFloat() const
+    {
+        return false;
+    }
 }
 OCIO_NAMESPACE_EXIT
@@ -12,11 +12,285 @@
 
 #include "BitDepthUtils.h"
 #include "ImagePacking.h"
+#include "SSE.h"
 
 
 OCIO_NAMESPACE_ENTER
 {
 
+bool IsHostBigEndian()
+{
+    const uint32_t one = 1;
+    return *reinterpret_cast<const uint8_t *>(&one)==0;
+}
+
+namespace
+{
+
+inline uint32_t SwapBytes(uint32_t word)
+{
+    return  (word >> 24)
+         | ((word >>  8) & 0x0000FF00)
+         | ((word <<  8) & 0x00FF0000)
+         |  (word << 24);
+}
+
+// Note: The image buffer may not be aligned on 32-bit words.
+
+inline uint32_t ReadWord(const char * data, bool swapBytes)
+{
+    uint32_t word;
+    memcpy(&word, data, sizeof(uint32_t));
+    return swapBytes ? SwapBytes(word) : word;
+}
+
+inline void WriteWord(char * data, uint32_t word, bool swapBytes)
+{
+    if(swapBytes)
+    {
+        word = SwapBytes(word);
+    }
+    memcpy(data, &word, sizeof(uint32_t));
+}
+
+#ifdef USE_SSE
+inline __m128i SwapBytes(__m128i words)
+{
+    // Swap the bytes of the 16-bit values and then the 16-bit values of the words.
+    words = _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+    words = _mm_shufflelo_epi16(words, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(words, _MM_SHUFFLE(2, 3, 0, 1));
+}
+#endif
+
+// Positions of the R, G & B values in the words of the 10-bit layouts.
+void Get10BitShifts(BitPacking packing, int & rShift, int & gShift, int & bShift)
+{
+    const int padding = packing==BIT_PACKING_10_FILLED_A ? 2 : 0;
+
+    rShift = 20 + padding;
+    gShift = 10 + padding;
+    bShift =  0 + padding;
+}
+
+void Unpack10BitLine(const char * in, uint16_t * out, long width,
+                     BitPacking packing, bool swapBytes)
+{
+    int rShift, gShift, bShift;
+    Get10BitShifts(packing, rShift, gShift, bShift);
+
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+
+    // Process four pixels i.e. four words at a time.
+    for(; idx + 4 <= width; idx += 4)
+    {
+        __m128i words = _mm_loadu_si128((const __m128i *)in);
+        if(swapBytes)
+        {
+            words = SwapBytes(words);
+        }
+
+        const __m128i r = _mm_and_si128(_mm_srli_epi32(words, rShift), mask);
+        const __m128i g = _mm_and_si128(_mm_srli_epi32(words, gShift), mask);
+        const __m128i b = _mm_and_si128(_mm_srli_epi32(words, bShift), mask);
+
+        // The 32-bit values are the (r, g) and (b, a) pairs of 16-bit values, alpha being 0.
+        const __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+
+        _mm_storeu_si128((__m128i *)(out    ), _mm_unpacklo_epi32(rg, b));
+        _mm_storeu_si128((__m128i *)(out + 8), _mm_unpackhi_epi32(rg, b));
+
+        in  += 4 * sizeof(uint32_t);
+        out += 16;
+    }
+#endif
+
+    for(; idx < width; ++idx)
+    {
+        const uint32_t word = ReadWord(in, swapBytes);
+
+        out[0] = uint16_t((word >> rShift) & 0x3FF);
+        out[1] = uint16_t((word >> gShift) & 0x3FF);
+        out[2] = uint16_t((word >> bShift) & 0x3FF);
+        out[3] = 0;
+
+        in  += sizeof(uint32_t);
+        out += 4;
+    }
+}
+
+void Pack10BitLine(const uint16_t * in, char * out, long width,
+                   BitPacking packing, bool swapBytes)
+{
+    int rShift, gShift, bShift;
+    Get10BitShifts(packing, rShift, gShift, bShift);
+
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+
+    // Process four pixels i.e. four words at a time.
+    for(; idx + 4 <= width; idx += 4)
+    {
+        const __m128i p01 = _mm_loadu_si128((const __m128i *)(in    ));
+        const __m128i p23 = _mm_loadu_si128((const __m128i *)(in + 8));
+
+        // Gather the (r, g) and (b, a) pairs of 16-bit values of the four pixels.
+        const __m128i t0 = _mm_unpacklo_epi32(p01, p23);
+        const __m128i t1 = _mm_unpackhi_epi32(p01, p23);
+        const __m128i rg = _mm_unpacklo_epi32(t0, t1);
+        const __m128i ba = _mm_unpackhi_epi32(t0, t1);
+
+        const __m128i r = _mm_and_si128(rg, mask);
+        const __m128i g = _mm_and_si128(_mm_srli_epi32(rg, 16), mask);
+        const __m128i b = _mm_and_si128(ba, mask);
+
+        __m128i words = _mm_or_si128(_mm_slli_epi32(r, rShift),
+                                     _mm_or_si128(_mm_slli_epi32(g, gShift),
+                                                  _mm_slli_epi32(b, bShift)));
+        if(swapBytes)
+        {
+            words = SwapBytes(words);
+        }
+
+        _mm_storeu_si128((__m128i *)out, words);
+
+        in  += 16;
+        out += 4 * sizeof(uint32_t);
+    }
+#endif
+
+    for(; idx < width; ++idx)
+    {
+        const uint32_t word = (uint32_t(in[0] & 0x3FF) << rShift)
+                            | (uint32_t(in[1] & 0x3FF) << gShift)
+                            | (uint32_t(in[2] & 0x3FF) << bShift);
+
+        WriteWord(out, word, swapBytes);
+
+        in  += 4;
+        out += sizeof(uint32_t);
+    }
+}
+
+// Note: As the 12-bit values straddle the words, the values are extracted from a bit
+// accumulator (i.e. no SIMD implementation).
+
+void Unpack12BitLine(const char * in, uint16_t * out, long width,
+                     long numChannels, bool swapBytes)
+{
+    uint64_t bits = 0;
+    unsigned numBits = 0;
+
+    for(long idx = 0; idx < width; ++idx)
+    {
+        for(long c = 0; c < numChannels; ++c)
+        {
+            if(numBits < 12)
+            {
+                bits |= uint64_t(ReadWord(in, swapBytes)) << numBits;
+                numBits += 32;
+                in += sizeof(uint32_t);
+            }
+
+            out[c] = uint16_t(bits & 0xFFF);
+            bits >>= 12;
+            numBits -= 12;
+        }
+
+        if(numChannels==3)
+        {
+            out[3] = 0;
+        }
+
+        out += 4;
+    }
+}
+
+void Pack12BitLine(const uint16_t * in, char * out, long width,
+                   long numChannels, bool swapBytes)
+{
+    uint64_t bits = 0;
+    unsigned numBits = 0;
+
+    for(long idx = 0; idx < width; ++idx)
+    {
+        for(long c = 0; c < numChannels; ++c)
+        {
+            bits |= uint64_t(in[c] & 0xFFF) << numBits;
+            numBits += 12;
+
+            if(numBits >= 32)
+            {
+                WriteWord(out, uint32_t(bits), swapBytes);
+                bits >>= 32;
+                numBits -= 32;
+                out += sizeof(uint32_t);
+            }
+        }
+
+        in += 4;
+    }
+
+    // The unused bits of the last word are 0.
+    if(numBits > 0)
+    {
+        WriteWord(out, uint32_t(bits), swapBytes);
+    }
+}
+
+}
+
+void BitPacked::UnpackRGBAFromImageDesc(const GenericImageDesc & srcImg,
+                                        uint16_t * outBitDepthBuffer,
+                                        long yIndex)
+{
+    if(yIndex<0 || yIndex>=srcImg.m_height)
+    {
+        throw Exception("Invalid input image position.");
+    }
+
+    const char * in = srcImg.m_rData + srcImg.m_yStrideBytes * yIndex;
+
+    if(srcImg.m_bitPacking==BIT_PACKING_12_PACKED)
+    {
+        Unpack12BitLine(in, outBitDepthBuffer, srcImg.m_width,
+                        srcImg.m_numChannels, srcImg.m_swapBytes);
+    }
+    else
+    {
+        Unpack10BitLine(in, outBitDepthBuffer, srcImg.m_width,
+                        srcImg.m_bitPacking, srcImg.m_swapBytes);
+    }
+}
+
+void BitPacked::PackRGBAToImageDesc(GenericImageDesc & dstImg,
+                                    const uint16_t * inBitDepthBuffer,
+                                    long yIndex)
+{
+    if(yIndex<0 || yIndex>=dstImg.m_height)
+    {
+        return;
+    }
+
+    char * out = dstImg.m_rData + dstImg.m_yStrideBytes * yIndex;
+
+    if(dstImg.m_bitPacking==BIT_PACKING_12_PACKED)
+    {
+        Pack12BitLine(inBitDepthBuffer, out, dstImg.m_width,
+                      dstImg.m_numChannels, dstImg.m_swapBytes);
+    }
+    else
+    {
+        Pack10BitLine(inBitDepthBuffer, out, dstImg.m_width,
+                      dstImg.m_bitPacking, dstImg.m_swapBytes);
+    }
+}
+
 
 template<typename Type>
 void Generic<Type>::PackRGBAFromImageDesc(const GenericImageDesc & srcImg,
@@ -34,6 +34,14 @@ struct GenericImageDesc
     // Is the image buffer a 32-bit float image buffer?
     bool m_isFloat      = false;
 
+    // Is the image buffer a bit-packed integer buffer (refer to BitPackedImageDesc)?
+    bool m_isBitPacked  = false;
+    BitPacking m_bitPacking = BIT_PACKING_10_FILLED_A;
+    long m_numChannels  = 0;
+    // Do the bytes of the words need to be swapped i.e. is the byte order of the image
+    // buffer different from the host one?
+    bool m_swapBytes    = false;
+
     
     // Resolves all AutoStride.
     void init(const ImageDesc & img, BitDepth bitDepth, const ConstOpCPURcPtr & bitDepthOp);
@@ -44,6 +52,23 @@ struct GenericImageDesc
     bool isRGBAPacked() const;
     // Is the image buffer a 32-bit float image buffer?
     bool isFloat() const;
+    // Does the image buffer have an alpha channel?
+    bool hasAlpha() const;
+};
+
+bool IsHostBigEndian();
+
+// Conversion of one line of a bit-packed image buffer from/to 16-bit RGBA values
+// (i.e. the type of the BIT_DEPTH_UINT10 & BIT_DEPTH_UINT12 image buffers).
+struct BitPacked
+{
+    static void UnpackRGBAFromImageDesc(const GenericImageDesc & srcImg,
+                                        uint16_t * outBitDepthBuffer,
+                                        long yIndex);
+
+    static void PackRGBAToImageDesc(GenericImageDesc & dstImg,
+                                    const uint16_t * inBitDepthBuffer,
+                                    long yIndex);
 };
 
 template<typename Type>
@@ -350,11 +350,18 @@ OCIO_NAMESPACE_ENTER
     
     void FinalizeOpVec(OpRcPtrVec & ops, FinalizationFlags fFlags)
     {
+        // The statistics, the run detection & the color cache only concern
+        // the processors.
+        const FinalizationFlags opFlags
+            = (FinalizationFlags)(fFlags & ~(FINALIZATION_STATISTICS
+                                             | FINALIZATION_RUN_DETECTION
+                                             | FINALIZATION_COLOR_CACHE));
+
         for(auto & op : ops)
         {
             op->setInputBitDepth(BIT_DEPTH_F32);
             op->setOutputBitDepth(BIT_DEPTH_F32);
-            op->finalize(fFlags);
+            op->finalize(opFlags);
         }
     }
 
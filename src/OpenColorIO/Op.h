@@ -162,6 +162,11 @@ OCIO_NAMESPACE_ENTER
         // returns true if the op's output does not combine input channels
         virtual bool hasChannelCrosstalk() const = 0;
 
+        // Determine whether the op changes the alpha channel (apart from a bit-depth
+        // conversion). For example, a Log or a 3D LUT never does, but a Matrix may
+        // depending on its last row. Returns false if the alpha values pass through.
+        virtual bool modifiesAlpha() const = 0;
+
         virtual bool operator==(const OpData & other) const;
         bool operator!=(const OpData & other) const = delete;
 
@@ -202,6 +207,12 @@ OCIO_NAMESPACE_ENTER
                        const BitDepth & outBitDepth,
                        OptimizationFlags oFlags);
 
+    // Same as the F32 OptimizeOpVec() but the ops whose parameters could be GPU shader
+    // uniforms (i.e. CDL, Exponent, Log, Matrix & Range) are left unchanged, even when
+    // their values make them no-ops, so that the resulting op list only depends on
+    // the kinds of ops (refer to GpuShaderDesc::setParameterMode()).
+    void OptimizeOpVecKeepingParameters(OpRcPtrVec & result, OptimizationFlags oFlags);
+
     void UnifyDynamicProperties(OpRcPtrVec & ops);
    
     void CreateOpVecFromOpData(OpRcPtrVec & ops,
@@ -254,6 +265,8 @@ OCIO_NAMESPACE_ENTER
             virtual void combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const;
             
             virtual bool hasChannelCrosstalk() const { return m_data->hasChannelCrosstalk(); }
+
+            virtual bool modifiesAlpha() const { return m_data->modifiesAlpha(); }
             
             virtual void dumpMetadata(ProcessorMetadataRcPtr & /*metadata*/) const
             { }
@@ -365,6 +378,16 @@ OCIO_NAMESPACE_ENTER
         // Note: It copies elements i.e. no clone.
         void insert(const_iterator position, const_iterator first, const_iterator last);
 
+        // Replace the content by the elements from the range ['first', 'last'[.
+        //
+        // Note: It copies elements i.e. no clone.
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            m_ops.assign(first, last);
+            adjustBitDepths();
+        }
+
         void clear() noexcept { m_ops.clear(); }
         bool empty() const noexcept { return m_ops.empty(); }
 
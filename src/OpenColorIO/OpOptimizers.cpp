@@ -2,15 +2,28 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <limits>
+#include <list>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BitDepthUtils.h"
 #include "Logging.h"
 #include "Op.h"
+#include "OpTools.h"
+#include "ops/Allocation/AllocationOp.h"
+#include "ops/CDL/CDLOpData.h"
+#include "ops/exposurecontrast/ExposureContrastOpData.h"
+#include "ops/FixedFunction/FixedFunctionOpData.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOp.h"
+#include "ops/Lut3D/Lut3DOpData.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "ops/Range/RangeOpData.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -35,272 +48,1131 @@ OCIO_NAMESPACE_ENTER
         }
     }
 
+    // Rules applied by the peephole optimizer.
+    enum PeepholeRules
+    {
+        PEEPHOLE_REMOVE_NOOPS   = 0x01, // Remove the no-op ops.
+        PEEPHOLE_REMOVE_INVERSE = 0x02, // Remove adjacent pairs of inverse ops.
+        PEEPHOLE_COMBINE        = 0x04, // Combine adjacent ops.
+
+        PEEPHOLE_ALL            = PEEPHOLE_REMOVE_NOOPS
+                                  | PEEPHOLE_REMOVE_INVERSE
+                                  | PEEPHOLE_COMBINE,
+
+        PEEPHOLE_KEEP_PARAMETER_OPS = 0x08 // No rule applies to the parameter ops.
+    };
+
+    // The ops whose parameters could be GPU shader uniforms (refer to
+    // GpuShaderDesc::setParameterMode()).
+    bool IsParameterOp(const ConstOpRcPtr & op)
+    {
+        switch (op->data()->getType())
+        {
+            case OpData::CDLType:
+            case OpData::ExponentType:
+            case OpData::LogType:
+            case OpData::MatrixType:
+            case OpData::RangeType:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Debug counters of the peephole optimizer.
+    struct PeepholeStats
+    {
+        int noops    = 0; // Number of no-op ops removed.
+        int inverses = 0; // Number of pairs of inverse ops removed.
+        int combines = 0; // Number of pairs of ops combined.
+        int visits   = 0; // Number of op positions examined.
+
+        bool maxRewritesReached = false;
+    };
+
+    typedef std::list<OpRcPtr> OpList;
+
+    // Once a rewrite changed the ops around 'pos', restore the bit-depth
+    // consistency between the op at 'pos' and its predecessor (i.e. what
+    // OpRcPtrVec::adjustBitDepths() does, but only where the list changed).
+    void AdjustBitDepthAt(OpList & ops, OpList::iterator pos)
+    {
+        OpList::iterator next = pos;
+        while (next != ops.end() && (*next)->isNoOpType())
+        {
+            ++next;
+        }
+        if (next == ops.end())
+        {
+            return;
+        }
+
+        OpList::iterator prev = pos;
+        while (prev != ops.begin())
+        {
+            --prev;
+            if (!(*prev)->isNoOpType())
+            {
+                const BitDepth prevOutBD = (*prev)->getOutputBitDepth();
+                if ((*next)->getInputBitDepth() != prevOutBD)
+                {
+                    (*next)->setInputBitDepth(prevOutBD);
+                }
+                return;
+            }
+        }
+    }
+
+    // Apply the rules until none of them can fire anywhere in the op list.
+    //
+    // The ops are moved into a linked list so that removing or replacing ops is
+    // done in constant time.  A cursor walks the list once and examines the op
+    // at the cursor and the pair it forms with the following op.  When a rule
+    // fires, the only new pair which could be affected is the one formed with
+    // the preceding op (i.e. the op before the first op resulting from a
+    // combine), so the cursor steps back by one op.  The common case
+    // of inverse ops is to have a deep nesting:
+    //
+    //         |
+    // ..., A, B, B', A', ...
+    //
+    // Once B and B' are removed, the cursor moves back to A to reconsider
+    // the A, A' pair:
+    //
+    //      |
+    // ..., A, A', ...
+    //
+    // Each rewrite removes at least one op (or replaces a pair), hence the
+    // number of visited positions is linear in the number of ops plus the
+    // number of rewrites, instead of the multiple passes over the vector
+    // (each erase/insert being itself linear) previously needed.
+    void PeepholeOptimize(OpRcPtrVec & opVec, unsigned rules, PeepholeStats & stats)
+    {
+        if (opVec.empty())
+        {
+            return;
+        }
+
+        OpList ops(opVec.begin(), opVec.end());
+
+        // Guard against rules undo-ing / redo-ing each other's results.
+        const int maxRewrites = MAX_OPTIMIZATION_PASSES * static_cast<int>(ops.size() + 1);
+        int rewrites = 0;
+
+        OpList::iterator cur = ops.begin();
+        while (cur != ops.end())
+        {
+            if (rewrites >= maxRewrites)
+            {
+                stats.maxRewritesReached = true;
+                break;
+            }
+
+            ++stats.visits;
+
+            OpList::iterator pos = ops.end();
+            // The first op of the rewritten sequence.
+            OpList::iterator restart = ops.end();
+
+            const bool keepParameterOps = (rules & PEEPHOLE_KEEP_PARAMETER_OPS) != 0;
+
+            if ((rules & PEEPHOLE_REMOVE_NOOPS) && (*cur)->isNoOp()
+                && !(keepParameterOps && IsParameterOp(*cur)))
+            {
+                pos = ops.erase(cur);
+                ++stats.noops;
+            }
+            else
+            {
+                OpList::iterator next = std::next(cur);
+                if (next == ops.end())
+                {
+                    break;
+                }
+
+                ConstOpRcPtr first  = *cur;
+                ConstOpRcPtr second = *next;
+
+                const bool keepPair
+                    = keepParameterOps && (IsParameterOp(first) || IsParameterOp(second));
+
+                if (keepPair)
+                {
+                    ++cur;
+                    continue;
+                }
+
+                if ((rules & PEEPHOLE_REMOVE_INVERSE)
+                    && first->isSameType(second) && first->isInverse(second))
+                {
+                    pos = ops.erase(cur, std::next(next));
+                    ++stats.inverses;
+                }
+                else if ((rules & PEEPHOLE_COMBINE) && first->canCombineWith(second))
+                {
+                    // The result may have any number of ops in it (0, 1, 2, ...).
+                    // (Size 0 would occur potentially iff the combination results
+                    // in a no-op.)
+                    OpRcPtrVec combined;
+                    first->combineWith(combined, second);
+
+                    pos = ops.erase(cur, std::next(next));
+                    OpList::iterator firstNew = ops.insert(pos, combined.begin(), combined.end());
+                    if (firstNew != pos)
+                    {
+                        AdjustBitDepthAt(ops, firstNew);
+                    }
+                    restart = firstNew;
+                    ++stats.combines;
+                }
+                else
+                {
+                    ++cur;
+                    continue;
+                }
+            }
+
+            ++rewrites;
+            AdjustBitDepthAt(ops, pos);
+
+            // Step back to reconsider the pair formed with the preceding op.
+            cur = (restart != ops.end()) ? restart : pos;
+            if (cur != ops.begin())
+            {
+                --cur;
+            }
+        }
+
+        opVec.assign(ops.begin(), ops.end());
+    }
+
     int RemoveNoOps(OpRcPtrVec & opVec)
     {
+        PeepholeStats stats;
+        PeepholeOptimize(opVec, PEEPHOLE_REMOVE_NOOPS, stats);
+        return stats.noops;
+    }
+
+    int RemoveInverseOps(OpRcPtrVec & opVec)
+    {
+        PeepholeStats stats;
+        PeepholeOptimize(opVec, PEEPHOLE_REMOVE_INVERSE, stats);
+        return stats.inverses;
+    }
+
+    int CombineOps(OpRcPtrVec & opVec)
+    {
+        PeepholeStats stats;
+        PeepholeOptimize(opVec, PEEPHOLE_COMBINE, stats);
+        return stats.combines;
+    }
+    } // namespace
+
+    namespace
+    {
+    // Build a matrix equivalent to the CDL, or return null if the CDL is not
+    // affine, i.e. if it clamps or has a power or a saturation.
+    MatrixOpDataRcPtr GetAffineMatrix(ConstCDLOpDataRcPtr & cdl)
+    {
+        if (cdl->isClamping()
+            || cdl->getPowerParams() != CDLOpData::ChannelParams(1.0)
+            || cdl->getSaturation() != 1.0)
+        {
+            return MatrixOpDataRcPtr();
+        }
+
+        const double * slope  = cdl->getSlopeParams().data();
+        const double * offset = cdl->getOffsetParams().data();
+
+        MatrixOpDataRcPtr mtx
+            = std::make_shared<MatrixOpData>(BIT_DEPTH_F32, BIT_DEPTH_F32,
+                                             cdl->getFormatMetadata());
+
+        for (unsigned long c = 0; c < 3; ++c)
+        {
+            if (cdl->isReverse())
+            {
+                // out = (in - offset) / slope
+                if (slope[c] == 0.0)
+                {
+                    return MatrixOpDataRcPtr();
+                }
+                mtx->setArrayValue(c * 5, 1.0 / slope[c]);
+                mtx->setOffsetValue(c, -offset[c] / slope[c]);
+            }
+            else
+            {
+                // out = in * slope + offset
+                mtx->setArrayValue(c * 5, slope[c]);
+                mtx->setOffsetValue(c, offset[c]);
+            }
+        }
+
+        mtx->setInputBitDepth(cdl->getInputBitDepth());
+        mtx->setOutputBitDepth(cdl->getOutputBitDepth());
+        mtx->validate();
+
+        return mtx;
+    }
+
+    // Build a matrix equivalent to the exposure/contrast, or return null if it
+    // is not affine.  Only the linear style without contrast is a pure scale
+    // (the pivot then cancels out), and its parameters must not be dynamic.
+    MatrixOpDataRcPtr GetAffineMatrix(ConstExposureContrastOpDataRcPtr & ec)
+    {
+        const ExposureContrastOpData::Style style = ec->getStyle();
+        if ((style != ExposureContrastOpData::STYLE_LINEAR
+             && style != ExposureContrastOpData::STYLE_LINEAR_REV)
+            || ec->isDynamic()
+            || ec->getContrast() * ec->getGamma() != 1.0)
+        {
+            return MatrixOpDataRcPtr();
+        }
+
+        double scale = std::pow(2.0, ec->getExposure());
+        if (style == ExposureContrastOpData::STYLE_LINEAR_REV)
+        {
+            scale = 1.0 / scale;
+        }
+
+        MatrixOpDataRcPtr mtx
+            = std::make_shared<MatrixOpData>(BIT_DEPTH_F32, BIT_DEPTH_F32,
+                                             ec->getFormatMetadata());
+        mtx->setArrayValue(0, scale);
+        mtx->setArrayValue(5, scale);
+        mtx->setArrayValue(10, scale);
+
+        mtx->setInputBitDepth(ec->getInputBitDepth());
+        mtx->setOutputBitDepth(ec->getOutputBitDepth());
+        mtx->validate();
+
+        return mtx;
+    }
+
+    // Build a matrix equivalent to the op, or return null if the op can not be
+    // expressed as a matrix with offsets.
+    MatrixOpDataRcPtr GetAffineMatrix(ConstOpRcPtr & op)
+    {
+        // An inverse op still holds its forward data until it is finalized.
+        if (op->getDirection() != TRANSFORM_DIR_FORWARD)
+        {
+            return MatrixOpDataRcPtr();
+        }
+
+        ConstOpDataRcPtr data = op->data();
+        switch (data->getType())
+        {
+            case OpData::RangeType:
+            {
+                ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(data);
+                if (range->minIsEmpty() && range->maxIsEmpty())
+                {
+                    return range->convertToMatrix();
+                }
+                break;
+            }
+            case OpData::CDLType:
+            {
+                ConstCDLOpDataRcPtr cdl = DynamicPtrCast<const CDLOpData>(data);
+                return GetAffineMatrix(cdl);
+            }
+            case OpData::ExposureContrastType:
+            {
+                ConstExposureContrastOpDataRcPtr ec
+                    = DynamicPtrCast<const ExposureContrastOpData>(data);
+                return GetAffineMatrix(ec);
+            }
+            default:
+                break;
+        }
+
+        return MatrixOpDataRcPtr();
+    }
+    } // namespace
+
+    // Replace the ops which are equivalent to a matrix with offsets (i.e. an
+    // unclamped range, a CDL without power nor saturation, or a static linear
+    // exposure) by a matrix op, when a neighbor is also a matrix (or another
+    // such op), so that the combine step folds them together.
+    // Returns the number of replaced ops.
+    int FoldAffineOps(OpRcPtrVec & ops)
+    {
+        const size_t numOps = ops.size();
+
+        std::vector<MatrixOpDataRcPtr> matrices(numOps);
+        std::vector<bool> isAffine(numOps, false);
+
+        for (size_t i = 0; i < numOps; ++i)
+        {
+            ConstOpRcPtr op = ops[i];
+            if (op->data()->getType() == OpData::MatrixType)
+            {
+                isAffine[i] = true;
+            }
+            else
+            {
+                matrices[i] = GetAffineMatrix(op);
+                isAffine[i] = (bool)matrices[i];
+            }
+        }
+
         int count = 0;
 
-        OpRcPtrVec::iterator iter = opVec.begin();
-        while (iter != opVec.end())
+        std::vector<OpRcPtr> folded;
+        folded.reserve(numOps);
+
+        for (size_t i = 0; i < numOps; ++i)
         {
-            if ((*iter)->isNoOp())
+            const bool hasAffineNeighbor = (i > 0 && isAffine[i - 1])
+                                           || (i + 1 < numOps && isAffine[i + 1]);
+
+            if (matrices[i] && hasAffineNeighbor)
             {
-                iter = opVec.erase(iter);
+                OpRcPtrVec mtxOps;
+                CreateMatrixOp(mtxOps, matrices[i], TRANSFORM_DIR_FORWARD);
+                folded.push_back(mtxOps[0]);
                 ++count;
             }
             else
             {
-                ++iter;
+                folded.push_back(ops[i]);
             }
         }
 
+        if (count > 0)
+        {
+            ops.assign(folded.begin(), folded.end());
+        }
+
         return count;
     }
 
-    int RemoveInverseOps(OpRcPtrVec & opVec)
+    namespace
     {
-        int count      = 0;
-        int firstindex = 0; // this must be a signed int
-
-        while (firstindex < static_cast<int>(opVec.size() - 1))
-        {
-            ConstOpRcPtr first  = opVec[firstindex];
-            ConstOpRcPtr second = opVec[firstindex + 1];
-
-            // The common case of inverse ops is to have a deep nesting:
-            // ..., A, B, B', A', ...
-            //
-            // Consider the above, when firstindex reaches B:
-            //
-            //         |
-            // ..., A, B, B', A', ...
-            //
-            // We will remove B and B'.
-            // Firstindex remains pointing at the original location:
-            //
-            //         |
-            // ..., A, A', ...
-            //
-            // We then decrement firstindex by 1,
-            // to backstep and reconsider the A, A' case:
-            //
-            //      |            <-- firstindex decremented
-            // ..., A, A', ...
-            //
-
-            if (first->isSameType(second) && first->isInverse(second))
-            {
-                opVec.erase(opVec.begin() + firstindex, opVec.begin() + firstindex + 2);
-                ++count;
+    // Return true if the separable ops in [first, last[ include at least one op
+    // that is more expensive to evaluate than a 1D LUT look-up.
+    bool HasExpensiveSeparableOps(const OpRcPtrVec & ops, unsigned first, unsigned last)
+    {
+        unsigned expensiveOps = 0u;
+        for (unsigned i = first; i < last; ++i)
+        {
+            auto op = ops[i];
 
-                firstindex = std::max(0, firstindex - 1);
+            if (op->hasChannelCrosstalk())
+            {
+                // Non-separable ops (should never get here).
+                throw Exception("Non-separable op.");
             }
-            else
+
+            ConstOpRcPtr constOp = op;
+            switch (constOp->data()->getType())
             {
-                ++firstindex;
+                // Potentially separable, but inexpensive ops.
+                // TODO: Perhaps a LUT is faster once the conversion to float is considered?
+                case OpData::MatrixType:
+                case OpData::RangeType:
+                {
+                    break;
+                }
+
+                // Potentially separable, and more expensive.
+                default:
+                {
+                    expensiveOps++;
+                    break;
+                }
             }
         }
 
-        return count;
+        return expensiveOps != 0;
     }
+    } // namespace
 
-    int CombineOps(OpRcPtrVec & opVec)
+    // (Note: the term "separable" in mathematics refers to a multi-dimensional
+    // function where the dimensions are independent of each other.)
+    //
+    // The goal here is to speed up calculations by replacing the contiguous separable
+    // (channel independent) list of ops from the first op onwards with a single
+    // LUT1D whose domain is sampled for the target bit depth.  A typical use-case
+    // would be a list of ops that starts with a gamma that is processing integer 10i
+    // pixels.  Rather than convert to float and apply the power function on each
+    // pixel, it's better to build a 1024 entry LUT and just do a look-up.
+    //
+    unsigned FindSeparablePrefix(const OpRcPtrVec & ops)
+    {
+        unsigned prefixLen = 0;
+
+        // Loop over the ops until we get to one that cannot be combined.
+        //
+        // Note: For some ops such as Matrix and CDL, the separability depends upon
+        //       the parameters.
+        for (const auto & op : ops)
+        {
+            // TODO: Dynamic bypassed ops can be 'optimizied' like any other ops.
+
+            // In OCIO, the hasChannelCrosstalk method returns false for separable ops.
+            // Note: A Lut1D does not process the alpha channel.
+            if (op->hasChannelCrosstalk() || op->isDynamic() || op->modifiesAlpha())
+            {
+                break;
+            }
+
+            // Op is separable, keep going.
+            prefixLen++;
+        }
+
+        // If the only op is a 1D LUT, there is actually nothing to optimize
+        // so set the length to 0.  (This also avoids an infinite loop.)
+        // (If it is an inverse 1D LUT, proceed since we want to replace it with a 1D LUT.)
+        if (prefixLen == 1)
+        {
+            ConstOpRcPtr constOp0 = ops[0];
+            if (constOp0->data()->getType() == OpData::Lut1DType &&
+                constOp0->getDirection() == TRANSFORM_DIR_FORWARD)
+            {
+                return 0;
+            }
+        }
+
+        // Some ops are so fast that it may not make sense to replace just one of those.
+        // E.g., if it's just a single matrix, it may not be faster to replace it with a LUT.
+        // So make sure there are some more expensive ops to combine.
+        if (!HasExpensiveSeparableOps(ops, 0, prefixLen))
+        {
+            return 0;
+        }
+
+        // TODO: The main source of potential lossiness is where there is a 1D LUT
+        // that has extended range values followed by something that clamps.  In
+        // that case, the clamp would get baked into the LUT entries and therefore
+        // result in a different interpolated value.  Could look for that case and
+        // turn off the optimization.
+
+        return prefixLen;
+    }
+
+    // Use functional composition to replace a string of separable ops at the head of
+    // the op list with a single 1D LUT that is built to do a look-up for the input bit-depth.
+    void OptimizeSeparablePrefix(OpRcPtrVec & ops, const BitDepth & inBitDepth)
+    {
+        // TODO: Take care of the dynamic properties.
+
+        if (ops.empty())
+        {
+            return;
+        }
+
+        // TODO: Investigate whether even the F32 case could be sped up via interpolating
+        //       in a half-domain Lut1D (e.g. replacing a string of exponent, log, etc.).
+        if (inBitDepth == BIT_DEPTH_F32 || inBitDepth == BIT_DEPTH_UINT32)
+        {
+            return;
+        }
+
+        const unsigned prefixLen = FindSeparablePrefix(ops);
+        if (prefixLen == 0)
+        {
+            return; // Nothing to do.
+        }
+
+        OpRcPtrVec prefixOps;
+        for (unsigned i = 0; i < prefixLen; ++i)
+        {
+            prefixOps.push_back(ops[i]->clone());
+        }
+
+        // Make a domain for the LUT.  (Will be half-domain for target == 16f.)
+        Lut1DOpDataRcPtr newDomain = Lut1DOpData::MakeLookupDomain(inBitDepth);
+
+        // Send the domain through the prefix ops.
+        // Note: This sets the outBitDepth of newDomain to match prefixOps.
+        Lut1DOpData::ComposeVec(newDomain, prefixOps);
+
+        // Remove the prefix ops.
+        ops.erase(ops.begin(), ops.begin() + prefixLen);
+
+        // Insert the new LUT to replace the prefix ops.
+        OpRcPtrVec lutOps;
+        CreateLut1DOp(lutOps, newDomain, TRANSFORM_DIR_FORWARD);
+
+        ops.insert(ops.begin(), lutOps.begin(), lutOps.end());
+    }
+
+    // The symmetric case of FindSeparablePrefix: find the contiguous list of separable
+    // ops at the end of the op list (e.g. a display gamma).  Dynamic ops stop the search.
+    unsigned FindSeparableSuffix(const OpRcPtrVec & ops)
+    {
+        unsigned suffixLen = 0;
+
+        for (auto iter = ops.end(); iter != ops.begin(); )
+        {
+            --iter;
+            if ((*iter)->hasChannelCrosstalk() || (*iter)->isDynamic()
+                || (*iter)->modifiesAlpha())
+            {
+                break;
+            }
+            suffixLen++;
+        }
+
+        // A forward 1D LUT alone is already what the optimization would produce.
+        if (suffixLen == 1)
+        {
+            ConstOpRcPtr constOp = ops.back();
+            if (constOp->data()->getType() == OpData::Lut1DType &&
+                constOp->getDirection() == TRANSFORM_DIR_FORWARD)
+            {
+                return 0;
+            }
+        }
+
+        const unsigned numOps = static_cast<unsigned>(ops.size());
+        if (!HasExpensiveSeparableOps(ops, numOps - suffixLen, numOps))
+        {
+            return 0;
+        }
+
+        return suffixLen;
+    }
+
+    // Use functional composition to replace a string of separable ops at the tail of the
+    // op list with a single half-domain 1D LUT whose values are scaled for the integer
+    // output bit-depth.  The CPU engine then uses that 1D LUT to also do the conversion
+    // to the output bit-depth, so a display gamma costs a look-up instead of a powf.
+    //
+    // Inputs to the suffix are floats of unknown range, hence the half-domain: the look-up
+    // is exact for each half value, and linear interpolation is used in-between.  The
+    // optimization is quantization-aware: it is only done when the interpolation error,
+    // measured halfway between adjacent half values, stays below half an output code value.
+    void OptimizeSeparableSuffix(OpRcPtrVec & ops, const BitDepth & outBitDepth)
+    {
+        if (ops.empty())
+        {
+            return;
+        }
+
+        // Only integer output bit-depths quantize the result.
+        if (IsFloatBitDepth(outBitDepth) || outBitDepth == BIT_DEPTH_UINT14
+            || outBitDepth == BIT_DEPTH_UINT32 || outBitDepth == BIT_DEPTH_UNKNOWN)
+        {
+            return;
+        }
+
+        const unsigned suffixLen = FindSeparableSuffix(ops);
+        if (suffixLen == 0)
+        {
+            return; // Nothing to do.
+        }
+
+        const unsigned firstIdx = static_cast<unsigned>(ops.size()) - suffixLen;
+
+        OpRcPtrVec suffixOps;
+        for (unsigned i = firstIdx; i < ops.size(); ++i)
+        {
+            suffixOps.push_back(ops[i]->clone());
+        }
+
+        // Make a half-domain LUT, working in 32f so the values are normalized.
+        Lut1DOpDataRcPtr newLut = Lut1DOpData::MakeLookupDomain(BIT_DEPTH_F32);
+
+        const unsigned long length = newLut->getArray().getLength();
+        const unsigned long numComp = newLut->getArray().getNumColorComponents();
+
+        // Midpoints of the adjacent (finite) half values, to measure the interpolation error.
+        std::vector<float> midIn;
+        std::vector<unsigned long> midIdx;
+        {
+            const Array::Values & domain = newLut->getArray().getValues();
+            for (unsigned long idx = 0; idx + 1 < length; ++idx)
+            {
+                const float a = domain[idx * numComp];
+                const float b = domain[(idx + 1) * numComp];
+                if (std::isfinite(a) && std::isfinite(b))
+                {
+                    const float m = 0.5f * (a + b);
+                    midIn.push_back(m);
+                    midIn.push_back(m);
+                    midIn.push_back(m);
+                    midIdx.push_back(idx);
+                }
+            }
+        }
+
+        FinalizeOpVec(suffixOps, FINALIZATION_EXACT);
+        Lut1DOpData::ComposeVec(newLut, suffixOps);
+
+        std::vector<float> midOut(midIn.size());
+        OpRcPtrVec evalOps = suffixOps.clone();
+        EvalTransform(&midIn[0], &midOut[0], long(midIdx.size()), evalOps);
+
+        // As the output is clamped to the bit-depth range, only consider the in-range error.
+        const double outScale = GetBitDepthMaxValue(outBitDepth);
+        const Array::Values & values = newLut->getArray().getValues();
+        double maxError = 0.;
+        for (size_t i = 0; i < midIdx.size(); ++i)
+        {
+            const unsigned long idx = midIdx[i];
+            for (unsigned long c = 0; c < 3; ++c)
+            {
+                const float interp = 0.5f * (values[idx * 3 + c] + values[(idx + 1) * 3 + c]);
+                const float exact = midOut[i * 3 + c];
+                if (std::isnan(interp) || std::isnan(exact))
+                {
+                    continue;
+                }
+                const double err = std::fabs(CLAMP(exact, 0.0f, 1.0f) - CLAMP(interp, 0.0f, 1.0f));
+                maxError = std::max(maxError, err * outScale);
+            }
+        }
+
+        if (maxError > 0.5)
+        {
+            if (IsDebugLoggingEnabled())
+            {
+                std::ostringstream os;
+                os << "Separable suffix not replaced, the error is " << maxError;
+                os << " code values for " << BitDepthToString(outBitDepth) << ".";
+                LogDebug(os.str());
+            }
+            return;
+        }
+
+        // The op before the suffix now outputs 32f i.e. the input of the new LUT.
+        if (firstIdx > 0)
+        {
+            ops[firstIdx - 1]->setOutputBitDepth(BIT_DEPTH_F32);
+        }
+        newLut->setOutputBitDepth(outBitDepth);
+
+        // Remove the suffix ops.
+        ops.erase(ops.begin() + firstIdx, ops.end());
+
+        // Append the new LUT to replace the suffix ops.
+        OpRcPtrVec lutOps;
+        CreateLut1DOp(lutOps, newLut, TRANSFORM_DIR_FORWARD);
+
+        ops.insert(ops.end(), lutOps.begin(), lutOps.end());
+    }
+
+    // TODO: Temporary method to limit code changes.
+    void OptimizeSeparablePrefix(OpRcPtrVec & ops, OptimizationFlags /*oFlags*/)
+    {
+        OptimizeSeparablePrefix(ops, BIT_DEPTH_F32);
+    }
+
+    // Rough estimate of the per-pixel CPU cost of an op, in units of a 4x4 matrix
+    // (i.e. a few multiply-adds per channel).  The numbers only need to be good
+    // enough to rank chains of ops against the cost of a 3D LUT look-up.
+    float EstimateOpCost(const ConstOpRcPtr & op)
+    {
+        ConstOpDataRcPtr data = op->data();
+
+        switch (data->getType())
+        {
+            case OpData::MatrixType:
+            case OpData::RangeType:
+            {
+                return 1.0f;
+            }
+            case OpData::ExposureContrastType:
+            {
+                return 4.0f;
+            }
+            case OpData::CDLType:
+            case OpData::ExponentType:
+            case OpData::GammaType:
+            case OpData::LogType:
+            {
+                // Per channel pow/log/exp calls.
+                return 6.0f;
+            }
+            case OpData::Lut1DType:
+            {
+                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(data);
+                if (op->getDirection() == TRANSFORM_DIR_INVERSE
+                    && lut->getConcreteInversionQuality() == LUT_INVERSION_EXACT)
+                {
+                    // Binary search per channel.
+                    return 8.0f;
+                }
+                return 2.0f;
+            }
+            case OpData::Lut3DType:
+            {
+                ConstLut3DOpDataRcPtr lut = DynamicPtrCast<const Lut3DOpData>(data);
+                if (op->getDirection() == TRANSFORM_DIR_INVERSE
+                    && lut->getConcreteInversionQuality() == LUT_INVERSION_EXACT)
+                {
+                    // Search through the tetrahedra of the LUT.
+                    return 60.0f;
+                }
+                return lut->getConcreteInterpolation() == INTERP_TETRAHEDRAL ? 6.0f : 8.0f;
+            }
+            case OpData::FixedFunctionType:
+            {
+                ConstFixedFunctionOpDataRcPtr func
+                    = DynamicPtrCast<const FixedFunctionOpData>(data);
+                switch (func->getStyle())
+                {
+                    case FixedFunctionOpData::ACES_RED_MOD_03_FWD:
+                    case FixedFunctionOpData::ACES_RED_MOD_03_INV:
+                    case FixedFunctionOpData::ACES_RED_MOD_10_FWD:
+                    case FixedFunctionOpData::ACES_RED_MOD_10_INV:
+                    {
+                        // Hue computation with atan2, sqrt & branches.
+                        return 20.0f;
+                    }
+                    case FixedFunctionOpData::ACES_GLOW_03_FWD:
+                    case FixedFunctionOpData::ACES_GLOW_03_INV:
+                    case FixedFunctionOpData::ACES_GLOW_10_FWD:
+                    case FixedFunctionOpData::ACES_GLOW_10_INV:
+                    {
+                        return 15.0f;
+                    }
+                    case FixedFunctionOpData::ACES_DARK_TO_DIM_10_FWD:
+                    case FixedFunctionOpData::ACES_DARK_TO_DIM_10_INV:
+                    case FixedFunctionOpData::REC2100_SURROUND:
+                    {
+                        return 8.0f;
+                    }
+                }
+                return 20.0f;
+            }
+            case OpData::ReferenceType:
+            case OpData::NoOpType:
+            {
+                break;
+            }
+        }
+
+        return 0.0f;
+    }
+
+    namespace
+    {
+    // Grid sizes tried, in order, when baking a chain into a 3D LUT.
+    const unsigned long BAKE_LUT3D_GRID_SIZES[] = { 33, 65 };
+
+    // The chain must be at least that many times more expensive than
+    // the baked LUTs for the bake to be worthwhile.
+    const float BAKE_LUT3D_MIN_COST_RATIO = 2.0f;
+
+    // Maximum absolute error allowed between the baked LUTs and the original chain
+    // over the input range of the bake.
+    const float BAKE_LUT3D_MAX_ERROR = 1e-3f;
+
+    // Number of samples per 3D LUT cell, and per channel, used to measure the error.
+    const unsigned long BAKE_LUT3D_SAMPLES_PER_CELL = 2;
+
+    void ApplyOpVec(OpRcPtrVec & ops, std::vector<float> & rgba)
+    {
+        const long numPixels = long(rgba.size() / 4);
+        FinalizeOpVec(ops, FINALIZATION_EXACT);
+        for (const auto & op : ops)
+        {
+            op->apply(&rgba[0], &rgba[0], numPixels);
+        }
+    }
+
+    float ComputeMaxError(const std::vector<float> & ref, const std::vector<float> & val)
+    {
+        float maxErr = 0.0f;
+        for (size_t idx = 0; idx < ref.size(); ++idx)
+        {
+            if (std::isnan(ref[idx]) && std::isnan(val[idx]))
+            {
+                continue;
+            }
+
+            const float err = std::fabs(ref[idx] - val[idx]);
+            // Note: Written so that a NaN error is reported as an infinite one.
+            if (!(err <= maxErr))
+            {
+                maxErr = std::isnan(err) ? std::numeric_limits<float>::infinity() : err;
+            }
+        }
+        return maxErr;
+    }
+    } // namespace
+
+    AllocationData GetDefaultBakeLut3DAllocation()
+    {
+        // A log2 shaper from 0 to 128 (i.e. 15 stops above the 2^-8 offset) which
+        // covers the usual scene-linear range, including HDR values up to 100.
+        AllocationData allocation;
+        allocation.allocation = ALLOCATION_LG2;
+        allocation.vars = { -8.0f, 7.0f, 0.00390625f };
+        return allocation;
+    }
+
+    // Replace an expensive, non-separable chain of ops by a shaper 1D LUT and a 3D LUT.
+    //
+    // For a float input bit-depth, the shaper is a half-domain 1D LUT applying the
+    // allocation (e.g. a log2 shaper) which maps the input range of the bake to [0, 1],
+    // clamping the values outside of that range.  The 3D LUT then bakes the inverse
+    // allocation followed by the ops.
+    //
+    // For an integer input bit-depth, the input range is [0, 1] so the separable ops
+    // at the front of the chain are baked into a shaper 1D LUT of the input bit-depth
+    // domain, whose output is normalized to [0, 1], and the remaining ops into the
+    // 3D LUT.  Without separable ops, the 3D LUT directly covers the input range and
+    // no shaper is needed.
+    //
+    // The dynamic ops at the end of the chain stay out of the bake, so they can still
+    // be adjusted.  The bake only happens when the estimated CPU cost of the chain is
+    // well above the cost of the LUTs, and when the absolute error measured on samples
+    // densely spread over the input range (i.e. including the centers of the 3D LUT
+    // cells, where the interpolation error is the largest) stays below
+    // BAKE_LUT3D_MAX_ERROR.  Returns the measured error, or a negative value if the
+    // chain was left unchanged.
+    float OptimizeBakeLut3D(OpRcPtrVec & ops, const BitDepth & inBitDepth,
+                            const AllocationData & floatAllocation)
     {
-        int count      = 0;
-        int firstindex = 0; // this must be a signed int
-
-        OpRcPtrVec tmpops;
+        OpRcPtrVec::size_type bakeEnd = ops.size();
+        while (bakeEnd > 0 && ops[bakeEnd - 1]->isDynamic())
+        {
+            --bakeEnd;
+        }
 
-        while (firstindex < static_cast<int>(opVec.size() - 1))
+        if (bakeEnd == 0)
         {
-            ConstOpRcPtr first  = opVec[firstindex];
-            ConstOpRcPtr second = opVec[firstindex + 1];
+            return -1.0f;
+        }
 
-            if (first->canCombineWith(second))
+        float chainCost = 0.0f;
+        bool hasCrosstalk = false;
+        for (OpRcPtrVec::size_type idx = 0; idx < bakeEnd; ++idx)
+        {
+            // Note: A Lut3D does not process the alpha channel.
+            if (ops[idx]->isDynamic() || ops[idx]->modifiesAlpha())
             {
-                tmpops.clear();
-                first->combineWith(tmpops, second);
+                return -1.0f;
+            }
+            chainCost += EstimateOpCost(ops[idx]);
+            hasCrosstalk = hasCrosstalk || ops[idx]->hasChannelCrosstalk();
+        }
 
-                // tmpops may have any number of ops in it. (0, 1, 2, ...)
-                // (size 0 would occur potentially iff the combination
-                // results in a no-op)
-                //
-                // No matter the number, we need to swap them in for the
-                // original ops
+        if (!hasCrosstalk)
+        {
+            // Separable chains are better handled by OptimizeSeparablePrefix.
+            return -1.0f;
+        }
 
-                // Erase the initial two ops we've combined
-                opVec.erase(opVec.begin() + firstindex, opVec.begin() + firstindex + 2);
+        // Note: With a float input, all the ops are baked into the 3D LUT.
+        const bool isFloatInput = IsFloatBitDepth(inBitDepth);
 
-                // Insert the new ops (which may be empty) at
-                // this location
-                opVec.insert(opVec.begin() + firstindex, tmpops.begin(), tmpops.end());
+        OpRcPtrVec::size_type prefixLen = 0;
+        while (!isFloatInput && prefixLen < bakeEnd && !ops[prefixLen]->hasChannelCrosstalk())
+        {
+            ++prefixLen;
+        }
 
-                // Decrement firstindex by 1,
-                // to backstep and reconsider the A, A' case.
-                // See RemoveInverseOps for the full discussion of
-                // why this is appropriate
-                firstindex = std::max(0, firstindex - 1);
+        const bool useShaper = isFloatInput || prefixLen > 0;
 
-                // We've done something so increment the count!
-                ++count;
-            }
-            else
-            {
-                ++firstindex;
-            }
+        const float bakedCost = 6.0f + (useShaper ? 2.0f : 0.0f);
+        if (chainCost < BAKE_LUT3D_MIN_COST_RATIO * bakedCost)
+        {
+            return -1.0f;
         }
 
-        return count;
-    }
-    } // namespace
+        // Build the shaper, and the ops in front of the baked ops in the 3D LUT.
 
-    // (Note: the term "separable" in mathematics refers to a multi-dimensional
-    // function where the dimensions are independent of each other.)
-    //
-    // The goal here is to speed up calculations by replacing the contiguous separable
-    // (channel independent) list of ops from the first op onwards with a single
-    // LUT1D whose domain is sampled for the target bit depth.  A typical use-case
-    // would be a list of ops that starts with a gamma that is processing integer 10i
-    // pixels.  Rather than convert to float and apply the power function on each
-    // pixel, it's better to build a 1024 entry LUT and just do a look-up.
-    //
-    unsigned FindSeparablePrefix(const OpRcPtrVec & ops)
-    {
-        unsigned prefixLen = 0;
+        Lut1DOpDataRcPtr shaper;
+        OpRcPtrVec lut3DPrefixOps;
 
-        // Loop over the ops until we get to one that cannot be combined.
-        //
-        // Note: For some ops such as Matrix and CDL, the separability depends upon
-        //       the parameters.
-        for (const auto & op : ops)
+        if (isFloatInput)
         {
-            // TODO: Dynamic bypassed ops can be 'optimizied' like any other ops.
+            shaper = Lut1DOpData::MakeLookupDomain(inBitDepth);
+            shaper->setInputBitDepth(BIT_DEPTH_F32);
+            shaper->setOutputBitDepth(BIT_DEPTH_F32);
 
-            // In OCIO, the hasChannelCrosstalk method returns false for separable ops.
-            if (op->hasChannelCrosstalk() || op->isDynamic())
+            OpRcPtrVec allocationOps;
+            CreateAllocationOps(allocationOps, floatAllocation, TRANSFORM_DIR_FORWARD);
+            FinalizeOpVec(allocationOps, FINALIZATION_EXACT);
+            Lut1DOpData::ComposeVec(shaper, allocationOps);
+
+            // Clamp to the input range of the bake.
+            for (float & v : shaper->getArray().getValues())
             {
-                break;
+                v = std::isnan(v) ? 0.0f : std::min(1.0f, std::max(0.0f, v));
             }
 
-            // Op is separable, keep going.
-            prefixLen++;
+            CreateAllocationOps(lut3DPrefixOps, floatAllocation, TRANSFORM_DIR_INVERSE);
         }
-
-        // If the only op is a 1D LUT, there is actually nothing to optimize
-        // so set the length to 0.  (This also avoids an infinite loop.)
-        // (If it is an inverse 1D LUT, proceed since we want to replace it with a 1D LUT.)
-        if (prefixLen == 1)
+        else if (useShaper)
         {
-            ConstOpRcPtr constOp0 = ops[0];
-            if (constOp0->data()->getType() == OpData::Lut1DType &&
-                constOp0->getDirection() == TRANSFORM_DIR_FORWARD)
+            shaper = Lut1DOpData::MakeLookupDomain(inBitDepth);
+            shaper->setInputBitDepth(BIT_DEPTH_F32);
+            shaper->setOutputBitDepth(BIT_DEPTH_F32);
+
+            OpRcPtrVec prefixOps;
+            for (OpRcPtrVec::size_type idx = 0; idx < prefixLen; ++idx)
             {
-                return 0;
+                prefixOps.push_back(ops[idx]->clone());
             }
-        }
+            FinalizeOpVec(prefixOps, FINALIZATION_EXACT);
 
-        // Some ops are so fast that it may not make sense to replace just one of those.
-        // E.g., if it's just a single matrix, it may not be faster to replace it with a LUT.
-        // So make sure there are some more expensive ops to combine.
-        unsigned expensiveOps = 0u;
-        for (unsigned i = 0; i < prefixLen; ++i)
-        {
-            auto op = ops[i];
+            Lut1DOpData::ComposeVec(shaper, prefixOps);
 
-            if (op->hasChannelCrosstalk())
+            float minVal[3] = { 0.0f, 0.0f, 0.0f };
+            float maxVal[3] = { 1.0f, 1.0f, 1.0f };
+
+            Array::Values & values = shaper->getArray().getValues();
+            const unsigned long length = shaper->getArray().getLength();
+            for (int c = 0; c < 3; ++c)
             {
-                // Non-separable ops (should never get here).
-                throw Exception("Non-separable op.");
+                minVal[c] = std::numeric_limits<float>::max();
+                maxVal[c] = -std::numeric_limits<float>::max();
+            }
+            for (unsigned long idx = 0; idx < length; ++idx)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    const float v = values[3 * idx + c];
+                    if (std::isfinite(v))
+                    {
+                        minVal[c] = std::min(minVal[c], v);
+                        maxVal[c] = std::max(maxVal[c], v);
+                    }
+                }
             }
 
-            ConstOpRcPtr constOp = op;
-            switch (constOp->data()->getType())
+            for (int c = 0; c < 3; ++c)
             {
-                // Potentially separable, but inexpensive ops.
-                // TODO: Perhaps a LUT is faster once the conversion to float is considered?
-                case OpData::MatrixType:
-                case OpData::RangeType:
+                if (!(minVal[c] < maxVal[c]))
                 {
-                    break;
+                    // Constant (or empty) range for that channel.
+                    maxVal[c] = minVal[c] + 1.0f;
+                }
+                if (!std::isfinite(maxVal[c] - minVal[c]))
+                {
+                    return -1.0f;
                 }
+            }
 
-                // Potentially separable, and more expensive.
-                default:
+            // Normalize the shaper output to [0, 1].
+            for (unsigned long idx = 0; idx < length; ++idx)
+            {
+                for (int c = 0; c < 3; ++c)
                 {
-                    expensiveOps++;
-                    break;
+                    float & v = values[3 * idx + c];
+                    v = (v - minVal[c]) / (maxVal[c] - minVal[c]);
                 }
             }
+
+            const double scale4[4]
+                = { maxVal[0] - minVal[0], maxVal[1] - minVal[1], maxVal[2] - minVal[2], 1. };
+            const double offset4[4] = { minVal[0], minVal[1], minVal[2], 0. };
+            CreateScaleOffsetOp(lut3DPrefixOps, scale4, offset4, TRANSFORM_DIR_FORWARD);
         }
 
-        if (expensiveOps == 0)
+        OpRcPtrVec bakedChain;
+        for (OpRcPtrVec::size_type idx = 0; idx < bakeEnd; ++idx)
         {
-            return 0;
+            bakedChain.push_back(ops[idx]);
         }
 
-        // TODO: The main source of potential lossiness is where there is a 1D LUT
-        // that has extended range values followed by something that clamps.  In
-        // that case, the clamp would get baked into the LUT entries and therefore
-        // result in a different interpolated value.  Could look for that case and
-        // turn off the optimization.
+        for (const unsigned long gridSize : BAKE_LUT3D_GRID_SIZES)
+        {
+            // Bake the remaining ops into the 3D LUT.
 
-        return prefixLen;
-    }
+            Lut3DOpDataRcPtr lut
+                = std::make_shared<Lut3DOpData>(BIT_DEPTH_F32, BIT_DEPTH_F32,
+                                                FormatMetadataImpl(METADATA_ROOT),
+                                                INTERP_TETRAHEDRAL, gridSize);
 
-    // Use functional composition to replace a string of separable ops at the head of
-    // the op list with a single 1D LUT that is built to do a look-up for the input bit-depth.
-    void OptimizeSeparablePrefix(OpRcPtrVec & ops, const BitDepth & inBitDepth)
-    {
-        // TODO: Take care of the dynamic properties.
+            OpRcPtrVec remainingOps = lut3DPrefixOps.clone();
+            for (OpRcPtrVec::size_type idx = prefixLen; idx < bakeEnd; ++idx)
+            {
+                remainingOps.push_back(ops[idx]->clone());
+            }
 
-        if (ops.empty())
-        {
-            return;
-        }
+            Array::Values & values = lut->getArray().getValues();
+            const long numEntries = long(gridSize * gridSize * gridSize);
+            EvalTransform(&values[0], &values[0], numEntries, remainingOps);
 
-        // TODO: Investigate whether even the F32 case could be sped up via interpolating
-        //       in a half-domain Lut1D (e.g. replacing a string of exponent, log, etc.).
-        if (inBitDepth == BIT_DEPTH_F32 || inBitDepth == BIT_DEPTH_UINT32)
-        {
-            return;
-        }
+            OpRcPtrVec bakedOps;
+            if (useShaper)
+            {
+                Lut1DOpDataRcPtr clonedShaper = shaper->clone();
+                CreateLut1DOp(bakedOps, clonedShaper, TRANSFORM_DIR_FORWARD);
+            }
+            CreateLut3DOp(bakedOps, lut, TRANSFORM_DIR_FORWARD);
 
-        const unsigned prefixLen = FindSeparablePrefix(ops);
-        if (prefixLen == 0)
-        {
-            return; // Nothing to do.
-        }
+            // Spread the samples over the input range, i.e. evenly in the shaper
+            // output for a float input, landing on the 3D LUT grid points and in
+            // between them.
 
-        OpRcPtrVec prefixOps;
-        for (unsigned i = 0; i < prefixLen; ++i)
-        {
-            prefixOps.push_back(ops[i]->clone());
-        }
+            const unsigned long numSamples = (gridSize - 1) * BAKE_LUT3D_SAMPLES_PER_CELL + 1;
+            std::vector<float> samples(numSamples * 4, 1.0f);
+            for (unsigned long idx = 0; idx < numSamples; ++idx)
+            {
+                const float t = float(idx) / float(numSamples - 1);
+                samples[4 * idx + 0] = t;
+                samples[4 * idx + 1] = t;
+                samples[4 * idx + 2] = t;
+            }
+            if (isFloatInput)
+            {
+                OpRcPtrVec inverseOps;
+                CreateAllocationOps(inverseOps, floatAllocation, TRANSFORM_DIR_INVERSE);
+                ApplyOpVec(inverseOps, samples);
+            }
 
-        // Make a domain for the LUT.  (Will be half-domain for target == 16f.)
-        Lut1DOpDataRcPtr newDomain = Lut1DOpData::MakeLookupDomain(inBitDepth);
+            std::vector<float> ref;
+            ref.reserve(numSamples * numSamples * numSamples * 4);
+            for (unsigned long r = 0; r < numSamples; ++r)
+            {
+                for (unsigned long g = 0; g < numSamples; ++g)
+                {
+                    for (unsigned long b = 0; b < numSamples; ++b)
+                    {
+                        ref.push_back(samples[4 * r + 0]);
+                        ref.push_back(samples[4 * g + 1]);
+                        ref.push_back(samples[4 * b + 2]);
+                        ref.push_back(0.5f);
+                    }
+                }
+            }
+            std::vector<float> val = ref;
 
-        // Send the domain through the prefix ops.
-        // Note: This sets the outBitDepth of newDomain to match prefixOps.
-        Lut1DOpData::ComposeVec(newDomain, prefixOps);
+            OpRcPtrVec originalOps = bakedChain.clone();
+            ApplyOpVec(originalOps, ref);
+            OpRcPtrVec testedOps = bakedOps.clone();
+            ApplyOpVec(testedOps, val);
 
-        // Remove the prefix ops.
-        ops.erase(ops.begin(), ops.begin() + prefixLen);
+            const float maxError = ComputeMaxError(ref, val);
 
-        // Insert the new LUT to replace the prefix ops.
-        OpRcPtrVec lutOps;
-        CreateLut1DOp(lutOps, newDomain, TRANSFORM_DIR_FORWARD);
+            if (IsDebugLoggingEnabled())
+            {
+                std::ostringstream os;
+                os << "Baking " << bakeEnd << " ops (estimated cost " << chainCost << ") into ";
+                os << (useShaper ? "a shaper 1D LUT and " : "");
+                os << "a " << gridSize << "^3 3D LUT (estimated cost " << bakedCost << "): ";
+                os << "max error " << maxError;
+                LogDebug(os.str());
+            }
 
-        ops.insert(ops.begin(), lutOps.begin(), lutOps.end());
+            if (maxError <= BAKE_LUT3D_MAX_ERROR)
+            {
+                ops.erase(ops.begin(), ops.begin() + bakeEnd);
+                ops.insert(ops.begin(), bakedOps.begin(), bakedOps.end());
+                return maxError;
+            }
+        }
+
+        return -1.0f;
     }
 
-    // TODO: Temporary method to limit code changes.
-    void OptimizeSeparablePrefix(OpRcPtrVec & ops, OptimizationFlags /*oFlags*/)
+    float OptimizeBakeLut3D(OpRcPtrVec & ops, const BitDepth & inBitDepth)
     {
-        OptimizeSeparablePrefix(ops, BIT_DEPTH_F32);
+        return OptimizeBakeLut3D(ops, inBitDepth, GetDefaultBakeLut3DAllocation());
     }
 
+    namespace
+    {
     void OptimizeOpVec(OpRcPtrVec & ops, const BitDepth & inBitDepth, const BitDepth & outBitDepth,
-                       OptimizationFlags oFlags)
+                       OptimizationFlags oFlags, bool keepParameterOps)
     {
         if (ops.empty())
             return;
@@ -316,32 +1188,28 @@ OCIO_NAMESPACE_ENTER
         // preserve their values.
 
         OpRcPtrVec::size_type originalSize = ops.size();
-        int total_noops                    = 0;
-        int total_inverseops               = 0;
-        int total_combines                 = 0;
-        int passes                         = 0;
 
-        while (passes <= MAX_OPTIMIZATION_PASSES)
+        // Folding, baking & the separable optimizations replace ops by ops of
+        // another kind, so none of them applies when the parameter ops are kept.
+
+        if ((oFlags & OPTIMIZATION_COMP_MATRIX) == OPTIMIZATION_COMP_MATRIX && !keepParameterOps)
         {
-            int noops      = RemoveNoOps(ops);
-            int inverseops = RemoveInverseOps(ops);
-            int combines   = CombineOps(ops);
+            FoldAffineOps(ops);
+        }
+
+        PeepholeStats stats;
+        PeepholeOptimize(ops,
+                         keepParameterOps ? (PEEPHOLE_ALL | PEEPHOLE_KEEP_PARAMETER_OPS)
+                                          : PEEPHOLE_ALL,
+                         stats);
 
-            if (noops == 0 && inverseops == 0 && combines == 0)
+        if (!ops.empty() && !keepParameterOps)
+        {
+            if ((oFlags & OPTIMIZATION_COMP_BAKE_LUT3D) == OPTIMIZATION_COMP_BAKE_LUT3D)
             {
-                // No optimization progress was made, so stop trying.
-                break;
+                OptimizeBakeLut3D(ops, inBitDepth);
             }
 
-            total_noops += noops;
-            total_inverseops += inverseops;
-            total_combines += combines;
-
-            ++passes;
-        }
-
-        if (!ops.empty())
-        {
             if ((oFlags & OPTIMIZATION_COMP_SEPARABLE_PREFIX) == OPTIMIZATION_COMP_SEPARABLE_PREFIX)
             {
                 // Adjust the op list to the input and output bit-depths
@@ -352,14 +1220,21 @@ OCIO_NAMESPACE_ENTER
 
                 OptimizeSeparablePrefix(ops, inBitDepth);
             }
+
+            if ((oFlags & OPTIMIZATION_COMP_SEPARABLE_SUFFIX) == OPTIMIZATION_COMP_SEPARABLE_SUFFIX)
+            {
+                ops.back()->setOutputBitDepth(outBitDepth);
+
+                OptimizeSeparableSuffix(ops, outBitDepth);
+            }
         }
 
         OpRcPtrVec::size_type finalSize = ops.size();
 
-        if (passes == MAX_OPTIMIZATION_PASSES)
+        if (stats.maxRewritesReached)
         {
             std::ostringstream os;
-            os << "The max number of passes, " << passes << ", ";
+            os << "The max number of rewrites, " << MAX_OPTIMIZATION_PASSES << " per op, ";
             os << "was reached during optimization. This is likely a sign ";
             os << "that either the complexity of the color transform is ";
             os << "very high, or that some internal optimizers are in conflict ";
@@ -372,19 +1247,31 @@ OCIO_NAMESPACE_ENTER
             std::ostringstream os;
             os << "Optimized ";
             os << originalSize << "->" << finalSize << ", ";
-            os << passes << " passes, ";
-            os << total_noops << " noops removed, ";
-            os << total_inverseops << " inverse ops removed\n";
-            os << total_combines << " ops combines\n";
+            os << stats.visits << " visits, ";
+            os << stats.noops << " noops removed, ";
+            os << stats.inverses << " inverse ops removed, ";
+            os << stats.combines << " ops combines\n";
             os << SerializeOpVec(ops, 4);
             LogDebug(os.str());
         }
     }
+    } // namespace
+
+    void OptimizeOpVec(OpRcPtrVec & ops, const BitDepth & inBitDepth, const BitDepth & outBitDepth,
+                       OptimizationFlags oFlags)
+    {
+        OptimizeOpVec(ops, inBitDepth, outBitDepth, oFlags, false);
+    }
 
     // TODO: Temporary method to limit code changes.
     void OptimizeOpVec(OpRcPtrVec & ops, OptimizationFlags oFlags)
     {
-        OptimizeOpVec(ops, BIT_DEPTH_F32, BIT_DEPTH_F32, oFlags);
+        OptimizeOpVec(ops, BIT_DEPTH_F32, BIT_DEPTH_F32, oFlags, false);
+    }
+
+    void OptimizeOpVecKeepingParameters(OpRcPtrVec & ops, OptimizationFlags oFlags)
+    {
+        OptimizeOpVec(ops, BIT_DEPTH_F32, BIT_DEPTH_F32, oFlags, true);
     }
 }
 OCIO_NAMESPACE_EXIT
@@ -401,6 +1288,7 @@ OCIO_NAMESPACE_EXIT
 #include "ops/Matrix/MatrixOps.h"
 #include "ops/Range/RangeOps.h"
 #include "ops/exposurecontrast/ExposureContrastOps.h"
+#include "ops/FixedFunction/FixedFunctionOps.h"
 
 namespace OCIO = OCIO_NAMESPACE;
 
@@ -491,38 +1379,276 @@ OCIO_ADD_TEST(OpOptimizers, CombineOps)
     }
 
     {
-        OCIO::OpRcPtrVec ops;
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_INVERSE);
-
-        OCIO_CHECK_EQUAL(ops.size(), 2);
-        OCIO::CombineOps(ops);
-        OCIO_CHECK_EQUAL(ops.size(), 0);
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_INVERSE);
+
+        OCIO_CHECK_EQUAL(ops.size(), 2);
+        OCIO::CombineOps(ops);
+        OCIO_CHECK_EQUAL(ops.size(), 0);
+    }
+
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_EQUAL(ops.size(), 5);
+        OCIO::CombineOps(ops);
+        OCIO_CHECK_EQUAL(ops.size(), 1);
+    }
+
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, m2, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_INVERSE);
+
+        OCIO_CHECK_EQUAL(ops.size(), 4);
+        OCIO::CombineOps(ops);
+        OCIO_CHECK_EQUAL(ops.size(), 0);
+    }
+}
+
+OCIO_ADD_TEST(OpOptimizers, peephole_nested_inverse_ops)
+{
+    // Deep nesting of inverse ops i.e. A, B, C, ..., C', B', A'.
+    const unsigned numLevels = 500;
+
+    OCIO::OpRcPtrVec ops;
+    for (unsigned i = 0; i < numLevels; ++i)
+    {
+        OCIO::CreateLogOp(ops, 2.0 + 0.01 * (i + 1), OCIO::TRANSFORM_DIR_FORWARD);
+    }
+    for (unsigned i = numLevels; i > 0; --i)
+    {
+        OCIO::CreateLogOp(ops, 2.0 + 0.01 * i, OCIO::TRANSFORM_DIR_INVERSE);
+    }
+    OCIO_REQUIRE_EQUAL(ops.size(), 2 * numLevels);
+
+    OCIO::PeepholeStats stats;
+    OCIO::PeepholeOptimize(ops, OCIO::PEEPHOLE_ALL, stats);
+
+    OCIO_CHECK_EQUAL(ops.size(), 0);
+    OCIO_CHECK_EQUAL(stats.inverses, (int)numLevels);
+    OCIO_CHECK_EQUAL(stats.combines, 0);
+    OCIO_CHECK_EQUAL(stats.noops, 0);
+    OCIO_CHECK_ASSERT(!stats.maxRewritesReached);
+    // The cursor walks forward once and steps back once per rewrite.
+    OCIO_CHECK_ASSERT(stats.visits <= (int)(3 * numLevels));
+}
+
+OCIO_ADD_TEST(OpOptimizers, peephole_mixed_rules)
+{
+    const double exp[4] = {1.2, 1.3, 1.4, 1.0};
+    const double m1[4]  = {2.0, 2.0, 2.0, 1.0};
+    const double m2[4]  = {0.25, 0.25, 0.25, 1.0};
+    const double m3[4]  = {0.6, 0.6, 0.6, 1.0};
+    const double identity[4] = {1.0, 1.0, 1.0, 1.0};
+
+    // Combining the scales exposes an inverse pair, which in turn exposes
+    // another inverse pair.
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateScaleOp(ops, identity, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_INVERSE);
+    OCIO::CreateScaleOp(ops, m3, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(ops.size(), 7);
+
+    OCIO::PeepholeStats stats;
+    OCIO::PeepholeOptimize(ops, OCIO::PEEPHOLE_ALL, stats);
+
+    OCIO_REQUIRE_EQUAL(ops.size(), 1);
+    OCIO::ConstOpRcPtr op = ops[0];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::MatrixType);
+    OCIO_CHECK_EQUAL(stats.noops, 1);
+    OCIO_CHECK_EQUAL(stats.combines, 1);
+    OCIO_CHECK_EQUAL(stats.inverses, 2);
+
+    // Only the requested rules are applied.
+    ops.clear();
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, identity, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m3, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO_CHECK_EQUAL(OCIO::RemoveNoOps(ops), 1);
+    OCIO_CHECK_EQUAL(ops.size(), 2);
+    OCIO_CHECK_EQUAL(OCIO::RemoveInverseOps(ops), 0);
+    OCIO_CHECK_EQUAL(ops.size(), 2);
+    OCIO_CHECK_EQUAL(OCIO::CombineOps(ops), 1);
+    OCIO_CHECK_EQUAL(ops.size(), 1);
+}
+
+namespace
+{
+// Op whose rewrite rules only depend on its name: "B" combines with "C"
+// into "X" & "Y", and "A" is the inverse of "X".
+class PeepholeTestOp : public OCIO::Op
+{
+public:
+    explicit PeepholeTestOp(const std::string & name)
+        :   OCIO::Op()
+        ,   m_name(name)
+    {
+        data() = std::make_shared<OCIO::MatrixOpData>();
+    }
+
+    OCIO::TransformDirection getDirection() const noexcept override
+    {
+        return OCIO::TRANSFORM_DIR_FORWARD;
+    }
+
+    OCIO::OpRcPtr clone() const override { return std::make_shared<PeepholeTestOp>(m_name); }
+
+    std::string getInfo() const override { return "<PeepholeTestOp " + m_name + ">"; }
+
+    bool isNoOp() const override { return false; }
+
+    bool isSameType(OCIO::ConstOpRcPtr & op) const override
+    {
+        return (bool)OCIO::DynamicPtrCast<const PeepholeTestOp>(op);
+    }
+
+    bool isInverse(OCIO::ConstOpRcPtr & op) const override
+    {
+        const std::string other = GetName(op);
+        return (m_name == "A" && other == "X") || (m_name == "X" && other == "A");
+    }
+
+    bool canCombineWith(OCIO::ConstOpRcPtr & op) const override
+    {
+        return m_name == "B" && GetName(op) == "C";
     }
 
+    void combineWith(OCIO::OpRcPtrVec & ops, OCIO::ConstOpRcPtr & /*secondOp*/) const override
     {
-        OCIO::OpRcPtrVec ops;
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
-
-        OCIO_CHECK_EQUAL(ops.size(), 5);
-        OCIO::CombineOps(ops);
-        OCIO_CHECK_EQUAL(ops.size(), 1);
+        ops.push_back(std::make_shared<PeepholeTestOp>("X"));
+        ops.push_back(std::make_shared<PeepholeTestOp>("Y"));
     }
 
+    void finalize(OCIO::FinalizationFlags /*fFlags*/) override {}
+
+    OCIO::ConstOpCPURcPtr getCPUOp() const override { return OCIO::ConstOpCPURcPtr(); }
+
+    void extractGpuShaderInfo(OCIO::GpuShaderDescRcPtr & /*shaderDesc*/) const override {}
+
+    static std::string GetName(OCIO::ConstOpRcPtr & op)
     {
-        OCIO::OpRcPtrVec ops;
-        OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateScaleOp(ops, m2, OCIO::TRANSFORM_DIR_FORWARD);
-        OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_INVERSE);
+        auto testOp = OCIO::DynamicPtrCast<const PeepholeTestOp>(op);
+        return testOp ? testOp->m_name : "";
+    }
 
-        OCIO_CHECK_EQUAL(ops.size(), 4);
-        OCIO::CombineOps(ops);
-        OCIO_CHECK_EQUAL(ops.size(), 0);
+private:
+    const std::string m_name;
+};
+}
+
+OCIO_ADD_TEST(OpOptimizers, peephole_combine_exposes_previous_pair)
+{
+    // Combining B & C into X & Y makes the A, X pair an inverse pair.
+    OCIO::OpRcPtrVec ops;
+    ops.push_back(std::make_shared<PeepholeTestOp>("A"));
+    ops.push_back(std::make_shared<PeepholeTestOp>("B"));
+    ops.push_back(std::make_shared<PeepholeTestOp>("C"));
+
+    OCIO::PeepholeStats stats;
+    OCIO::PeepholeOptimize(ops, OCIO::PEEPHOLE_ALL, stats);
+
+    OCIO_CHECK_EQUAL(stats.combines, 1);
+    OCIO_CHECK_EQUAL(stats.inverses, 1);
+    OCIO_REQUIRE_EQUAL(ops.size(), 1);
+    OCIO::ConstOpRcPtr op = ops[0];
+    OCIO_CHECK_EQUAL(PeepholeTestOp::GetName(op), "Y");
+}
+
+OCIO_ADD_TEST(OpOptimizers, peephole_bit_depths)
+{
+    const double m1[4] = {2.0, 2.0, 2.0, 1.0};
+    const double m2[4] = {0.6, 0.6, 0.6, 1.0};
+    const double m3[4] = {0.7, 0.7, 0.7, 1.0};
+    const double exp[4] = {1.2, 1.3, 1.4, 1.0};
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m3, OCIO::TRANSFORM_DIR_FORWARD);
+
+    ops[0]->setInputBitDepth(OCIO::BIT_DEPTH_UINT10);
+    ops[2]->setOutputBitDepth(OCIO::BIT_DEPTH_F16);
+    ops[3]->setInputBitDepth(OCIO::BIT_DEPTH_F16);
+    ops[4]->setOutputBitDepth(OCIO::BIT_DEPTH_UINT8);
+    OCIO_CHECK_NO_THROW(ops.validate());
+
+    OCIO::PeepholeStats stats;
+    OCIO::PeepholeOptimize(ops, OCIO::PEEPHOLE_ALL, stats);
+    OCIO_CHECK_EQUAL(stats.combines, 1);
+
+    // The combined op keeps the bit-depths of the pair it replaces.
+    OCIO_REQUIRE_EQUAL(ops.size(), 4);
+    OCIO_CHECK_EQUAL(ops[0]->getInputBitDepth(), OCIO::BIT_DEPTH_UINT10);
+    OCIO_CHECK_EQUAL(ops[1]->getInputBitDepth(), OCIO::BIT_DEPTH_F32);
+    OCIO_CHECK_EQUAL(ops[1]->getOutputBitDepth(), OCIO::BIT_DEPTH_F16);
+    OCIO_CHECK_EQUAL(ops[2]->getInputBitDepth(), OCIO::BIT_DEPTH_F16);
+    OCIO_CHECK_EQUAL(ops[3]->getOutputBitDepth(), OCIO::BIT_DEPTH_UINT8);
+    OCIO_CHECK_NO_THROW(ops.validate());
+}
+
+OCIO_ADD_TEST(OpOptimizers, keeping_parameters)
+{
+    const double identity[4] = {1.0, 1.0, 1.0, 1.0};
+    const double m1[4]  = {2.0, 2.0, 2.0, 1.0};
+    const double m2[4]  = {0.6, 0.6, 0.6, 1.0};
+    const double exp[4] = {1.2, 1.3, 1.4, 1.0};
+    const double slope[3]  = {1.1, 0.9, 1.0};
+    const double offset[3] = {0.0, 0.0, 0.0};
+    const double power[3]  = {1.0, 1.0, 1.0};
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateScaleOp(ops, identity, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                      slope, offset, power, 1.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_INVERSE);
+
+    OCIO::FixedFunctionOpData::Params params;
+    OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_GLOW_10_FWD);
+    OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_GLOW_10_INV);
+    OCIO_REQUIRE_EQUAL(ops.size(), 8);
+
+    // All the ops but the fixed functions are folded into a single matrix...
+    OCIO::OpRcPtrVec optimizedOps = ops.clone();
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1);
+    OCIO::ConstOpRcPtr op = optimizedOps[0];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::MatrixType);
+
+    // ...whereas only the fixed functions are removed when the parameters are kept.
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVecKeepingParameters(ops, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(ops.size(), 6);
+    OCIO_CHECK_ASSERT(ops[0]->isNoOp());
+
+    const OCIO::OpData::Type types[6] = { OCIO::OpData::MatrixType,
+                                          OCIO::OpData::CDLType,
+                                          OCIO::OpData::MatrixType,
+                                          OCIO::OpData::MatrixType,
+                                          OCIO::OpData::ExponentType,
+                                          OCIO::OpData::ExponentType };
+    for (size_t idx = 0; idx < ops.size(); ++idx)
+    {
+        op = ops[idx];
+        OCIO_CHECK_EQUAL(op->data()->getType(), types[idx]);
     }
 }
 
@@ -793,6 +1919,615 @@ OCIO_ADD_TEST(OpOptimizers, optimizations_with_bit_depths)
     OCIO_CHECK_EQUAL(ops.back()->getOutputBitDepth(), OCIO::BIT_DEPTH_UINT16);
 }
 
+OCIO_ADD_TEST(OptimizeSeparableSuffix, gamma_suffix)
+{
+    OCIO::OpRcPtrVec originalOps;
+
+    const double m44[16] = { 0.7, 0.2, 0.1, 0.0,
+                             0.1, 0.8, 0.1, 0.0,
+                             0.1, 0.1, 0.8, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+    OCIO::CreateMatrixOp(originalOps, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+    const double exp[4] = { 2.4, 2.4, 2.4, 1.0 };
+    OCIO::CreateExponentOp(originalOps, exp, OCIO::TRANSFORM_DIR_INVERSE);
+    OCIO_REQUIRE_EQUAL(originalOps.size(), 2);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps,
+                                            OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT10,
+                                            OCIO::OPTIMIZATION_DEFAULT));
+
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    OCIO::ConstOpRcPtr o = optimizedOps[0];
+    OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::MatrixType);
+    OCIO_CHECK_EQUAL(o->getOutputBitDepth(), OCIO::BIT_DEPTH_F32);
+
+    o = optimizedOps[1];
+    OCIO::ConstLut1DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o->data());
+    OCIO_REQUIRE_ASSERT(lut);
+    OCIO_CHECK_ASSERT(lut->isInputHalfDomain());
+    OCIO_CHECK_EQUAL(lut->getInputBitDepth(), OCIO::BIT_DEPTH_F32);
+    OCIO_CHECK_EQUAL(lut->getOutputBitDepth(), OCIO::BIT_DEPTH_UINT10);
+
+    // Results must be within half a 10-bit code value.
+
+    std::vector<float> img1 = { 0.0001f, 0.002f, 0.0123f, 1.f,
+                                0.18f,   0.5f,   0.77f,   0.f,
+                                1.f,     1.2f,  -0.1f,    1.f };
+    std::vector<float> img2 = img1;
+
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(originalOps, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+
+    for (const auto & op : originalOps)
+    {
+        op->apply(&img1[0], &img1[0], 3);
+    }
+    for (const auto & op : optimizedOps)
+    {
+        op->apply(&img2[0], &img2[0], 3);
+    }
+    for (size_t idx = 0; idx < img1.size(); ++idx)
+    {
+        const float v1 = std::min(std::max(img1[idx], 0.f), 1.f) * 1023.f;
+        const float v2 = std::min(std::max(img2[idx], 0.f), 1.f) * 1023.f;
+        OCIO_CHECK_CLOSE(v1, v2, 0.5f);
+    }
+
+    // Float output is left unchanged.
+    optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparableSuffix(optimizedOps, OCIO::BIT_DEPTH_F32));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    o = optimizedOps[1];
+    OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::ExponentType);
+
+    // The interpolation error of the half-domain is too large for 16-bit output.
+    optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparableSuffix(optimizedOps, OCIO::BIT_DEPTH_UINT16));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    o = optimizedOps[1];
+    OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::ExponentType);
+}
+
+OCIO_ADD_TEST(OptimizeSeparableSuffix, inexpensive_suffix)
+{
+    OCIO::OpRcPtrVec ops;
+
+    const double m44[16] = { 0.7, 0.2, 0.1, 0.0,
+                             0.1, 0.8, 0.1, 0.0,
+                             0.1, 0.1, 0.8, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+    OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+    const double scale[4] = { 0.5, 0.5, 0.5, 1.0 };
+    OCIO::CreateScaleOp(ops, scale, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateRangeOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                        0., 1., 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(ops.size(), 3);
+
+    OCIO_CHECK_EQUAL(OCIO::FindSeparableSuffix(ops), 0);
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparableSuffix(ops, OCIO::BIT_DEPTH_UINT8));
+    OCIO_CHECK_EQUAL(ops.size(), 3);
+}
+
+namespace
+{
+
+void compareBakedRender(OCIO::OpRcPtrVec ops1, OCIO::OpRcPtrVec ops2,
+                        const std::vector<float> & img, unsigned line)
+{
+    std::vector<float> img1 = img;
+    std::vector<float> img2 = img;
+    const long numPixels = long(img.size() / 4);
+
+    OCIO::FinalizeOpVec(ops1, OCIO::FINALIZATION_EXACT);
+    for (const auto & op : ops1)
+    {
+        op->apply(&img1[0], &img1[0], numPixels);
+    }
+
+    OCIO::FinalizeOpVec(ops2, OCIO::FINALIZATION_EXACT);
+    for (const auto & op : ops2)
+    {
+        op->apply(&img2[0], &img2[0], numPixels);
+    }
+
+    for (size_t idx = 0; idx < img1.size(); ++idx)
+    {
+        OCIO_CHECK_CLOSE_FROM(img1[idx], img2[idx], 1e-3f, line);
+    }
+}
+
+void compareBakedRender(OCIO::OpRcPtrVec ops1, OCIO::OpRcPtrVec ops2, unsigned line)
+{
+    const std::vector<float> img = {
+        0.80f, 0.20f, 0.10f, 1.00f,
+        0.02f, 0.03f, 0.04f, 0.50f,
+        0.25f, 0.50f, 0.75f, 0.00f,
+        1.00f, 0.95f, 0.10f, 1.00f,
+        0.45f, 0.45f, 0.45f, 1.00f,
+        0.00f, 0.00f, 0.00f, 1.00f,
+        1.00f, 1.00f, 1.00f, 1.00f };
+
+    compareBakedRender(ops1, ops2, img, line);
+}
+
+void createAcesLikeOps(OCIO::OpRcPtrVec & ops)
+{
+    const double m44[16] = { 0.70, 0.20, 0.10, 0.0,
+                             0.05, 0.90, 0.05, 0.0,
+                             0.02, 0.08, 0.90, 0.0,
+                             0.00, 0.00, 0.00, 1.0 };
+    OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::FixedFunctionOpData::Params params;
+    OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_GLOW_10_FWD);
+    OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_RED_MOD_10_FWD);
+
+    OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_INVERSE);
+}
+
+void createGradeOps(OCIO::OpRcPtrVec & ops)
+{
+    const double m44[16] = { 0.70, 0.20, 0.10, 0.0,
+                             0.05, 0.90, 0.05, 0.0,
+                             0.02, 0.08, 0.90, 0.0,
+                             0.00, 0.00, 0.00, 1.0 };
+    OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+    const double slope[3]  = { 1.10, 0.95, 1.05 };
+    const double offset[3] = { 0.01, 0.00, 0.02 };
+    const double power[3]  = { 1.20, 1.10, 1.25 };
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                      slope, offset, power, 0.8, OCIO::TRANSFORM_DIR_FORWARD);
+}
+
+void createLogOps(OCIO::OpRcPtrVec & ops)
+{
+    // Scene-linear to a normalized log encoding.
+    const double base = 2.0;
+    const double logSlope[3]  = { 1.0 / 16.0, 1.0 / 16.0, 1.0 / 16.0 };
+    const double logOffset[3] = { 0.5, 0.5, 0.5 };
+    const double linSlope[3]  = { 1.0, 1.0, 1.0 };
+    const double linOffset[3] = { 0.01, 0.01, 0.01 };
+    OCIO::CreateLogOp(ops, base, logSlope, logOffset, linSlope, linOffset,
+                      OCIO::TRANSFORM_DIR_FORWARD);
+}
+
+void createSceneToLogOps(OCIO::OpRcPtrVec & ops)
+{
+    // Start with an unclamped separable op.
+    const double exp[4] = { 1.1, 1.1, 1.1, 1.0 };
+    OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+    createGradeOps(ops);
+    createLogOps(ops);
+}
+
+} // namespace
+
+OCIO_ADD_TEST(OptimizeBakeLut3D, estimate_cost)
+{
+    OCIO::OpRcPtrVec ops;
+    createAcesLikeOps(ops);
+    OCIO_REQUIRE_EQUAL(ops.size(), 4);
+
+    OCIO_CHECK_EQUAL(OCIO::EstimateOpCost(ops[0]), 1.0f);
+    OCIO_CHECK_EQUAL(OCIO::EstimateOpCost(ops[1]), 15.0f);
+    OCIO_CHECK_EQUAL(OCIO::EstimateOpCost(ops[2]), 20.0f);
+}
+
+OCIO_ADD_TEST(OptimizeBakeLut3D, integer_input)
+{
+    OCIO::OpRcPtrVec originalOps;
+    createGradeOps(originalOps);
+    createGradeOps(originalOps);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    float error = -1.0f;
+    OCIO_CHECK_NO_THROW(error = OCIO::OptimizeBakeLut3D(optimizedOps, OCIO::BIT_DEPTH_UINT10));
+
+    // As the first op has crosstalk, there is no shaper.
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1);
+    OCIO::ConstOpRcPtr op = optimizedOps[0];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut3DType);
+    OCIO_CHECK_ASSERT(error >= 0.0f);
+    OCIO_CHECK_ASSERT(error <= 1e-3f);
+
+    compareBakedRender(originalOps, optimizedOps, __LINE__);
+
+    // The separable ops at the front of the chain are baked into the shaper.
+    const double exp[4] = { 2.2, 2.2, 2.2, 1.0 };
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+    ops += originalOps;
+    originalOps = ops.clone();
+
+    optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(error = OCIO::OptimizeBakeLut3D(optimizedOps, OCIO::BIT_DEPTH_UINT10));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    op = optimizedOps[0];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut1DType);
+    op = optimizedOps[1];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut3DType);
+    OCIO_CHECK_ASSERT(error >= 0.0f);
+    OCIO_CHECK_ASSERT(error <= 1e-3f);
+
+    compareBakedRender(originalOps, optimizedOps, __LINE__);
+}
+
+OCIO_ADD_TEST(OptimizeBakeLut3D, float_input)
+{
+    OCIO::OpRcPtrVec originalOps;
+    createSceneToLogOps(originalOps);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    float error = -1.0f;
+    OCIO_CHECK_NO_THROW(error = OCIO::OptimizeBakeLut3D(optimizedOps, OCIO::BIT_DEPTH_F32));
+
+    // The shaper maps the input range of the bake to the 3D LUT domain.
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    OCIO::ConstOpRcPtr op = optimizedOps[0];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut1DType);
+    op = optimizedOps[1];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut3DType);
+    OCIO_CHECK_ASSERT(error >= 0.0f);
+    OCIO_CHECK_ASSERT(error <= 1e-3f);
+
+    compareBakedRender(originalOps, optimizedOps, __LINE__);
+
+    // The HDR values are also in the default input range.
+    const std::vector<float> img = {
+        2.00f,  0.50f,  0.10f,  1.0f,
+        10.0f,  12.0f,  9.00f,  1.0f,
+        100.0f, 100.0f, 100.0f, 1.0f,
+        0.001f, 80.0f,  0.01f,  1.0f };
+    compareBakedRender(originalOps, optimizedOps, img, __LINE__);
+}
+
+OCIO_ADD_TEST(OptimizeBakeLut3D, float_input_range)
+{
+    OCIO::OpRcPtrVec originalOps;
+    createSceneToLogOps(originalOps);
+
+    // Only bake the [0, 1) range.
+    OCIO::AllocationData allocation;
+    allocation.allocation = OCIO::ALLOCATION_LG2;
+    allocation.vars = { -8.0f, 0.0f, 0.00390625f };
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    float error = -1.0f;
+    OCIO_CHECK_NO_THROW(
+        error = OCIO::OptimizeBakeLut3D(optimizedOps, OCIO::BIT_DEPTH_F32, allocation));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    OCIO_CHECK_ASSERT(error >= 0.0f);
+    OCIO_CHECK_ASSERT(error <= 1e-3f);
+
+    compareBakedRender(originalOps, optimizedOps, __LINE__);
+
+    // The values outside of the range are clamped.
+    const float maxIn = 1.0f - 0.00390625f;
+    std::vector<float> ref = { maxIn, maxIn, maxIn, 1.0f, 0.0f,  maxIn, 0.0f, 1.0f };
+    std::vector<float> img = { 4.0f,  50.0f, 2.0f,  1.0f, -1.0f, 10.0f, 0.0f, 1.0f };
+
+    OCIO::FinalizeOpVec(originalOps, OCIO::FINALIZATION_EXACT);
+    for (const auto & op : originalOps)
+    {
+        op->apply(&ref[0], &ref[0], 2);
+    }
+    OCIO::FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT);
+    for (const auto & op : optimizedOps)
+    {
+        op->apply(&img[0], &img[0], 2);
+    }
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        OCIO_CHECK_CLOSE(img[idx], ref[idx], 1e-3f);
+    }
+}
+
+OCIO_ADD_TEST(OptimizeBakeLut3D, trailing_dynamic_op)
+{
+    OCIO::OpRcPtrVec originalOps;
+    createGradeOps(originalOps);
+    createGradeOps(originalOps);
+
+    OCIO::ExposureContrastOpDataRcPtr exposure
+        = std::make_shared<OCIO::ExposureContrastOpData>();
+    exposure->getExposureProperty()->makeDynamic();
+    OCIO::CreateExposureContrastOp(originalOps, exposure, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(originalOps.size(), 5);
+
+    // The dynamic op stays out of the bake.
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    float error = -1.0f;
+    OCIO_CHECK_NO_THROW(error = OCIO::OptimizeBakeLut3D(optimizedOps, OCIO::BIT_DEPTH_UINT8));
+    OCIO_CHECK_ASSERT(error >= 0.0f);
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    OCIO::ConstOpRcPtr op = optimizedOps[0];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut3DType);
+    op = optimizedOps[1];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::ExposureContrastType);
+    OCIO_CHECK_ASSERT(op->isDynamic());
+
+    compareBakedRender(originalOps, optimizedOps, __LINE__);
+}
+
+OCIO_ADD_TEST(OptimizeBakeLut3D, optimize_op_vec)
+{
+    OCIO::OpRcPtrVec originalOps;
+    createSceneToLogOps(originalOps);
+    OCIO_REQUIRE_EQUAL(originalOps.size(), 4);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_DRAFT));
+
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2);
+    OCIO::ConstOpRcPtr op = optimizedOps[0];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut1DType);
+    op = optimizedOps[1];
+    OCIO_CHECK_EQUAL(op->data()->getType(), OCIO::OpData::Lut3DType);
+
+    compareBakedRender(originalOps, optimizedOps, __LINE__);
+
+    // The default optimization level does not bake.
+    optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_CHECK_EQUAL(optimizedOps.size(), 4);
+}
+
+OCIO_ADD_TEST(OptimizeBakeLut3D, not_baked)
+{
+    // Inexpensive chain.
+    {
+        OCIO::OpRcPtrVec ops;
+        const double m44[16] = { 0.7, 0.2, 0.1, 0.0,
+                                 0.1, 0.8, 0.1, 0.0,
+                                 0.1, 0.1, 0.8, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+        const double exp[4] = { 2.2, 2.2, 2.2, 1.0 };
+        OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_ASSERT(OCIO::OptimizeBakeLut3D(ops, OCIO::BIT_DEPTH_UINT8) < 0.0f);
+        OCIO_CHECK_EQUAL(ops.size(), 2);
+    }
+
+    // Dynamic op inside the chain.
+    {
+        OCIO::OpRcPtrVec ops;
+        createGradeOps(ops);
+        createGradeOps(ops);
+
+        OCIO::ExposureContrastOpDataRcPtr exposure
+            = std::make_shared<OCIO::ExposureContrastOpData>();
+        exposure->getExposureProperty()->makeDynamic();
+        OCIO::CreateExposureContrastOp(ops, exposure, OCIO::TRANSFORM_DIR_FORWARD);
+        createGradeOps(ops);
+        createGradeOps(ops);
+
+        OCIO_CHECK_ASSERT(OCIO::OptimizeBakeLut3D(ops, OCIO::BIT_DEPTH_UINT8) < 0.0f);
+        OCIO_CHECK_EQUAL(ops.size(), 9);
+    }
+
+    // Measured error is too large.
+    {
+        OCIO::OpRcPtrVec ops;
+        const double m44[16] = { 0.7, 0.2, 0.1, 0.0,
+                                 0.1, 0.8, 0.1, 0.0,
+                                 0.1, 0.1, 0.8, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+        const double exp[4] = { 25., 25., 25., 1.0 };
+        OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateExponentOp(ops, exp, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_ASSERT(OCIO::OptimizeBakeLut3D(ops, OCIO::BIT_DEPTH_UINT8) < 0.0f);
+        OCIO_CHECK_EQUAL(ops.size(), 3);
+    }
+
+    // Scene-linear output values are not accurate enough once baked over the input range.
+    {
+        OCIO::OpRcPtrVec ops;
+        createAcesLikeOps(ops);
+
+        OCIO_CHECK_ASSERT(OCIO::OptimizeBakeLut3D(ops, OCIO::BIT_DEPTH_F32) < 0.0f);
+        OCIO_CHECK_EQUAL(ops.size(), 4);
+    }
+}
+
+OCIO_ADD_TEST(FoldAffineOps, matrix_cdl_exposure)
+{
+    const double m1[4] = {1.1, 0.9, 1.2, 1.0};
+    const double o1[4] = {0.01, -0.02, 0.03, 0.0};
+    const double m2[4] = {0.8, 0.8, 0.7, 1.0};
+
+    const double slope[3]  = {1.2, 1.1, 0.9};
+    const double offset[3] = {0.05, -0.05, 0.1};
+    const double power[3]  = {1.0, 1.0, 1.0};
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateScaleOffsetOp(ops, m1, o1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                      slope, offset, power, 1.0, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::ExposureContrastOpDataRcPtr ec
+        = std::make_shared<OCIO::ExposureContrastOpData>(
+            OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+            OCIO::ExposureContrastOpData::STYLE_LINEAR);
+    ec->setExposure(0.5);
+    OCIO::CreateExposureContrastOp(ops, ec, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_NO_CLAMP_REV,
+                      slope, offset, power, 1.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(ops.size(), 5);
+
+    OCIO::OpRcPtrVec originalOps = ops.clone();
+
+    OCIO::OpRcPtrVec foldedOps = ops.clone();
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(foldedOps), 3);
+    OCIO_REQUIRE_EQUAL(foldedOps.size(), 5);
+    for (const auto & op : foldedOps)
+    {
+        OCIO::ConstOpRcPtr constOp = op;
+        OCIO_CHECK_EQUAL(constOp->data()->getType(), OCIO::OpData::MatrixType);
+    }
+    compareBakedRender(originalOps, foldedOps, __LINE__);
+
+    // The optimizer then combines all the matrices.
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(ops.size(), 1);
+    OCIO::ConstOpRcPtr op0 = ops[0];
+    OCIO_CHECK_EQUAL(op0->data()->getType(), OCIO::OpData::MatrixType);
+    compareBakedRender(originalOps, ops, __LINE__);
+
+    // Folding is part of the matrix composition optimization.
+    ops = originalOps.clone();
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::OPTIMIZATION_NONE));
+    OCIO_CHECK_EQUAL(ops.size(), 5);
+}
+
+OCIO_ADD_TEST(FoldAffineOps, range_bit_depths)
+{
+    const double m1[4] = {0.5, 0.5, 0.5, 1.0};
+
+    // An unclamped range only scales and offsets.
+    OCIO::RangeOpDataRcPtr range
+        = std::make_shared<OCIO::RangeOpData>(
+            OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32,
+            OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+            OCIO::RangeOpData::EmptyValue(), OCIO::RangeOpData::EmptyValue(),
+            OCIO::RangeOpData::EmptyValue(), OCIO::RangeOpData::EmptyValue());
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateRangeOp(ops, range, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 1);
+    OCIO_REQUIRE_EQUAL(ops.size(), 2);
+    OCIO::ConstOpRcPtr op0 = ops[0];
+    OCIO_CHECK_EQUAL(op0->data()->getType(), OCIO::OpData::MatrixType);
+    OCIO_CHECK_EQUAL(op0->getInputBitDepth(), OCIO::BIT_DEPTH_UINT8);
+    OCIO_CHECK_EQUAL(op0->getOutputBitDepth(), OCIO::BIT_DEPTH_F32);
+
+    OCIO::ConstMatrixOpDataRcPtr mtx
+        = OCIO::DynamicPtrCast<const OCIO::MatrixOpData>(op0->data());
+    OCIO_CHECK_CLOSE(mtx->getArray()[0], 1.0 / 255.0, 1e-9);
+    OCIO_CHECK_EQUAL(mtx->getOffsetValue(0), 0.0);
+
+    // A clamping range is kept.
+    ops.clear();
+    OCIO::CreateRangeOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                        0., 1., 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+
+    // An inverse unclamped range is only folded once finalized (i.e. until then
+    // its data still holds the forward scaling).
+    range = std::make_shared<OCIO::RangeOpData>(
+        OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32,
+        OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+        OCIO::RangeOpData::EmptyValue(), OCIO::RangeOpData::EmptyValue(),
+        OCIO::RangeOpData::EmptyValue(), OCIO::RangeOpData::EmptyValue());
+
+    ops.clear();
+    OCIO::CreateRangeOp(ops, range, OCIO::TRANSFORM_DIR_INVERSE);
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+    OCIO_REQUIRE_EQUAL(ops.size(), 2);
+    op0 = ops[0];
+    OCIO_CHECK_EQUAL(op0->data()->getType(), OCIO::OpData::RangeType);
+
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 1);
+    OCIO_REQUIRE_EQUAL(ops.size(), 2);
+    op0 = ops[0];
+    OCIO_CHECK_EQUAL(op0->data()->getType(), OCIO::OpData::MatrixType);
+}
+
+OCIO_ADD_TEST(FoldAffineOps, not_folded)
+{
+    const double m1[4] = {0.5, 0.5, 0.5, 1.0};
+
+    const double slope[3]  = {1.2, 1.1, 0.9};
+    const double offset[3] = {0.05, -0.05, 0.1};
+    const double power[3]  = {1.0, 1.0, 1.0};
+    const double gamma[3]  = {1.0, 1.1, 1.0};
+
+    // Clamping CDL.
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_V1_2_FWD,
+                      slope, offset, power, 1.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+
+    // CDL with a power.
+    ops.clear();
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                      slope, offset, gamma, 1.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+
+    // CDL with a saturation.
+    ops.clear();
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                      slope, offset, power, 0.8, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+
+    // Affine CDL without any affine neighbor.
+    ops.clear();
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateCDLOp(ops, OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                      OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                      slope, offset, power, 1.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+
+    // Exposure with contrast.
+    OCIO::ExposureContrastOpDataRcPtr ec
+        = std::make_shared<OCIO::ExposureContrastOpData>(
+            OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+            OCIO::ExposureContrastOpData::STYLE_LINEAR);
+    ec->setExposure(0.5);
+    ec->setContrast(1.5);
+
+    ops.clear();
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExposureContrastOp(ops, ec, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+
+    // Dynamic exposure.
+    ec = std::make_shared<OCIO::ExposureContrastOpData>(
+        OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+        OCIO::ExposureContrastOpData::STYLE_LINEAR);
+    ec->getExposureProperty()->makeDynamic();
+
+    ops.clear();
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExposureContrastOp(ops, ec, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+
+    // Video style exposure.
+    ec = std::make_shared<OCIO::ExposureContrastOpData>(
+        OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+        OCIO::ExposureContrastOpData::STYLE_VIDEO);
+    ec->setExposure(0.5);
+
+    ops.clear();
+    OCIO::CreateScaleOp(ops, m1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExposureContrastOp(ops, ec, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(OCIO::FoldAffineOps(ops), 0);
+}
+
 // TODO: Add separable prefix tests that mix in more non-separable ops.
 
 // TODO: Add synColor unit tests opt_prefix_test1
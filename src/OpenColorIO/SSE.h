@@ -49,6 +49,9 @@ static const __m128 EPOS127 = _mm_set1_ps(127.0f);
 
 static const __m128 EPOSINF = _mm_set1_ps(std::numeric_limits<float>::infinity());
 
+// Select the R, G & B channels of a packed RGBA pixel (i.e. leave the alpha channel as is).
+static const __m128 ERGB_MASK = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
 // Debug function to print out the contents of a floating-point SSE register
 inline void ssePrintRegister(const char* msg, __m128& reg)
 {
@@ -12,6 +12,65 @@
 OCIO_NAMESPACE_ENTER
 {
 
+namespace
+{
+
+// Divide the color values by alpha. The fully transparent pixels (i.e. alpha not greater
+// than 0 or NaN) are saved to be restored by Premultiply() i.e. they are not processed.
+void Unpremultiply(float * rgba, long numPixels,
+                   std::vector<long> & transparentIndices,
+                   std::vector<float> & transparentPixels)
+{
+    transparentIndices.clear();
+    transparentPixels.clear();
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const float alpha = rgba[3];
+
+        if(alpha > 0.0f)
+        {
+            rgba[0] /= alpha;
+            rgba[1] /= alpha;
+            rgba[2] /= alpha;
+        }
+        else
+        {
+            transparentIndices.push_back(idx);
+            transparentPixels.insert(transparentPixels.end(), rgba, rgba + 4);
+        }
+
+        rgba += 4;
+    }
+}
+
+// Multiply the color values by the processed alpha, and restore the fully transparent pixels.
+void Premultiply(float * rgba, long numPixels,
+                 const std::vector<long> & transparentIndices,
+                 const std::vector<float> & transparentPixels)
+{
+    float * pix = rgba;
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const float alpha = pix[3];
+
+        pix[0] *= alpha;
+        pix[1] *= alpha;
+        pix[2] *= alpha;
+
+        pix += 4;
+    }
+
+    const size_t numTransparentPixels = transparentIndices.size();
+    for(size_t idx=0; idx<numTransparentPixels; ++idx)
+    {
+        std::copy(&transparentPixels[4 * idx], &transparentPixels[4 * idx] + 4,
+                  rgba + 4 * transparentIndices[idx]);
+    }
+}
+
+}
+
 Optimizations GetOptimizationMode(const GenericImageDesc & imgDesc)
 {
     Optimizations optim = NO_OPTIMIZATION;
@@ -34,7 +93,9 @@ template<typename InType, typename OutType>
 GenericScanlineHelper<InType, OutType>::GenericScanlineHelper(BitDepth inputBitDepth,
                                                               const ConstOpCPURcPtr & inBitDepthOp,
                                                               BitDepth outputBitDepth,
-                                                              const ConstOpCPURcPtr & outBitDepthOp)
+                                                              const ConstOpCPURcPtr & outBitDepthOp,
+                                                              AlphaMode alphaMode,
+                                                              bool modifiesAlpha)
     :   ScanlineHelper()
     ,   m_inputBitDepth(inputBitDepth)
     ,   m_outputBitDepth(outputBitDepth)
@@ -42,6 +103,8 @@ GenericScanlineHelper<InType, OutType>::GenericScanlineHelper(BitDepth inputBitD
     ,   m_outBitDepthOp(outBitDepthOp)
     ,   m_inOptimizedMode(NO_OPTIMIZATION)
     ,   m_outOptimizedMode(NO_OPTIMIZATION)
+    ,   m_alphaMode(alphaMode)
+    ,   m_modifiesAlpha(modifiesAlpha)
     ,   m_yIndex(0)
     ,   m_useDstBuffer(false)
 {
@@ -63,6 +126,12 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & srcImg, cons
     m_inOptimizedMode  = GetOptimizationMode(m_srcImg);
     m_outOptimizedMode = GetOptimizationMode(m_dstImg);
 
+    // Without alpha, the color values cannot be premultiplied.
+    if(!m_srcImg.hasAlpha())
+    {
+        m_alphaMode = ALPHA_STRAIGHT;
+    }
+
     // Can the output buffer be used as the internal RGBA F32 buffer?
     m_useDstBuffer
         = (m_outOptimizedMode & PACKED_FLOAT_OPTIMIZATION) == PACKED_FLOAT_OPTIMIZATION;
@@ -92,6 +161,19 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & img)
     m_inOptimizedMode  = GetOptimizationMode(m_srcImg);
     m_outOptimizedMode = m_inOptimizedMode;
 
+    // Without alpha, the color values cannot be premultiplied.
+    if(!m_srcImg.hasAlpha())
+    {
+        m_alphaMode = ALPHA_STRAIGHT;
+    }
+
+    // When the alpha channel is unchanged, the in-place image buffer already holds the
+    // output alpha values so the generic packing only writes the color channels.
+    if(!m_modifiesAlpha && m_inputBitDepth==m_outputBitDepth)
+    {
+        m_dstImg.m_aData = nullptr;
+    }
+
     // Can the output buffer be used as the internal RGBA F32 buffer?
     m_useDstBuffer
         = (m_outOptimizedMode & PACKED_FLOAT_OPTIMIZATION) == PACKED_FLOAT_OPTIMIZATION;
@@ -135,6 +217,17 @@ void GenericScanlineHelper<InType, OutType>::prepRGBAScanline(float** buffer, lo
 
         m_srcImg.m_bitDepthOp->apply(inBuffer, *buffer, m_dstImg.m_width);
     }
+    else if(m_srcImg.m_isBitPacked)
+    {
+        // Unpack the bit-packed values to 16-bit RGBA values (i.e. the bit-packed image
+        // buffers are always 10 or 12-bit integers) and then convert them to F32.
+
+        BitPacked::UnpackRGBAFromImageDesc(m_srcImg,
+                                           reinterpret_cast<uint16_t*>(&m_inBitDepthBuffer[0]),
+                                           m_yIndex);
+
+        m_srcImg.m_bitDepthOp->apply(&m_inBitDepthBuffer[0], *buffer, m_dstImg.m_width);
+    }
     else
     {
         // Pack from any channel ordering & bit-depth to a packed RGBA F32 buffer.
@@ -147,6 +240,11 @@ void GenericScanlineHelper<InType, OutType>::prepRGBAScanline(float** buffer, lo
     }
 
     numPixels = m_dstImg.m_width;
+
+    if(m_alphaMode==ALPHA_PREMULTIPLIED)
+    {
+        Unpremultiply(*buffer, numPixels, m_transparentIndices, m_transparentPixels);
+    }
 }
 
 // Write back the result of our work, from the scanline to our destination image.
@@ -155,6 +253,15 @@ void GenericScanlineHelper<InType, OutType>::finishRGBAScanline()
 {
     // Note that only a line-by-line processing is done on the image buffer.
 
+    if(m_alphaMode==ALPHA_PREMULTIPLIED)
+    {
+        float * buffer
+            = m_useDstBuffer ? (float*)(m_dstImg.m_rData + m_dstImg.m_yStrideBytes * m_yIndex)
+                             : &m_rgbaFloatBuffer[0];
+
+        Premultiply(buffer, m_dstImg.m_width, m_transparentIndices, m_transparentPixels);
+    }
+
     if((m_outOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION)
     {
         void * out = (void*)(m_dstImg.m_rData + m_dstImg.m_yStrideBytes * m_yIndex);
@@ -163,6 +270,17 @@ void GenericScanlineHelper<InType, OutType>::finishRGBAScanline()
 
         m_dstImg.m_bitDepthOp->apply(in, out, m_dstImg.m_width);
     }
+    else if(m_dstImg.m_isBitPacked)
+    {
+        // Convert from F32 to 16-bit RGBA values and then pack them.
+
+        m_dstImg.m_bitDepthOp->apply(&m_rgbaFloatBuffer[0], &m_outBitDepthBuffer[0],
+                                     m_dstImg.m_width);
+
+        BitPacked::PackRGBAToImageDesc(m_dstImg,
+                                       reinterpret_cast<uint16_t*>(&m_outBitDepthBuffer[0]),
+                                       m_yIndex);
+    }
     else
     {
         // Unpack from packed RGBA F32 to any channel ordering & bit-depth.
@@ -176,6 +294,30 @@ void GenericScanlineHelper<InType, OutType>::finishRGBAScanline()
     ++m_yIndex;
 }
 
+template<typename InType, typename OutType>
+bool GenericScanlineHelper<InType, OutType>::fillRGBAScanline(const float * rgba)
+{
+    if(m_yIndex >= m_dstImg.m_height)
+    {
+        return false;
+    }
+
+    // Note: The packing could process the buffer in-place so it is filled for each line.
+
+    float * buffer
+        = m_useDstBuffer ? (float*)(m_dstImg.m_rData + m_dstImg.m_yStrideBytes * m_yIndex)
+                         : &m_rgbaFloatBuffer[0];
+
+    for(long idx=0; idx<m_dstImg.m_width; ++idx)
+    {
+        std::copy(rgba, rgba + 4, buffer + 4 * idx);
+    }
+
+    finishRGBAScanline();
+
+    return true;
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////
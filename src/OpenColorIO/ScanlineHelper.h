@@ -40,6 +40,8 @@ public:
     virtual void prepRGBAScanline(float** buffer, long & numPixels) = 0;
     
     virtual void finishRGBAScanline() = 0;
+
+    virtual bool fillRGBAScanline(const float * rgba) = 0;
 };
 
 template<typename InType, typename OutType>
@@ -51,7 +53,8 @@ public:
     GenericScanlineHelper& operator=(const GenericScanlineHelper&) = delete;
 
     GenericScanlineHelper(BitDepth inputBitDepth, const ConstOpCPURcPtr & inBitDepthOp,
-                          BitDepth outputBitDepth, const ConstOpCPURcPtr & outBitDepthOp);
+                          BitDepth outputBitDepth, const ConstOpCPURcPtr & outBitDepthOp,
+                          AlphaMode alphaMode, bool modifiesAlpha);
 
     void init(const ImageDesc & srcImg, const ImageDesc & dstImg) override;
     void init(const ImageDesc & img) override;
@@ -68,6 +71,12 @@ public:
 
     void finishRGBAScanline() override;
 
+    // Write a constant RGBA 32-bit float color to the next line of the destination
+    // image (i.e. the source image is not read). Return false when all the lines are
+    // written.
+
+    bool fillRGBAScanline(const float * rgba) override;
+
 private:
     BitDepth m_inputBitDepth;
     BitDepth m_outputBitDepth;
@@ -88,6 +97,20 @@ private:
     std::vector<InType> m_inBitDepthBuffer;
     std::vector<OutType> m_outBitDepthBuffer;
 
+    // Are the color values premultiplied by alpha? Then the bit-depth ops must only
+    // be bit-depth casts as the color values are divided & multiplied by alpha in
+    // the 32-bit float buffer.
+    AlphaMode m_alphaMode;
+
+    // The fully transparent pixels of the current line (i.e. the indices & the
+    // 32-bit float values) to bypass the color processing in premultiplied mode.
+    std::vector<long> m_transparentIndices;
+    std::vector<float> m_transparentPixels;
+
+    // Does the color processing change the alpha channel? If not, the alpha values
+    // of an in-place image buffer are left as is (i.e. they are not packed back).
+    bool m_modifiesAlpha;
+
     // The index of the current line to process.
     int m_yIndex;
 
@@ -8,7 +8,9 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
 #include "BitDepthUtils.h"
+#include "fileformats/NumberWriter.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -104,7 +106,10 @@ OCIO_NAMESPACE_ENTER
 
             void bake(const Baker & baker,
                        const std::string & formatName,
-                       std::ostream & ostream) const override;
+                       std::ostream & ostream,
+                       BakingContext * context) const override;
+
+            int getDefaultCubeSize(const std::string & formatName) const override;
 
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -488,27 +493,32 @@ OCIO_NAMESPACE_ENTER
             return static_cast<int>(logval);
         }
         
-        void LocalFileFormat::bake(const Baker & baker,
-                                   const std::string & formatName,
-                                   std::ostream & ostream) const
+        int LocalFileFormat::getDefaultCubeSize(const std::string & formatName) const
         {
-            int DEFAULT_CUBE_SIZE = 0;
-            int SHAPER_BIT_DEPTH = 10;
-            int CUBE_BIT_DEPTH = 12;
-
-            
             // NOTE: This code is very old, Lustre and Flame have long been able
             //       to support much larger cube sizes.  Furthermore there is no
             //       need to use the legacy 3dl format since CLF/CTF is supported.
             if(formatName == "lustre")
             {
-                DEFAULT_CUBE_SIZE = 33;
+                return 33;
             }
             else if(formatName == "flame")
             {
-                DEFAULT_CUBE_SIZE = 17;
+                return 17;
             }
-            else
+            return -1;
+        }
+
+        void LocalFileFormat::bake(const Baker & baker,
+                                   const std::string & formatName,
+                                   std::ostream & ostream,
+                                   BakingContext * context) const
+        {
+            const int DEFAULT_CUBE_SIZE = getDefaultCubeSize(formatName);
+            int SHAPER_BIT_DEPTH = 10;
+            int CUBE_BIT_DEPTH = 12;
+
+            if(DEFAULT_CUBE_SIZE == -1)
             {
                 std::ostringstream os;
                 os << "Unknown 3dl format name, '";
@@ -526,9 +536,6 @@ OCIO_NAMESPACE_ENTER
             if(shaperSize==-1) shaperSize = cubeSize;
 
             std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_BLUE);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
 
             // Apply our conversion from the input space to the output space.
             ConstProcessorRcPtr inputToTarget;
@@ -548,7 +555,7 @@ OCIO_NAMESPACE_ENTER
                   baker.getTargetSpace());
             }
             ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            BakingContext::EvaluateLut3D(context, { cpu }, cubeSize, LUT3DORDER_FAST_BLUE, cubeData);
 
             // Write out the file.
             // For for maximum compatibility with other apps, we will
@@ -582,14 +589,19 @@ OCIO_NAMESPACE_ENTER
             {
                 throw Exception("Internal cube size exception.");
             }
-            for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                int r = GetClampedIntFromNormFloat(cubeData[3*i+0], cubeScale);
-                int g = GetClampedIntFromNormFloat(cubeData[3*i+1], cubeScale);
-                int b = GetClampedIntFromNormFloat(cubeData[3*i+2], cubeScale);
-                ostream << r << " " << g << " " << b << "\n";
+                NumberWriter writer(ostream);
+                for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
+                {
+                    writer.writeInteger(GetClampedIntFromNormFloat(cubeData[3*i+0], cubeScale));
+                    writer.write(' ');
+                    writer.writeInteger(GetClampedIntFromNormFloat(cubeData[3*i+1], cubeScale));
+                    writer.write(' ');
+                    writer.writeInteger(GetClampedIntFromNormFloat(cubeData[3*i+2], cubeScale));
+                    writer.write('\n');
+                }
+                writer.write('\n');
             }
-            ostream << "\n";
 
             if(formatName == "lustre")
             {
@@ -13,6 +13,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/NumberWriter.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -325,7 +327,10 @@ OCIO_NAMESPACE_ENTER
 
             void bake(const Baker & baker,
                       const std::string & formatName,
-                      std::ostream & ostream) const override;
+                      std::ostream & ostream,
+                      BakingContext * context) const override;
+
+            int getDefaultCubeSize(const std::string & formatName) const override;
 
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -688,11 +693,17 @@ OCIO_NAMESPACE_ENTER
         }
         
         
+        int LocalFileFormat::getDefaultCubeSize(const std::string & /*formatName*/) const
+        {
+            return 32;
+        }
+
         void LocalFileFormat::bake(const Baker & baker,
-                                   const std::string & /*formatName*/,
-                                   std::ostream & ostream) const
+                                   const std::string & formatName,
+                                   std::ostream & ostream,
+                                   BakingContext * context) const
         {
-            const int DEFAULT_CUBE_SIZE = 32;
+            const int DEFAULT_CUBE_SIZE = getDefaultCubeSize(formatName);
             const int DEFAULT_SHAPER_SIZE = 1024;
             
             ConstConfigRcPtr config = baker.getConfig();
@@ -702,9 +713,6 @@ OCIO_NAMESPACE_ENTER
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
             std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
 
             std::string looks = baker.getLooks();
             
@@ -728,9 +736,7 @@ OCIO_NAMESPACE_ENTER
                 }
                 
                 shaperOutData.resize(shaperSize*3);
-                shaperInData.resize(shaperSize*3);
                 GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-                GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
                 
                 ConstCPUProcessorRcPtr shaperToInput 
                     = config->getProcessor(baker.getShaperSpace(), 
@@ -744,8 +750,7 @@ OCIO_NAMESPACE_ENTER
                     os << "Please select an alternate shaper space or omit this option.";
                     throw Exception(os.str().c_str());
                 }
-                PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-                shaperToInput->apply(shaperInImg);
+                BakingContext::EvaluateLut1D(context, { shaperToInput }, shaperSize, 3, shaperInData);
 
                 ConstCPUProcessorRcPtr shaperToTarget;
                 if (!looks.empty())
@@ -764,7 +769,8 @@ OCIO_NAMESPACE_ENTER
                         = config->getProcessor(baker.getShaperSpace(), 
                                                baker.getTargetSpace())->getDefaultCPUProcessor();
                 }
-                shaperToTarget->apply(cubeImg);
+                BakingContext::EvaluateLut3D(context, { shaperToTarget }, cubeSize,
+                                             LUT3DORDER_FAST_RED, cubeData);
             }
             else
             {
@@ -808,17 +814,13 @@ OCIO_NAMESPACE_ENTER
                     shaperSize = 2;
                 }
                 shaperOutData.resize(shaperSize*3);
-                shaperInData.resize(shaperSize*3);
                 GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-                GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
                 
                 // Apply the forward to the allocation to the output shaper y axis, and the cube
                 ConstCPUProcessorRcPtr shaperToInput
                     = config->getProcessor(allocationTransform, TRANSFORM_DIR_INVERSE)->getDefaultCPUProcessor();
 
-                PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-                shaperToInput->apply(shaperInImg);
-                shaperToInput->apply(cubeImg);
+                BakingContext::EvaluateLut1D(context, { shaperToInput }, shaperSize, 3, shaperInData);
                 
                 // Apply the 3D LUT to the remainder (from the input to the output).
                 ConstProcessorRcPtr inputToTarget;
@@ -836,7 +838,8 @@ OCIO_NAMESPACE_ENTER
                     inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
                 }
                 ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                BakingContext::EvaluateLut3D(context, { shaperToInput, cpu }, cubeSize,
+                                             LUT3DORDER_FAST_RED, cubeData);
             }
             
             // Write out the file.
@@ -889,11 +892,17 @@ OCIO_NAMESPACE_ENTER
                 throw Exception("Internal cube size exception.");
             }
             ostream << cubeSize << " " << cubeSize << " " << cubeSize << "\n";
+            NumberWriter writer(ostream);
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " " << cubeData[3*i+1] << " " << cubeData[3*i+2] << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.write('\n');
             }
-            ostream << "\n";
+            writer.write('\n');
         }
         
         void
@@ -29,6 +29,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/NumberWriter.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -273,7 +275,10 @@ OCIO_NAMESPACE_ENTER
             
             void bake(const Baker & baker,
                       const std::string & formatName,
-                      std::ostream & ostream) const override;
+                      std::ostream & ostream,
+                      BakingContext * context) const override;
+
+            int getDefaultCubeSize(const std::string & formatName) const override;
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -552,9 +557,18 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
         
+        int LocalFileFormat::getDefaultCubeSize(const std::string & /*formatName*/) const
+        {
+            // MPlay produces bad results with 32^3 cube (in a way
+            // that looks more quantised than even "nearest"
+            // interpolation in OCIOFileTransform)
+            return 64;
+        }
+
         void LocalFileFormat::bake(const Baker & baker,
                                    const std::string & formatName,
-                                   std::ostream & ostream) const
+                                   std::ostream & ostream,
+                                   BakingContext * context) const
         {
 
             if(formatName != "houdini")
@@ -574,10 +588,7 @@ OCIO_NAMESPACE_ENTER
 
             // Default sizes
             const int DEFAULT_SHAPER_SIZE = 1024;
-            // MPlay produces bad results with 32^3 cube (in a way
-            // that looks more quantised than even "nearest"
-            // interpolation in OCIOFileTransform)
-            const int DEFAULT_CUBE_SIZE = 64;
+            const int DEFAULT_CUBE_SIZE = getDefaultCubeSize(formatName);
             const int DEFAULT_1D_SIZE = 1024;
 
             // Get configured sizes
@@ -747,11 +758,6 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> cubeData;
             if(required_lut == HDL_3D || required_lut == HDL_3D1D)
             {
-                cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-
-                GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-                PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
                 ConstProcessorRcPtr cubeProc;
                 if(required_lut == HDL_3D1D)
                 {
@@ -778,7 +784,7 @@ OCIO_NAMESPACE_ENTER
                 }
 
                 ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                BakingContext::EvaluateLut3D(context, { cpu }, cubeSize, LUT3DORDER_FAST_RED, cubeData);
             }
 
 
@@ -786,12 +792,8 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> onedData;
             if(required_lut == HDL_1D)
             {
-                onedData.resize(onedSize * 3);
-
-                GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-                PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
                 ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-                cpu->apply(onedImg);
+                BakingContext::EvaluateLut1D(context, { cpu }, onedSize, 3, onedData);
             }
 
 
@@ -849,14 +851,21 @@ OCIO_NAMESPACE_ENTER
             // Write the cube data after the "{"
             if(required_lut == HDL_3D || required_lut == HDL_3D1D)
             {
-                for(int i=0; i < cubeSize*cubeSize*cubeSize; ++i)
                 {
-                    // TODO: Original baker code clamped values to
-                    // 1.0, was this necessary/desirable?
-
-                    ostream << "\t" << cubeData[3*i+0];
-                    ostream << " "  << cubeData[3*i+1];
-                    ostream << " "  << cubeData[3*i+2] << "\n";
+                    NumberWriter writer(ostream);
+                    for(int i=0; i < cubeSize*cubeSize*cubeSize; ++i)
+                    {
+                        // TODO: Original baker code clamped values to
+                        // 1.0, was this necessary/desirable?
+
+                        writer.write('\t');
+                        writer.writeFixed(cubeData[3*i+0], 6);
+                        writer.write(' ');
+                        writer.writeFixed(cubeData[3*i+1], 6);
+                        writer.write(' ');
+                        writer.writeFixed(cubeData[3*i+2], 6);
+                        writer.write('\n');
+                    }
                 }
 
                 // Write closing "}"
@@ -8,6 +8,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/NumberWriter.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ops/Matrix/MatrixOps.h"
@@ -98,7 +100,10 @@ OCIO_NAMESPACE_ENTER
             
             void bake(const Baker & baker,
                       const std::string & formatName,
-                      std::ostream & ostream) const override;
+                      std::ostream & ostream,
+                      BakingContext * context) const override;
+
+            int getDefaultCubeSize(const std::string & formatName) const override;
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -343,12 +348,18 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
         
+        int LocalFileFormat::getDefaultCubeSize(const std::string & /*formatName*/) const
+        {
+            return 32;
+        }
+
         void LocalFileFormat::bake(const Baker & baker,
                                    const std::string & formatName,
-                                   std::ostream & ostream) const
+                                   std::ostream & ostream,
+                                   BakingContext * context) const
         {
 
-            static const int DEFAULT_CUBE_SIZE = 32;
+            const int DEFAULT_CUBE_SIZE = getDefaultCubeSize(formatName);
 
             if(formatName != "iridas_cube")
             {
@@ -365,9 +376,6 @@ OCIO_NAMESPACE_ENTER
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
             std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
 
             // Apply our conversion from the input space to the output space.
             ConstProcessorRcPtr inputToTarget;
@@ -385,7 +393,7 @@ OCIO_NAMESPACE_ENTER
                 inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
             }
             ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            BakingContext::EvaluateLut3D(context, { cpu }, cubeSize, LUT3DORDER_FAST_RED, cubeData);
 
             if(baker.getMetadata() != NULL)
             {
@@ -408,13 +416,15 @@ OCIO_NAMESPACE_ENTER
             }
 
             // Set to a fixed 6 decimal precision
-            ostream.setf(std::ios::fixed, std::ios::floatfield);
-            ostream.precision(6);
+            NumberWriter writer(ostream);
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " "
-                        << cubeData[3*i+1] << " "
-                        << cubeData[3*i+2] << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.write('\n');
             }
         }
 
@@ -8,6 +8,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/NumberWriter.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -72,7 +74,10 @@ OCIO_NAMESPACE_ENTER
             
             void bake(const Baker & baker,
                       const std::string & formatName,
-                      std::ostream & ostream) const override;
+                      std::ostream & ostream,
+                      BakingContext * context) const override;
+
+            int getDefaultCubeSize(const std::string & formatName) const override;
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -222,11 +227,17 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
         
+        int LocalFileFormat::getDefaultCubeSize(const std::string & /*formatName*/) const
+        {
+            return 64;
+        }
+
         void LocalFileFormat::bake(const Baker & baker,
                                    const std::string & formatName,
-                                   std::ostream & ostream) const
+                                   std::ostream & ostream,
+                                   BakingContext * context) const
         {
-            int DEFAULT_CUBE_SIZE = 64;
+            const int DEFAULT_CUBE_SIZE = getDefaultCubeSize(formatName);
 
             if(formatName != "iridas_itx")
             {
@@ -243,9 +254,6 @@ OCIO_NAMESPACE_ENTER
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
             std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
 
             // Apply our conversion from the input space to the output space.
             ConstProcessorRcPtr inputToTarget;
@@ -265,7 +273,7 @@ OCIO_NAMESPACE_ENTER
                     baker.getTargetSpace());
             }
             ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            BakingContext::EvaluateLut3D(context, { cpu }, cubeSize, LUT3DORDER_FAST_RED, cubeData);
 
             // Write out the file.
             // For for maximum compatibility with other apps, we will
@@ -278,16 +286,17 @@ OCIO_NAMESPACE_ENTER
             }
 
             // Set to a fixed 6 decimal precision
-            ostream.setf(std::ios::fixed, std::ios::floatfield);
-            ostream.precision(6);
+            NumberWriter writer(ostream);
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                float r = cubeData[3*i+0];
-                float g = cubeData[3*i+1];
-                float b = cubeData[3*i+2];
-                ostream << r << " " << g << " " << b << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.write('\n');
             }
-            ostream << "\n";
+            writer.write('\n');
         }
 
 
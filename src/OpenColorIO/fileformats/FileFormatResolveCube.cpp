@@ -8,6 +8,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/NumberWriter.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ops/Matrix/MatrixOps.h"
@@ -207,7 +209,10 @@ OCIO_NAMESPACE_ENTER
             
             void bake(const Baker & baker,
                       const std::string & formatName,
-                      std::ostream & ostream) const override;
+                      std::ostream & ostream,
+                      BakingContext * context) const override;
+
+            int getDefaultCubeSize(const std::string & formatName) const override;
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -480,14 +485,20 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
         
+        int LocalFileFormat::getDefaultCubeSize(const std::string & /*formatName*/) const
+        {
+            return 64;
+        }
+
         void LocalFileFormat::bake(const Baker & baker,
                                    const std::string & formatName,
-                                   std::ostream & ostream) const
+                                   std::ostream & ostream,
+                                   BakingContext * context) const
         {
 
             const int DEFAULT_1D_SIZE = 4096;
             const int DEFAULT_SHAPER_SIZE = 4096;
-            const int DEFAULT_3D_SIZE = 64;
+            const int DEFAULT_3D_SIZE = getDefaultCubeSize(formatName);
 
             if(formatName != "resolve_cube")
             {
@@ -662,10 +673,6 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> cubeData;
             if(required_lut == CUBE_3D || required_lut == CUBE_1D_3D)
             {
-                cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-                GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-                PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
                 ConstProcessorRcPtr cubeProc;
                 if(required_lut == CUBE_1D_3D)
                 {
@@ -692,7 +699,7 @@ OCIO_NAMESPACE_ENTER
                 }
 
                 ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                BakingContext::EvaluateLut3D(context, { cpu }, cubeSize, LUT3DORDER_FAST_RED, cubeData);
             }
 
             //
@@ -702,12 +709,8 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> onedData;
             if(required_lut == CUBE_1D)
             {
-                onedData.resize(onedSize * 3);
-                GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-                PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
-                
                 ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-                cpu->apply(onedImg);
+                BakingContext::EvaluateLut1D(context, { cpu }, onedSize, 3, onedData);
             }
 
             //
@@ -755,23 +758,31 @@ OCIO_NAMESPACE_ENTER
                 //ostream << "LUT_3D_INPUT_RANGE 0.0 1.0\n";
             }
 
+            NumberWriter writer(ostream);
+
             // Write 1D data
             if(required_lut == CUBE_1D)
             {
                 for(int i=0; i<onedSize; ++i)
                 {
-                    ostream << onedData[3*i+0] << " "
-                            << onedData[3*i+1] << " "
-                            << onedData[3*i+2] << "\n";
+                    writer.writeFixed(onedData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(onedData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(onedData[3*i+2], 6);
+                    writer.write('\n');
                 }
             }
             else if(required_lut == CUBE_1D_3D)
             {
                 for(int i=0; i<shaperSize; ++i)
                 {
-                    ostream << shaperData[3*i+0] << " "
-                            << shaperData[3*i+1] << " "
-                            << shaperData[3*i+2] << "\n";
+                    writer.writeFixed(shaperData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(shaperData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(shaperData[3*i+2], 6);
+                    writer.write('\n');
                 }
             }
 
@@ -780,9 +791,12 @@ OCIO_NAMESPACE_ENTER
             {
                 for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
                 {
-                    ostream << cubeData[3*i+0] << " "
-                            << cubeData[3*i+1] << " "
-                            << cubeData[3*i+2] << "\n";
+                    writer.writeFixed(cubeData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+2], 6);
+                    writer.write('\n');
                 }
             }
         }
@@ -9,6 +9,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/NumberWriter.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -63,7 +65,10 @@ OCIO_NAMESPACE_ENTER
             
             void bake(const Baker & baker,
                       const std::string & formatName,
-                      std::ostream & ostream) const override;
+                      std::ostream & ostream,
+                      BakingContext * context) const override;
+
+            int getDefaultCubeSize(const std::string & formatName) const override;
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -261,13 +266,19 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
 
+        int
+        LocalFileFormat::getDefaultCubeSize(const std::string & /*formatName*/) const
+        {
+            return 32;
+        }
 
         void
         LocalFileFormat::bake(const Baker & baker,
-                              const std::string & /*formatName*/,
-                              std::ostream & ostream) const
+                              const std::string & formatName,
+                              std::ostream & ostream,
+                              BakingContext * context) const
         {
-            const int DEFAULT_CUBE_SIZE = 32;
+            const int DEFAULT_CUBE_SIZE = getDefaultCubeSize(formatName);
             const int DEFAULT_SHAPER_SIZE = 1024;
 
             ConstConfigRcPtr config = baker.getConfig();
@@ -277,16 +288,13 @@ OCIO_NAMESPACE_ENTER
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
             std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
 
             // Apply processor to LUT data
             ConstCPUProcessorRcPtr inputToTarget;
             inputToTarget
                 = config->getProcessor(baker.getInputSpace(), 
                                        baker.getTargetSpace())->getDefaultCPUProcessor();
-            inputToTarget->apply(cubeImg);
+            BakingContext::EvaluateLut3D(context, { inputToTarget }, cubeSize, LUT3DORDER_FAST_RED, cubeData);
 
             int shaperSize = baker.getShaperSize();
             if (shaperSize==-1) shaperSize = DEFAULT_SHAPER_SIZE;
@@ -318,9 +326,17 @@ OCIO_NAMESPACE_ENTER
 
             // Write the cube
             ostream << "# Cube\n";
-            for (int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " " << cubeData[3*i+1] << " " << cubeData[3*i+2] << "\n";
+                NumberWriter writer(ostream);
+                for (int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
+                {
+                    writer.writeFixed(cubeData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+2], 6);
+                    writer.write('\n');
+                }
             }
 
             ostream << "# end\n";
@@ -0,0 +1,323 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "fileformats/NumberWriter.h"
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+// Size of the buffer flushed to the stream.
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+// Limits ensuring that any formatted value fits in MAX_NUMBER_LENGTH characters
+// (e.g. DBL_MAX in fixed notation has 309 digits before the decimal point).
+constexpr int MAX_PRECISION = 64;
+constexpr int MAX_WIDTH     = 64;
+constexpr size_t MAX_NUMBER_LENGTH = 512;
+
+void CheckFormat(int precision, int width)
+{
+    if (precision < 0 || precision > MAX_PRECISION || width < 0 || width > MAX_WIDTH)
+    {
+        std::ostringstream oss;
+        oss << "Unsupported number format with precision " << precision
+            << " and width " << width << ".";
+        throw Exception(oss.str().c_str());
+    }
+}
+
+// snprintf uses the decimal separator of the process C locale (i.e. LC_NUMERIC) whereas
+// the std::ostream formatting uses the classic locale by default, so replace the separator
+// by a '.' when a host application changed the locale (e.g. "0,5" with a French locale).
+// Returns the new length of the null-terminated number.
+size_t FixDecimalPoint(char * number, size_t length)
+{
+    const char * point = localeconv()->decimal_point;
+    if (!point || !*point || (point[0] == '.' && point[1] == '\0'))
+    {
+        return length;
+    }
+
+    char * pos = strstr(number, point);
+    if (!pos)
+    {
+        return length;
+    }
+
+    const size_t pointLength = strlen(point);
+    *pos = '.';
+    if (pointLength > 1)
+    {
+        // Also move the null terminator.
+        memmove(pos + 1, pos + pointLength, length - (pos - number) - pointLength + 1);
+        length -= pointLength - 1;
+    }
+    return length;
+}
+}
+
+NumberWriter::NumberWriter(std::ostream & stream)
+    : m_stream(stream)
+    , m_buffer(BUFFER_SIZE)
+{
+}
+
+NumberWriter::~NumberWriter()
+{
+    flush();
+}
+
+void NumberWriter::flush()
+{
+    if (m_size > 0)
+    {
+        m_stream.write(m_buffer.data(), m_size);
+        m_size = 0;
+    }
+}
+
+void NumberWriter::reserve(size_t length)
+{
+    if (m_size + length > m_buffer.size())
+    {
+        flush();
+        if (length > m_buffer.size())
+        {
+            m_buffer.resize(length);
+        }
+    }
+}
+
+void NumberWriter::writeFixed(double value, int precision)
+{
+    CheckFormat(precision, 0);
+    reserve(MAX_NUMBER_LENGTH);
+
+    const int length = snprintf(&m_buffer[m_size], MAX_NUMBER_LENGTH, "%.*f", precision, value);
+    m_size += FixDecimalPoint(&m_buffer[m_size], length);
+}
+
+void NumberWriter::writeGeneral(double value, int precision, int width)
+{
+    CheckFormat(precision, width);
+    reserve(MAX_NUMBER_LENGTH);
+
+    const int length
+        = snprintf(&m_buffer[m_size], MAX_NUMBER_LENGTH, "%*.*g", width, precision, value);
+    m_size += FixDecimalPoint(&m_buffer[m_size], length);
+}
+
+void NumberWriter::writeInteger(long long value, int width)
+{
+    CheckFormat(0, width);
+    reserve(MAX_NUMBER_LENGTH);
+
+    const int length = snprintf(&m_buffer[m_size], MAX_NUMBER_LENGTH, "%*lld", width, value);
+    m_size += length;
+}
+
+void NumberWriter::write(const char * str, int width)
+{
+    CheckFormat(0, width);
+
+    const size_t length = strlen(str);
+    const size_t padding = length < (size_t)width ? (size_t)width - length : 0;
+    reserve(length + padding);
+
+    for (size_t i = 0; i < padding; ++i)
+    {
+        m_buffer[m_size++] = ' ';
+    }
+    memcpy(&m_buffer[m_size], str, length);
+    m_size += length;
+}
+
+void NumberWriter::write(char c)
+{
+    reserve(1);
+    m_buffer[m_size++] = c;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+#include <iomanip>
+#include <limits>
+
+OCIO_ADD_TEST(NumberWriter, fixed)
+{
+    const double values[] = { 0.0, -0.0, 1.0, -1.0, 0.1234565, 0.99999951, 123456.789,
+                              1e-7, -1e-7, 1e30, -3.5e15,
+                              std::numeric_limits<double>::max(),
+                              std::numeric_limits<double>::infinity(),
+                              -std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<double>::quiet_NaN() };
+
+    for (int precision : { 0, 1, 6, 15 })
+    {
+        std::ostringstream ref;
+        ref.setf(std::ios::fixed, std::ios::floatfield);
+        ref.precision(precision);
+
+        std::ostringstream oss;
+        {
+            OCIO::NumberWriter writer(oss);
+            for (double v : values)
+            {
+                ref << v << " " << (float)v << "\n";
+
+                writer.writeFixed(v, precision);
+                writer.write(' ');
+                writer.writeFixed((float)v, precision);
+                writer.write('\n');
+            }
+        }
+
+        OCIO_CHECK_EQUAL(oss.str(), ref.str());
+    }
+}
+
+OCIO_ADD_TEST(NumberWriter, general)
+{
+    const double values[] = { 0.0, 1.0, -1.0, 0.1234565, 0.99999951, 123456.789, 1234567.0,
+                              1e-7, 1e30, 1.0 / 3.0, 65535.0, 127.5,
+                              std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<double>::quiet_NaN() };
+
+    for (int precision : { 1, 5, 6, 8, 15 })
+    {
+        for (int width : { 0, 3, 11, 19 })
+        {
+            std::ostringstream ref;
+            ref.precision(precision);
+
+            std::ostringstream oss;
+            {
+                OCIO::NumberWriter writer(oss);
+                for (double v : values)
+                {
+                    ref << std::setw(width) << v << " ";
+                    writer.writeGeneral(v, precision, width);
+                    writer.write(' ');
+                }
+            }
+
+            OCIO_CHECK_EQUAL(oss.str(), ref.str());
+        }
+    }
+}
+
+OCIO_ADD_TEST(NumberWriter, integers_and_strings)
+{
+    std::ostringstream ref;
+    ref << std::setw(4) << 1023 << " " << -12 << " " << std::setw(11) << "nan" << " "
+        << std::setw(2) << "inf" << "\n";
+
+    std::ostringstream oss;
+    {
+        OCIO::NumberWriter writer(oss);
+        writer.writeInteger(1023, 4);
+        writer.write(' ');
+        writer.writeInteger(-12);
+        writer.write(' ');
+        writer.write("nan", 11);
+        writer.write(' ');
+        writer.write("inf", 2);
+        writer.write('\n');
+
+        // Nothing is written before the flush.
+        OCIO_CHECK_ASSERT(oss.str().empty());
+        writer.flush();
+        OCIO_CHECK_EQUAL(oss.str(), ref.str());
+    }
+
+    OCIO::NumberWriter writer(oss);
+    OCIO_CHECK_THROW_WHAT(writer.writeFixed(1.0, 100), OCIO::Exception,
+                          "Unsupported number format with precision 100");
+    OCIO_CHECK_THROW_WHAT(writer.writeGeneral(1.0, 6, -1), OCIO::Exception,
+                          "Unsupported number format with precision 6 and width -1");
+}
+
+OCIO_ADD_TEST(NumberWriter, large_output)
+{
+    // More values than the buffer holds.
+    const int numValues = 65 * 65 * 65;
+
+    std::ostringstream ref;
+    ref.setf(std::ios::fixed, std::ios::floatfield);
+    ref.precision(6);
+
+    std::ostringstream oss;
+    {
+        OCIO::NumberWriter writer(oss);
+        for (int i = 0; i < numValues; ++i)
+        {
+            const float v = (float)i / (float)(numValues - 1);
+            ref << v << "\n";
+            writer.writeFixed(v, 6);
+            writer.write('\n');
+        }
+    }
+
+    OCIO_CHECK_EQUAL(oss.str().size(), ref.str().size());
+    OCIO_CHECK_ASSERT(oss.str() == ref.str());
+}
+
+OCIO_ADD_TEST(NumberWriter, comma_decimal_locale)
+{
+    const std::string oldLocale = setlocale(LC_NUMERIC, nullptr);
+
+    // Use any available locale with a comma as decimal separator.
+    bool commaLocale = false;
+    for (const char * name : { "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "de_DE.UTF-8",
+                               "de_DE.utf8", "de_DE", "French_France.1252", "German_Germany.1252" })
+    {
+        if (setlocale(LC_NUMERIC, name) && localeconv()->decimal_point[0] == ',')
+        {
+            commaLocale = true;
+            break;
+        }
+    }
+
+    std::ostringstream oss;
+    {
+        OCIO::NumberWriter writer(oss);
+        writer.writeFixed(0.5, 6);
+        writer.write(' ');
+        writer.writeGeneral(-1.25, 6, 8);
+        writer.write(' ');
+        writer.writeGeneral(1e-7, 6);
+        writer.write(' ');
+        writer.writeGeneral(2.0, 6);
+        writer.write(' ');
+        writer.writeInteger(1023);
+    }
+
+    setlocale(LC_NUMERIC, oldLocale.c_str());
+
+    // The test is only meaningful when such a locale is installed.
+    if (commaLocale)
+    {
+        OCIO_CHECK_EQUAL(oss.str(), "0.500000    -1.25 1e-07 2 1023");
+    }
+}
+
+#endif // OCIO_UNIT_TEST
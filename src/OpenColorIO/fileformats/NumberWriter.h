@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#ifndef INCLUDED_OCIO_FILEFORMATS_NUMBERWRITER_H
+#define INCLUDED_OCIO_FILEFORMATS_NUMBERWRITER_H
+
+#include <ostream>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Buffered writer of numeric values used by the LUT writers (i.e. bakers and
+// CLF/CTF writer).  Values are formatted with snprintf into a large buffer which
+// is written to the stream once full, instead of going through the std::ostream
+// formatting (and its locale & sentry overhead) for each value.
+//
+// Note: The output is identical to the std::ostream one (using the classic locale)
+// for the same precision, width and floatfield, whatever the process C locale.
+class NumberWriter final
+{
+public:
+    NumberWriter() = delete;
+    NumberWriter(const NumberWriter &) = delete;
+    NumberWriter & operator=(const NumberWriter &) = delete;
+
+    explicit NumberWriter(std::ostream & stream);
+    // Flush the remaining characters to the stream.
+    ~NumberWriter();
+
+    // Same as 'stream << std::fixed << std::setprecision(precision) << value'.
+    void writeFixed(double value, int precision);
+
+    // Same as 'stream << std::setw(width) << std::setprecision(precision) << value'
+    // using the default floatfield.
+    void writeGeneral(double value, int precision, int width = 0);
+
+    // Same as 'stream << std::setw(width) << value'.
+    void writeInteger(long long value, int width = 0);
+
+    // Same as 'stream << std::setw(width) << str'.
+    void write(const char * str, int width = 0);
+    void write(char c);
+
+    // Write the buffered characters to the stream.
+    void flush();
+
+private:
+    // Make room for at least 'length' more characters.
+    void reserve(size_t length);
+
+    std::ostream &    m_stream;
+    std::vector<char> m_buffer;
+    size_t            m_size = 0;
+};
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
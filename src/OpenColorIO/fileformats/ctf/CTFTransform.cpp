@@ -6,6 +6,7 @@
 #include "BitDepthUtils.h"
 #include "fileformats/ctf/CTFReaderUtils.h"
 #include "fileformats/ctf/CTFTransform.h"
+#include "fileformats/NumberWriter.h"
 #include "fileformats/xmlutils/XMLReaderUtils.h"
 #include "HashUtils.h"
 #include "ops/CDL/CDLOpData.h"
@@ -487,17 +488,39 @@ typename std::enable_if<!std::is_floating_point<T>::value, void>::type WriteValu
 }
 
 template <typename T>
-void SetOStream(T, std::ostream & xml)
+void WriteValue(T value, int precision, int width, NumberWriter & writer)
 {
-    xml.width(11);
-    xml.precision(8);
+    if (IsNan(value))
+    {
+        writer.write("nan", width);
+    }
+    else if (value == std::numeric_limits<T>::infinity())
+    {
+        writer.write("inf", width);
+    }
+    else if (std::is_signed<T>::value &&
+        value == -std::numeric_limits<T>::infinity())
+    {
+        writer.write("-inf", width);
+    }
+    else
+    {
+        writer.writeGeneral(value, precision, width);
+    }
+}
+
+template <typename T>
+void GetFloatFormat(T, int & precision, int & width)
+{
+    width = 11;
+    precision = 8;
 }
 
 template <>
-void SetOStream<double>(double, std::ostream & xml)
+void GetFloatFormat<double>(double, int & precision, int & width)
 {
-    xml.width(19);
-    xml.precision(15);
+    width = 19;
+    precision = 15;
 }
 
 template<typename Iter, typename scaleType>
@@ -511,69 +534,76 @@ void WriteValues(XmlFormatter & formatter,
 {
     std::ostream& xml = formatter.getStream();
 
-    for (Iter it(valuesBegin); it != valuesEnd; it += iterStep)
+    // Values are formatted in a buffer as it is much faster than the
+    // std::ostream formatting for large LUTs.  The precision is kept
+    // in sync with the stream so the output is unchanged.
+    int precision = static_cast<int>(xml.precision());
+    int width = 0;
+
     {
-        switch (bitDepth)
-        {
-        case BIT_DEPTH_UINT8:
-        {
-            xml.width(3);
-            xml << (*it) * scale;
-            break;
-        }
-        case BIT_DEPTH_UINT10:
-        {
-            xml.width(4);
-            xml << (*it) * scale;
-            break;
-        }
+        NumberWriter writer(xml);
 
-        case BIT_DEPTH_UINT12:
+        for (Iter it(valuesBegin); it != valuesEnd; it += iterStep)
         {
-            xml.width(4);
-            xml << (*it) * scale;
-            break;
-        }
+            switch (bitDepth)
+            {
+            case BIT_DEPTH_UINT8:
+            {
+                writer.writeGeneral((*it) * scale, precision, 3);
+                break;
+            }
+            case BIT_DEPTH_UINT10:
+            {
+                writer.writeGeneral((*it) * scale, precision, 4);
+                break;
+            }
 
-        case BIT_DEPTH_UINT16:
-        {
-            xml.width(5);
-            xml << (*it) * scale;
-            break;
-        }
+            case BIT_DEPTH_UINT12:
+            {
+                writer.writeGeneral((*it) * scale, precision, 4);
+                break;
+            }
 
-        case BIT_DEPTH_F16:
-        {
-            xml.width(11);
-            xml.precision(5);
-            WriteValue((*it) * scale, xml);
-            break;
-        }
+            case BIT_DEPTH_UINT16:
+            {
+                writer.writeGeneral((*it) * scale, precision, 5);
+                break;
+            }
 
-        case BIT_DEPTH_F32:
-        {
-            SetOStream(*it, xml);
-            WriteValue((*it) * scale, xml);
-            break;
-        }
+            case BIT_DEPTH_F16:
+            {
+                precision = 5;
+                WriteValue((*it) * scale, precision, 11, writer);
+                break;
+            }
 
-        default:
-        {
-            throw Exception("Unknown bitdepth.");
-            break;
-        }
-        }
+            case BIT_DEPTH_F32:
+            {
+                GetFloatFormat(*it, precision, width);
+                WriteValue((*it) * scale, precision, width, writer);
+                break;
+            }
 
-        if (std::distance(valuesBegin, it) % valuesPerLine
-            == valuesPerLine - 1)
-        {
-            xml << std::endl;
-        }
-        else
-        {
-            xml << " ";
+            default:
+            {
+                throw Exception("Unknown bitdepth.");
+                break;
+            }
+            }
+
+            if (std::distance(valuesBegin, it) % valuesPerLine
+                == valuesPerLine - 1)
+            {
+                writer.write('\n');
+            }
+            else
+            {
+                writer.write(' ');
+            }
         }
     }
+
+    xml.precision(precision);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
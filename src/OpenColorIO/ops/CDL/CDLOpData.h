@@ -189,6 +189,8 @@ public:
 
     bool hasChannelCrosstalk() const override;
 
+    bool modifiesAlpha() const override { return false; }
+
     virtual void validate() const override;
 
     std::string getSlopeString() const;
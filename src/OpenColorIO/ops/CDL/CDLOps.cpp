@@ -240,11 +240,11 @@ void CDLOp::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const
 
     // Since alpha is not affected, only need to use the RGB components
     ss.declareVec3f("lumaWeights", 0.2126f,   0.7152f,   0.0722f  );
-    ss.declareVec3f("slope",       slope [0], slope [1], slope [2]);
-    ss.declareVec3f("offset",      offset[0], offset[1], offset[2]);
-    ss.declareVec3f("power",       power [0], power [1], power [2]);
+    DeclareVec3fParameter(shaderDesc, ss, "slope",  slope [0], slope [1], slope [2]);
+    DeclareVec3fParameter(shaderDesc, ss, "offset", offset[0], offset[1], offset[2]);
+    DeclareVec3fParameter(shaderDesc, ss, "power",  power [0], power [1], power [2]);
 
-    ss.declareVar("saturation" , saturation);
+    ss.declareVar("saturation" , AddParameter(shaderDesc, "saturation", saturation));
 
     ss.newLine() << ss.vec3fDecl("pix") << " = "
                  << shaderDesc->getPixelName() << ".xyz;";
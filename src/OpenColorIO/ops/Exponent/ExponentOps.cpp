@@ -169,7 +169,9 @@ OCIO_NAMESPACE_ENTER
 
         OpRcPtr ExponentOp::clone() const
         {
-            return std::make_shared<ExponentOp>(expData()->m_exp4);
+            // Note: Copy the op data to also preserve the bit-depths.
+            ExponentOpDataRcPtr f = std::make_shared<ExponentOpData>(*expData());
+            return std::make_shared<ExponentOp>(f);
         }
 
         ExponentOp::~ExponentOp()
@@ -267,13 +269,18 @@ OCIO_NAMESPACE_ENTER
 
             // outColor = pow(max(outColor, 0.), exp);
 
+            const double * exp4 = expData()->m_exp4;
+            const std::string r = AddParameter(shaderDesc, "exponent_r", exp4[0]);
+            const std::string g = AddParameter(shaderDesc, "exponent_g", exp4[1]);
+            const std::string b = AddParameter(shaderDesc, "exponent_b", exp4[2]);
+            const std::string a = AddParameter(shaderDesc, "exponent_a", exp4[3]);
+
             ss.newLine()
                 << shaderDesc->getPixelName()
                 << " = pow( "
                 << "max( " << shaderDesc->getPixelName()
                 << ", " << ss.vec4fConst(0.0f) << " )"
-                << ", " << ss.vec4fConst(expData()->m_exp4[0], expData()->m_exp4[1],
-                                         expData()->m_exp4[2], expData()->m_exp4[3]) << " );";
+                << ", " << ss.vec4fConst(r, g, b, a) << " );";
 
             shaderDesc->addToFunctionShaderCode(ss.string().c_str());
         }
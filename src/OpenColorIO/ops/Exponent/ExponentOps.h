@@ -32,6 +32,8 @@ OCIO_NAMESPACE_ENTER
 
         virtual bool hasChannelCrosstalk() const override { return false; }
 
+        virtual bool modifiesAlpha() const override { return m_exp4[3] != 1.0; }
+
         double m_exp4[4];
 
         virtual void finalize() override;
@@ -8,6 +8,7 @@
 
 #include "BitDepthUtils.h"
 #include "ops/FixedFunction/FixedFunctionOpCPU.h"
+#include "SSE.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -222,12 +223,171 @@ __inline float CalcHueWeight(const float red, const float grn, const float blu,
     return f_H;
 }
 
+#ifdef USE_SSE
+
+// The SSE versions process four pixels at once i.e. one register per channel, where
+// the branches of the scalar versions become selections.
+
+inline void LoadPixels(const float * in, __m128 & red, __m128 & grn, __m128 & blu, __m128 & alp)
+{
+    red = _mm_loadu_ps(in);
+    grn = _mm_loadu_ps(in + 4);
+    blu = _mm_loadu_ps(in + 8);
+    alp = _mm_loadu_ps(in + 12);
+
+    _MM_TRANSPOSE4_PS(red, grn, blu, alp);
+}
+
+inline void StorePixels(float * out, __m128 red, __m128 grn, __m128 blu, __m128 alp)
+{
+    _MM_TRANSPOSE4_PS(red, grn, blu, alp);
+
+    _mm_storeu_ps(out,      red);
+    _mm_storeu_ps(out + 4,  grn);
+    _mm_storeu_ps(out + 8,  blu);
+    _mm_storeu_ps(out + 12, alp);
+}
+
+inline __m128 sseCalcSatWeight(const __m128 red, const __m128 grn, const __m128 blu,
+                               const __m128 noiseLimit)
+{
+    const __m128 minVal = _mm_min_ps( red, _mm_min_ps( grn, blu ) );
+    const __m128 maxVal = _mm_max_ps( red, _mm_max_ps( grn, blu ) );
+
+    const __m128 tiny = _mm_set1_ps(1e-10f);
+    return _mm_div_ps( _mm_sub_ps( _mm_max_ps(maxVal, tiny), _mm_max_ps(minVal, tiny) ),
+                       _mm_max_ps(maxVal, noiseLimit) );
+}
+
+inline __m128 sseCalcHueWeight(const __m128 red, const __m128 grn, const __m128 blu,
+                               const __m128 inv_width)
+{
+    // Convert RGB to Yab (luma/chroma).
+    const __m128 a = _mm_sub_ps( _mm_add_ps(red, red), _mm_add_ps(grn, blu) );
+    const __m128 b = _mm_mul_ps( _mm_set1_ps(1.7320508075688772f), _mm_sub_ps(grn, blu) );
+
+    const __m128 hue = sseAtan2(b, a);
+
+    // Determine normalized input coords to B-spline.
+    const __m128 knot_coord = _mm_add_ps( _mm_mul_ps(hue, inv_width), _mm_set1_ps(2.f) );
+    const __m128i j = _mm_cvttps_epi32(knot_coord);
+    const __m128 t = _mm_sub_ps( knot_coord, _mm_cvtepi32_ps(j) );
+
+    // Gather the coefficients of the quadratic B-spline basis function. Outside of the
+    // window (i.e. j not in [0, 3]) all the coefficients are zero so the weight is zero.
+    static const float _M[4][4] = {
+        { 0.25f,  0.00f,  0.00f,  0.00f},
+        {-0.75f,  0.75f,  0.75f,  0.25f},
+        { 0.75f, -1.50f,  0.00f,  1.00f},
+        {-0.25f,  0.75f, -0.75f,  0.25f} };
+
+    __m128 coefs[4] = { EZERO, EZERO, EZERO, EZERO };
+    for (int k = 0; k < 4; ++k)
+    {
+        const __m128 mask = _mm_castsi128_ps( _mm_cmpeq_epi32(j, _mm_set1_epi32(k)) );
+        for (int c = 0; c < 4; ++c)
+        {
+            coefs[c] = _mm_or_ps( coefs[c], _mm_and_ps(mask, _mm_set1_ps(_M[k][c])) );
+        }
+    }
+
+    __m128 f_H = _mm_add_ps( coefs[1], _mm_mul_ps(t, coefs[0]) );
+    f_H = _mm_add_ps( coefs[2], _mm_mul_ps(t, f_H) );
+    return _mm_add_ps( coefs[3], _mm_mul_ps(t, f_H) );
+}
+
+// Restore the hue after the red channel modification (from red to newRed).
+inline void sseRestoreHue(const __m128 red, const __m128 newRed, __m128 & grn, __m128 & blu)
+{
+    const __m128 grnGeBlu = _mm_cmpge_ps(grn, blu);
+
+    // red >= grn >= blu or red >= blu >= grn
+    const __m128 minChan = sseSelect(grnGeBlu, blu, grn);
+    const __m128 midChan = sseSelect(grnGeBlu, grn, blu);
+
+    const __m128 hue_fac = _mm_div_ps( _mm_sub_ps(midChan, minChan),
+                                       _mm_max_ps( _mm_sub_ps(red, minChan),
+                                                   _mm_set1_ps(1e-10f) ) );
+    const __m128 newMid = _mm_add_ps( _mm_mul_ps( hue_fac, _mm_sub_ps(newRed, minChan) ),
+                                      minChan );
+
+    grn = sseSelect(grnGeBlu, newMid, grn);
+    blu = sseSelect(grnGeBlu, blu, newMid);
+}
+
+inline __m128 sseRgbToYC(const __m128 red, const __m128 grn, const __m128 blu)
+{
+    // Convert RGB to YC (luma + chroma factor).
+    const __m128 chroma
+        = _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( blu, _mm_sub_ps(blu, grn) ),
+                                               _mm_mul_ps( grn, _mm_sub_ps(grn, red) ) ),
+                                   _mm_mul_ps( red, _mm_sub_ps(red, blu) ) ) );
+
+    const __m128 sum = _mm_add_ps( _mm_add_ps(blu, grn), red );
+    return _mm_div_ps( _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps(1.75f), chroma ) ),
+                       _mm_set1_ps(3.f) );
+}
+
+inline __m128 sseSigmoidShaper(const __m128 sat)
+{
+    const __m128 x = _mm_mul_ps( _mm_sub_ps( sat, _mm_set1_ps(0.4f) ), _mm_set1_ps(5.f) );
+    const __m128 sign = _mm_or_ps( _mm_and_ps(x, ESIGN_MASK), EONE );
+    const __m128 t = _mm_max_ps( _mm_sub_ps( EONE, _mm_mul_ps( _mm_set1_ps(0.5f),
+                                                               _mm_mul_ps(sign, x) ) ),
+                                 EZERO );
+    const __m128 s = _mm_add_ps( EONE, _mm_mul_ps( sign,
+                                                   _mm_sub_ps( EONE, _mm_mul_ps(t, t) ) ) );
+    return _mm_mul_ps( s, _mm_set1_ps(0.5f) );
+}
+
+#endif // USE_SSE
+
 void Renderer_ACES_RedMod03_Fwd::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width   = _mm_set1_ps(m_inv_width);
+    const __m128 noiseLimit  = _mm_set1_ps(m_noiseLimit);
+    const __m128 pivot       = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+    const __m128 alphaScale  = _mm_set1_ps(m_alphaScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        const __m128 f_H = sseCalcHueWeight(red, grn, blu, inv_width);
+        const __m128 f_S = sseCalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 newRed
+            = _mm_add_ps( red, _mm_mul_ps( _mm_mul_ps( _mm_mul_ps(f_H, f_S),
+                                                       _mm_sub_ps(pivot, red) ),
+                                           oneMinusScale ) );
+
+        __m128 newGrn = grn;
+        __m128 newBlu = blu;
+        sseRestoreHue(red, newRed, newGrn, newBlu);
+
+        // Only modify the hues in the window.
+        const __m128 inWindow = _mm_cmpgt_ps(f_H, EZERO);
+        red = _mm_mul_ps( sseSelect(inWindow, newRed, red), alphaScale );
+        grn = _mm_mul_ps( sseSelect(inWindow, newGrn, grn), alphaScale );
+        blu = _mm_mul_ps( sseSelect(inWindow, newBlu, blu), alphaScale );
+
+        StorePixels(out, red, grn, blu, _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         float grn = in[1];
@@ -283,7 +443,52 @@ void Renderer_ACES_RedMod03_Inv::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width   = _mm_set1_ps(m_inv_width);
+    const __m128 pivot       = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+    const __m128 alphaScale  = _mm_set1_ps(m_alphaScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        const __m128 f_H = sseCalcHueWeight(red, grn, blu, inv_width);
+
+        const __m128 minChan = _mm_min_ps(grn, blu);
+
+        const __m128 a = _mm_sub_ps( _mm_mul_ps(f_H, oneMinusScale), EONE );
+        const __m128 b = _mm_sub_ps( red, _mm_mul_ps( _mm_mul_ps( f_H, _mm_add_ps(pivot, minChan) ),
+                                                      oneMinusScale ) );
+        const __m128 c = _mm_mul_ps( _mm_mul_ps( _mm_mul_ps(f_H, pivot), minChan ), oneMinusScale );
+
+        const __m128 discrim = _mm_sub_ps( _mm_mul_ps(b, b),
+                                           _mm_mul_ps( _mm_mul_ps(_mm_set1_ps(4.f), a), c ) );
+        const __m128 newRed = _mm_div_ps( _mm_sub_ps( _mm_sub_ps(EZERO, b), _mm_sqrt_ps(discrim) ),
+                                          _mm_mul_ps(_mm_set1_ps(2.f), a) );
+
+        __m128 newGrn = grn;
+        __m128 newBlu = blu;
+        sseRestoreHue(red, newRed, newGrn, newBlu);
+
+        // Only modify the hues in the window.
+        const __m128 inWindow = _mm_cmpgt_ps(f_H, EZERO);
+        red = _mm_mul_ps( sseSelect(inWindow, newRed, red), alphaScale );
+        grn = _mm_mul_ps( sseSelect(inWindow, newGrn, grn), alphaScale );
+        blu = _mm_mul_ps( sseSelect(inWindow, newBlu, blu), alphaScale );
+
+        StorePixels(out, red, grn, blu, _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         float grn = in[1];
@@ -346,7 +551,43 @@ void Renderer_ACES_RedMod10_Fwd::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width   = _mm_set1_ps(m_inv_width);
+    const __m128 noiseLimit  = _mm_set1_ps(m_noiseLimit);
+    const __m128 pivot       = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+    const __m128 alphaScale  = _mm_set1_ps(m_alphaScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        const __m128 f_H = sseCalcHueWeight(red, grn, blu, inv_width);
+        const __m128 f_S = sseCalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 newRed
+            = _mm_add_ps( red, _mm_mul_ps( _mm_mul_ps( _mm_mul_ps(f_H, f_S),
+                                                       _mm_sub_ps(pivot, red) ),
+                                           oneMinusScale ) );
+
+        // Only modify the hues in the window.
+        const __m128 inWindow = _mm_cmpgt_ps(f_H, EZERO);
+        red = _mm_mul_ps( sseSelect(inWindow, newRed, red), alphaScale );
+        grn = _mm_mul_ps( grn, alphaScale );
+        blu = _mm_mul_ps( blu, alphaScale );
+
+        StorePixels(out, red, grn, blu, _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         const float grn = in[1];
@@ -388,7 +629,48 @@ void Renderer_ACES_RedMod10_Inv::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width   = _mm_set1_ps(m_inv_width);
+    const __m128 pivot       = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+    const __m128 alphaScale  = _mm_set1_ps(m_alphaScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        const __m128 f_H = sseCalcHueWeight(red, grn, blu, inv_width);
+
+        const __m128 minChan = _mm_min_ps(grn, blu);
+
+        const __m128 a = _mm_sub_ps( _mm_mul_ps(f_H, oneMinusScale), EONE );
+        const __m128 b = _mm_sub_ps( red, _mm_mul_ps( _mm_mul_ps( f_H, _mm_add_ps(pivot, minChan) ),
+                                                      oneMinusScale ) );
+        const __m128 c = _mm_mul_ps( _mm_mul_ps( _mm_mul_ps(f_H, pivot), minChan ), oneMinusScale );
+
+        const __m128 discrim = _mm_sub_ps( _mm_mul_ps(b, b),
+                                           _mm_mul_ps( _mm_mul_ps(_mm_set1_ps(4.f), a), c ) );
+        const __m128 newRed = _mm_div_ps( _mm_sub_ps( _mm_sub_ps(EZERO, b), _mm_sqrt_ps(discrim) ),
+                                          _mm_mul_ps(_mm_set1_ps(2.f), a) );
+
+        // Only modify the hues in the window.
+        const __m128 inWindow = _mm_cmpgt_ps(f_H, EZERO);
+        red = _mm_mul_ps( sseSelect(inWindow, newRed, red), alphaScale );
+        grn = _mm_mul_ps( grn, alphaScale );
+        blu = _mm_mul_ps( blu, alphaScale );
+
+        StorePixels(out, red, grn, blu, _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         const float grn = in[1];
@@ -451,7 +733,55 @@ void Renderer_ACES_Glow03_Fwd::apply(const void * inImg, void * outImg, long num
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 noiseLimit = _mm_set1_ps(m_noiseLimit);
+    const __m128 glowGain   = _mm_set1_ps(m_glowGain);
+    const __m128 alphaScale = _mm_set1_ps(m_alphaScale);
+
+    const float GlowMid = m_glowMid * m_inScale;
+    const __m128 glowMid    = _mm_set1_ps(GlowMid);
+    const __m128 glowMidMax = _mm_set1_ps(GlowMid * 2.f);
+
+    const __m128 glowMidMin = _mm_set1_ps(GlowMid * 2.f / 3.f);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        // NB: YC is at inScale.
+        const __m128 YC = sseRgbToYC(red, grn, blu);
+
+        const __m128 sat = sseCalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 s = sseSigmoidShaper(sat);
+
+        const __m128 GlowGain = _mm_mul_ps(glowGain, s);
+
+        // Apply FwdGlow.
+        __m128 glowGainOut = _mm_mul_ps( GlowGain, _mm_sub_ps( _mm_div_ps(glowMid, YC),
+                                                               _mm_set1_ps(0.5f) ) );
+        glowGainOut = sseSelect(_mm_cmple_ps(YC, glowMidMin), GlowGain, glowGainOut);
+        glowGainOut = sseSelect(_mm_cmpge_ps(YC, glowMidMax), EZERO, glowGainOut);
+
+        // Calculate glow factor.
+        const __m128 scaleFac = _mm_mul_ps( alphaScale, _mm_add_ps(EONE, glowGainOut) );
+
+        StorePixels(out,
+                    _mm_mul_ps(red, scaleFac),
+                    _mm_mul_ps(grn, scaleFac),
+                    _mm_mul_ps(blu, scaleFac),
+                    _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -508,7 +838,62 @@ void Renderer_ACES_Glow03_Inv::apply(const void * inImg, void * outImg, long num
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 noiseLimit = _mm_set1_ps(m_noiseLimit);
+    const __m128 glowGain   = _mm_set1_ps(m_glowGain);
+    const __m128 alphaScale = _mm_set1_ps(m_alphaScale);
+
+    const float GlowMid = m_glowMid * m_inScale;
+    const __m128 glowMid    = _mm_set1_ps(GlowMid);
+    const __m128 glowMidMax = _mm_set1_ps(GlowMid * 2.f);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        // NB: YC is at inScale.
+        const __m128 YC = sseRgbToYC(red, grn, blu);
+
+        const __m128 sat = sseCalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 s = sseSigmoidShaper(sat);
+
+        const __m128 GlowGain = _mm_mul_ps(glowGain, s);
+
+        // Apply InvGlow.
+        const __m128 onePlusGlowGain = _mm_add_ps(EONE, GlowGain);
+        const __m128 glowMidMin = _mm_div_ps( _mm_mul_ps( _mm_mul_ps(onePlusGlowGain, glowMid),
+                                                          _mm_set1_ps(2.f) ),
+                                              _mm_set1_ps(3.f) );
+
+        __m128 glowGainOut
+            = _mm_div_ps( _mm_mul_ps( GlowGain, _mm_sub_ps( _mm_div_ps(glowMid, YC),
+                                                            _mm_set1_ps(0.5f) ) ),
+                          _mm_sub_ps( _mm_mul_ps(GlowGain, _mm_set1_ps(0.5f)), EONE ) );
+        glowGainOut = sseSelect(_mm_cmple_ps(YC, glowMidMin),
+                                _mm_div_ps( _mm_sub_ps(EZERO, GlowGain), onePlusGlowGain ),
+                                glowGainOut);
+        glowGainOut = sseSelect(_mm_cmpge_ps(YC, glowMidMax), EZERO, glowGainOut);
+
+        // Calculate glow factor.
+        const __m128 scaleFac = _mm_mul_ps( alphaScale, _mm_add_ps(EONE, glowGainOut) );
+
+        StorePixels(out,
+                    _mm_mul_ps(red, scaleFac),
+                    _mm_mul_ps(grn, scaleFac),
+                    _mm_mul_ps(blu, scaleFac),
+                    _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -567,7 +952,39 @@ void Renderer_ACES_DarkToDim10_Fwd::apply(const void * inImg, void * outImg, lon
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 minLum     = _mm_set1_ps(1e-10f);
+    const __m128 invInScale = _mm_set1_ps(m_invInScale);
+    const __m128 gamma      = _mm_set1_ps(m_gamma);
+    const __m128 alphaScale = _mm_set1_ps(m_alphaScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        const __m128 lum = _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps(0.27222871678091454f), red ),
+                                                   _mm_mul_ps( _mm_set1_ps(0.67408176581114831f), grn ) ),
+                                       _mm_mul_ps( _mm_set1_ps(0.053689517407937051f), blu ) );
+        const __m128 Y = _mm_max_ps( _mm_mul_ps(invInScale, lum), minLum );
+
+        const __m128 scaleFac = _mm_mul_ps( alphaScale, ssePower(Y, gamma) );
+
+        StorePixels(out,
+                    _mm_mul_ps(red, scaleFac),
+                    _mm_mul_ps(grn, scaleFac),
+                    _mm_mul_ps(blu, scaleFac),
+                    _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -615,7 +1032,39 @@ void Renderer_REC2100_Surround::apply(const void * inImg, void * outImg, long nu
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 minLum     = _mm_set1_ps(1e-4f);
+    const __m128 invInScale = _mm_set1_ps(m_invInScale);
+    const __m128 gamma      = _mm_set1_ps(m_gamma);
+    const __m128 alphaScale = _mm_set1_ps(m_alphaScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alp;
+        LoadPixels(in, red, grn, blu, alp);
+
+        const __m128 lum = _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps(0.2627f), red ),
+                                                   _mm_mul_ps( _mm_set1_ps(0.6780f), grn ) ),
+                                       _mm_mul_ps( _mm_set1_ps(0.0593f), blu ) );
+        const __m128 Y = _mm_max_ps( _mm_mul_ps(invInScale, lum), minLum );
+
+        const __m128 scaleFac = _mm_mul_ps( alphaScale, ssePower(Y, gamma) );
+
+        StorePixels(out,
+                    _mm_mul_ps(red, scaleFac),
+                    _mm_mul_ps(grn, scaleFac),
+                    _mm_mul_ps(blu, scaleFac),
+                    _mm_mul_ps(alp, alphaScale));
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    // Scalar processing of the remaining pixels.
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -958,6 +1407,13 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, aces_dark_to_dim_10)
 {
     const unsigned num_samples = 4;
 
+#ifdef USE_SSE
+    // The SSE version uses a fast approximation of pow().
+    const float error = 5e-6f;
+#else
+    const float error = 1e-7f;
+#endif // USE_SSE
+
     const float input_32f[num_samples*4] = {
             0.11f,  0.02f,  0.04f, 0.5f,
             0.71f,  0.51f,  0.92f, 1.0f,
@@ -985,7 +1441,7 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, aces_dark_to_dim_10)
 
         ApplyFixedFunction(&output_32f[0], &expected_32f[0], num_samples, 
                            funcData,
-                           1e-7f);
+                           error);
     }
 
     {
@@ -996,7 +1452,7 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, aces_dark_to_dim_10)
 
         ApplyFixedFunction(&output_32f[0], &input_32f[0], num_samples, 
                            funcData,
-                           1e-7f);
+                           error);
     }
 }   
 
@@ -1004,6 +1460,13 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, rec2100_surround)
 {
     const unsigned num_samples = 4;
 
+#ifdef USE_SSE
+    // The SSE version uses a fast approximation of pow().
+    const float error = 5e-6f;
+#else
+    const float error = 1e-7f;
+#endif // USE_SSE
+
     float input_32f[num_samples*4] = {
             0.11f,  0.02f,  0.04f, 0.5f,
             0.71f,  0.51f,  0.81f, 1.0f,
@@ -1026,7 +1489,88 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, rec2100_surround)
 
     ApplyFixedFunction(&input_32f[0], &expected_32f[0], num_samples, 
                        funcData,
-                       1e-7f);
+                       error);
 }   
 
+OCIO_ADD_TEST(FixedFunctionOpCPU, vectorized_vs_scalar)
+{
+    // When processing several pixels, the renderers process them by blocks of four using
+    // SSE (if enabled) while the remaining pixels use the scalar code so processing one
+    // pixel at a time compares the two versions.
+
+    const float values[] = { -0.5f, -0.01f, 0.0f, 0.005f, 0.02f, 0.18f,
+                              0.4f,  0.6f,  0.9f, 1.0f,   1.5f,  4.0f };
+    const size_t numValues = sizeof(values) / sizeof(float);
+
+    std::vector<float> input;
+    for (size_t r = 0; r < numValues; ++r)
+    {
+        for (size_t g = 0; g < numValues; ++g)
+        {
+            for (size_t b = 0; b < numValues; ++b)
+            {
+                input.push_back(values[r]);
+                input.push_back(values[g]);
+                input.push_back(values[b]);
+                input.push_back(values[(r + g + b) % numValues]);
+            }
+        }
+    }
+    const long numPixels = long(input.size() / 4);
+
+    const struct
+    {
+        OCIO::FixedFunctionOpData::Style style;
+        OCIO::FixedFunctionOpData::Params params;
+        float errorThreshold;
+    } tests[] = {
+        // The SSE versions use fast approximations of atan2() and pow().
+        { OCIO::FixedFunctionOpData::ACES_RED_MOD_03_FWD,     {},       1e-4f },
+        { OCIO::FixedFunctionOpData::ACES_RED_MOD_03_INV,     {},       1e-4f },
+        { OCIO::FixedFunctionOpData::ACES_RED_MOD_10_FWD,     {},       1e-4f },
+        { OCIO::FixedFunctionOpData::ACES_RED_MOD_10_INV,     {},       1e-4f },
+        { OCIO::FixedFunctionOpData::ACES_GLOW_03_FWD,        {},       1e-6f },
+        { OCIO::FixedFunctionOpData::ACES_GLOW_03_INV,        {},       1e-6f },
+        { OCIO::FixedFunctionOpData::ACES_GLOW_10_FWD,        {},       1e-6f },
+        { OCIO::FixedFunctionOpData::ACES_GLOW_10_INV,        {},       1e-6f },
+        { OCIO::FixedFunctionOpData::ACES_DARK_TO_DIM_10_FWD, {},       1e-5f },
+        { OCIO::FixedFunctionOpData::ACES_DARK_TO_DIM_10_INV, {},       1e-5f },
+        { OCIO::FixedFunctionOpData::REC2100_SURROUND,        { 0.78 }, 1e-5f },
+        { OCIO::FixedFunctionOpData::REC2100_SURROUND,        { 1.2 },  1e-5f },
+    };
+
+    for (const auto & test : tests)
+    {
+        OCIO::ConstFixedFunctionOpDataRcPtr funcData
+            = std::make_shared<OCIO::FixedFunctionOpData>(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                                          test.params, test.style);
+
+        OCIO::ConstOpCPURcPtr op;
+        OCIO_CHECK_NO_THROW(op = OCIO::GetFixedFunctionCPURenderer(funcData));
+
+        std::vector<float> vectorized(input.size());
+        op->apply(&input[0], &vectorized[0], numPixels);
+
+        std::vector<float> scalar(input.size());
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            op->apply(&input[4 * idx], &scalar[4 * idx], 1);
+        }
+
+        for (size_t idx = 0; idx < input.size(); ++idx)
+        {
+            if (!OCIO::EqualWithSafeRelError(vectorized[idx], scalar[idx],
+                                             test.errorThreshold, 1.0f))
+            {
+                std::ostringstream errorMsg;
+                errorMsg.precision(9);
+                errorMsg << "Style: " << OCIO::FixedFunctionOpData::ConvertStyleToString(test.style, false)
+                         << " - Index: " << idx
+                         << " - Values: " << vectorized[idx] << " and: " << scalar[idx];
+                OCIO_CHECK_ASSERT_MESSAGE(0, errorMsg.str());
+            }
+        }
+    }
+}
+
 #endif
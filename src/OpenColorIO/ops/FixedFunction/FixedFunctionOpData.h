@@ -64,6 +64,7 @@ public:
     bool isNoOp() const override { return false; }
     bool isIdentity() const override { return false; }
     bool hasChannelCrosstalk() const override { return true; }
+    bool modifiesAlpha() const override { return false; }
 
     bool isInverse(ConstFixedFunctionOpDataRcPtr & r) const;
     FixedFunctionOpDataRcPtr inverse() const;
@@ -81,22 +81,27 @@ void Add_RedMod_03_Inv_Shader(GpuShaderText & ss)
     ss.newLine() << "{";
     ss.indent();
 
-    ss.newLine() << ss.vec3fDecl("maxval") << " = max( outColor.rgb, max( outColor.gbr, outColor.brg));";
-    ss.newLine() << ss.vec3fDecl("minval") << " = min( outColor.rgb, min( outColor.gbr, outColor.brg));";
-    ss.newLine() << "float oldChroma = max(1e-10, maxval.r - minval.r);";
-    ss.newLine() << ss.vec3fDecl("delta") << " = outColor.rgb - minval;";
+    // Red is the largest channel in the hue window.
+    ss.newLine() << "float minChan = min(outColor.g, outColor.b);";
 
     // Note: If f_H == 0, the following generally doesn't change the red value,
     //       but it does for R < 0, hence the need for the if-statement above.
     ss.newLine() << "float ka = f_H * " << _1minusScale << " - 1.;";
-    ss.newLine() << "float kb = outColor.r - f_H * (" << _pivot << " + minval.r) * " 
+    ss.newLine() << "float kb = outColor.r - f_H * (" << _pivot << " + minChan) * " 
                  << _1minusScale << ";";
-    ss.newLine() << "float kc = f_H * " << _pivot << " * minval.r * " << _1minusScale << ";";
-    ss.newLine() << "outColor.r = ( -kb - sqrt( kb * kb - 4. * ka * kc)) / ( 2. * ka);";
-
-    ss.newLine() << ss.vec3fDecl("maxval2") << " = max( outColor.rgb, max( outColor.gbr, outColor.brg));";
-    ss.newLine() << "float newChroma = maxval2.r - minval.r;";
-    ss.newLine() << "outColor.rgb = minval.r + delta * newChroma / oldChroma;";
+    ss.newLine() << "float kc = f_H * " << _pivot << " * minChan * " << _1minusScale << ";";
+    ss.newLine() << "float newRed = ( -kb - sqrt( kb * kb - 4. * ka * kc)) / ( 2. * ka);";
+
+    // Restore the hue like the CPU renderer i.e. only the middle channel is scaled, so
+    // a gray pixel keeps its new red value and a negative discriminant (i.e. a NaN)
+    // does not spread to the smallest channel.
+    ss.newLine() << "float hue_fac = (max(outColor.g, outColor.b) - minChan)"
+                 << " / max(1e-10, outColor.r - minChan);";
+    ss.newLine() << "float newMid = hue_fac * (newRed - minChan) + minChan;";
+    ss.newLine() << "bool grnGeBlu = outColor.g >= outColor.b;";
+    ss.newLine() << "outColor.g = grnGeBlu ? newMid : outColor.g;";
+    ss.newLine() << "outColor.b = grnGeBlu ? outColor.b : newMid;";
+    ss.newLine() << "outColor.r = newRed;";
 
     ss.dedent();
     ss.newLine() << "}";
@@ -159,7 +164,9 @@ void Add_Glow_03_Fwd_Shader(GpuShaderText & ss, float glowGain, float glowMid)
 
     ss.newLine() << "float GlowGain = " << glowGain << " * s;";
     ss.newLine() << "float GlowMid = " << glowMid << ";";
-    ss.newLine() << "float glowGainOut = " << ss.lerp( "GlowGain", "GlowGain * (GlowMid / YC - 0.5)",
+    // Both sides of the lerp are computed so YC is guarded against zero (i.e. a black
+    // pixel) where the CPU renderer only computes the selected branch.
+    ss.newLine() << "float glowGainOut = " << ss.lerp( "GlowGain", "GlowGain * (GlowMid / max(1e-10, YC) - 0.5)",
                                                        "float( YC > GlowMid * 2. / 3. )" ) << ";";
     ss.newLine() << "glowGainOut = " << ss.lerp( "glowGainOut", "0.", "float( YC > GlowMid * 2. )" ) << ";";
 
@@ -185,7 +192,7 @@ void Add_Glow_03_Inv_Shader(GpuShaderText & ss, float glowGain, float glowMid)
     ss.newLine() << "float GlowMid = " << glowMid << ";";
     ss.newLine() << "float glowGainOut = " 
                  << ss.lerp( "-GlowGain / (1. + GlowGain)",
-                             "GlowGain * (GlowMid / YC - 0.5) / (GlowGain * 0.5 - 1.)",
+                             "GlowGain * (GlowMid / max(1e-10, YC) - 0.5) / (GlowGain * 0.5 - 1.)",
                              "float( YC > (1. + GlowGain) * GlowMid * 2. / 3. )" ) << ";";
     ss.newLine() << "glowGainOut = " << ss.lerp( "glowGainOut", "0.", "float( YC > GlowMid * 2. )" ) << ";";
 
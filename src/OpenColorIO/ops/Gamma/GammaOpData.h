@@ -131,6 +131,8 @@ public:
 
     virtual bool hasChannelCrosstalk() const override { return false; }
 
+    virtual bool modifiesAlpha() const override { return !isAlphaComponentIdentity(); }
+
     virtual void validate() const override;
 
     virtual void validateParameters() const;
@@ -70,6 +70,8 @@ public:
 
     bool hasChannelCrosstalk() const override { return false; }
 
+    bool modifiesAlpha() const override { return false; }
+
     void finalize() override;
 
     bool operator==(const OpData& other) const override;
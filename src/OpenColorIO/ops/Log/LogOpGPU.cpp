@@ -86,11 +86,12 @@ void AddLogToLinShader(GpuShaderDescRcPtr & shaderDesc,
                                    1.0f / (float)paramsG[LIN_SIDE_SLOPE],
                                    1.0f / (float)paramsB[LIN_SIDE_SLOPE] };
 
-    st.declareVec3f("log_slopeinv", logSlopeInv[0], logSlopeInv[1], logSlopeInv[2]);
-    st.declareVec3f("lin_slopeinv", linSlopeInv[0], linSlopeInv[1], linSlopeInv[2]);
-    st.declareVec3f("lin_offset", paramsR[LIN_SIDE_OFFSET], paramsG[LIN_SIDE_OFFSET], paramsB[LIN_SIDE_OFFSET]);
-    st.declareVec3f("log_base", base, base, base);
-    st.declareVec3f("log_offset", paramsR[LOG_SIDE_OFFSET], paramsG[LOG_SIDE_OFFSET], paramsB[LOG_SIDE_OFFSET]);
+    DeclareVec3fParameter(shaderDesc, st, "log_slopeinv", logSlopeInv[0], logSlopeInv[1], logSlopeInv[2]);
+    DeclareVec3fParameter(shaderDesc, st, "lin_slopeinv", linSlopeInv[0], linSlopeInv[1], linSlopeInv[2]);
+    DeclareVec3fParameter(shaderDesc, st, "lin_offset", paramsR[LIN_SIDE_OFFSET], paramsG[LIN_SIDE_OFFSET], paramsB[LIN_SIDE_OFFSET]);
+    const std::string logBase = AddParameter(shaderDesc, "log_base", base);
+    st.declareVec3f("log_base", logBase, logBase, logBase);
+    DeclareVec3fParameter(shaderDesc, st, "log_offset", paramsR[LOG_SIDE_OFFSET], paramsG[LOG_SIDE_OFFSET], paramsB[LOG_SIDE_OFFSET]);
     // Decompose into 3 steps:
     // 1) (x - logOffset) * logSlopeInv
     // 2) pow(base, x)
@@ -128,14 +129,14 @@ void AddLinToLogShader(GpuShaderDescRcPtr & shaderDesc,
     const char * pix = shaderDesc->getPixelName();
 
     st.declareVec3f("minValue", minValue, minValue, minValue);
-    st.declareVec3f("lin_slope", paramsR[LIN_SIDE_SLOPE], paramsG[LIN_SIDE_SLOPE], paramsB[LIN_SIDE_SLOPE]);
-    st.declareVec3f("lin_offset", paramsR[LIN_SIDE_OFFSET], paramsG[LIN_SIDE_OFFSET], paramsB[LIN_SIDE_OFFSET]);
+    DeclareVec3fParameter(shaderDesc, st, "lin_slope", paramsR[LIN_SIDE_SLOPE], paramsG[LIN_SIDE_SLOPE], paramsB[LIN_SIDE_SLOPE]);
+    DeclareVec3fParameter(shaderDesc, st, "lin_offset", paramsR[LIN_SIDE_OFFSET], paramsG[LIN_SIDE_OFFSET], paramsB[LIN_SIDE_OFFSET]);
     // We account for the change of base by rolling the multiplier in with log slope.
     const float logSlopeNew[3] = { (float)(paramsR[LOG_SIDE_SLOPE] / log(base)),
                                    (float)(paramsG[LOG_SIDE_SLOPE] / log(base)),
                                    (float)(paramsB[LOG_SIDE_SLOPE] / log(base)) };
-    st.declareVec3f("log_slope", logSlopeNew[0], logSlopeNew[1], logSlopeNew[2]);
-    st.declareVec3f("log_offset", paramsR[LOG_SIDE_OFFSET], paramsG[LOG_SIDE_OFFSET], paramsB[LOG_SIDE_OFFSET]);
+    DeclareVec3fParameter(shaderDesc, st, "log_slope", logSlopeNew[0], logSlopeNew[1], logSlopeNew[2]);
+    DeclareVec3fParameter(shaderDesc, st, "log_offset", paramsR[LOG_SIDE_OFFSET], paramsG[LOG_SIDE_OFFSET], paramsB[LOG_SIDE_OFFSET]);
     // Decompose into 2 steps:
     // 1) clamp(fltmin, linSlope * x + linOffset)
     // 2) logSlopeNew * log(x) + logOffset
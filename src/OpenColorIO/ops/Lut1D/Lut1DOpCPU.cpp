@@ -48,13 +48,16 @@ inline uint16_t GetLookupValue(const float & val)
     return (uint16_t)val;
 }
 
-template<typename InType, typename OutType>
+// Out of range integer codes (e.g. above 1023 in a 10-bit image buffer) are clamped.
+template<BitDepth inBD, typename OutType>
 struct LookupLut
 {
+    typedef typename BitDepthInfo<inBD>::Type InType;
+
     static inline OutType compute(const OutType * lutData,
                                   const InType & val)
     {
-        return lutData[GetLookupValue(val)];
+        return lutData[GetLookupValue(ClampCode<inBD>(val))];
     }
 };
 
@@ -484,10 +487,10 @@ void Lut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * outImg
 
         for(long idx=0; idx<numPixels; ++idx)
         {
-            out[0] = LookupLut<InType, OutType>::compute(lutR, in[0]);
-            out[1] = LookupLut<InType, OutType>::compute(lutG, in[1]);
-            out[2] = LookupLut<InType, OutType>::compute(lutB, in[2]);
-            out[3] = OutType(in[3] * this->m_alphaScaling);
+            out[0] = LookupLut<inBD, OutType>::compute(lutR, in[0]);
+            out[1] = LookupLut<inBD, OutType>::compute(lutG, in[1]);
+            out[2] = LookupLut<inBD, OutType>::compute(lutB, in[2]);
+            out[3] = OutType(ClampCode<inBD>(in[3]) * this->m_alphaScaling);
 
             in  += 4;
             out += 4;
@@ -603,10 +606,10 @@ void Lut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, long n
 
         for(long idx=0; idx<numPixels; ++idx)
         {
-            out[0] = LookupLut<InType, OutType>::compute(lutR, in[0]);
-            out[1] = LookupLut<InType, OutType>::compute(lutG, in[1]);
-            out[2] = LookupLut<InType, OutType>::compute(lutB, in[2]);
-            out[3] = OutType(in[3] * this->m_alphaScaling);
+            out[0] = LookupLut<inBD, OutType>::compute(lutR, in[0]);
+            out[1] = LookupLut<inBD, OutType>::compute(lutG, in[1]);
+            out[2] = LookupLut<inBD, OutType>::compute(lutB, in[2]);
+            out[3] = OutType(ClampCode<inBD>(in[3]) * this->m_alphaScaling);
 
             in  += 4;
             out += 4;
@@ -756,7 +759,9 @@ void Lut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void
     {
         for(long idx=0; idx<numPixels; ++idx)
         {
-            const float RGB[] = {(float)in[0], (float)in[1], (float)in[2]};
+            const float RGB[] = {(float)ClampCode<inBD>(in[0]),
+                                 (float)ClampCode<inBD>(in[1]),
+                                 (float)ClampCode<inBD>(in[2])};
 
             int min, mid, max;
             GamutMapUtils::Order3( RGB, min, mid, max);
@@ -767,9 +772,9 @@ void Lut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void
                                       :  (RGB[mid] - RGB[min]) / orig_chroma;
 
             float RGB2[] = {
-                LookupLut<InType, float>::compute(lutR, in[0]),
-                LookupLut<InType, float>::compute(lutG, in[1]),
-                LookupLut<InType, float>::compute(lutB, in[2])   };
+                LookupLut<inBD, float>::compute(lutR, in[0]),
+                LookupLut<inBD, float>::compute(lutG, in[1]),
+                LookupLut<inBD, float>::compute(lutB, in[2])   };
 
             const float new_chroma = RGB2[max] - RGB2[min];
 
@@ -778,7 +783,7 @@ void Lut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void
             out[0] = OutType(RGB2[0]);
             out[1] = OutType(RGB2[1]);
             out[2] = OutType(RGB2[2]);
-            out[3] = OutType(in[3] * this->m_alphaScaling);
+            out[3] = OutType(ClampCode<inBD>(in[3]) * this->m_alphaScaling);
 
             in  += 4;
             out += 4;
@@ -851,7 +856,9 @@ void Lut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * outIm
     {
         for(long idx=0; idx<numPixels; ++idx)
         {
-            const float RGB[] = {(float)in[0], (float)in[1], (float)in[2]};
+            const float RGB[] = {(float)ClampCode<inBD>(in[0]),
+                                 (float)ClampCode<inBD>(in[1]),
+                                 (float)ClampCode<inBD>(in[2])};
 
             int min, mid, max;
             GamutMapUtils::Order3(RGB, min, mid, max);
@@ -862,9 +869,9 @@ void Lut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * outIm
                                      : (RGB[mid] - RGB[min]) / orig_chroma;
 
             float RGB2[] = {
-                LookupLut<InType, float>::compute(lutR, in[0]),
-                LookupLut<InType, float>::compute(lutG, in[1]),
-                LookupLut<InType, float>::compute(lutB, in[2])
+                LookupLut<inBD, float>::compute(lutR, in[0]),
+                LookupLut<inBD, float>::compute(lutG, in[1]),
+                LookupLut<inBD, float>::compute(lutB, in[2])
             };
 
             const float new_chroma = RGB2[max] - RGB2[min];
@@ -874,7 +881,7 @@ void Lut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * outIm
             out[0] = OutType(RGB2[0]);
             out[1] = OutType(RGB2[1]);
             out[2] = OutType(RGB2[2]);
-            out[3] = OutType(in[3] * this->m_alphaScaling);
+            out[3] = OutType(ClampCode<inBD>(in[3]) * this->m_alphaScaling);
 
             in  += 4;
             out += 4;
@@ -1243,7 +1250,7 @@ void InvLut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, lon
                                this->m_paramsR.lutEnd,
                                this->m_paramsR.flipSign,
                                m_scale,
-                               (float)in[0]));
+                               (float)ClampCode<inBD>(in[0])));
 
         // green
         out[1] = Converter<outBD>::CastValue(
@@ -1252,7 +1259,7 @@ void InvLut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, lon
                                this->m_paramsG.lutEnd,
                                this->m_paramsG.flipSign,
                                m_scale,
-                               (float)in[1]));
+                               (float)ClampCode<inBD>(in[1])));
 
         // blue
         out[2] = Converter<outBD>::CastValue(
@@ -1261,10 +1268,10 @@ void InvLut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, lon
                                this->m_paramsB.lutEnd,
                                this->m_paramsB.flipSign,
                                m_scale,
-                               (float)in[2]));
+                               (float)ClampCode<inBD>(in[2])));
 
         // alpha
-        out[3] = Converter<outBD>::CastValue(in[3] * m_alphaScaling);
+        out[3] = Converter<outBD>::CastValue(ClampCode<inBD>(in[3]) * m_alphaScaling);
 
         in  += 4;
         out += 4;
@@ -1289,7 +1296,9 @@ void InvLut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * ou
 
     for(long idx=0; idx<numPixels; ++idx)
     {
-        const float RGB[] = {(float)in[0], (float)in[1], (float)in[2]};
+        const float RGB[] = {(float)ClampCode<inBD>(in[0]),
+                             (float)ClampCode<inBD>(in[1]),
+                             (float)ClampCode<inBD>(in[2])};
 
         int min, mid, max;
         GamutMapUtils::Order3(RGB, min, mid, max);
@@ -1330,7 +1339,7 @@ void InvLut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * ou
         out[0] = Converter<outBD>::CastValue(RGB2[0]);
         out[1] = Converter<outBD>::CastValue(RGB2[1]);
         out[2] = Converter<outBD>::CastValue(RGB2[2]);
-        out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
+        out[3] = Converter<outBD>::CastValue(ClampCode<inBD>(in[3]) * this->m_alphaScaling);
 
         in  += 4;
         out += 4;
@@ -1452,7 +1461,7 @@ void InvLut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * out
         // the neg effective domain starts.
         // If this proves to be a problem, could move the clamp here instead.
 
-        const float redIn = in[0];
+        const float redIn = ClampCode<inBD>(in[0]);
         const float redOut 
             = (redIsIncreasing == (redIn >= this->m_paramsR.bisectPoint)) 
                 ? FindLutInvHalf(this->m_paramsR.lutStart,
@@ -1468,7 +1477,7 @@ void InvLut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * out
                                  this->m_scale,
                                  redIn);
 
-        const float grnIn = in[1];
+        const float grnIn = ClampCode<inBD>(in[1]);
         const float grnOut 
             = (grnIsIncreasing == (grnIn >= this->m_paramsG.bisectPoint)) 
                 ? FindLutInvHalf(this->m_paramsG.lutStart,
@@ -1484,7 +1493,7 @@ void InvLut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * out
                                  this->m_scale,
                                  grnIn);
 
-        const float bluIn = in[2];
+        const float bluIn = ClampCode<inBD>(in[2]);
         const float bluOut 
             = (bluIsIncreasing == (bluIn >= this->m_paramsB.bisectPoint)) 
                 ? FindLutInvHalf(this->m_paramsB.lutStart,
@@ -1503,7 +1512,7 @@ void InvLut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * out
         out[0] = Converter<outBD>::CastValue(redOut);
         out[1] = Converter<outBD>::CastValue(grnOut);
         out[2] = Converter<outBD>::CastValue(bluOut);
-        out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
+        out[3] = Converter<outBD>::CastValue(ClampCode<inBD>(in[3]) * this->m_alphaScaling);
 
         in  += 4;
         out += 4;
@@ -1532,7 +1541,9 @@ void InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, v
 
     for(long idx=0; idx<numPixels; ++idx)
     {
-        const float RGB[] = {(float)in[0], (float)in[1], (float)in[2]};
+        const float RGB[] = {(float)ClampCode<inBD>(in[0]),
+                             (float)ClampCode<inBD>(in[1]),
+                             (float)ClampCode<inBD>(in[2])};
 
         int min, mid, max;
         GamutMapUtils::Order3( RGB, min, mid, max);
@@ -1596,7 +1607,7 @@ void InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, v
         out[0] = Converter<outBD>::CastValue(RGB2[0]);
         out[1] = Converter<outBD>::CastValue(RGB2[1]);
         out[2] = Converter<outBD>::CastValue(RGB2[2]);
-        out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
+        out[3] = Converter<outBD>::CastValue(ClampCode<inBD>(in[3]) * this->m_alphaScaling);
 
         in  += 4;
         out += 4;
@@ -131,6 +131,8 @@ public:
 
     bool hasChannelCrosstalk() const override;
 
+    bool modifiesAlpha() const override { return false; }
+
     void setOutputBitDepth(BitDepth out) override;
     void setInputBitDepth(BitDepth in) override;
 
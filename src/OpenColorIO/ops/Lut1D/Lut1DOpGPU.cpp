@@ -6,6 +6,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOpGPU.h"
@@ -91,10 +92,10 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
 
     // Adjust LUT texture to allow for correct 2d linear interpolation, if needed.
 
-    std::vector<float> values;
-    values.reserve(width*height*3);
+    OCIO_SHARED_PTR<std::vector<float>> values = std::make_shared<std::vector<float>>();
+    values->reserve(width*height*3);
 
-    PadLutChannels(width, height, lutData->getArray().getValues(), values);
+    PadLutChannels(width, height, lutData->getArray().getValues(), *values);
 
     // Register the RGB LUT.
 
@@ -105,12 +106,13 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
 
     const std::string name(resName.str());
     
-    shaderDesc->addTexture(GpuShaderText::getSamplerName(name).c_str(),
-                           lutData->getCacheID().c_str(),
-                           width, height,
-                           GpuShaderDesc::TEXTURE_RGB_CHANNEL,
-                           lutData->getConcreteInterpolation(),
-                           &values[0]);
+    // The padded values are moved to the texture (i.e. no copy).
+    AddSharedTexture(*shaderDesc, GpuShaderText::getSamplerName(name).c_str(),
+                     lutData->getCacheID().c_str(),
+                     width, height,
+                     GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                     lutData->getConcreteInterpolation(),
+                     GpuTextureValuesRcPtr(values, values->data()));
 
     // Add the LUT code to the OCIO shader program.
 
@@ -260,6 +262,18 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                         << ss.sampleTex1D(name, name + "_coords.b") << ".b;";
     }
 
+    if (shaderDesc->getTextureFormat() == GpuShaderDesc::TEXTURE_FORMAT_UNORM16)
+    {
+        // Decode the normalized texture values.
+        float scale = 1.0f;
+        float offset = 0.0f;
+        GetUnorm16TextureRange(values->data(), values->size(), scale, offset);
+
+        ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
+                     << shaderDesc->getPixelName() << ".rgb * " << ss.vec3fConst(scale)
+                     << " + " << ss.vec3fConst(offset) << ";";
+    }
+
     if (lutData->getHueAdjust() == HUE_DW3)
     {
         ss.newLine() << "";
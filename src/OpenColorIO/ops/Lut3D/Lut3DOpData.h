@@ -92,6 +92,8 @@ public:
 
     bool hasChannelCrosstalk() const override { return true; }
 
+    bool modifiesAlpha() const override { return false; }
+
     OpDataRcPtr getIdentityReplacement() const;
 
     void setInputBitDepth(BitDepth in) override;
@@ -5,6 +5,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 #include "ops/Lut3D/Lut3DOpGPU.h"
@@ -23,9 +24,11 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
 
     const std::string name(resName.str());
 
-    shaderDesc->add3DTexture(GpuShaderText::getSamplerName(name).c_str(),
+    // The texture shares the LUT values, which are kept alive by the texture.
+    AddShared3DTexture(*shaderDesc, GpuShaderText::getSamplerName(name).c_str(),
         lutData->getCacheID().c_str(), lutData->getGridSize(),
-        lutData->getConcreteInterpolation(), &lutData->getArray()[0]);
+        lutData->getConcreteInterpolation(),
+        GpuTextureValuesRcPtr(lutData, &lutData->getArray()[0]));
 
     {
         GpuShaderText ss(shaderDesc->getLanguage());
@@ -221,6 +224,20 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                          << ss.sampleTex3D(name, name + "_coords") << ".rgb;";
         }
 
+        if (shaderDesc->getTextureFormat() == GpuShaderDesc::TEXTURE_FORMAT_UNORM16)
+        {
+            // Decode the normalized texture values.  As the interpolation is a
+            // weighted average, decoding the interpolated value is equivalent.
+            const Array::Values & values = lutData->getArray().getValues();
+            float scale = 1.0f;
+            float offset = 0.0f;
+            GetUnorm16TextureRange(values.data(), values.size(), scale, offset);
+
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
+                         << shaderDesc->getPixelName() << ".rgb * " << ss.vec3fConst(scale)
+                         << " + " << ss.vec3fConst(offset) << ";";
+        }
+
         shaderDesc->addToFunctionShaderCode(ss.string().c_str());
     }
 }
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
@@ -76,6 +78,57 @@ private:
     float m_column4[4];
 };
 
+// Matrix (with or without offset) leaving the alpha channel unchanged i.e. the alpha
+// does not contribute to the color channels and is only copied, so only the 3x3 part
+// of the matrix is computed.
+class RGBMatrixRenderer : public OpCPU
+{
+public:
+    RGBMatrixRenderer() = delete;
+    RGBMatrixRenderer(const RGBMatrixRenderer &) = delete;
+    explicit RGBMatrixRenderer(ConstMatrixOpDataRcPtr & mat);
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+private:
+    float m_column1[3];
+    float m_column2[3];
+    float m_column3[3];
+
+    float m_offset[3];
+};
+
+// Matrix with offset followed by a Range i.e. the scale & clamp of the Range are
+// fused into the tail of the Matrix renderer so the pixels are only processed once.
+class MatrixWithRangeRenderer : public OpCPU
+{
+public:
+    MatrixWithRangeRenderer() = delete;
+    MatrixWithRangeRenderer(const MatrixWithRangeRenderer &) = delete;
+    MatrixWithRangeRenderer(ConstMatrixOpDataRcPtr & mat, ConstRangeOpDataRcPtr & range);
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+private:
+    float m_column1[4];
+    float m_column2[4];
+    float m_column3[4];
+    float m_column4[4];
+
+    float m_offset[4];
+
+    bool m_copyAlpha; // Same alpha as the RGBMatrixRenderer when the matrix leaves it as is.
+    bool m_scales;
+    bool m_minClips;
+    bool m_maxClips;
+
+    float m_scale;
+    float m_rangeOffset;
+    float m_lowerBound;
+    float m_upperBound;
+    float m_alphaScale;
+};
+
 ScaleRenderer::ScaleRenderer(ConstMatrixOpDataRcPtr & mat)
     : OpCPU()
 {
@@ -395,6 +448,292 @@ void MatrixRenderer::apply(const void * inImg, void * outImg, long numPixels) co
 #endif
 }
 
+RGBMatrixRenderer::RGBMatrixRenderer(ConstMatrixOpDataRcPtr & mat)
+    : OpCPU()
+{
+    const unsigned long dim = mat->getArray().getLength();
+    const unsigned long twoDim = 2 * dim;
+    const ArrayDouble::Values & m = mat->getArray().getValues();
+
+    // Red multipliers.
+    m_column1[0] = (float)m[0];
+    m_column1[1] = (float)m[dim];
+    m_column1[2] = (float)m[twoDim];
+
+    // Green multipliers.
+    m_column2[0] = (float)m[1];
+    m_column2[1] = (float)m[dim + 1];
+    m_column2[2] = (float)m[twoDim + 1];
+
+    // Blue multipliers.
+    m_column3[0] = (float)m[2];
+    m_column3[1] = (float)m[dim + 2];
+    m_column3[2] = (float)m[twoDim + 2];
+
+    const MatrixOpData::Offsets & o = mat->getOffsets();
+
+    m_offset[0] = (float)o[0];
+    m_offset[1] = (float)o[1];
+    m_offset[2] = (float)o[2];
+}
+
+void RGBMatrixRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    const float * in = (const float *)inImg;
+    float * out = (float *)outImg;
+
+#ifdef USE_SSE
+    // Matrix decomposition per _column (the alpha lanes are not used).
+    __m128 m0 = _mm_set_ps(0.0f, m_column1[2], m_column1[1], m_column1[0]);
+    __m128 m1 = _mm_set_ps(0.0f, m_column2[2], m_column2[1], m_column2[0]);
+    __m128 m2 = _mm_set_ps(0.0f, m_column3[2], m_column3[1], m_column3[0]);
+    __m128 o  = _mm_set_ps(0.0f, m_offset[2], m_offset[1], m_offset[0]);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+
+        __m128 r = _mm_shuffle_ps(pix, pix, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 g = _mm_shuffle_ps(pix, pix, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 b = _mm_shuffle_ps(pix, pix, _MM_SHUFFLE(2, 2, 2, 2));
+
+        __m128 rm0 = _mm_mul_ps(m0, r);
+        __m128 gm1 = _mm_mul_ps(m1, g);
+        __m128 bm2 = _mm_mul_ps(m2, b);
+
+        __m128 img = _mm_add_ps(_mm_add_ps(_mm_add_ps(rm0, gm1), bm2), o);
+
+        // Copy the alpha from the input pixel.
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, img, pix));
+
+        in  += 4;
+        out += 4;
+    }
+#else
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        const float r = in[0];
+        const float g = in[1];
+        const float b = in[2];
+        const float a = in[3];
+
+        out[0] = r*m_column1[0]
+               + g*m_column2[0]
+               + b*m_column3[0]
+               + m_offset[0];
+        out[1] = r*m_column1[1]
+               + g*m_column2[1]
+               + b*m_column3[1]
+               + m_offset[1];
+        out[2] = r*m_column1[2]
+               + g*m_column2[2]
+               + b*m_column3[2]
+               + m_offset[2];
+        out[3] = a;
+
+        in  += 4;
+        out += 4;
+    }
+#endif
+}
+
+MatrixWithRangeRenderer::MatrixWithRangeRenderer(ConstMatrixOpDataRcPtr & mat,
+                                                 ConstRangeOpDataRcPtr & range)
+    : OpCPU()
+{
+    const unsigned long dim = mat->getArray().getLength();
+    const unsigned long twoDim = 2 * dim;
+    const unsigned long threeDim = 3 * dim;
+    const ArrayDouble::Values & m = mat->getArray().getValues();
+
+    // Red multipliers.
+    m_column1[0] = (float)m[0];
+    m_column1[1] = (float)m[dim];
+    m_column1[2] = (float)m[twoDim];
+    m_column1[3] = (float)m[threeDim];
+
+    // Green multipliers.
+    m_column2[0] = (float)m[1];
+    m_column2[1] = (float)m[dim + 1];
+    m_column2[2] = (float)m[twoDim + 1];
+    m_column2[3] = (float)m[threeDim + 1];
+
+    // Blue multipliers.
+    m_column3[0] = (float)m[2];
+    m_column3[1] = (float)m[dim + 2];
+    m_column3[2] = (float)m[twoDim + 2];
+    m_column3[3] = (float)m[threeDim + 2];
+
+    // Alpha multipliers.
+    m_column4[0] = (float)m[3];
+    m_column4[1] = (float)m[dim + 3];
+    m_column4[2] = (float)m[twoDim + 3];
+    m_column4[3] = (float)m[threeDim + 3];
+
+    const MatrixOpData::Offsets & o = mat->getOffsets();
+
+    m_offset[0] = (float)o[0];
+    m_offset[1] = (float)o[1];
+    m_offset[2] = (float)o[2];
+    m_offset[3] = (float)o[3];
+
+    m_copyAlpha = !mat->hasAlpha() && !mat->modifiesAlpha()
+                  && mat->getInputBitDepth() == mat->getOutputBitDepth();
+
+    // Refer to GetRangeRenderer() i.e. when the range does not scale, m_scale = 1,
+    // m_alphaScale = 1 and m_rangeOffset = 0.
+    m_scales   = range->scales(false);
+    m_minClips = range->minClips();
+    m_maxClips = range->maxClips();
+
+    m_scale       = (float)range->getScale();
+    m_rangeOffset = (float)range->getOffset();
+    m_lowerBound  = (float)range->getLowBound();
+    m_upperBound  = (float)range->getHighBound();
+    m_alphaScale  = (float)range->getAlphaScale();
+}
+
+void MatrixWithRangeRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    const float * in = (const float *)inImg;
+    float * out = (float *)outImg;
+
+#ifdef USE_SSE
+    // Matrix decomposition per _column.
+    __m128 m0 = _mm_set_ps(m_column1[3],
+                           m_column1[2],
+                           m_column1[1],
+                           m_column1[0]);
+    __m128 m1 = _mm_set_ps(m_column2[3],
+                           m_column2[2],
+                           m_column2[1],
+                           m_column2[0]);
+    __m128 m2 = _mm_set_ps(m_column3[3],
+                           m_column3[2],
+                           m_column3[1],
+                           m_column3[0]);
+    __m128 m3 = _mm_set_ps(m_column4[3],
+                           m_column4[2],
+                           m_column4[1],
+                           m_column4[0]);
+    __m128 o = _mm_set_ps(m_offset[3], m_offset[2], m_offset[1], m_offset[0]);
+
+    const __m128 scale  = _mm_set_ps(m_alphaScale, m_scale, m_scale, m_scale);
+    // Adding -0 leaves the alpha channel unchanged.
+    const __m128 offset = _mm_set_ps(-0.0f, m_rangeOffset, m_rangeOffset, m_rangeOffset);
+    const __m128 lower  = _mm_set1_ps(m_lowerBound);
+    const __m128 upper  = _mm_set1_ps(m_upperBound);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        __m128 r = _mm_set1_ps(in[0]);
+        __m128 g = _mm_set1_ps(in[1]);
+        __m128 b = _mm_set1_ps(in[2]);
+        __m128 a = _mm_set1_ps(in[3]);
+
+        __m128 rm0 = _mm_mul_ps(m0, r);
+        __m128 gm1 = _mm_mul_ps(m1, g);
+        __m128 bm2 = _mm_mul_ps(m2, b);
+        __m128 am3 = _mm_mul_ps(m3, a);
+
+        __m128 img = _mm_add_ps(_mm_add_ps(rm0, gm1), _mm_add_ps(bm2, am3));
+        img = _mm_add_ps(img, o);
+
+        if (m_copyAlpha)
+        {
+            img = sseSelect(ERGB_MASK, img, a);
+        }
+
+        if (m_scales)
+        {
+            img = _mm_add_ps(_mm_mul_ps(img, scale), offset);
+        }
+
+        // Same NaN handling as the Range renderers i.e. NaNs become m_lowerBound
+        // when the min clips, or m_upperBound otherwise.
+        __m128 res = img;
+        if (m_minClips)
+        {
+            res = _mm_max_ps(res, lower);
+        }
+        if (m_maxClips)
+        {
+            res = _mm_min_ps(res, upper);
+        }
+
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, res, img));
+
+        in  += 4;
+        out += 4;
+    }
+#else
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        const float r = in[0];
+        const float g = in[1];
+        const float b = in[2];
+        const float a = in[3];
+
+        float res[4];
+        res[0] = r*m_column1[0]
+               + g*m_column2[0]
+               + b*m_column3[0]
+               + a*m_column4[0]
+               + m_offset[0];
+        res[1] = r*m_column1[1]
+               + g*m_column2[1]
+               + b*m_column3[1]
+               + a*m_column4[1]
+               + m_offset[1];
+        res[2] = r*m_column1[2]
+               + g*m_column2[2]
+               + b*m_column3[2]
+               + a*m_column4[2]
+               + m_offset[2];
+        res[3] = r*m_column1[3]
+               + g*m_column2[3]
+               + b*m_column3[3]
+               + a*m_column4[3]
+               + m_offset[3];
+
+        if (m_copyAlpha)
+        {
+            res[3] = a;
+        }
+
+        if (m_scales)
+        {
+            res[0] = res[0] * m_scale + m_rangeOffset;
+            res[1] = res[1] * m_scale + m_rangeOffset;
+            res[2] = res[2] * m_scale + m_rangeOffset;
+            res[3] = res[3] * m_alphaScale;
+        }
+
+        // Same NaN handling as the Range renderers i.e. NaNs become m_lowerBound
+        // when the min clips, or m_upperBound otherwise.
+        for (int c = 0; c < 3; ++c)
+        {
+            if (m_minClips)
+            {
+                res[c] = std::max(m_lowerBound, res[c]);
+            }
+            if (m_maxClips)
+            {
+                res[c] = std::min(m_upperBound, res[c]);
+            }
+        }
+
+        out[0] = res[0];
+        out[1] = res[1];
+        out[2] = res[2];
+        out[3] = res[3];
+
+        in  += 4;
+        out += 4;
+    }
+#endif
+}
+
 }
 
 ConstOpCPURcPtr GetMatrixRenderer(ConstMatrixOpDataRcPtr & mat)
@@ -410,6 +749,12 @@ ConstOpCPURcPtr GetMatrixRenderer(ConstMatrixOpDataRcPtr & mat)
             return std::make_shared<ScaleRenderer>(mat);
         }
     }
+    else if (!mat->hasAlpha() && !mat->modifiesAlpha()
+             && mat->getInputBitDepth() == mat->getOutputBitDepth())
+    {
+        // The alpha is neither modified nor used by the color channels.
+        return std::make_shared<RGBMatrixRenderer>(mat);
+    }
     else
     {
         if (mat->hasOffsets())
@@ -423,12 +768,21 @@ ConstOpCPURcPtr GetMatrixRenderer(ConstMatrixOpDataRcPtr & mat)
     }
 }
 
+ConstOpCPURcPtr GetMatrixWithRangeRenderer(ConstMatrixOpDataRcPtr & mat,
+                                           ConstRangeOpDataRcPtr & range)
+{
+    return std::make_shared<MatrixWithRangeRenderer>(mat, range);
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
 
 #ifdef OCIO_UNIT_TEST
 
+#include <limits>
+
+#include "ops/Range/RangeOpCPU.h"
 #include "UnitTest.h"
 
 namespace OCIO = OCIO_NAMESPACE;
@@ -549,6 +903,115 @@ OCIO_ADD_TEST(MatrixOpCPU, matrix_renderer)
     OCIO_CHECK_EQUAL(rgba[3], 2.f);
 }
 
+OCIO_ADD_TEST(MatrixOpCPU, rgb_matrix_renderer)
+{
+    OCIO::MatrixOpDataRcPtr mat(OCIO::MatrixOpData::CreateDiagonalMatrix(
+        OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32, 2.0));
+
+    // Make not diagonal while leaving the alpha unchanged.
+    mat->setArrayValue(1, 0.5f);
+    mat->setArrayValue(15, 1.0f);
+    mat->setOffsetValue(2, 3.f);
+
+    OCIO::ConstMatrixOpDataRcPtr m = OCIO::DynamicPtrCast<const OCIO::MatrixOpData>(mat);
+    OCIO::ConstOpCPURcPtr op = OCIO::GetMatrixRenderer(m);
+    OCIO_CHECK_ASSERT((bool)op);
+
+    const OCIO::RGBMatrixRenderer * matOp
+        = dynamic_cast<const OCIO::RGBMatrixRenderer*>(op.get());
+    OCIO_CHECK_ASSERT(matOp);
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+
+    float rgba[8] = { 4.f, 3.f, 2.f, 0.5f,
+                      4.f, 3.f, 2.f, qnan };
+
+    op->apply(rgba, rgba, 2);
+
+    OCIO_CHECK_EQUAL(rgba[0], 9.5f);
+    OCIO_CHECK_EQUAL(rgba[1], 6.f);
+    OCIO_CHECK_EQUAL(rgba[2], 7.f);
+    OCIO_CHECK_EQUAL(rgba[3], 0.5f);
+
+    // The alpha is copied.
+    OCIO_CHECK_EQUAL(rgba[4], 9.5f);
+    OCIO_CHECK_EQUAL(rgba[5], 6.f);
+    OCIO_CHECK_EQUAL(rgba[6], 7.f);
+    OCIO_CHECK_ASSERT(OCIO::IsNan(rgba[7]));
+
+    // The alpha contributes to the color channels.
+    mat->setArrayValue(3, 0.5f);
+    op = OCIO::GetMatrixRenderer(m);
+    OCIO_CHECK_ASSERT(!dynamic_cast<const OCIO::RGBMatrixRenderer*>(op.get()));
+}
+
+OCIO_ADD_TEST(MatrixOpCPU, matrix_with_range_renderer)
+{
+    OCIO::MatrixOpDataRcPtr mat(OCIO::MatrixOpData::CreateDiagonalMatrix(
+        OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32, 0.8));
+
+    mat->setArrayValue(1, 0.1f);
+    mat->setArrayValue(6, 0.2f);
+    mat->setArrayValue(12, 0.1f);
+    mat->setOffsetValue(0, 0.1f);
+    mat->setOffsetValue(2, -0.1f);
+
+    OCIO::ConstMatrixOpDataRcPtr m = OCIO::DynamicPtrCast<const OCIO::MatrixOpData>(mat);
+    OCIO::ConstOpCPURcPtr matOp = OCIO::GetMatrixRenderer(m);
+
+    const double empty = OCIO::RangeOpData::EmptyValue();
+
+    // All the Range renderer styles i.e. with and without a scale.
+    const double bounds[6][4] = { { 0.0,   1.0,   0.5,   1.5   },
+                                  { 0.0,   empty, 0.5,   empty },
+                                  { empty, 1.0,   empty, 1.5   },
+                                  { 0.1,   0.9,   0.1,   0.9   },
+                                  { 0.1,   empty, 0.1,   empty },
+                                  { empty, 0.9,   empty, 0.9   } };
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf  = std::numeric_limits<float>::infinity();
+
+    constexpr long numPixels = 6;
+    const float src[4 * numPixels] = { -0.50f, -0.25f, 0.50f,  0.0f,
+                                        0.75f,  1.00f, 1.25f,  1.0f,
+                                        1.25f,  1.50f, 1.75f, -0.0f,
+                                         qnan,   0.0f,  0.0f,  1.0f,
+                                          inf,  -inf,   0.5f,  0.5f,
+                                         0.0f,   0.0f,  0.0f,  qnan };
+
+    for (const auto & b : bounds)
+    {
+        OCIO::RangeOpDataRcPtr range
+            = std::make_shared<OCIO::RangeOpData>(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                                  OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                                                  b[0], b[1], b[2], b[3]);
+        OCIO_CHECK_NO_THROW(range->finalize());
+
+        OCIO::ConstRangeOpDataRcPtr r = range;
+        OCIO::ConstOpCPURcPtr rangeOp = OCIO::GetRangeRenderer(r);
+        OCIO::ConstOpCPURcPtr op = OCIO::GetMatrixWithRangeRenderer(m, r);
+
+        float ref[4 * numPixels];
+        matOp->apply(src, ref, numPixels);
+        rangeOp->apply(ref, ref, numPixels);
+
+        float res[4 * numPixels];
+        op->apply(src, res, numPixels);
+
+        for (long idx = 0; idx < 4 * numPixels; ++idx)
+        {
+            if (OCIO::IsNan(ref[idx]))
+            {
+                OCIO_CHECK_ASSERT(OCIO::IsNan(res[idx]));
+            }
+            else
+            {
+                OCIO_CHECK_EQUAL(res[idx], ref[idx]);
+            }
+        }
+    }
+}
 
 
 #endif
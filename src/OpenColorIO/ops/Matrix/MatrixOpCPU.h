@@ -8,12 +8,18 @@
 
 #include "Op.h"
 #include "ops/Matrix/MatrixOpData.h"
+#include "ops/Range/RangeOpData.h"
 
 OCIO_NAMESPACE_ENTER
 {
 
 ConstOpCPURcPtr GetMatrixRenderer(ConstMatrixOpDataRcPtr & mat);
 
+// Get the renderer of a Matrix followed by a Range where the Range is fused into
+// the tail of the Matrix renderer (i.e. only one pass over the pixels).
+ConstOpCPURcPtr GetMatrixWithRangeRenderer(ConstMatrixOpDataRcPtr & mat,
+                                           ConstRangeOpDataRcPtr & range);
+
 }
 OCIO_NAMESPACE_EXIT
 
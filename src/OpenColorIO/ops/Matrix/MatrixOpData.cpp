@@ -663,6 +663,27 @@ bool MatrixOpData::hasAlpha() const
 
 }
 
+bool MatrixOpData::modifiesAlpha() const
+{
+    const ArrayDouble & a = getArray();
+    const ArrayDouble::Values & m = a.getValues();
+
+    const double scaleFactor
+        = (double)GetBitDepthMaxValue(getOutputBitDepth())
+        / (double)GetBitDepthMaxValue(getInputBitDepth());
+
+    return
+
+        // Bottom row.
+        (m[12] != 0.0) || // Strict comparison intended
+        (m[13] != 0.0) ||
+        (m[14] != 0.0) ||
+        (m[15] != scaleFactor) ||
+
+        // Alpha offset
+        (m_offsets[3] != 0.0);
+}
+
 MatrixOpDataRcPtr MatrixOpData::CreateDiagonalMatrix(
     BitDepth inBitDepth,
     BitDepth outBitDepth,
@@ -1103,6 +1124,35 @@ OCIO_ADD_TEST(MatrixOpData, has_alpha)
 
 #undef MATRIX_TEST_HAS_ALPHA
 
+OCIO_ADD_TEST(MatrixOpData, modifies_alpha)
+{
+    OCIO::MatrixOpData mat;
+    OCIO_CHECK_ASSERT(!mat.modifiesAlpha());
+
+    // The alpha may contribute to the color channels.
+    mat.setArrayValue(3, 0.5);
+    OCIO_CHECK_ASSERT(mat.hasAlpha());
+    OCIO_CHECK_ASSERT(!mat.modifiesAlpha());
+    mat.setArrayValue(3, 0.0);
+
+    mat.setArrayValue(12, 0.001);
+    OCIO_CHECK_ASSERT(mat.modifiesAlpha());
+    mat.setArrayValue(12, 0.0);
+
+    mat.setArrayValue(15, 1.0 + 1e-7);
+    OCIO_CHECK_ASSERT(!mat.hasAlpha());
+    OCIO_CHECK_ASSERT(mat.modifiesAlpha());
+    mat.setArrayValue(15, 1.0);
+
+    mat.getOffsets()[3] = 0.001;
+    OCIO_CHECK_ASSERT(mat.modifiesAlpha());
+    mat.getOffsets()[3] = 0.0;
+
+    // The alpha is only scaled by the bit-depth conversion.
+    mat.setOutputBitDepth(OCIO::BIT_DEPTH_UINT16);
+    OCIO_CHECK_ASSERT(!mat.modifiesAlpha());
+}
+
 OCIO_ADD_TEST(MatrixOpData, clone)
 {
     OCIO::MatrixOpData ref;
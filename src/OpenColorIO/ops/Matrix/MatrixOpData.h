@@ -165,6 +165,10 @@ public:
     // Returns true if the op's output combines input channels.
     bool hasChannelCrosstalk() const override { return !isDiagonal(); }
 
+    // Returns true if the alpha output differs from the (bit-depth scaled) alpha input
+    // i.e. if the last row or the alpha offset are not the identity ones.
+    bool modifiesAlpha() const override;
+
     void finalize() override;
 
     OpDataRcPtr getIdentityReplacement() const;
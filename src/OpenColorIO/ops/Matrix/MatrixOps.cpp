@@ -239,6 +239,35 @@ OCIO_NAMESPACE_ENTER
             ArrayDouble::Values values = matData->getArray().getValues();
             MatrixOpData::Offsets offs(matData->getOffsets());
 
+            if (shaderDesc->getParameterMode() != GpuShaderDesc::PARAMETER_CONSTANT)
+            {
+                // The uniform layout must not depend on the values so the
+                // complete matrix and offsets are always applied.
+                std::string mtx[16];
+                for (unsigned idx = 0; idx < 16; ++idx)
+                {
+                    std::ostringstream oss;
+                    oss << "matrix_" << idx / 4 << idx % 4;
+                    mtx[idx] = AddParameter(shaderDesc, oss.str(), values[idx]);
+                }
+
+                ss.newLine() << shaderDesc->getPixelName() << " = "
+                             << ss.mat4fMul(mtx, shaderDesc->getPixelName())
+                             << ";";
+
+                const std::string r = AddParameter(shaderDesc, "offset_r", offs[0]);
+                const std::string g = AddParameter(shaderDesc, "offset_g", offs[1]);
+                const std::string b = AddParameter(shaderDesc, "offset_b", offs[2]);
+                const std::string a = AddParameter(shaderDesc, "offset_a", offs[3]);
+
+                ss.newLine() << shaderDesc->getPixelName() << " = "
+                             << ss.vec4fConst(r, g, b, a)
+                             << " + " << shaderDesc->getPixelName() << ";";
+
+                shaderDesc->addToFunctionShaderCode(ss.string().c_str());
+                return;
+            }
+
             if (!matData->isUnityDiagonal())
             {
                 if (matData->isDiagonal())
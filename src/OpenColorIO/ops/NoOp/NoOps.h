@@ -46,6 +46,7 @@ OCIO_NAMESPACE_ENTER
         bool isNoOp() const override { return true; }
         bool isIdentity() const override { return true; }
         bool hasChannelCrosstalk() const override { return false; }
+        bool modifiesAlpha() const override { return false; }
         void finalize() override { m_cacheID = ""; }
     };
 
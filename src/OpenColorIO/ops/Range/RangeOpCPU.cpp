@@ -8,6 +8,7 @@
 
 #include "MathUtils.h"
 #include "ops/Range/RangeOpCPU.h"
+#include "SSE.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -112,6 +113,26 @@ void RangeScaleMinMaxRenderer::apply(const void * inImg, void * outImg, long num
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 scale  = _mm_set_ps(m_alphaScale, m_scale, m_scale, m_scale);
+    // Adding -0 leaves the alpha channel unchanged.
+    const __m128 offset = _mm_set_ps(-0.0f, m_offset, m_offset, m_offset);
+    const __m128 lower  = _mm_set1_ps(m_lowerBound);
+    const __m128 upper  = _mm_set1_ps(m_upperBound);
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in), scale), offset);
+
+        // NaNs become m_lowerBound.
+        const __m128 res = _mm_min_ps(_mm_max_ps(pix, lower), upper);
+
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, res, pix));
+
+        in  += 4;
+        out += 4;
+    }
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         const float t[3] = { in[0] * m_scale + m_offset,
@@ -127,6 +148,7 @@ void RangeScaleMinMaxRenderer::apply(const void * inImg, void * outImg, long num
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 RangeScaleMinRenderer::RangeScaleMinRenderer(ConstRangeOpDataRcPtr & range)
@@ -139,6 +161,25 @@ void RangeScaleMinRenderer::apply(const void * inImg, void * outImg, long numPix
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 scale  = _mm_set_ps(m_alphaScale, m_scale, m_scale, m_scale);
+    // Adding -0 leaves the alpha channel unchanged.
+    const __m128 offset = _mm_set_ps(-0.0f, m_offset, m_offset, m_offset);
+    const __m128 lower  = _mm_set1_ps(m_lowerBound);
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in), scale), offset);
+
+        // NaNs become m_lowerBound.
+        const __m128 res = _mm_max_ps(pix, lower);
+
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, res, pix));
+
+        in  += 4;
+        out += 4;
+    }
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         out[0] = in[0] * m_scale + m_offset;
@@ -154,6 +195,7 @@ void RangeScaleMinRenderer::apply(const void * inImg, void * outImg, long numPix
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 RangeScaleMaxRenderer::RangeScaleMaxRenderer(ConstRangeOpDataRcPtr & range)
@@ -166,6 +208,25 @@ void RangeScaleMaxRenderer::apply(const void * inImg, void * outImg, long numPix
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 scale  = _mm_set_ps(m_alphaScale, m_scale, m_scale, m_scale);
+    // Adding -0 leaves the alpha channel unchanged.
+    const __m128 offset = _mm_set_ps(-0.0f, m_offset, m_offset, m_offset);
+    const __m128 upper  = _mm_set1_ps(m_upperBound);
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in), scale), offset);
+
+        // NaNs become m_upperBound.
+        const __m128 res = _mm_min_ps(pix, upper);
+
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, res, pix));
+
+        in  += 4;
+        out += 4;
+    }
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         out[0] = in[0] * m_scale + m_offset;
@@ -181,6 +242,7 @@ void RangeScaleMaxRenderer::apply(const void * inImg, void * outImg, long numPix
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 // NOTE: Currently there is no way to create the Scale renderer.  If a Range Op
@@ -198,6 +260,19 @@ void RangeScaleRenderer::apply(const void * inImg, void * outImg, long numPixels
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 scale  = _mm_set_ps(m_alphaScale, m_scale, m_scale, m_scale);
+    // Adding -0 leaves the alpha channel unchanged.
+    const __m128 offset = _mm_set_ps(-0.0f, m_offset, m_offset, m_offset);
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in), scale), offset));
+
+        in  += 4;
+        out += 4;
+    }
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         out[0] = in[0] * m_scale + m_offset;
@@ -208,6 +283,7 @@ void RangeScaleRenderer::apply(const void * inImg, void * outImg, long numPixels
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 RangeMinMaxRenderer::RangeMinMaxRenderer(ConstRangeOpDataRcPtr & range)
@@ -220,6 +296,23 @@ void RangeMinMaxRenderer::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 lower  = _mm_set1_ps(m_lowerBound);
+    const __m128 upper  = _mm_set1_ps(m_upperBound);
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+
+        // NaNs become m_lowerBound.
+        const __m128 res = _mm_min_ps(_mm_max_ps(pix, lower), upper);
+
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, res, pix));
+
+        in  += 4;
+        out += 4;
+    }
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         // NaNs become m_lowerBound.
@@ -231,6 +324,7 @@ void RangeMinMaxRenderer::apply(const void * inImg, void * outImg, long numPixel
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 RangeMinRenderer::RangeMinRenderer(ConstRangeOpDataRcPtr & range)
@@ -243,6 +337,22 @@ void RangeMinRenderer::apply(const void * inImg, void * outImg, long numPixels)
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 lower  = _mm_set1_ps(m_lowerBound);
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+
+        // NaNs become m_lowerBound.
+        const __m128 res = _mm_max_ps(pix, lower);
+
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, res, pix));
+
+        in  += 4;
+        out += 4;
+    }
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         // Note: Although m_scale is not applied in this renderer, it is ok.
@@ -259,6 +369,7 @@ void RangeMinRenderer::apply(const void * inImg, void * outImg, long numPixels)
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 RangeMaxRenderer::RangeMaxRenderer(ConstRangeOpDataRcPtr & range)
@@ -271,6 +382,22 @@ void RangeMaxRenderer::apply(const void * inImg, void * outImg, long numPixels)
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 upper  = _mm_set1_ps(m_upperBound);
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+
+        // NaNs become m_upperBound.
+        const __m128 res = _mm_min_ps(pix, upper);
+
+        _mm_storeu_ps(out, sseSelect(ERGB_MASK, res, pix));
+
+        in  += 4;
+        out += 4;
+    }
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         // NaNs become m_upperBound.
@@ -282,6 +409,7 @@ void RangeMaxRenderer::apply(const void * inImg, void * outImg, long numPixels)
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 
@@ -142,6 +142,9 @@ public:
 
     bool hasChannelCrosstalk() const override { return false; }
 
+    // The alpha channel is only scaled for the bit-depth conversion.
+    bool modifiesAlpha() const override { return false; }
+
     // Set the output bit depth
     // - out the output bit depth
     // Note: Multiple set operations are lossless.
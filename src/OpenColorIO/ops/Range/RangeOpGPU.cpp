@@ -22,7 +22,26 @@ void GetRangeGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
     ss.newLine() << "// Add a Range processing";
     ss.newLine() << "";
 
-    if(range->scales(true))
+    // The uniform layout must not depend on the values so the scale & offset
+    // are always applied when the parameters are uniforms.
+    const bool useUniforms
+        = shaderDesc->getParameterMode() != GpuShaderDesc::PARAMETER_CONSTANT;
+
+    if(useUniforms)
+    {
+        ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
+                     << shaderDesc->getPixelName() << ".rgb * "
+                     << ss.vec3fConst(AddParameter(shaderDesc, "scale", range->getScale()))
+                     << " + "
+                     << ss.vec3fConst(AddParameter(shaderDesc, "offset", range->getOffset()))
+                     << ";";
+
+        ss.newLine() << shaderDesc->getPixelName() << ".w = "
+                     << shaderDesc->getPixelName() << ".w * "
+                     << AddParameter(shaderDesc, "alphaScale", range->getAlphaScale())
+                     << ";";
+    }
+    else if(range->scales(true))
     {
         const double scale[3]
             = { range->getScale(),
@@ -50,7 +69,15 @@ void GetRangeGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
         }
     }
 
-    if(range->minClips())
+    if(range->minClips() && useUniforms)
+    {
+        ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
+                     << "max(" << ss.vec3fConst(AddParameter(shaderDesc, "lowBound",
+                                                             range->getLowBound())) << ", "
+                     << shaderDesc->getPixelName()
+                     << ".rgb);";
+    }
+    else if(range->minClips())
     {
         const double lowerBound[3] 
             = { range->getLowBound(), 
@@ -65,7 +92,15 @@ void GetRangeGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                      << ".rgb);";
     }
 
-    if (range->maxClips())
+    if (range->maxClips() && useUniforms)
+    {
+        ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
+            << "min(" << ss.vec3fConst(AddParameter(shaderDesc, "highBound",
+                                                    range->getHighBound())) << ", "
+            << shaderDesc->getPixelName()
+            << ".rgb);";
+    }
+    else if (range->maxClips())
     {
         const double upperBound[3]
             = { range->getHighBound(),
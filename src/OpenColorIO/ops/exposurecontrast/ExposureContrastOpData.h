@@ -156,6 +156,7 @@ public:
     bool isNoOp() const override;
     bool isIdentity() const override;
     bool hasChannelCrosstalk() const override { return false; }
+    bool modifiesAlpha() const override { return false; }
 
     bool isDynamic() const;
     bool isInverse(ConstExposureContrastOpDataRcPtr & r) const;
@@ -39,6 +39,11 @@ bool ReferenceOpData::hasChannelCrosstalk() const
     return true;
 }
 
+bool ReferenceOpData::modifiesAlpha() const
+{
+    return true;
+}
+
 bool ReferenceOpData::operator==(const OpData& other) const
 {
     if (this == &other) return true;
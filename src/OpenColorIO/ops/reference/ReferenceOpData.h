@@ -42,6 +42,8 @@ public:
 
     bool hasChannelCrosstalk() const override;
 
+    bool modifiesAlpha() const override;
+
     bool operator==(const OpData& other) const override;
 
     virtual void finalize() override;
@@ -421,12 +421,18 @@ OCIO_NAMESPACE_ENTER
     
     void FileFormat::bake(const Baker & /*baker*/,
                           const std::string & formatName,
-                          std::ostream & /*ostream*/) const
+                          std::ostream & /*ostream*/,
+                          BakingContext * /*context*/) const
     {
         std::ostringstream os;
         os << "Format " << formatName << " does not support baking.";
         throw Exception(os.str().c_str());
     }
+
+    int FileFormat::getDefaultCubeSize(const std::string & /*formatName*/) const
+    {
+        return -1;
+    }
     
     void FileFormat::write(const OpRcPtrVec & /*ops*/,
                            const FormatMetadataImpl & /*metadata*/,
@@ -18,6 +18,8 @@ OCIO_NAMESPACE_ENTER
 {
     void ClearFileTransformCaches();
     
+    class BakingContext;
+
     class CachedFile
     {
     public:
@@ -59,9 +61,15 @@ OCIO_NAMESPACE_ENTER
             std::istream & istream,
             const std::string & originalFileName) const = 0;
         
+        // The context (if any) holds the lattices shared by the targets baked together.
         virtual void bake(const Baker & baker,
                           const std::string & formatName,
-                          std::ostream & ostream) const;
+                          std::ostream & ostream,
+                          BakingContext * context) const;
+
+        // Cube size baked when neither the target nor the baker sets one,
+        // -1 if the format does not bake a cube.
+        virtual int getDefaultCubeSize(const std::string & formatName) const;
 
         virtual void write(const OpRcPtrVec & ops,
                            const FormatMetadataImpl & metadata,
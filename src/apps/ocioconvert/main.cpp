@@ -1,10 +1,20 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -344,6 +354,36 @@ bool StringToInt(int * ival, const char * str);
 
 bool StringToVector(std::vector<int> * ivector, const char * str);
 
+bool SetAttributes(OIIO::ImageSpec & spec,
+                   const std::vector<std::string> & floatAttrs,
+                   const std::vector<std::string> & intAttrs,
+                   const std::vector<std::string> & stringAttrs);
+
+bool StreamImage(const char * inputimage,
+                 const char * outputimage,
+                 const OCIO::ConstProcessorRcPtr & processor,
+                 const std::vector<std::string> & floatAttrs,
+                 const std::vector<std::string> & intAttrs,
+                 const std::vector<std::string> & stringAttrs,
+                 int blockSize,
+                 bool verbose);
+
+typedef std::vector<std::pair<std::string, std::string>> FrameList;
+
+bool GetFrameList(FrameList & frames,
+                  const std::string & frameRanges,
+                  const std::string & fileList,
+                  const std::string & inputPattern,
+                  const std::string & outputPattern);
+
+size_t ConvertFrames(const FrameList & frames,
+                     const OCIO::ConstProcessorRcPtr & processor,
+                     const std::vector<std::string> & floatAttrs,
+                     const std::vector<std::string> & intAttrs,
+                     const std::vector<std::string> & stringAttrs,
+                     int numThreads,
+                     bool verbose);
+
 int main(int argc, const char **argv)
 {
     ArgParse ap;
@@ -356,10 +396,18 @@ int main(int argc, const char **argv)
     bool usegpu = false;
     bool usegpuLegacy = false;
     bool outputgpuInfo = false;
+    bool stream = false;
+    int blockSize = 64;
+    std::string frameRanges;
+    std::string fileList;
+    int numThreads = 0;
     bool verbose = false;
 
     ap.options("ocioconvert -- apply colorspace transform to an image \n\n"
-               "usage: ocioconvert [options]  inputimage inputcolorspace outputimage outputcolorspace\n\n",
+               "usage: ocioconvert [options]  inputimage inputcolorspace outputimage outputcolorspace\n"
+               "   or: ocioconvert [options] --frames 1001-1100 input.####.exr inputcolorspace "
+               "output.####.exr outputcolorspace\n"
+               "   or: ocioconvert [options] --filelist files.txt inputcolorspace outputcolorspace\n\n",
                "%*", parse_end_args, "",
                "<SEPARATOR>", "OpenImageIO options",
                "--float-attribute %L", &floatAttrs, "name=float pair defining OIIO float attribute",
@@ -371,6 +419,19 @@ int main(int argc, const char **argv)
                "--gpulegacy", &usegpuLegacy, "Use the legacy (i.e. baked) GPU color processing "
                                              "instead of the CPU one (--gpu is ignored)",
                "--gpuinfo", &outputgpuInfo, "Output the OCIO shader program",
+               "<SEPARATOR>", "Streaming options",
+               "--stream", &stream, "Process the image by blocks of scanlines to bound the memory "
+                                    "usage regardless of the image size (CPU only)",
+               "--blocksize %d", &blockSize, "Number of scanlines per block in streaming mode "
+                                             "(default: 64)",
+               "<SEPARATOR>", "Batch options",
+               "--frames %s", &frameRanges, "Convert a sequence of frames (e.g. \"1001-1100,1200\") "
+                                            "where the '#' characters of the image names are "
+                                            "replaced by the padded frame number",
+               "--filelist %s", &fileList, "Convert the images listed in a text file, "
+                                           "one \"inputimage outputimage\" pair per line",
+               "--threads %d", &numThreads, "Number of frames converted concurrently in batch mode "
+                                            "(default: number of cores)",
                "--v", &verbose, "Display general information",
                NULL
                );
@@ -380,7 +441,7 @@ int main(int argc, const char **argv)
         exit(1);
     }
 
-    if(args.size()!=4)
+    if(args.size() != (fileList.empty() ? 4 : 2))
     {
       ap.usage();
       exit(1);
@@ -421,10 +482,107 @@ int main(int argc, const char **argv)
         std::cout << "Using GPU color processing." << std::endl;
     }
 
+    if (!frameRanges.empty() || !fileList.empty())
+    {
+        if (usegpu || usegpuLegacy || croptofull || !keepChannels.empty() || stream)
+        {
+            std::cerr << "Error: --frames and --filelist do not support --gpu, --gpulegacy, "
+                      << "--croptofull, --ch and --stream" << std::endl;
+            exit(1);
+        }
+
+        if (!frameRanges.empty() && !fileList.empty())
+        {
+            std::cerr << "Error: --frames and --filelist are mutually exclusive" << std::endl;
+            exit(1);
+        }
+
+        FrameList frames;
+        if (!GetFrameList(frames, frameRanges, fileList,
+                          fileList.empty() ? args[0] : "",
+                          fileList.empty() ? args[2] : ""))
+        {
+            exit(1);
+        }
+
+        // Report the attribute errors once, before converting any frame.
+        OIIO::ImageSpec attrSpec;
+        if (!SetAttributes(attrSpec, floatAttrs, intAttrs, stringAttrs))
+        {
+            exit(1);
+        }
+
+        const std::string & inputcolorspace  = fileList.empty() ? args[1] : args[0];
+        const std::string & outputcolorspace = fileList.empty() ? args[3] : args[1];
+
+        try
+        {
+            // The processor is only built once for all the frames.
+            OCIO::ConstConfigRcPtr config = OCIO::GetCurrentConfig();
+            OCIO::ConstProcessorRcPtr processor
+                = config->getProcessor(inputcolorspace.c_str(), outputcolorspace.c_str());
+
+            const size_t numErrors = ConvertFrames(frames, processor, floatAttrs, intAttrs,
+                                                   stringAttrs, numThreads, verbose);
+            if (numErrors > 0)
+            {
+                std::cerr << "Error: " << numErrors << " of the " << frames.size()
+                          << " frames failed" << std::endl;
+                exit(1);
+            }
+        }
+        catch(OCIO::Exception & exception)
+        {
+            std::cerr << "OCIO Error: " << exception.what() << std::endl;
+            exit(1);
+        }
+
+        return 0;
+    }
+
     const char * inputimage = args[0].c_str();
     const char * inputcolorspace = args[1].c_str();
     const char * outputimage = args[2].c_str();
     const char * outputcolorspace = args[3].c_str();
+
+    if (stream)
+    {
+        if (usegpu || usegpuLegacy || croptofull || !keepChannels.empty())
+        {
+            std::cerr << "Error: --stream does not support --gpu, --gpulegacy, "
+                      << "--croptofull and --ch" << std::endl;
+            exit(1);
+        }
+
+        if (blockSize <= 0)
+        {
+            std::cerr << "Error: --blocksize must be a positive number of scanlines" << std::endl;
+            exit(1);
+        }
+
+        try
+        {
+            OCIO::ConstConfigRcPtr config = OCIO::GetCurrentConfig();
+            OCIO::ConstProcessorRcPtr processor
+                = config->getProcessor(inputcolorspace, outputcolorspace);
+
+            if (!StreamImage(inputimage, outputimage, processor,
+                             floatAttrs, intAttrs, stringAttrs, blockSize, verbose))
+            {
+                exit(1);
+            }
+        }
+        catch(OCIO::Exception & exception)
+        {
+            std::cerr << "OCIO Error: " << exception.what() << std::endl;
+            exit(1);
+        }
+
+        std::cout << std::endl;
+        std::cout << "Wrote " << outputimage << std::endl;
+
+        return 0;
+    }
     
     OIIO::ImageSpec spec;
     OCIO::ImgBuffer img;
@@ -679,6 +837,62 @@ int main(int argc, const char **argv)
     //
     // set the provided OpenImageIO attributes
     //
+    if(!SetAttributes(spec, floatAttrs, intAttrs, stringAttrs))
+    {
+        exit(1);
+    }
+    
+    
+    
+    
+    // Write out the result
+    try
+    {
+#if OIIO_VERSION < 10903
+        OIIO::ImageOutput* f = OIIO::ImageOutput::create(outputimage);
+#else
+        auto f = OIIO::ImageOutput::create(outputimage);
+#endif
+        if(!f)
+        {
+            std::cerr << "Could not create output input." << std::endl;
+            exit(1);
+        }
+        
+        f->open(outputimage, spec);
+
+        if(!f->write_image(spec.format, img.getBuffer()))
+        {
+            std::cerr << "Error writing \"" << outputimage << "\" : " << f->geterror() << "\n";
+            exit(1);
+        }
+
+        f->close();
+#if OIIO_VERSION < 10903
+        OIIO::ImageOutput::destroy(f);
+#endif
+    }
+    catch(...)
+    {
+        std::cerr << "Error writing file.";
+        exit(1);
+    }
+    
+    std::cout << std::endl;
+    std::cout << "Wrote " << outputimage << std::endl;
+    
+    return 0;
+}
+
+
+// Set the provided OpenImageIO attributes
+// return false on parsing errors
+
+bool SetAttributes(OIIO::ImageSpec & spec,
+                   const std::vector<std::string> & floatAttrs,
+                   const std::vector<std::string> & intAttrs,
+                   const std::vector<std::string> & stringAttrs)
+{
     bool parseerror = false;
     for(unsigned int i=0; i<floatAttrs.size(); ++i)
     {
@@ -723,52 +937,550 @@ int main(int argc, const char **argv)
         
         spec.attribute(name, value);
     }
-   
-    if(parseerror)
+
+    return !parseerror;
+}
+
+
+// Block of scanlines exchanged by the streaming stages.
+struct StreamBlock
+{
+    OCIO::ImgBuffer m_img;
+    int m_ybegin = 0;
+    int m_yend = 0;
+};
+
+// Queue of blocks between two streaming stages, where a null block ends the stream.
+class StreamQueue
+{
+public:
+    void push(StreamBlock * block)
     {
-        exit(1);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_blocks.push(block);
+        }
+        m_cond.notify_one();
     }
-    
-    
-    
-    
-    // Write out the result
-    try
+
+    StreamBlock * pop()
     {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]() { return !m_blocks.empty(); });
+
+        StreamBlock * block = m_blocks.front();
+        m_blocks.pop();
+        return block;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::queue<StreamBlock *> m_blocks;
+};
+
+// Number of blocks in flight i.e. one per stage so reading, processing and writing overlap.
+static constexpr int NumStreamBlocks = 3;
+
+// Convert the image by blocks of scanlines (or rows of tiles) so the memory usage only
+// depends on the image width: a reader thread, the color processing and a writer thread
+// recycle a fixed number of blocks.
+// return true on success
+
+bool StreamImage(const char * inputimage,
+                 const char * outputimage,
+                 const OCIO::ConstProcessorRcPtr & processor,
+                 const std::vector<std::string> & floatAttrs,
+                 const std::vector<std::string> & intAttrs,
+                 const std::vector<std::string> & stringAttrs,
+                 int blockSize,
+                 bool verbose)
+{
+    std::cout << std::endl;
+    std::cout << "Streaming " << inputimage << std::endl;
+
+    // The images are released whatever the exit path.
 #if OIIO_VERSION < 10903
-        OIIO::ImageOutput* f = OIIO::ImageOutput::create(outputimage);
+    std::unique_ptr<OIIO::ImageInput, void (*)(OIIO::ImageInput *)>
+        in(OIIO::ImageInput::create(inputimage), OIIO::ImageInput::destroy);
 #else
-        auto f = OIIO::ImageOutput::create(outputimage);
+    auto in = OIIO::ImageInput::create(inputimage);
 #endif
-        if(!f)
+    OIIO::ImageSpec spec;
+    if(!in || !in->open(inputimage, spec))
+    {
+        std::cerr << "Error loading \"" << inputimage << "\" : "
+                  << (in ? in->geterror() : OIIO::geterror()) << std::endl;
+        return false;
+    }
+
+    OCIO::PrintImageSpec(spec, verbose);
+
+    // The output is always written by scanlines.
+    OIIO::ImageSpec outSpec = spec;
+    outSpec.tile_width  = 0;
+    outSpec.tile_height = 0;
+    outSpec.tile_depth  = 0;
+
+    if(!SetAttributes(outSpec, floatAttrs, intAttrs, stringAttrs))
+    {
+        return false;
+    }
+
+#if OIIO_VERSION < 10903
+    std::unique_ptr<OIIO::ImageOutput, void (*)(OIIO::ImageOutput *)>
+        out(OIIO::ImageOutput::create(outputimage), OIIO::ImageOutput::destroy);
+#else
+    auto out = OIIO::ImageOutput::create(outputimage);
+#endif
+    if(!out || !out->open(outputimage, outSpec))
+    {
+        std::cerr << "Error writing \"" << outputimage << "\" : "
+                  << (out ? out->geterror() : OIIO::geterror()) << std::endl;
+        return false;
+    }
+
+    const OCIO::BitDepth bitDepth = OCIO::GetBitDepth(spec);
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor 
+        = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT);
+
+    // Read the tiled images by complete rows of tiles.
+    if(spec.tile_height > 0)
+    {
+        blockSize = ((blockSize + spec.tile_height - 1) / spec.tile_height) * spec.tile_height;
+    }
+    blockSize = std::min(blockSize, spec.height);
+
+    OIIO::ImageSpec blockSpec = spec;
+    blockSpec.height = blockSize;
+
+    StreamBlock blocks[NumStreamBlocks];
+    StreamQueue freeBlocks, readBlocks, processedBlocks;
+    for(auto & block : blocks)
+    {
+        block.m_img.allocate(blockSpec);
+        freeBlocks.push(&block);
+    }
+
+    // Each error message is only set by its own stage.
+    std::atomic<bool> failed(false);
+    std::string readError, processError, writeError;
+
+    const std::chrono::high_resolution_clock::time_point start
+        = std::chrono::high_resolution_clock::now();
+
+    std::thread reader([&]()
+    {
+        for(int y = spec.y; y < spec.y + spec.height && !failed; y += blockSize)
         {
-            std::cerr << "Could not create output input." << std::endl;
-            exit(1);
+            StreamBlock * block = freeBlocks.pop();
+            block->m_ybegin = y;
+            block->m_yend   = std::min(y + blockSize, spec.y + spec.height);
+
+            if(!in->read_scanlines(block->m_ybegin, block->m_yend, spec.z,
+                                   spec.format, block->m_img.getBuffer()))
+            {
+                readError = in->geterror();
+                failed = true;
+                freeBlocks.push(block);
+                break;
+            }
+
+            readBlocks.push(block);
         }
-        
-        f->open(outputimage, spec);
+        readBlocks.push(nullptr);
+    });
 
-        if(!f->write_image(spec.format, img.getBuffer()))
+    std::thread writer([&]()
+    {
+        while(StreamBlock * block = processedBlocks.pop())
         {
-            std::cerr << "Error writing \"" << outputimage << "\" : " << f->geterror() << "\n";
-            exit(1);
+            if(!failed && !out->write_scanlines(block->m_ybegin, block->m_yend, spec.z,
+                                                spec.format, block->m_img.getBuffer()))
+            {
+                writeError = out->geterror();
+                failed = true;
+            }
+            freeBlocks.push(block);
         }
+    });
 
-        f->close();
+    while(StreamBlock * block = readBlocks.pop())
+    {
+        if(!failed)
+        {
+            try
+            {
+                blockSpec.height = block->m_yend - block->m_ybegin;
+
+                OCIO::ImageDescRcPtr imgDesc = OCIO::CreateImageDesc(blockSpec, block->m_img);
+                cpuProcessor->apply(*imgDesc);
+            }
+            catch(OCIO::Exception & exception)
+            {
+                processError = exception.what();
+                failed = true;
+            }
+        }
+        processedBlocks.push(block);
+    }
+    processedBlocks.push(nullptr);
+
+    reader.join();
+    writer.join();
+
+    in->close();
+    out->close();
+
+    if(!readError.empty())
+    {
+        std::cerr << "Error reading \"" << inputimage << "\" : " << readError << std::endl;
+        return false;
+    }
+    if(!processError.empty())
+    {
+        std::cerr << "OCIO Error: " << processError << std::endl;
+        return false;
+    }
+    if(!writeError.empty())
+    {
+        std::cerr << "Error writing \"" << outputimage << "\" : " << writeError << std::endl;
+        return false;
+    }
+
+    if(verbose)
+    {
+        const std::chrono::high_resolution_clock::time_point end
+            = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<float, std::milli> duration = end - start;
+
+        std::cout << std::endl;
+        std::cout << "Streaming by blocks of " << blockSize << " scanlines took: "
+                  << duration.count()
+                  <<  " ms" << std::endl;
+    }
+
+    return true;
+}
+
+
+// Replace the '#' characters of the pattern by the zero-padded frame number.
+
+std::string ExpandFramePattern(const std::string & pattern, int frame)
+{
+    const size_t first = pattern.find('#');
+    if(first == std::string::npos)
+    {
+        return pattern;
+    }
+
+    size_t last = pattern.find_first_not_of('#', first);
+    if(last == std::string::npos)
+    {
+        last = pattern.size();
+    }
+
+    std::ostringstream oss;
+    oss << pattern.substr(0, first)
+        << std::setw(int(last - first)) << std::setfill('0') << frame
+        << pattern.substr(last);
+    return oss.str();
+}
+
+// Parse the frame ranges (e.g. "1001-1100,1200")
+// return true on success
+
+bool ParseFrameRanges(std::vector<int> & frameNumbers, const std::string & frameRanges)
+{
+    std::stringstream ss(frameRanges);
+    std::string range;
+    while(std::getline(ss, range, ','))
+    {
+        int first = 0, last = 0;
+
+        // Skip the first character so negative frame numbers are parsed.
+        const size_t pos = range.find('-', 1);
+        if(pos == std::string::npos)
+        {
+            if(!StringToInt(&first, range.c_str())) return false;
+            last = first;
+        }
+        else if(!StringToInt(&first, range.substr(0, pos).c_str())
+                || !StringToInt(&last, range.substr(pos + 1).c_str()))
+        {
+            return false;
+        }
+
+        if(last < first) return false;
+
+        for(int frame = first; frame <= last; ++frame)
+        {
+            frameNumbers.push_back(frame);
+        }
+    }
+    return !frameNumbers.empty();
+}
+
+// Get the input and output images of the batch mode
+// return false on errors
+
+bool GetFrameList(FrameList & frames,
+                  const std::string & frameRanges,
+                  const std::string & fileList,
+                  const std::string & inputPattern,
+                  const std::string & outputPattern)
+{
+    if(!fileList.empty())
+    {
+        std::ifstream file(fileList.c_str());
+        if(!file)
+        {
+            std::cerr << "Error: Could not open the file list '" << fileList << "'\n";
+            return false;
+        }
+
+        std::string line;
+        while(std::getline(file, line))
+        {
+            std::istringstream iss(line);
+            std::string inputimage, outputimage;
+            if(!(iss >> inputimage))
+            {
+                // Skip empty lines.
+                continue;
+            }
+            if(!(iss >> outputimage))
+            {
+                std::cerr << "Error: file list line '" << line
+                          << "' should be in the form inputimage outputimage\n";
+                return false;
+            }
+            frames.push_back(std::make_pair(inputimage, outputimage));
+        }
+
+        if(frames.empty())
+        {
+            std::cerr << "Error: the file list '" << fileList << "' has no images\n";
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<int> frameNumbers;
+    if(!ParseFrameRanges(frameNumbers, frameRanges))
+    {
+        std::cerr << "Error: --frames: '" << frameRanges
+                  << "' should be comma-separated frame numbers or first-last ranges\n";
+        return false;
+    }
+
+    if(inputPattern.find('#') == std::string::npos || outputPattern.find('#') == std::string::npos)
+    {
+        std::cerr << "Error: --frames needs '#' characters in the image names\n";
+        return false;
+    }
+
+    for(const int frame : frameNumbers)
+    {
+        frames.push_back(std::make_pair(ExpandFramePattern(inputPattern, frame),
+                                        ExpandFramePattern(outputPattern, frame)));
+    }
+    return true;
+}
+
+// CPU processors of the batch frames, built once per image bit-depth and shared
+// by all the worker threads.
+class BatchProcessors
+{
+public:
+    explicit BatchProcessors(const OCIO::ConstProcessorRcPtr & processor)
+        :   m_processor(processor)
+    {
+    }
+
+    OCIO::ConstCPUProcessorRcPtr get(OCIO::BitDepth bitDepth)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        OCIO::ConstCPUProcessorRcPtr & cpuProcessor = m_cpuProcessors[bitDepth];
+        if(!cpuProcessor)
+        {
+            cpuProcessor = m_processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                                                 OCIO::OPTIMIZATION_DEFAULT,
+                                                                 OCIO::FINALIZATION_DEFAULT);
+        }
+        return cpuProcessor;
+    }
+
+private:
+    OCIO::ConstProcessorRcPtr m_processor;
+    std::mutex m_mutex;
+    std::map<OCIO::BitDepth, OCIO::ConstCPUProcessorRcPtr> m_cpuProcessors;
+};
+
+// Convert one image of the batch
+// return an error message on failure
+
+std::string ConvertFrame(const std::string & inputimage,
+                         const std::string & outputimage,
+                         BatchProcessors & processors,
+                         const std::vector<std::string> & floatAttrs,
+                         const std::vector<std::string> & intAttrs,
+                         const std::vector<std::string> & stringAttrs)
+{
 #if OIIO_VERSION < 10903
-        OIIO::ImageOutput::destroy(f);
+    OIIO::ImageInput* in = OIIO::ImageInput::create(inputimage);
+#else
+    auto in = OIIO::ImageInput::create(inputimage);
 #endif
+    OIIO::ImageSpec spec;
+    if(!in || !in->open(inputimage, spec))
+    {
+        const std::string error = "Error loading \"" + inputimage + "\" : "
+                                  + (in ? in->geterror() : OIIO::geterror());
+#if OIIO_VERSION < 10903
+        if(in)
+        {
+            OIIO::ImageInput::destroy(in);
+        }
+#endif
+        return error;
     }
-    catch(...)
+
+    OCIO::ImgBuffer img(spec);
+    const bool ok = in->read_image(spec.format, img.getBuffer());
+    const std::string readError = in->geterror();
+    in->close();
+#if OIIO_VERSION < 10903
+    OIIO::ImageInput::destroy(in);
+#endif
+    if(!ok)
     {
-        std::cerr << "Error writing file.";
-        exit(1);
+        return "Error reading \"" + inputimage + "\" : " + readError;
     }
-    
-    std::cout << std::endl;
-    std::cout << "Wrote " << outputimage << std::endl;
-    
-    return 0;
+
+    try
+    {
+        OCIO::ImageDescRcPtr imgDesc = OCIO::CreateImageDesc(spec, img);
+        processors.get(OCIO::GetBitDepth(spec))->apply(*imgDesc);
+    }
+    catch(OCIO::Exception & exception)
+    {
+        return std::string("OCIO Error: ") + exception.what();
+    }
+
+    // The attributes were already validated.
+    SetAttributes(spec, floatAttrs, intAttrs, stringAttrs);
+
+#if OIIO_VERSION < 10903
+    OIIO::ImageOutput* out = OIIO::ImageOutput::create(outputimage);
+#else
+    auto out = OIIO::ImageOutput::create(outputimage);
+#endif
+    if(!out)
+    {
+        return "Error writing \"" + outputimage + "\" : " + OIIO::geterror();
+    }
+
+    const bool written = out->open(outputimage, spec)
+                         && out->write_image(spec.format, img.getBuffer());
+    const std::string writeError = written ? "" : out->geterror();
+    out->close();
+#if OIIO_VERSION < 10903
+    OIIO::ImageOutput::destroy(out);
+#endif
+    if(!written)
+    {
+        return "Error writing \"" + outputimage + "\" : " + writeError;
+    }
+
+    return "";
+}
+
+// Convert all the frames using a pool of worker threads, each one reading, processing
+// and writing its own frames so the I/O of a frame overlaps the processing of the others.
+// Only one image per worker is in memory.
+// return the number of frames which failed
+
+size_t ConvertFrames(const FrameList & frames,
+                     const OCIO::ConstProcessorRcPtr & processor,
+                     const std::vector<std::string> & floatAttrs,
+                     const std::vector<std::string> & intAttrs,
+                     const std::vector<std::string> & stringAttrs,
+                     int numThreads,
+                     bool verbose)
+{
+    if(numThreads <= 0)
+    {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, (int)frames.size());
+
+    if(verbose)
+    {
+        std::cout << std::endl;
+        std::cout << "Converting " << frames.size() << " frames using "
+                  << numThreads << " threads" << std::endl;
+    }
+
+    BatchProcessors processors(processor);
+
+    std::atomic<size_t> nextFrame(0);
+    std::atomic<size_t> numErrors(0);
+    std::mutex outputMutex;
+
+    const std::chrono::high_resolution_clock::time_point start
+        = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> workers;
+    for(int idx = 0; idx < numThreads; ++idx)
+    {
+        workers.emplace_back([&]()
+        {
+            for(size_t frame = nextFrame++; frame < frames.size(); frame = nextFrame++)
+            {
+                const std::string error = ConvertFrame(frames[frame].first,
+                                                       frames[frame].second,
+                                                       processors,
+                                                       floatAttrs, intAttrs, stringAttrs);
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                if(error.empty())
+                {
+                    std::cout << "Wrote " << frames[frame].second << std::endl;
+                }
+                else
+                {
+                    std::cerr << error << std::endl;
+                    ++numErrors;
+                }
+            }
+        });
+    }
+
+    for(auto & worker : workers)
+    {
+        worker.join();
+    }
+
+    if(verbose)
+    {
+        const std::chrono::high_resolution_clock::time_point end
+            = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<float, std::milli> duration = end - start;
+
+        std::cout << std::endl;
+        std::cout << "Batch conversion took: " 
+                  << duration.count()
+                  <<  " ms" << std::endl;
+    }
+
+    return numErrors;
 }
 
 
@@ -256,6 +256,9 @@ int main(int argc, const char **argv)
     std::string filepath;
     unsigned iterations = 10;
     std::string outBitDepthStr("auto");
+    bool stats = false;
+    bool runs = false;
+    bool cache = false;
 
     bool help = false;
 
@@ -266,7 +269,8 @@ int main(int argc, const char **argv)
                "--v", &verbose, "Display some general information",
                "--test %d", &testType, "Define the type of processing to measure: "\
                                        "0 means on the complete image (the default), 1 is line-by-line, "\
-                                       "2 is pixel-per-pixel and -1 performs all the test types",
+                                       "2 is pixel-per-pixel, 3 is the GPU shader program extraction "\
+                                       "(no image needed) and -1 performs all the test types",
                "--transform %s", &transformFile, "Provide the transform file to apply on the image",
                "--colorspaces %s %s", &inputColorSpace, &outputColorSpace,
                                       "Provide the input and output color spaces to apply on the image",
@@ -274,6 +278,9 @@ int main(int argc, const char **argv)
                "--iter %d", &iterations, "Provide the number of iterations on the processing. Default is 10",
                "--out %s", &outBitDepthStr, "Provide an output bit-depth (auto, ui16, f32)"\
                                             " where auto preserves the input bit-depth",
+               "--stats", &stats, "Display the per-op statistics of the processing as JSON",
+               "--runs", &runs, "Only process once the runs of identical pixels of each line",
+               "--cache", &cache, "Cache the processed colors and display the cache hit rate",
                NULL);
 
     if(ap.parse (argc, argv) < 0) {
@@ -314,7 +321,10 @@ int main(int argc, const char **argv)
 
     OIIO::ImageSpec spec;
     OCIO::ImgBuffer img;
-    LoadImage(filepath, verbose, spec, img);
+    if(testType!=3)
+    {
+        LoadImage(filepath, verbose, spec, img);
+    }
 
     outBitDepthStr = pystring::lower(outBitDepthStr);
 
@@ -365,6 +375,34 @@ int main(int argc, const char **argv)
             throw OCIO::Exception("Missing color transformation description.");
         }
 
+        if(testType==3 || testType==-1)
+        {
+            // Extract the GPU shader program (e.g. as an application UI thread does
+            // when the view changes).  The shader program cache is cleared before
+            // each iteration to always measure the complete extraction.
+
+            Measure m("Extract the GPU shader program:", iterations);
+
+            OCIO::ConstGPUProcessorRcPtr gpuProcessor = processor->getDefaultGPUProcessor();
+
+            for(unsigned iter=0; iter<iterations; ++iter)
+            {
+                OCIO::ClearAllCaches();
+
+                OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+                shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+
+                m.resume();
+                gpuProcessor->extractGpuShaderInfo(shaderDesc);
+                m.pause();
+            }
+
+            if(testType==3)
+            {
+                return 0;
+            }
+        }
+
         const OCIO::BitDepth inBitDepth  = OCIO::GetBitDepth(spec);
         OCIO::BitDepth outBitDepth = inBitDepth;
         if(outBitDepthStr=="f32")
@@ -383,10 +421,24 @@ int main(int argc, const char **argv)
         }
 
         // Get the CPU processor.
+        unsigned fFlags = OCIO::FINALIZATION_DEFAULT;
+        if(stats)
+        {
+            fFlags |= OCIO::FINALIZATION_STATISTICS;
+        }
+        if(runs)
+        {
+            fFlags |= OCIO::FINALIZATION_RUN_DETECTION;
+        }
+        if(cache)
+        {
+            fFlags |= OCIO::FINALIZATION_COLOR_CACHE;
+        }
+
         OCIO::ConstCPUProcessorRcPtr cpuProcessor
             = processor->getOptimizedCPUProcessor(inBitDepth, outBitDepth,
                                                   OCIO::OPTIMIZATION_DEFAULT,
-                                                  OCIO::FINALIZATION_DEFAULT);
+                                                  (OCIO::FinalizationFlags)fFlags);
 
         if(testType==0 || testType==-1)
         {
@@ -476,6 +528,27 @@ int main(int argc, const char **argv)
                 }
             }
         }
+
+        if(stats)
+        {
+            std::cout << std::endl;
+            cpuProcessor->serializeStatistics(std::cout);
+        }
+
+        if(runs)
+        {
+            std::cout << std::endl
+                      << "Run detection: " << cpuProcessor->getRunDetectionNumLines()
+                      << " lines processed once per run" << std::endl;
+        }
+
+        if(cache)
+        {
+            std::cout << std::endl
+                      << "Color cache: " << cpuProcessor->getColorCacheNumHits()
+                      << " hits for " << cpuProcessor->getColorCacheNumLookups()
+                      << " lookups" << std::endl;
+        }
     }
     catch(OCIO::Exception & exception)
     {
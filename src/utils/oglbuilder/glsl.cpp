@@ -78,15 +78,67 @@ namespace
         glTexParameteri(textureType, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     }
 
+    // Get the OpenGL internal format and data type of the texture values.
+    void GetTextureFormat(GpuShaderDesc::TextureFormat format,
+                          GLint & internalFormat, GLenum & type)
+    {
+        switch(format)
+        {
+            case GpuShaderDesc::TEXTURE_FORMAT_FLOAT16:
+                internalFormat = GL_RGB16F_ARB;
+                type = GL_HALF_FLOAT;
+                break;
+            case GpuShaderDesc::TEXTURE_FORMAT_UNORM16:
+                internalFormat = GL_RGB16;
+                type = GL_UNSIGNED_SHORT;
+                break;
+            case GpuShaderDesc::TEXTURE_FORMAT_FLOAT32:
+            default:
+                internalFormat = GL_RGB32F_ARB;
+                type = GL_FLOAT;
+                break;
+        }
+    }
+
+    // The texture rows are only aligned on the size of a value (e.g. a row of
+    // 33 16-bit RGB texels is 198 bytes) whereas the host could have set any
+    // unpack alignment (e.g. 4 bytes), so adjust it during the upload.
+    class UnpackAlignment
+    {
+    public:
+        explicit UnpackAlignment(GLenum type)
+        {
+            glGetIntegerv(GL_UNPACK_ALIGNMENT, &m_previous);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, type==GL_FLOAT ? 4 : 2);
+        }
+
+        ~UnpackAlignment()
+        {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, m_previous);
+        }
+
+    private:
+        UnpackAlignment() = delete;
+        UnpackAlignment(const UnpackAlignment &) = delete;
+        UnpackAlignment & operator=(const UnpackAlignment &) = delete;
+
+        GLint m_previous = 4;
+    };
+
     void AllocateTexture3D(unsigned index, unsigned & texId, 
                            Interpolation interpolation,
-                           unsigned edgelen, const float * values)
+                           GpuShaderDesc::TextureFormat format,
+                           unsigned edgelen, const void * values)
     {
         if(values==0x0)
         {
             throw Exception("Missing texture data");
         }
 
+        GLint internalFormat = GL_RGB32F_ARB;
+        GLenum type = GL_FLOAT;
+        GetTextureFormat(format, internalFormat, type);
+
         glGenTextures(1, &texId);
         
         glActiveTexture(GL_TEXTURE0 + index);
@@ -95,29 +147,37 @@ namespace
 
         SetTextureParameters(GL_TEXTURE_3D, interpolation);
 
-        glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB32F_ARB,
-                     edgelen, edgelen, edgelen, 0, GL_RGB, GL_FLOAT, values);
+        UnpackAlignment alignment(type);
+        glTexImage3D(GL_TEXTURE_3D, 0, internalFormat,
+                     edgelen, edgelen, edgelen, 0, GL_RGB, type, values);
     }
 
     void AllocateTexture2D(unsigned index, unsigned & texId, unsigned width, unsigned height,
-                           Interpolation interpolation, const float * values)
+                           Interpolation interpolation,
+                           GpuShaderDesc::TextureFormat format, const void * values)
     {
         if(values==0x0)
         {
             throw Exception("Missing texture data");
         }
 
+        GLint internalFormat = GL_RGB32F_ARB;
+        GLenum type = GL_FLOAT;
+        GetTextureFormat(format, internalFormat, type);
+
         glGenTextures(1, &texId);
 
         glActiveTexture(GL_TEXTURE0 + index);
 
+        UnpackAlignment alignment(type);
+
         if(height>1)
         {
             glBindTexture(GL_TEXTURE_2D, texId);
 
             SetTextureParameters(GL_TEXTURE_2D, interpolation);
 
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F_ARB, width, height, 0, GL_RGB, GL_FLOAT, values);
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_RGB, type, values);
         }
         else
         {
@@ -125,7 +185,7 @@ namespace
 
             SetTextureParameters(GL_TEXTURE_1D, interpolation);
 
-            glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB32F_ARB, width, 0, GL_RGB, GL_FLOAT, values);
+            glTexImage1D(GL_TEXTURE_1D, 0, internalFormat, width, 0, GL_RGB, type, values);
         }
     }
 
@@ -283,8 +343,20 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
             throw Exception("The texture data is corrupted");
         }
 
-        const float* values = 0x0;
-        m_shaderDesc->get3DTextureValues(idx, values);
+        const GpuShaderDesc::TextureFormat format = m_shaderDesc->getTextureFormat();
+
+        const void * values = 0x0;
+        if(format==GpuShaderDesc::TEXTURE_FORMAT_FLOAT32)
+        {
+            const float * floatValues = 0x0;
+            m_shaderDesc->get3DTextureValues(idx, floatValues);
+            values = floatValues;
+        }
+        else
+        {
+            m_shaderDesc->get3DTexturePackedValues(idx, values);
+        }
+
         if(!values)
         {
             throw Exception("The texture values are missing");
@@ -293,7 +365,7 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
         // 2. Allocate the 3D LUT.
 
         unsigned texId = 0;
-        AllocateTexture3D(currIndex, texId, interpolation, edgelen, values);
+        AllocateTexture3D(currIndex, texId, interpolation, format, edgelen, values);
 
         // 3. Keep the texture id & name for the later enabling.
 
@@ -322,8 +394,20 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
             throw Exception("The texture data is corrupted");
         }
 
-        const float * values = 0x0;
-        m_shaderDesc->getTextureValues(idx, values);
+        const GpuShaderDesc::TextureFormat format = m_shaderDesc->getTextureFormat();
+
+        const void * values = 0x0;
+        if(format==GpuShaderDesc::TEXTURE_FORMAT_FLOAT32)
+        {
+            const float * floatValues = 0x0;
+            m_shaderDesc->getTextureValues(idx, floatValues);
+            values = floatValues;
+        }
+        else
+        {
+            m_shaderDesc->getTexturePackedValues(idx, values);
+        }
+
         if(!values)
         {
             throw Exception("The texture values are missing");
@@ -332,7 +416,7 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
         // 2. Allocate the 1D LUT (a 2D texture is needed to hold large LUTs).
 
         unsigned texId = 0;
-        AllocateTexture2D(currIndex, texId, width, height, interpolation, values);
+        AllocateTexture2D(currIndex, texId, width, height, interpolation, format, values);
 
         // 3. Keep the texture id & name for the later enabling.
 
@@ -0,0 +1,1391 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#ifdef OCIO_UNIT_TEST
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "GpuShaderEvaluator.h"
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+void ThrowError(const std::string & msg)
+{
+    std::string err("GPU shader evaluator: ");
+    err += msg;
+    throw Exception(err.c_str());
+}
+
+
+//
+// Values
+//
+
+struct Value
+{
+    enum Kind
+    {
+        KIND_BOOL = 0,
+        KIND_INT,
+        KIND_FLOAT
+    };
+
+    Kind m_kind = KIND_FLOAT;
+    // 1 for scalars, 2 to 4 for vectors and 16 for the 4x4 matrices.
+    unsigned m_size = 1;
+    // Matrices are column-major as in GLSL.
+    float m_v[16] = { 0.0f };
+
+    float get(unsigned idx) const
+    {
+        // Scalars are broadcast to any size.
+        return m_v[m_size == 1 ? 0 : idx];
+    }
+};
+
+Value MakeScalar(float v, Value::Kind kind = Value::KIND_FLOAT)
+{
+    Value res;
+    res.m_kind = kind;
+    res.m_v[0] = v;
+    return res;
+}
+
+bool IsTypeName(const std::string & name)
+{
+    return name == "float" || name == "int" || name == "bool"
+        || name == "vec2" || name == "vec3" || name == "vec4" || name == "mat4";
+}
+
+Value MakeValue(const std::string & type)
+{
+    Value res;
+    if (type == "float")     { res.m_kind = Value::KIND_FLOAT; res.m_size = 1;  }
+    else if (type == "int")  { res.m_kind = Value::KIND_INT;   res.m_size = 1;  }
+    else if (type == "bool") { res.m_kind = Value::KIND_BOOL;  res.m_size = 1;  }
+    else if (type == "vec2") { res.m_kind = Value::KIND_FLOAT; res.m_size = 2;  }
+    else if (type == "vec3") { res.m_kind = Value::KIND_FLOAT; res.m_size = 3;  }
+    else if (type == "vec4") { res.m_kind = Value::KIND_FLOAT; res.m_size = 4;  }
+    else if (type == "mat4") { res.m_kind = Value::KIND_FLOAT; res.m_size = 16; }
+    else
+    {
+        ThrowError("Unsupported type '" + type + "'.");
+    }
+    return res;
+}
+
+float ConvertTo(Value::Kind kind, float v)
+{
+    switch (kind)
+    {
+        case Value::KIND_BOOL:  return v != 0.0f ? 1.0f : 0.0f;
+        case Value::KIND_INT:   return std::trunc(v);
+        case Value::KIND_FLOAT:
+        default:                return v;
+    }
+}
+
+// Assign a value to a variable of a given type (i.e. with the implicit conversions).
+void Assign(Value & dst, const Value & src)
+{
+    if (dst.m_size != src.m_size)
+    {
+        ThrowError("Cannot assign values of different sizes.");
+    }
+    for (unsigned idx = 0; idx < dst.m_size; ++idx)
+    {
+        dst.m_v[idx] = ConvertTo(dst.m_kind, src.m_v[idx]);
+    }
+}
+
+// Type constructors e.g. float(j == 1), vec3(0.5) or mat4(...).
+Value Construct(const std::string & type, const std::vector<Value> & args)
+{
+    Value res = MakeValue(type);
+
+    if (args.size() == 1 && args[0].m_size == 1)
+    {
+        const float v = ConvertTo(res.m_kind, args[0].m_v[0]);
+        if (res.m_size == 16)
+        {
+            // Diagonal matrix.
+            for (unsigned idx = 0; idx < 4; ++idx) res.m_v[idx * 5] = v;
+        }
+        else
+        {
+            for (unsigned idx = 0; idx < res.m_size; ++idx) res.m_v[idx] = v;
+        }
+        return res;
+    }
+
+    unsigned num = 0;
+    for (const auto & arg : args)
+    {
+        for (unsigned idx = 0; idx < arg.m_size && num < res.m_size; ++idx)
+        {
+            res.m_v[num++] = ConvertTo(res.m_kind, arg.m_v[idx]);
+        }
+    }
+
+    if (num != res.m_size)
+    {
+        ThrowError("Not enough values to construct a " + type + ".");
+    }
+
+    return res;
+}
+
+int SwizzleIndex(char c)
+{
+    switch (c)
+    {
+        case 'x': case 'r': case 's': return 0;
+        case 'y': case 'g': case 't': return 1;
+        case 'z': case 'b': case 'p': return 2;
+        case 'w': case 'a': case 'q': return 3;
+        default:
+        {
+            ThrowError(std::string("Invalid swizzle component '") + c + "'.");
+        }
+    }
+    return -1;
+}
+
+Value Swizzle(const Value & val, const std::string & swizzle)
+{
+    if (val.m_size > 4 || swizzle.empty() || swizzle.size() > 4)
+    {
+        ThrowError("Invalid swizzle '" + swizzle + "'.");
+    }
+
+    Value res;
+    res.m_kind = val.m_kind;
+    res.m_size = (unsigned)swizzle.size();
+    for (unsigned idx = 0; idx < res.m_size; ++idx)
+    {
+        const unsigned comp = (unsigned)SwizzleIndex(swizzle[idx]);
+        if (comp >= val.m_size)
+        {
+            ThrowError("Swizzle '" + swizzle + "' out of range.");
+        }
+        res.m_v[idx] = val.m_v[comp];
+    }
+    return res;
+}
+
+unsigned ResultSize(const Value & a, const Value & b)
+{
+    if (a.m_size != b.m_size && a.m_size != 1 && b.m_size != 1)
+    {
+        ThrowError("Incompatible operand sizes.");
+    }
+    return std::max(a.m_size, b.m_size);
+}
+
+Value Arithmetic(const std::string & op, const Value & a, const Value & b)
+{
+    if (op == "*" && a.m_size == 16 && b.m_size == 4)
+    {
+        Value res;
+        res.m_size = 4;
+        for (unsigned row = 0; row < 4; ++row)
+        {
+            float sum = 0.0f;
+            for (unsigned col = 0; col < 4; ++col)
+            {
+                sum += a.m_v[col * 4 + row] * b.m_v[col];
+            }
+            res.m_v[row] = sum;
+        }
+        return res;
+    }
+
+    if (a.m_size == 16 || b.m_size == 16)
+    {
+        ThrowError("Unsupported matrix operation '" + op + "'.");
+    }
+
+    Value res;
+    res.m_size = ResultSize(a, b);
+    res.m_kind = (a.m_kind == Value::KIND_INT && b.m_kind == Value::KIND_INT)
+                     ? Value::KIND_INT : Value::KIND_FLOAT;
+
+    for (unsigned idx = 0; idx < res.m_size; ++idx)
+    {
+        const float x = a.get(idx);
+        const float y = b.get(idx);
+
+        float v = 0.0f;
+        if (op == "+")      v = x + y;
+        else if (op == "-") v = x - y;
+        else if (op == "*") v = x * y;
+        else if (op == "/") v = x / y;
+        else
+        {
+            ThrowError("Unsupported operator '" + op + "'.");
+        }
+
+        res.m_v[idx] = ConvertTo(res.m_kind, v);
+    }
+
+    return res;
+}
+
+Value Comparison(const std::string & op, const Value & a, const Value & b)
+{
+    if (op == "==" || op == "!=")
+    {
+        if (a.m_size != b.m_size)
+        {
+            ThrowError("Incompatible operand sizes.");
+        }
+        bool equal = true;
+        for (unsigned idx = 0; idx < a.m_size; ++idx)
+        {
+            equal = equal && (a.m_v[idx] == b.m_v[idx]);
+        }
+        return MakeScalar((op == "==") == equal ? 1.0f : 0.0f, Value::KIND_BOOL);
+    }
+
+    if (a.m_size != 1 || b.m_size != 1)
+    {
+        ThrowError("Operator '" + op + "' only applies to scalars.");
+    }
+
+    const float x = a.m_v[0];
+    const float y = b.m_v[0];
+
+    bool res = false;
+    if (op == "<")       res = x < y;
+    else if (op == ">")  res = x > y;
+    else if (op == "<=") res = x <= y;
+    else if (op == ">=") res = x >= y;
+    else
+    {
+        ThrowError("Unsupported operator '" + op + "'.");
+    }
+
+    return MakeScalar(res ? 1.0f : 0.0f, Value::KIND_BOOL);
+}
+
+float Sign(float x)
+{
+    return x > 0.0f ? 1.0f : (x < 0.0f ? -1.0f : 0.0f);
+}
+
+float Pow(float x, float y)
+{
+    // Undefined for negative values in GLSL, which the GPUs compute as exp2(y * log2(x)).
+    return x < 0.0f ? std::numeric_limits<float>::quiet_NaN() : std::pow(x, y);
+}
+
+typedef float (*UnaryFunc)(float);
+typedef float (*BinaryFunc)(float, float);
+
+const std::map<std::string, UnaryFunc> & GetUnaryFunctions()
+{
+    static const std::map<std::string, UnaryFunc> funcs = {
+        { "abs",   [](float x) { return std::fabs(x); } },
+        { "sign",  Sign },
+        { "floor", [](float x) { return std::floor(x); } },
+        { "ceil",  [](float x) { return std::ceil(x); } },
+        { "fract", [](float x) { return x - std::floor(x); } },
+        { "sqrt",  [](float x) { return std::sqrt(x); } },
+        { "inversesqrt", [](float x) { return 1.0f / std::sqrt(x); } },
+        { "exp",   [](float x) { return std::exp(x); } },
+        { "exp2",  [](float x) { return std::exp2(x); } },
+        { "log",   [](float x) { return std::log(x); } },
+        { "log2",  [](float x) { return std::log2(x); } },
+        { "sin",   [](float x) { return std::sin(x); } },
+        { "cos",   [](float x) { return std::cos(x); } },
+        { "tan",   [](float x) { return std::tan(x); } },
+        { "atan",  [](float x) { return std::atan(x); } }
+    };
+    return funcs;
+}
+
+const std::map<std::string, BinaryFunc> & GetBinaryFunctions()
+{
+    static const std::map<std::string, BinaryFunc> funcs = {
+        { "pow",  Pow },
+        { "min",  [](float x, float y) { return std::min(x, y); } },
+        { "max",  [](float x, float y) { return std::max(x, y); } },
+        { "step", [](float edge, float x) { return x < edge ? 0.0f : 1.0f; } },
+        { "atan", [](float y, float x) { return std::atan2(y, x); } },
+        { "mod",  [](float x, float y) { return x - y * std::floor(x / y); } }
+    };
+    return funcs;
+}
+
+// Evaluate a built-in function i.e. returns false if the function does not exist.
+bool CallBuiltin(const std::string & name, const std::vector<Value> & args, Value & res)
+{
+    if (args.size() == 1)
+    {
+        const auto & funcs = GetUnaryFunctions();
+        const auto it = funcs.find(name);
+        if (it != funcs.end())
+        {
+            res = args[0];
+            res.m_kind = Value::KIND_FLOAT;
+            for (unsigned idx = 0; idx < res.m_size; ++idx)
+            {
+                res.m_v[idx] = it->second(args[0].m_v[idx]);
+            }
+            return true;
+        }
+    }
+    else if (args.size() == 2)
+    {
+        const auto & funcs = GetBinaryFunctions();
+        const auto it = funcs.find(name);
+        if (it != funcs.end())
+        {
+            res = Value();
+            res.m_size = ResultSize(args[0], args[1]);
+            for (unsigned idx = 0; idx < res.m_size; ++idx)
+            {
+                res.m_v[idx] = it->second(args[0].get(idx), args[1].get(idx));
+            }
+            return true;
+        }
+
+        if (name == "dot")
+        {
+            if (args[0].m_size != args[1].m_size)
+            {
+                ThrowError("Incompatible operand sizes.");
+            }
+            float sum = 0.0f;
+            for (unsigned idx = 0; idx < args[0].m_size; ++idx)
+            {
+                sum += args[0].m_v[idx] * args[1].m_v[idx];
+            }
+            res = MakeScalar(sum);
+            return true;
+        }
+
+        static const std::map<std::string, std::string> comparisons = {
+            { "greaterThan", ">" }, { "greaterThanEqual", ">=" },
+            { "lessThan", "<" },    { "lessThanEqual", "<=" }
+        };
+        const auto cmp = comparisons.find(name);
+        if (cmp != comparisons.end())
+        {
+            if (args[0].m_size != args[1].m_size)
+            {
+                ThrowError("Incompatible operand sizes.");
+            }
+            res = Value();
+            res.m_kind = Value::KIND_BOOL;
+            res.m_size = args[0].m_size;
+            for (unsigned idx = 0; idx < res.m_size; ++idx)
+            {
+                res.m_v[idx] = Comparison(cmp->second,
+                                          MakeScalar(args[0].m_v[idx]),
+                                          MakeScalar(args[1].m_v[idx])).m_v[0];
+            }
+            return true;
+        }
+    }
+    else if (args.size() == 3)
+    {
+        const unsigned size = std::max(ResultSize(args[0], args[1]),
+                                       ResultSize(args[1], args[2]));
+
+        if (name == "clamp" || name == "mix" || name == "smoothstep")
+        {
+            res = Value();
+            res.m_size = size;
+            for (unsigned idx = 0; idx < size; ++idx)
+            {
+                const float a = args[0].get(idx);
+                const float b = args[1].get(idx);
+                const float c = args[2].get(idx);
+
+                if (name == "clamp")
+                {
+                    res.m_v[idx] = std::min(std::max(a, b), c);
+                }
+                else if (name == "mix")
+                {
+                    res.m_v[idx] = a * (1.0f - c) + b * c;
+                }
+                else
+                {
+                    const float t = std::min(std::max((c - a) / (b - a), 0.0f), 1.0f);
+                    res.m_v[idx] = t * t * (3.0f - 2.0f * t);
+                }
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+//
+// Tokens
+//
+
+struct Token
+{
+    enum Type
+    {
+        TOKEN_IDENT = 0,
+        TOKEN_NUMBER,
+        TOKEN_SYMBOL,
+        TOKEN_END
+    };
+
+    Type m_type;
+    std::string m_text;
+};
+
+typedef std::vector<Token> Tokens;
+
+Tokens Tokenize(const std::string & text)
+{
+    static const char * twoCharSymbols[]
+        = { "==", "!=", "<=", ">=", "&&", "||", "+=", "-=", "*=", "/=" };
+
+    Tokens tokens;
+
+    const size_t size = text.size();
+    size_t pos = 0;
+    while (pos < size)
+    {
+        const char c = text[pos];
+        const char next = pos + 1 < size ? text[pos + 1] : '\0';
+
+        if (std::isspace((unsigned char)c))
+        {
+            ++pos;
+        }
+        else if ((c == '/' && next == '/') || c == '#')
+        {
+            // Comments & preprocessor directives.
+            pos = text.find('\n', pos);
+            pos = (pos == std::string::npos) ? size : pos;
+        }
+        else if (c == '/' && next == '*')
+        {
+            pos = text.find("*/", pos + 2);
+            pos = (pos == std::string::npos) ? size : pos + 2;
+        }
+        else if (std::isalpha((unsigned char)c) || c == '_')
+        {
+            const size_t start = pos;
+            while (pos < size && (std::isalnum((unsigned char)text[pos]) || text[pos] == '_'))
+            {
+                ++pos;
+            }
+            tokens.push_back({ Token::TOKEN_IDENT, text.substr(start, pos - start) });
+        }
+        else if (std::isdigit((unsigned char)c) || (c == '.' && std::isdigit((unsigned char)next)))
+        {
+            const size_t start = pos;
+            while (pos < size && (std::isdigit((unsigned char)text[pos]) || text[pos] == '.'))
+            {
+                ++pos;
+            }
+            if (pos < size && (text[pos] == 'e' || text[pos] == 'E'))
+            {
+                ++pos;
+                if (pos < size && (text[pos] == '+' || text[pos] == '-'))
+                {
+                    ++pos;
+                }
+                while (pos < size && std::isdigit((unsigned char)text[pos]))
+                {
+                    ++pos;
+                }
+            }
+            tokens.push_back({ Token::TOKEN_NUMBER, text.substr(start, pos - start) });
+
+            // Skip the float suffix.
+            if (pos < size && (text[pos] == 'f' || text[pos] == 'F'))
+            {
+                ++pos;
+            }
+        }
+        else
+        {
+            std::string symbol(1, c);
+            for (const char * s : twoCharSymbols)
+            {
+                if (c == s[0] && next == s[1])
+                {
+                    symbol = s;
+                    break;
+                }
+            }
+            tokens.push_back({ Token::TOKEN_SYMBOL, symbol });
+            pos += symbol.size();
+        }
+    }
+
+    tokens.push_back({ Token::TOKEN_END, "" });
+    return tokens;
+}
+
+
+//
+// Abstract syntax tree
+//
+
+struct Expr;
+typedef std::unique_ptr<Expr> ExprPtr;
+
+struct Expr
+{
+    enum Type
+    {
+        EXPR_CONSTANT = 0,
+        EXPR_VARIABLE,
+        EXPR_SWIZZLE,   // m_name is the swizzle of m_args[0]
+        EXPR_CALL,      // m_name is the function or type name
+        EXPR_UNARY,     // m_name is the operator
+        EXPR_BINARY,    // m_name is the operator
+        EXPR_TERNARY
+    };
+
+    Type m_type = EXPR_CONSTANT;
+    std::string m_name;
+    Value m_value;
+    std::vector<ExprPtr> m_args;
+};
+
+struct Stmt;
+typedef std::unique_ptr<Stmt> StmtPtr;
+typedef std::vector<StmtPtr> Stmts;
+
+struct Stmt
+{
+    enum Type
+    {
+        STMT_DECLARATION = 0,   // m_name of type m_typeName initialized with m_expr
+        STMT_ASSIGNMENT,        // m_lhs m_op m_expr
+        STMT_IF,                // if (m_expr) m_body[0] else m_body[1]
+        STMT_BLOCK,
+        STMT_RETURN,
+        STMT_EXPRESSION
+    };
+
+    Type m_type = STMT_BLOCK;
+    std::string m_typeName;
+    std::string m_name;
+    std::string m_op;
+    ExprPtr m_lhs;
+    ExprPtr m_expr;
+    Stmts m_body;
+};
+
+struct Function
+{
+    std::string m_returnType;
+    std::vector<std::pair<std::string, std::string>> m_params;  // Type & name.
+    Stmts m_body;
+};
+
+
+//
+// Parser
+//
+
+class Parser
+{
+public:
+    explicit Parser(const Tokens & tokens)
+        :   m_tokens(tokens)
+    {
+    }
+
+    const Token & peek(size_t ahead = 0) const
+    {
+        const size_t pos = std::min(m_pos + ahead, m_tokens.size() - 1);
+        return m_tokens[pos];
+    }
+
+    bool atEnd() const
+    {
+        return peek().m_type == Token::TOKEN_END;
+    }
+
+    bool isNext(const char * text) const
+    {
+        const Token & token = peek();
+        return token.m_type != Token::TOKEN_NUMBER && token.m_text == text;
+    }
+
+    bool accept(const char * text)
+    {
+        if (isNext(text))
+        {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const char * text)
+    {
+        if (!accept(text))
+        {
+            ThrowError(std::string("Expecting '") + text + "' instead of '"
+                       + peek().m_text + "'.");
+        }
+    }
+
+    std::string expectIdentifier()
+    {
+        const Token & token = peek();
+        if (token.m_type != Token::TOKEN_IDENT)
+        {
+            ThrowError("Expecting an identifier instead of '" + token.m_text + "'.");
+        }
+        ++m_pos;
+        return token.m_text;
+    }
+
+    // Skip the tokens up to the closing parenthesis e.g. 'layout(std140)'.
+    void skipParentheses()
+    {
+        expect("(");
+        while (!atEnd() && !accept(")"))
+        {
+            ++m_pos;
+        }
+    }
+
+    ExprPtr parseExpression()
+    {
+        ExprPtr cond = parseBinary(0);
+        if (accept("?"))
+        {
+            ExprPtr expr(new Expr);
+            expr->m_type = Expr::EXPR_TERNARY;
+            expr->m_args.push_back(std::move(cond));
+            expr->m_args.push_back(parseExpression());
+            expect(":");
+            expr->m_args.push_back(parseExpression());
+            return expr;
+        }
+        return cond;
+    }
+
+    StmtPtr parseStatement()
+    {
+        StmtPtr stmt(new Stmt);
+
+        if (accept("{"))
+        {
+            stmt->m_type = Stmt::STMT_BLOCK;
+            while (!accept("}"))
+            {
+                if (atEnd())
+                {
+                    ThrowError("Missing '}'.");
+                }
+                stmt->m_body.push_back(parseStatement());
+            }
+        }
+        else if (accept("if"))
+        {
+            stmt->m_type = Stmt::STMT_IF;
+            expect("(");
+            stmt->m_expr = parseExpression();
+            expect(")");
+            stmt->m_body.push_back(parseStatement());
+            if (accept("else"))
+            {
+                stmt->m_body.push_back(parseStatement());
+            }
+        }
+        else if (accept("return"))
+        {
+            stmt->m_type = Stmt::STMT_RETURN;
+            if (!isNext(";"))
+            {
+                stmt->m_expr = parseExpression();
+            }
+            expect(";");
+        }
+        else if (accept(";"))
+        {
+            stmt->m_type = Stmt::STMT_BLOCK;
+        }
+        else if (accept("const") || (IsTypeName(peek().m_text)
+                                     && peek(1).m_type == Token::TOKEN_IDENT))
+        {
+            stmt->m_type = Stmt::STMT_DECLARATION;
+            stmt->m_typeName = expectIdentifier();
+            stmt->m_name = expectIdentifier();
+            if (accept("="))
+            {
+                stmt->m_expr = parseExpression();
+            }
+            expect(";");
+        }
+        else
+        {
+            ExprPtr expr = parseExpression();
+
+            static const char * assignments[] = { "=", "+=", "-=", "*=", "/=" };
+            for (const char * op : assignments)
+            {
+                if (accept(op))
+                {
+                    if (expr->m_type != Expr::EXPR_VARIABLE
+                        && !(expr->m_type == Expr::EXPR_SWIZZLE
+                             && expr->m_args[0]->m_type == Expr::EXPR_VARIABLE))
+                    {
+                        ThrowError("Invalid assignment.");
+                    }
+
+                    stmt->m_type = Stmt::STMT_ASSIGNMENT;
+                    stmt->m_op = op;
+                    stmt->m_lhs = std::move(expr);
+                    stmt->m_expr = parseExpression();
+                    break;
+                }
+            }
+
+            if (stmt->m_type != Stmt::STMT_ASSIGNMENT)
+            {
+                stmt->m_type = Stmt::STMT_EXPRESSION;
+                stmt->m_expr = std::move(expr);
+            }
+            expect(";");
+        }
+
+        return stmt;
+    }
+
+private:
+    // Binary operators by increasing precedence.
+    ExprPtr parseBinary(unsigned level)
+    {
+        static const std::vector<std::vector<const char *>> operators = {
+            { "||" }, { "&&" }, { "==", "!=" }, { "<", ">", "<=", ">=" }, { "+", "-" }, { "*", "/" }
+        };
+
+        if (level == operators.size())
+        {
+            return parseUnary();
+        }
+
+        ExprPtr lhs = parseBinary(level + 1);
+
+        bool found = true;
+        while (found)
+        {
+            found = false;
+            for (const char * op : operators[level])
+            {
+                if (accept(op))
+                {
+                    ExprPtr expr(new Expr);
+                    expr->m_type = Expr::EXPR_BINARY;
+                    expr->m_name = op;
+                    expr->m_args.push_back(std::move(lhs));
+                    expr->m_args.push_back(parseBinary(level + 1));
+                    lhs = std::move(expr);
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        return lhs;
+    }
+
+    ExprPtr parseUnary()
+    {
+        if (accept("+"))
+        {
+            return parseUnary();
+        }
+
+        for (const char * op : { "-", "!" })
+        {
+            if (accept(op))
+            {
+                ExprPtr arg = parseUnary();
+                if (arg->m_type == Expr::EXPR_CONSTANT && op[0] == '-')
+                {
+                    // Fold the negative literals so they do not count as operations.
+                    arg->m_value.m_v[0] = -arg->m_value.m_v[0];
+                    return arg;
+                }
+
+                ExprPtr expr(new Expr);
+                expr->m_type = Expr::EXPR_UNARY;
+                expr->m_name = op;
+                expr->m_args.push_back(std::move(arg));
+                return expr;
+            }
+        }
+
+        ExprPtr expr = parsePrimary();
+        while (accept("."))
+        {
+            ExprPtr swizzle(new Expr);
+            swizzle->m_type = Expr::EXPR_SWIZZLE;
+            swizzle->m_name = expectIdentifier();
+            swizzle->m_args.push_back(std::move(expr));
+            expr = std::move(swizzle);
+        }
+        return expr;
+    }
+
+    ExprPtr parsePrimary()
+    {
+        ExprPtr expr(new Expr);
+
+        const Token token = peek();
+        if (token.m_type == Token::TOKEN_NUMBER)
+        {
+            ++m_pos;
+            const bool isFloat = token.m_text.find_first_of(".eE") != std::string::npos;
+            expr->m_type = Expr::EXPR_CONSTANT;
+            expr->m_value = MakeScalar((float)std::strtod(token.m_text.c_str(), nullptr),
+                                       isFloat ? Value::KIND_FLOAT : Value::KIND_INT);
+        }
+        else if (accept("("))
+        {
+            expr = parseExpression();
+            expect(")");
+        }
+        else if (accept("true") || accept("false"))
+        {
+            expr->m_type = Expr::EXPR_CONSTANT;
+            expr->m_value = MakeScalar(token.m_text == "true" ? 1.0f : 0.0f, Value::KIND_BOOL);
+        }
+        else
+        {
+            expr->m_name = expectIdentifier();
+            if (accept("("))
+            {
+                expr->m_type = Expr::EXPR_CALL;
+                if (!accept(")"))
+                {
+                    do
+                    {
+                        expr->m_args.push_back(parseExpression());
+                    }
+                    while (accept(","));
+                    expect(")");
+                }
+            }
+            else
+            {
+                expr->m_type = Expr::EXPR_VARIABLE;
+            }
+        }
+
+        return expr;
+    }
+
+    const Tokens & m_tokens;
+    size_t m_pos = 0;
+};
+
+} // anon.
+
+
+//
+// Evaluator
+//
+
+class GpuShaderEvaluator::Impl
+{
+public:
+    explicit Impl(const GpuShaderDescRcPtr & shaderDesc)
+        :   m_shaderDesc(shaderDesc)
+        ,   m_functionName(shaderDesc->getFunctionName())
+    {
+        switch (shaderDesc->getLanguage())
+        {
+            case GPU_LANGUAGE_GLSL_1_0:
+            case GPU_LANGUAGE_GLSL_1_3:
+            case GPU_LANGUAGE_GLSL_4_0:
+                break;
+            default:
+                ThrowError("Only the GLSL shader programs are supported.");
+        }
+
+        if (shaderDesc->getNumTextures() > 0 || shaderDesc->getNum3DTextures() > 0)
+        {
+            ThrowError("Shader programs using textures are not supported.");
+        }
+
+        parse(Tokenize(shaderDesc->getShaderText()));
+
+        if (m_functions.find(m_functionName) == m_functions.end())
+        {
+            ThrowError("Missing the shader function '" + m_functionName + "'.");
+        }
+    }
+
+    void apply(float * rgba, size_t numPixels)
+    {
+        // Global variables i.e. uniforms & constants.
+        m_scopes.assign(1, Scope());
+        m_frame = 0;
+        initGlobals();
+
+        const Function & func = m_functions.at(m_functionName);
+        if (func.m_params.size() != 1 || func.m_params[0].first != "vec4")
+        {
+            ThrowError("Unexpected signature of the shader function.");
+        }
+
+        for (size_t idx = 0; idx < numPixels; ++idx)
+        {
+            float * pix = rgba + 4 * idx;
+
+            Value in = MakeValue("vec4");
+            std::copy(pix, pix + 4, in.m_v);
+
+            m_numOperations = 0;
+            const Value out = call(m_functionName, { in });
+            if (out.m_size != 4)
+            {
+                ThrowError("The shader function must return a vec4.");
+            }
+            std::copy(out.m_v, out.m_v + 4, pix);
+        }
+    }
+
+    size_t m_numOperations = 0;
+
+private:
+    typedef std::map<std::string, Value> Scope;
+
+    struct Global
+    {
+        bool m_isUniform = false;
+        std::string m_typeName;
+        std::string m_name;
+        ExprPtr m_init;
+    };
+
+    void parse(const Tokens & tokens)
+    {
+        Parser parser(tokens);
+
+        while (!parser.atEnd())
+        {
+            if (parser.accept("layout"))
+            {
+                parser.skipParentheses();
+                continue;
+            }
+
+            bool isUniform = false;
+            if (parser.accept("uniform"))
+            {
+                isUniform = true;
+            }
+            else
+            {
+                parser.accept("const");
+            }
+
+            const std::string type = parser.expectIdentifier();
+            if (type.compare(0, 7, "sampler") == 0 || type.compare(0, 7, "texture") == 0)
+            {
+                ThrowError("Shader programs using textures are not supported.");
+            }
+
+            if (isUniform && parser.accept("{"))
+            {
+                // Uniform block i.e. its members are uniforms.
+                while (!parser.accept("}"))
+                {
+                    Global member;
+                    member.m_isUniform = true;
+                    member.m_typeName = parser.expectIdentifier();
+                    member.m_name = parser.expectIdentifier();
+                    parser.expect(";");
+                    m_globals.push_back(std::move(member));
+                }
+                parser.expect(";");
+                continue;
+            }
+
+            const std::string name = parser.expectIdentifier();
+
+            if (!isUniform && parser.accept("("))
+            {
+                Function & func = m_functions[name];
+                func.m_returnType = type;
+                if (!parser.accept(")"))
+                {
+                    do
+                    {
+                        if (parser.accept("out") || parser.accept("inout"))
+                        {
+                            ThrowError("Output parameters are not supported.");
+                        }
+                        parser.accept("in");
+                        const std::string paramType = parser.expectIdentifier();
+                        func.m_params.emplace_back(paramType, parser.expectIdentifier());
+                    }
+                    while (parser.accept(","));
+                    parser.expect(")");
+                }
+
+                StmtPtr body = parser.parseStatement();
+                if (body->m_type != Stmt::STMT_BLOCK)
+                {
+                    ThrowError("Invalid function body.");
+                }
+                func.m_body = std::move(body->m_body);
+                continue;
+            }
+
+            Global global;
+            global.m_isUniform = isUniform;
+            global.m_typeName = type;
+            global.m_name = name;
+            if (!isUniform && parser.accept("="))
+            {
+                global.m_init = parser.parseExpression();
+            }
+            parser.expect(";");
+            m_globals.push_back(std::move(global));
+        }
+    }
+
+    void initGlobals()
+    {
+        for (const auto & global : m_globals)
+        {
+            Value val = MakeValue(global.m_typeName);
+
+            if (global.m_isUniform)
+            {
+                bool found = false;
+                for (unsigned idx = 0; idx < m_shaderDesc->getNumUniforms() && !found; ++idx)
+                {
+                    const char * name = nullptr;
+                    DynamicPropertyRcPtr prop;
+                    m_shaderDesc->getUniform(idx, name, prop);
+                    if (global.m_name == name)
+                    {
+                        Assign(val, MakeScalar((float)prop->getDoubleValue()));
+                        found = true;
+                    }
+                }
+
+                if (!found)
+                {
+                    ThrowError("Missing the value of the uniform '" + global.m_name + "'.");
+                }
+            }
+            else if (global.m_init)
+            {
+                Assign(val, evaluate(*global.m_init));
+            }
+
+            m_scopes[0][global.m_name] = val;
+        }
+    }
+
+    Value & lookup(const std::string & name)
+    {
+        // Local variables of the current function then the global ones.
+        for (size_t idx = m_scopes.size(); idx > m_frame; --idx)
+        {
+            auto it = m_scopes[idx - 1].find(name);
+            if (it != m_scopes[idx - 1].end())
+            {
+                return it->second;
+            }
+        }
+
+        auto it = m_scopes[0].find(name);
+        if (it == m_scopes[0].end())
+        {
+            ThrowError("Unknown variable '" + name + "'.");
+        }
+        return it->second;
+    }
+
+    Value call(const std::string & name, const std::vector<Value> & args)
+    {
+        const Function & func = m_functions.at(name);
+        if (func.m_params.size() != args.size())
+        {
+            ThrowError("Wrong number of arguments for '" + name + "'.");
+        }
+
+        const size_t prevFrame = m_frame;
+        m_frame = m_scopes.size();
+        m_scopes.push_back(Scope());
+
+        for (size_t idx = 0; idx < args.size(); ++idx)
+        {
+            Value param = MakeValue(func.m_params[idx].first);
+            Assign(param, args[idx]);
+            m_scopes.back()[func.m_params[idx].second] = param;
+        }
+
+        Value res;
+        bool returned = false;
+        for (const auto & stmt : func.m_body)
+        {
+            if (execute(*stmt, res))
+            {
+                returned = true;
+                break;
+            }
+        }
+
+        m_scopes.resize(m_frame);
+        m_frame = prevFrame;
+
+        if (!returned)
+        {
+            ThrowError("Missing return statement in '" + name + "'.");
+        }
+
+        Value ret = MakeValue(func.m_returnType);
+        Assign(ret, res);
+        return ret;
+    }
+
+    // Returns true when a return statement was executed.
+    bool execute(const Stmt & stmt, Value & ret)
+    {
+        switch (stmt.m_type)
+        {
+            case Stmt::STMT_DECLARATION:
+            {
+                Value val = MakeValue(stmt.m_typeName);
+                if (stmt.m_expr)
+                {
+                    Assign(val, evaluate(*stmt.m_expr));
+                }
+                m_scopes.back()[stmt.m_name] = val;
+                return false;
+            }
+            case Stmt::STMT_ASSIGNMENT:
+            {
+                Value rhs = evaluate(*stmt.m_expr);
+                if (stmt.m_op != "=")
+                {
+                    ++m_numOperations;
+                    rhs = Arithmetic(stmt.m_op.substr(0, 1), evaluate(*stmt.m_lhs), rhs);
+                }
+
+                if (stmt.m_lhs->m_type == Expr::EXPR_VARIABLE)
+                {
+                    Assign(lookup(stmt.m_lhs->m_name), rhs);
+                }
+                else
+                {
+                    Value & var = lookup(stmt.m_lhs->m_args[0]->m_name);
+                    const std::string & swizzle = stmt.m_lhs->m_name;
+                    if (rhs.m_size != 1 && rhs.m_size != swizzle.size())
+                    {
+                        ThrowError("Cannot assign values of different sizes.");
+                    }
+                    for (size_t idx = 0; idx < swizzle.size(); ++idx)
+                    {
+                        const unsigned comp = (unsigned)SwizzleIndex(swizzle[idx]);
+                        if (comp >= var.m_size)
+                        {
+                            ThrowError("Swizzle '" + swizzle + "' out of range.");
+                        }
+                        var.m_v[comp] = ConvertTo(var.m_kind, rhs.get((unsigned)idx));
+                    }
+                }
+                return false;
+            }
+            case Stmt::STMT_IF:
+            {
+                const Value cond = evaluate(*stmt.m_expr);
+                if (cond.m_v[0] != 0.0f)
+                {
+                    return execute(*stmt.m_body[0], ret);
+                }
+                else if (stmt.m_body.size() > 1)
+                {
+                    return execute(*stmt.m_body[1], ret);
+                }
+                return false;
+            }
+            case Stmt::STMT_BLOCK:
+            {
+                m_scopes.push_back(Scope());
+                bool returned = false;
+                for (const auto & child : stmt.m_body)
+                {
+                    if (execute(*child, ret))
+                    {
+                        returned = true;
+                        break;
+                    }
+                }
+                m_scopes.pop_back();
+                return returned;
+            }
+            case Stmt::STMT_RETURN:
+            {
+                if (stmt.m_expr)
+                {
+                    ret = evaluate(*stmt.m_expr);
+                }
+                return true;
+            }
+            case Stmt::STMT_EXPRESSION:
+            {
+                evaluate(*stmt.m_expr);
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    Value evaluate(const Expr & expr)
+    {
+        switch (expr.m_type)
+        {
+            case Expr::EXPR_CONSTANT:
+            {
+                return expr.m_value;
+            }
+            case Expr::EXPR_VARIABLE:
+            {
+                return lookup(expr.m_name);
+            }
+            case Expr::EXPR_SWIZZLE:
+            {
+                return Swizzle(evaluate(*expr.m_args[0]), expr.m_name);
+            }
+            case Expr::EXPR_UNARY:
+            {
+                ++m_numOperations;
+                Value val = evaluate(*expr.m_args[0]);
+                for (unsigned idx = 0; idx < val.m_size; ++idx)
+                {
+                    val.m_v[idx] = (expr.m_name == "-") ? -val.m_v[idx]
+                                                        : (val.m_v[idx] == 0.0f ? 1.0f : 0.0f);
+                }
+                return val;
+            }
+            case Expr::EXPR_BINARY:
+            {
+                ++m_numOperations;
+                const std::string & op = expr.m_name;
+                const Value lhs = evaluate(*expr.m_args[0]);
+
+                if (op == "&&" || op == "||")
+                {
+                    // Short-circuit evaluation.
+                    const bool l = lhs.m_v[0] != 0.0f;
+                    if ((op == "&&" && !l) || (op == "||" && l))
+                    {
+                        return MakeScalar(l ? 1.0f : 0.0f, Value::KIND_BOOL);
+                    }
+                    const bool r = evaluate(*expr.m_args[1]).m_v[0] != 0.0f;
+                    return MakeScalar(r ? 1.0f : 0.0f, Value::KIND_BOOL);
+                }
+
+                const Value rhs = evaluate(*expr.m_args[1]);
+                if (op == "+" || op == "-" || op == "*" || op == "/")
+                {
+                    return Arithmetic(op, lhs, rhs);
+                }
+                return Comparison(op, lhs, rhs);
+            }
+            case Expr::EXPR_TERNARY:
+            {
+                ++m_numOperations;
+                const Value cond = evaluate(*expr.m_args[0]);
+                return evaluate(*expr.m_args[cond.m_v[0] != 0.0f ? 1 : 2]);
+            }
+            case Expr::EXPR_CALL:
+            {
+                std::vector<Value> args;
+                for (const auto & arg : expr.m_args)
+                {
+                    args.push_back(evaluate(*arg));
+                }
+
+                if (IsTypeName(expr.m_name))
+                {
+                    return Construct(expr.m_name, args);
+                }
+
+                if (m_functions.find(expr.m_name) != m_functions.end())
+                {
+                    return call(expr.m_name, args);
+                }
+
+                Value res;
+                if (!CallBuiltin(expr.m_name, args, res))
+                {
+                    ThrowError("Unsupported function '" + expr.m_name + "'.");
+                }
+                ++m_numOperations;
+                return res;
+            }
+        }
+
+        return Value();
+    }
+
+    const GpuShaderDescRcPtr m_shaderDesc;
+    const std::string m_functionName;
+
+    std::vector<Global> m_globals;
+    std::map<std::string, Function> m_functions;
+
+    std::vector<Scope> m_scopes;
+    // Index of the first scope of the function being executed.
+    size_t m_frame = 0;
+};
+
+GpuShaderEvaluator::GpuShaderEvaluator(const GpuShaderDescRcPtr & shaderDesc)
+    :   m_impl(new Impl(shaderDesc))
+{
+}
+
+GpuShaderEvaluator::~GpuShaderEvaluator()
+{
+}
+
+void GpuShaderEvaluator::apply(float * rgba, size_t numPixels)
+{
+    m_impl->apply(rgba, numPixels);
+}
+
+size_t GpuShaderEvaluator::getNumOperations() const
+{
+    return m_impl->m_numOperations;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif // OCIO_UNIT_TEST
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#ifndef INCLUDED_OCIO_GPUSHADEREVALUATOR_H
+#define INCLUDED_OCIO_GPUSHADEREVALUATOR_H
+
+#ifdef OCIO_UNIT_TEST
+
+#include <memory>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+OCIO_NAMESPACE_ENTER
+{
+
+// CPU evaluator of the GLSL shader programs produced by the GPU processors (i.e. the
+// subset of the language emitted by GpuShaderText) in order to validate the shader
+// programs against the CPU renderers without any GPU (e.g. on a headless build farm).
+//
+// Note: Only the analytical shader programs are supported so a shader program
+// using textures (e.g. LUTs) throws. All the computations are single precision.
+class GpuShaderEvaluator
+{
+public:
+    GpuShaderEvaluator() = delete;
+    GpuShaderEvaluator(const GpuShaderEvaluator &) = delete;
+    GpuShaderEvaluator & operator=(const GpuShaderEvaluator &) = delete;
+
+    // Parse the shader program of a finalized GLSL shader description.
+    explicit GpuShaderEvaluator(const GpuShaderDescRcPtr & shaderDesc);
+    ~GpuShaderEvaluator();
+
+    // Process packed RGBA pixels in place using the current uniform values.
+    void apply(float * rgba, size_t numPixels);
+
+    // Number of operations (i.e. arithmetic operators and built-in function calls)
+    // evaluated for the last processed pixel, to track the cost of a shader program.
+    size_t getNumOperations() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif // OCIO_UNIT_TEST
+
+#endif // INCLUDED_OCIO_GPUSHADEREVALUATOR_H
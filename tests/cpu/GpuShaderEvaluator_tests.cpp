@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cmath>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "GpuShaderEvaluator.h"
+#include "UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+const std::vector<float> AllValues
+    = { -0.25f, 0.0f, 0.02f, 0.18f, 0.5f, 0.75f, 1.0f, 1.25f };
+
+// RGBA pixels made of all the combinations of the values.
+std::vector<float> CreatePixels(const std::vector<float> & values)
+{
+    std::vector<float> pixels;
+    for (float r : values)
+    {
+        for (float g : values)
+        {
+            for (float b : values)
+            {
+                pixels.push_back(r);
+                pixels.push_back(g);
+                pixels.push_back(b);
+                pixels.push_back(g < 0.5f ? 1.0f : 0.5f);
+            }
+        }
+    }
+    return pixels;
+}
+
+OCIO::GpuShaderDescRcPtr ExtractShader(const OCIO::ConstProcessorRcPtr & processor,
+                                       OCIO::GpuShaderDesc::ParameterMode mode)
+{
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(mode == OCIO::GpuShaderDesc::PARAMETER_UNIFORM_BLOCK
+                                ? OCIO::GPU_LANGUAGE_GLSL_4_0 : OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc->setParameterMode(mode);
+    processor->getDefaultGPUProcessor()->extractGpuShaderInfo(shaderDesc);
+    return shaderDesc;
+}
+
+// Compare the shader program evaluation with the CPU processing on the same pixels
+// and return the number of operations per pixel.
+size_t CompareCPUAndGPU(const OCIO::ConstProcessorRcPtr & processor,
+                        float errorThreshold,
+                        unsigned line,
+                        OCIO::GpuShaderDesc::ParameterMode mode
+                            = OCIO::GpuShaderDesc::PARAMETER_CONSTANT)
+{
+    std::vector<float> cpuPixels = CreatePixels(AllValues);
+    std::vector<float> gpuPixels = cpuPixels;
+    const long numPixels = (long)cpuPixels.size() / 4;
+
+    OCIO::PackedImageDesc imgDesc(&cpuPixels[0], numPixels, 1, 4);
+    processor->getDefaultCPUProcessor()->apply(imgDesc);
+
+    OCIO::GpuShaderEvaluator evaluator(ExtractShader(processor, mode));
+    evaluator.apply(&gpuPixels[0], (size_t)numPixels);
+
+    for (size_t idx = 0; idx < cpuPixels.size(); ++idx)
+    {
+        const float cpu = cpuPixels[idx];
+        const float gpu = gpuPixels[idx];
+        if (std::isnan(cpu) && std::isnan(gpu))
+        {
+            continue;
+        }
+        // Relative error above 1 and absolute error below. Note that the CPU renderers
+        // use a fast approximation of pow() so the error is around 1e-5.
+        const float error = std::fabs(cpu - gpu) / std::max(1.0f, std::fabs(cpu));
+        OCIO_CHECK_ASSERT_MESSAGE(error <= errorThreshold,
+                                  "Line " + std::to_string(line) + ", index "
+                                  + std::to_string(idx) + ": " + std::to_string(cpu)
+                                  + " (CPU) vs. " + std::to_string(gpu) + " (GPU)");
+    }
+
+    return evaluator.getNumOperations();
+}
+
+OCIO::ConstProcessorRcPtr GetProcessor(const OCIO::ConstTransformRcPtr & transform)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+    return config->getProcessor(transform);
+}
+
+}
+
+
+OCIO_ADD_TEST(GpuShaderEvaluator, language_subset)
+{
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc->setFunctionName("func");
+
+    shaderDesc->addToDeclareShaderCode("const float half_pi = 1.5707963;\n");
+    shaderDesc->addToHelperShaderCode("vec2 helper(in float f)\n"
+                                      "{\n"
+                                      "  vec2 ret = vec2(f, 1.);\n"
+                                      "  if (f > 0.5) { ret.y = 2.; } else ret.y = -2;\n"
+                                      "  return ret;\n"
+                                      "}\n");
+    shaderDesc->addToFunctionHeaderShaderCode("vec4 func(in vec4 inPixel)\n{\n");
+    shaderDesc->addToFunctionShaderCode(
+        "  vec4 outColor = inPixel;\n"
+        "  // Comment\n"
+        "  int j = int(min(outColor.r * 4., 3.));\n"
+        "  float t = float(j == 2) + float(j / 2);\n"
+        "  vec2 h = helper(outColor.g);\n"
+        "  outColor.rg = outColor.gr * h.y + vec2(t);\n"
+        "  outColor.b = (outColor.b > 0.25 && t > 0.) ? -outColor.b : atan(1., 0.) / half_pi;\n"
+        "  outColor = mat4(2.) * outColor;\n"
+        "  outColor.a += dot(outColor.rgb, vec3(1.0e-1, 0., 0.));\n");
+    shaderDesc->addToFunctionFooterShaderCode("  return outColor;\n}\n");
+    shaderDesc->finalize();
+
+    OCIO::GpuShaderEvaluator evaluator(shaderDesc);
+
+    float pixel[4] = { 0.6f, 0.75f, 0.5f, 1.0f };
+    evaluator.apply(pixel, 1);
+
+    // j = 2 so t = 2, h.y = 2 and rgb = (0.75 * 2 + 2, 0.6 * 2 + 2, -0.5) * 2.
+    OCIO_CHECK_CLOSE(pixel[0], 7.0f, 1e-6f);
+    OCIO_CHECK_CLOSE(pixel[1], 6.4f, 1e-6f);
+    OCIO_CHECK_CLOSE(pixel[2], -1.0f, 1e-6f);
+    OCIO_CHECK_CLOSE(pixel[3], 2.7f, 1e-6f);
+
+    float pixel2[4] = { 0.1f, 0.25f, 0.5f, 1.0f };
+    evaluator.apply(pixel2, 1);
+
+    // j = 0 so t = 0, h.y = -2 and b = atan(1, 0) / half_pi.
+    OCIO_CHECK_CLOSE(pixel2[0], -1.0f, 1e-6f);
+    OCIO_CHECK_CLOSE(pixel2[1], -0.4f, 1e-6f);
+    OCIO_CHECK_CLOSE(pixel2[2], 2.0f, 1e-6f);
+    OCIO_CHECK_CLOSE(pixel2[3], 1.9f, 1e-6f);
+
+    OCIO_CHECK_GT(evaluator.getNumOperations(), 10U);
+
+    // Textures are not supported.
+
+    const float values[2 * 2 * 2 * 3] = { 0.0f };
+    OCIO::GpuShaderDescRcPtr lutDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    lutDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    lutDesc->add3DTexture("lut", "id", 2, OCIO::INTERP_LINEAR, values);
+    lutDesc->finalize();
+    OCIO_CHECK_THROW_WHAT(OCIO::GpuShaderEvaluator ev(lutDesc), OCIO::Exception,
+                          "Shader programs using textures are not supported");
+}
+
+OCIO_ADD_TEST(GpuShaderEvaluator, analytical_ops)
+{
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const double m44[16] = { 1.1, 0.2, -0.1, 0.0,
+                             0.1, 0.9,  0.1, 0.0,
+                            -0.2, 0.1,  1.2, 0.0,
+                             0.0, 0.0,  0.0, 0.8 };
+    const double offset4[4] = { 0.01, -0.02, 0.03, 0.1 };
+    matrix->setMatrix(m44);
+    matrix->setOffset(offset4);
+    const size_t numMatrixOps = CompareCPUAndGPU(GetProcessor(matrix), 1e-6f, __LINE__);
+    // The matrix multiplication and the offset addition.
+    OCIO_CHECK_EQUAL(numMatrixOps, 2U);
+
+    OCIO::CDLTransformRcPtr cdl = OCIO::CDLTransform::Create();
+    const double slope[3] = { 1.2, 1.0, 0.8 };
+    const double offset[3] = { 0.05, 0.0, -0.05 };
+    const double power[3] = { 1.1, 0.9, 1.0 };
+    cdl->setSlope(slope);
+    cdl->setOffset(offset);
+    cdl->setPower(power);
+    cdl->setSat(1.3);
+    CompareCPUAndGPU(GetProcessor(cdl), 1e-4f, __LINE__);
+
+    OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+    range->setMinInValue(0.1);
+    range->setMaxInValue(0.9);
+    range->setMinOutValue(-0.1);
+    range->setMaxOutValue(1.2);
+    CompareCPUAndGPU(GetProcessor(range), 1e-6f, __LINE__);
+
+    OCIO::LogAffineTransformRcPtr logAffine = OCIO::LogAffineTransform::Create();
+    logAffine->setBase(10.0);
+    logAffine->setLogSideSlopeValue({ 0.3, 0.35, 0.4 });
+    logAffine->setLogSideOffsetValue({ 0.6, 0.55, 0.5 });
+    logAffine->setLinSideSlopeValue({ 1.1, 1.0, 0.9 });
+    logAffine->setLinSideOffsetValue({ 0.01, 0.02, 0.03 });
+    CompareCPUAndGPU(GetProcessor(logAffine), 1e-4f, __LINE__);
+    logAffine->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+    CompareCPUAndGPU(GetProcessor(logAffine), 1e-4f, __LINE__);
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    exponent->setValue({ 2.2, 2.4, 2.6, 1.0 });
+    CompareCPUAndGPU(GetProcessor(exponent), 1e-4f, __LINE__);
+
+    OCIO::ExponentWithLinearTransformRcPtr expLinear = OCIO::ExponentWithLinearTransform::Create();
+    expLinear->setGamma({ 2.4, 2.4, 2.4, 1.0 });
+    expLinear->setOffset({ 0.055, 0.055, 0.055, 0.0 });
+    CompareCPUAndGPU(GetProcessor(expLinear), 1e-4f, __LINE__);
+
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->setStyle(OCIO::EXPOSURE_CONTRAST_LINEAR);
+    ec->setExposure(0.5);
+    ec->setContrast(1.2);
+    ec->setPivot(0.18);
+    ec->makeExposureDynamic();
+    CompareCPUAndGPU(GetProcessor(ec), 1e-4f, __LINE__);
+}
+
+OCIO_ADD_TEST(GpuShaderEvaluator, fixed_functions)
+{
+    struct FixedFunctionTest
+    {
+        OCIO::FixedFunctionStyle m_style;
+        OCIO::TransformDirection m_dir;
+        float m_errorThreshold;
+        unsigned m_line;
+    };
+
+    const FixedFunctionTest tests[] = {
+        { OCIO::FIXED_FUNCTION_ACES_RED_MOD_03,     OCIO::TRANSFORM_DIR_FORWARD, 1e-5f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_RED_MOD_03,     OCIO::TRANSFORM_DIR_INVERSE, 1e-5f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_RED_MOD_10,     OCIO::TRANSFORM_DIR_FORWARD, 1e-5f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_RED_MOD_10,     OCIO::TRANSFORM_DIR_INVERSE, 1e-5f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_GLOW_03,        OCIO::TRANSFORM_DIR_FORWARD, 1e-6f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_GLOW_03,        OCIO::TRANSFORM_DIR_INVERSE, 1e-6f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_GLOW_10,        OCIO::TRANSFORM_DIR_FORWARD, 1e-6f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_GLOW_10,        OCIO::TRANSFORM_DIR_INVERSE, 1e-6f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_DARK_TO_DIM_10, OCIO::TRANSFORM_DIR_FORWARD, 1e-5f, __LINE__ },
+        { OCIO::FIXED_FUNCTION_ACES_DARK_TO_DIM_10, OCIO::TRANSFORM_DIR_INVERSE, 1e-5f, __LINE__ },
+    };
+
+    for (const auto & test : tests)
+    {
+        OCIO::FixedFunctionTransformRcPtr func = OCIO::FixedFunctionTransform::Create();
+        func->setStyle(test.m_style);
+        func->setDirection(test.m_dir);
+        CompareCPUAndGPU(GetProcessor(func), test.m_errorThreshold, test.m_line);
+    }
+}
+
+OCIO_ADD_TEST(GpuShaderEvaluator, parameter_modes)
+{
+    OCIO::CDLTransformRcPtr cdl = OCIO::CDLTransform::Create();
+    const double slope[3] = { 1.2, 1.0, 0.8 };
+    const double power[3] = { 1.1, 0.9, 1.0 };
+    cdl->setSlope(slope);
+    cdl->setPower(power);
+    cdl->setSat(0.7);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const double offset4[4] = { 0.01, -0.02, 0.03, 0.0 };
+    matrix->setOffset(offset4);
+
+    OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+    range->setMinInValue(0.0);
+    range->setMinOutValue(0.0);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(cdl);
+    group->push_back(matrix);
+    group->push_back(range);
+
+    OCIO::ConstProcessorRcPtr processor = GetProcessor(group);
+
+    const size_t numConstantOps
+        = CompareCPUAndGPU(processor, 1e-4f, __LINE__, OCIO::GpuShaderDesc::PARAMETER_CONSTANT);
+    const size_t numUniformOps
+        = CompareCPUAndGPU(processor, 1e-4f, __LINE__, OCIO::GpuShaderDesc::PARAMETER_UNIFORM);
+    CompareCPUAndGPU(processor, 1e-4f, __LINE__, OCIO::GpuShaderDesc::PARAMETER_UNIFORM_BLOCK);
+
+    // The uniform layout does not depend on the values so more operations are needed.
+    OCIO_CHECK_GT(numUniformOps, numConstantOps);
+}
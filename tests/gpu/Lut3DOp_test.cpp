@@ -399,6 +399,31 @@ OCIO_ADD_GPU_TEST(Lut3DOp, inv3dlut_file_spi3d_bizarre_tetra)
     test.setErrorThreshold(3e-4f);
 }
 
+OCIO_ADD_GPU_TEST(Lut3DOp, 3dlut_file_odd_edge_half)
+{
+    // A row of 33 half-float RGB texels is 198 bytes i.e. it is not aligned
+    // on the 4 bytes of the unpack alignment used by the test framework.
+    OCIO::FileTransformRcPtr file = GetFileTransform("lustre_33x33x33.3dl");
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_FLOAT16);
+    test.setContext(file->createEditableCopy(), shaderDesc);
+
+    // Half-float values.
+    test.setErrorThreshold(1e-3f);
+}
+
+OCIO_ADD_GPU_TEST(Lut3DOp, 3dlut_file_odd_edge_unorm16)
+{
+    OCIO::FileTransformRcPtr file = GetFileTransform("lustre_33x33x33.3dl");
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+    test.setContext(file->createEditableCopy(), shaderDesc);
+
+    test.setErrorThreshold(5e-4f);
+}
+
 // TODO: Port syncolor test: renderer\test\GPURenderer_cases.cpp_inc GPURendererLut3D_File2_test
 // TODO: Port syncolor test: renderer\test\GPURenderer_cases.cpp_inc GPURendererLut3D_File3_test
 // TODO: Port syncolor test: renderer\test\GPURenderer_cases.cpp_inc GPURendererLut3D_File4_test